@@ -7,8 +7,30 @@
 /** \addtogroup BUZZER Buzzer
  ** @{ */
 
-/** @brief 
+/** @brief Buzzer driver.
  *
+ * BuzzerPlayTone() and BuzzerPlayRtttl() block the calling task until the
+ * sound ends. BuzzerPlay() plays a melody compiled with RtttlCompile() (see
+ * rtttl.h) in the background, driven by a timer: the note frequencies and
+ * durations are already computed, so nothing is parsed while playing.
+ *
+ * Sounds given to BuzzerPlay() are queued with a priority. A sound with a
+ * higher priority than the one being played interrupts it (e.g. an alarm over
+ * music), and the interrupted sound continues afterwards from the note where
+ * it was stopped. Sounds with the same priority are played in order.
+ *
+ * @code
+ * static rtttl_note_t music[128];
+ * static rtttl_note_t alarm[] = {{NOTE_A6, 150}, {RTTTL_PAUSE, 50}, {NOTE_A6, 150}};
+ * uint16_t len = RtttlCompile(songEntertainer, music, 128);
+ * BuzzerPlay(music, len, BUZZER_PRIORITY_MUSIC);
+ * ...
+ * BuzzerPlay(alarm, 3, BUZZER_PRIORITY_ALARM);
+ * @endcode
+ *
+ * @note The notes given to BuzzerPlay() are not copied: they must be kept
+ * until the sound ends. Blocking functions must not be used while
+ * BuzzerBusy().
  *
  * @author Albano Peñalva
  * 
@@ -17,103 +39,20 @@
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 08/04/2024 | Document creation		                         |
+ * | 18/10/2026 | Background playback queue with priorities      |
  *
  */
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 #include <gpio_mcu.h>
+#include "rtttl.h"
 /*==================[macros]=================================================*/
-/* Note frequency (in Hz) */
-#define NOTE_B0  31
-#define NOTE_C1  33
-#define NOTE_CS1 35
-#define NOTE_D1  37
-#define NOTE_DS1 39
-#define NOTE_E1  41
-#define NOTE_F1  44
-#define NOTE_FS1 46
-#define NOTE_G1  49
-#define NOTE_GS1 52
-#define NOTE_A1  55
-#define NOTE_AS1 58
-#define NOTE_B1  62
-#define NOTE_C2  65
-#define NOTE_CS2 69
-#define NOTE_D2  73
-#define NOTE_DS2 78
-#define NOTE_E2  82
-#define NOTE_F2  87
-#define NOTE_FS2 93
-#define NOTE_G2  98
-#define NOTE_GS2 104
-#define NOTE_A2  110
-#define NOTE_AS2 117
-#define NOTE_B2  123
-#define NOTE_C3  131
-#define NOTE_CS3 139
-#define NOTE_D3  147
-#define NOTE_DS3 156
-#define NOTE_E3  165
-#define NOTE_F3  175
-#define NOTE_FS3 185
-#define NOTE_G3  196
-#define NOTE_GS3 208
-#define NOTE_A3  220
-#define NOTE_AS3 233
-#define NOTE_B3  247
-#define NOTE_C4  262
-#define NOTE_CS4 277
-#define NOTE_D4  294
-#define NOTE_DS4 311
-#define NOTE_E4  330
-#define NOTE_F4  349
-#define NOTE_FS4 370
-#define NOTE_G4  392
-#define NOTE_GS4 415
-#define NOTE_A4  440
-#define NOTE_AS4 466
-#define NOTE_B4  494
-#define NOTE_C5  523
-#define NOTE_CS5 554
-#define NOTE_D5  587
-#define NOTE_DS5 622
-#define NOTE_E5  659
-#define NOTE_F5  698
-#define NOTE_FS5 740
-#define NOTE_G5  784
-#define NOTE_GS5 831
-#define NOTE_A5  880
-#define NOTE_AS5 932
-#define NOTE_B5  988
-#define NOTE_C6  1047
-#define NOTE_CS6 1109
-#define NOTE_D6  1175
-#define NOTE_DS6 1245
-#define NOTE_E6  1319
-#define NOTE_F6  1397
-#define NOTE_FS6 1480
-#define NOTE_G6  1568
-#define NOTE_GS6 1661
-#define NOTE_A6  1760
-#define NOTE_AS6 1865
-#define NOTE_B6  1976
-#define NOTE_C7  2093
-#define NOTE_CS7 2217
-#define NOTE_D7  2349
-#define NOTE_DS7 2489
-#define NOTE_E7  2637
-#define NOTE_F7  2794
-#define NOTE_FS7 2960
-#define NOTE_G7  3136
-#define NOTE_GS7 3322
-#define NOTE_A7  3520
-#define NOTE_AS7 3729
-#define NOTE_B7  3951
-#define NOTE_C8  4186
-#define NOTE_CS8 4435
-#define NOTE_D8  4699
-#define NOTE_DS8 4978
+/* Note frequencies (NOTE_xx, in Hz) are defined in rtttl.h */
+#define BUZZER_QUEUE_LEN		4		/*!< Sounds that can be queued (including the one playing) */
+#define BUZZER_PRIORITY_MUSIC	0		/*!< Suggested priority for music */
+#define BUZZER_PRIORITY_ALARM	10		/*!< Suggested priority for alarms */
 /*==================[typedef]================================================*/
 
 /*==================[external data declaration]==============================*/
@@ -161,6 +100,33 @@ void BuzzerPlayTone(uint16_t freq, uint16_t duration);
  */
 void BuzzerPlayRtttl(const char * rtttl_melody);
 
+/**
+ * @brief Plays a compiled melody in the background.
+ *
+ * @note If the queue is full, the sound with the lowest priority is replaced
+ * when its priority is lower than priority.
+ *
+ * @param notes Array of notes (see RtttlCompile()), kept until the sound ends.
+ * @param length Number of notes.
+ * @param priority Sound priority (higher values interrupt lower ones).
+ * @return true Sound queued.
+ * @return false Queue full with sounds of equal or higher priority, or invalid sound.
+ */
+bool BuzzerPlay(const rtttl_note_t *notes, uint16_t length, uint8_t priority);
+
+/**
+ * @brief Stops the sound being played and empties the queue.
+ */
+void BuzzerStop(void);
+
+/**
+ * @brief Checks if a sound given to BuzzerPlay() is playing or queued.
+ *
+ * @return true Sound playing or queued.
+ * @return false Buzzer idle.
+ */
+bool BuzzerBusy(void);
+
 /**
  * @brief Buzzer de-initialization.
  */
@@ -9,7 +9,8 @@
 
 /** \brief RTTTL Melodies for play with Buzzer.
  *
- * @note Use BuzzerPlayRtttl() for playing the melodies.
+ * @note Use BuzzerPlayRtttl() for playing the melodies, or compile them once
+ * with RtttlCompile() and play them in the background with BuzzerPlay().
  *
  * @section changelog
  *
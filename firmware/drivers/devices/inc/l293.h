@@ -26,11 +26,14 @@
  * | 	3A		 	| 	GPIO_18		|
  * | 	4A		 	| 	GPIO_9		|
  *
+ * @note For speed changes with acceleration and jerk limits see motion.h.
+ *
  * @section changelog
  *
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 17/05/2024 | Document creation		                         |
+ * | 18/10/2026 | L293SetDuty(), backward direction fixed        |
  *
  */
 
@@ -70,6 +73,17 @@ uint8_t L293Init(void);
  */
 uint8_t L293SetSpeed(l293_motor_t motor, int8_t speed);
 
+/**
+ * @brief  		Sets motor speed with the full PWM resolution
+ * @param[in]  	motor: 	motor to be configured
+ * @param[in]  	duty: 	from -PWM_DUTY_MAX to PWM_DUTY_MAX (see pwm_mcu.h)
+ * 						0: 			stop
+ * 						positive: 	foward
+ * 						negative: 	backward
+ * @retval 		0 when success, 1 when fails
+ */
+uint8_t L293SetDuty(l293_motor_t motor, int16_t duty);
+
 /**
  * @brief  	De-initializes L293 Driver
  * @param	None
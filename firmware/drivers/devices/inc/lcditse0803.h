@@ -22,6 +22,13 @@
  * | 	SEL2	 	| 	GPIO_18		|
  * | 	SEL3	 	| 	GPIO_9		|
  * | 	Gnd 	    | 	GND     	|
+ *
+ * Each digit of the display has a BCD latch. The driver keeps a shadow
+ * buffer with the port value of every digit (computed once per value, see
+ * bcd_frame.h) and a timer writes and latches one digit every LCD_REFRESH_MS,
+ * with one port write for the data and latch lines. LcdItsE0803Set() only
+ * updates the buffer, so it can be called at any rate without blocking: the
+ * display shows the new value within LCD_FRAME_REFRESH_MS.
  * 
  * @author Albano Peñalva
  *
@@ -30,6 +37,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 18/10/2026 | Background refresh from a timer, LcdItsE0803Set()						|
  * 
  **/
 
@@ -37,6 +45,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 /*==================[macros]=================================================*/
+#define LCD_REFRESH_MS			5						/*!< Period between digit refreshes */
+#define LCD_FRAME_REFRESH_MS	(3 * LCD_REFRESH_MS)	/*!< Period of a whole display refresh */
 
 /*==================[typedef]================================================*/
 
@@ -44,9 +54,10 @@
 
 /*==================[external functions declaration]=========================*/
 /**
- * @brief ESP-EDU LCD Module initialization.
+ * @brief ESP-EDU LCD Module initialization (starts the refresh timer).
  * 
  * @return true 
+ * @return false The refresh timer could not be created or started
  */
 bool LcdItsE0803Init(void);
 
@@ -57,11 +68,22 @@ bool LcdItsE0803Init(void);
  * @return false if an error occurs (out of scale), in other case returns true
  */
 
+/**
+ * @brief Set the value displayed (non-blocking, only updates the shadow buffer).
+ *
+ * @param value Number to display (0 to 999)
+ * @return true if value <= 999
+ * @return false if value > 999 (the display is not changed)
+ */
+bool LcdItsE0803Set(uint16_t value);
+
 /**
  * @brief Display a value in LCD Module.
+ *
+ * @note Same as LcdItsE0803Set().
  * 
  * @param value Number to display (o to 999)
- * @return true if value < 999
+ * @return true if value <= 999
  * @return false if value > 999
  */
 bool LcdItsE0803Write(uint16_t value);
@@ -74,13 +96,13 @@ bool LcdItsE0803Write(uint16_t value);
 uint16_t LcdItsE0803Read(void);
 
 /**
- * @brief Turn off display.
+ * @brief Turn off display (blank digits, LcdItsE0803Set() turns it on again).
  * 
  */
 void LcdItsE0803Off(void);
 
 /**
- * @brief ESP-EDU LCD Module initialization.
+ * @brief ESP-EDU LCD Module de-initialization (stops the refresh timer).
  * 
  * @return true 
  */
@@ -0,0 +1,146 @@
+#ifndef MOTION_H
+#define MOTION_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup Motion Motion
+ ** @{ */
+
+/** \brief Motion controller for servos (servo_sg90.h) and DC motors (l293.h).
+ *
+ * Instead of jumping to a new angle or speed, each axis follows a motion
+ * profile (see motion_profile.h) with limits on its rate of change and on the
+ * derivatives of that rate, which avoids current spikes and mechanical
+ * overshoot. A timer updates every axis each MOTION_TICK_MS: the application
+ * only sets targets and never blocks.
+ *
+ * - Servo axes (MOTION_SERVO_x): the value is the angle (-90 to 90 degrees),
+ *   limited in velocity (deg/s), acceleration (deg/s²) and jerk (deg/s³).
+ * - Motor axes (MOTION_MOTOR_x): the value is the speed (-100 to 100 %),
+ *   limited in acceleration (%/s, max_rate) and jerk (%/s², max_accel);
+ *   max_jerk is not used.
+ *
+ * MotionMoveSync() starts a coordinated move: all the axes start at the same
+ * time and arrive together (the faster ones are slowed down).
+ *
+ * A new target for an axis that is moving is applied when its current move
+ * ends (only the last target is kept).
+ *
+ * @note Servos and motors must be initialized with ServoInit() and
+ * L293Init() before MotionAxisInit().
+ *
+ * @note MOTION_SERVO_0 and MOTION_SERVO_1 share PWM_0 and PWM_1 with the L293
+ * motors: they can not be enabled together with MOTION_MOTOR_1 or
+ * MOTION_MOTOR_2 (MotionAxisInit() returns false).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#define MOTION_TICK_MS		20		/*!< Profile update period (servo PWM period) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Axes
+ */
+typedef enum {
+	MOTION_SERVO_0 = 0,		/*!< Servo SERVO_0 (PWM_0) */
+	MOTION_SERVO_1,			/*!< Servo SERVO_1 (PWM_1) */
+	MOTION_SERVO_2,			/*!< Servo SERVO_2 (PWM_2) */
+	MOTION_SERVO_3,			/*!< Servo SERVO_3 (PWM_3) */
+	MOTION_MOTOR_1,			/*!< L293 MOTOR_1 (PWM_0) */
+	MOTION_MOTOR_2,			/*!< L293 MOTOR_2 (PWM_1) */
+	MOTION_AXES,			/*!< Number of axes */
+} motion_axis_t;
+
+/**
+ * @brief Axis limits (per second, see units of each axis type above)
+ */
+typedef struct {
+	float max_rate;			/*!< Maximum rate of change of the value */
+	float max_accel;		/*!< Maximum rate of change of max_rate */
+	float max_jerk;			/*!< Maximum rate of change of max_accel (0: trapezoidal profile) */
+} motion_limits_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Start the motion controller timer
+ *
+ * @return true Controller running
+ * @return false Timer could not be created
+ */
+bool MotionInit(void);
+
+/**
+ * @brief Enable an axis
+ *
+ * @note The output is set to position immediately (without a profile).
+ *
+ * @param axis Axis
+ * @param limits Pointer to axis limits
+ * @param position Current value of the axis
+ * @return true Axis enabled
+ * @return false Invalid axis or limits, or an axis using the same PWM outputs is enabled
+ */
+bool MotionAxisInit(motion_axis_t axis, const motion_limits_t *limits, float position);
+
+/**
+ * @brief Move an axis to a target
+ *
+ * @param axis Axis
+ * @param target Target value
+ * @return true Move queued
+ * @return false Axis not enabled
+ */
+bool MotionMoveTo(motion_axis_t axis, float target);
+
+/**
+ * @brief Coordinated move: the axes start at the same time and arrive together
+ *
+ * @param axes Array of axes
+ * @param targets Array of target values, one per axis
+ * @param n Number of axes
+ * @return true Move queued
+ * @return false An axis is not enabled (nothing is queued)
+ */
+bool MotionMoveSync(const motion_axis_t *axes, const float *targets, uint8_t n);
+
+/**
+ * @brief Check if an axis is moving or has a move queued
+ *
+ * @param axis Axis
+ * @return true Axis moving
+ * @return false Axis stopped at its last target
+ */
+bool MotionBusy(motion_axis_t axis);
+
+/**
+ * @brief Current value of an axis (angle or speed)
+ *
+ * @param axis Axis
+ * @return float Value sent to the output in the last update
+ */
+float MotionPosition(motion_axis_t axis);
+
+/**
+ * @brief Stop the motion controller timer (outputs keep their last value)
+ */
+void MotionDeinit(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* MOTION_H */
+
+/*==================[end of file]============================================*/
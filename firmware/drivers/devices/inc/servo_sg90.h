@@ -11,6 +11,8 @@
  *
  * @note This driver can handle up to 4 SG90 microservos.
  * 
+ * @note For smooth, speed limited moves see motion.h.
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -18,6 +20,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/01/2024 | Document creation		                         						|
+ * | 18/10/2026 | Fine angle resolution, ServoMoveAngles()								|
  * 
  **/
 
@@ -55,6 +58,15 @@ uint8_t ServoInit(servo_out_t servo, gpio_t gpio);
  */
 void ServoMove(servo_out_t servo, int8_t ang);
 
+/**
+ * @brief Change the angle of several servos in the same PWM period.
+ * 
+ * @param servos Array of servo numbers
+ * @param angles Array of angles (from -90 to 90 degrees), one per servo
+ * @param n Number of servos
+ */
+void ServoMoveAngles(const servo_out_t *servos, const float *angles, uint8_t n);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
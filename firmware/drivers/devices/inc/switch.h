@@ -12,6 +12,12 @@
  * @note ESP-EDU have 2 switches connected to GPIO_4 and GPIO_15. 
  * The latter is also routed to J2 connector.
  *
+ * @note The switch service (SwitchServiceInit()) debounces both switches
+ * from a periodic tick (see debounce.h) and publishes one event per gesture
+ * (press, release, long press, double click) to a queue read with
+ * SwitchReadEvent(). It replaces polling SwitchesRead() with delays and
+ * interrupts attached with SwitchActivInt(), which fire on every bounce.
+ *
  * @author Albano Peñalva
  *
  * @section changelog
@@ -19,6 +25,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 18/10/2026 | Debounced switch service with event queue								|
  * 
  **/
 
@@ -26,12 +33,36 @@
 #include <stdbool.h>
 #include <stdint.h>
 /*==================[macros]=================================================*/
+#define SWITCH_TICK_MS			5		/*!< Switch service sampling period */
+#define SWITCH_DEBOUNCE_MS		20		/*!< Stable time needed to accept a press or release */
+#define SWITCH_LONG_PRESS_MS	800		/*!< Hold time of a long press */
+#define SWITCH_DOUBLE_CLICK_MS	300		/*!< Maximum time between release and second press of a double click */
+#define SWITCH_QUEUE_LEN		16		/*!< Events waiting to be read */
+#define SWITCH_WAIT_FOREVER		UINT32_MAX	/*!< SwitchReadEvent() timeout without limit */
 
 /*==================[typedef]================================================*/
 typedef enum switches {
     SWITCH_1 = (1 << 0),  /**< Routed to GPIO_4 */
     SWITCH_2 = (1 << 1),  /**< Routed to GPIO_15 */
 } switch_t;
+
+/**
+ * @brief Switch service event types
+ */
+typedef enum {
+	SWITCH_PRESSED,			/*!< Switch pressed */
+	SWITCH_RELEASED,		/*!< Switch released */
+	SWITCH_LONG_PRESS,		/*!< Switch held for SWITCH_LONG_PRESS_MS */
+	SWITCH_DOUBLE_CLICK,	/*!< Second press of a double click (after its SWITCH_PRESSED event) */
+} switch_event_type_t;
+
+/**
+ * @brief Switch service event
+ */
+typedef struct {
+	switch_t sw;				/*!< Switch */
+	switch_event_type_t type;	/*!< Event type */
+} switch_event_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -58,6 +89,37 @@ int8_t SwitchesRead(void);
  */
 void SwitchActivInt(switch_t tec, void *ptrIntFunc, void *args);
 
+/**
+ * @brief Start the switch service (switches are initialized if needed)
+ * 
+ * @return true Service running
+ * @return false Could not create the queue or the tick timer
+ */
+bool SwitchServiceInit(void);
+
+/**
+ * @brief Wait for the next switch event
+ * 
+ * @param event Pointer where the event is copied
+ * @param timeout_ms Maximum waiting time (in ms), 0 to return immediately or SWITCH_WAIT_FOREVER
+ * @return true Event copied
+ * @return false No event before the timeout (or service not running)
+ */
+bool SwitchReadEvent(switch_event_t *event, uint32_t timeout_ms);
+
+/**
+ * @brief Read the debounced state of the switches (switch service)
+ * 
+ * @return int8_t 0 if no key pressed, SWITCH_1, SWITCH_2 or (SWITCH_1 | SWITCH_2) in other case.
+ */
+int8_t SwitchesState(void);
+
+/**
+ * @brief Stop the switch service and discard pending events
+ * 
+ */
+void SwitchServiceDeinit(void);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
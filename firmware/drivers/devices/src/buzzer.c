@@ -13,37 +13,123 @@
 #include "buzzer.h"
 #include "delay_mcu.h"
 #include "pwm_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
 /*==================[macros and definitions]=================================*/
 #define PWM_BUZZER      PWM_3
 #define PWM_DC          50
-#define OCTAVE_OFFSET   0
+#define NO_SOUND        (-1)
+
+typedef struct {
+    const rtttl_note_t *notes;  /*!< Compiled melody */
+    uint16_t length;            /*!< Number of notes */
+    uint16_t position;          /*!< Note being played (or to play when resumed) */
+    uint8_t priority;           /*!< Sound priority */
+    uint32_t order;             /*!< Queue order among sounds of the same priority */
+    bool used;                  /*!< Queue slot in use */
+} buzzer_sound_t;
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
-uint16_t notes[] = {
-    0,
-    NOTE_C4, NOTE_CS4, NOTE_D4, NOTE_DS4, NOTE_E4, NOTE_F4, NOTE_FS4, NOTE_G4, NOTE_GS4, NOTE_A4, NOTE_AS4, NOTE_B4,
-    NOTE_C5, NOTE_CS5, NOTE_D5, NOTE_DS5, NOTE_E5, NOTE_F5, NOTE_FS5, NOTE_G5, NOTE_GS5, NOTE_A5, NOTE_AS5, NOTE_B5,
-    NOTE_C6, NOTE_CS6, NOTE_D6, NOTE_DS6, NOTE_E6, NOTE_F6, NOTE_FS6, NOTE_G6, NOTE_GS6, NOTE_A6, NOTE_AS6, NOTE_B6,
-    NOTE_C7, NOTE_CS7, NOTE_D7, NOTE_DS7, NOTE_E7, NOTE_F7, NOTE_FS7, NOTE_G7, NOTE_GS7, NOTE_A7, NOTE_AS7, NOTE_B7
-};
+static buzzer_sound_t buzzer_queue[BUZZER_QUEUE_LEN];
+static int8_t buzzer_playing = NO_SOUND;        /* Queue slot being played */
+static int64_t buzzer_note_end;                 /* End of the note being played (us) */
+static uint32_t buzzer_order = 0;
+static esp_timer_handle_t buzzer_timer = NULL;
+static portMUX_TYPE buzzer_mux = portMUX_INITIALIZER_UNLOCKED;
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
-bool isDigit(char c){
-    if((c >= '0') && (c <= '9')){
-        return true;
-    }else{
-        return false;
+/**
+ * @brief Queue slot to play: highest priority, and the oldest among equals
+ */
+static int8_t buzzer_select(void){
+    int8_t best = NO_SOUND;
+    for(int8_t i = 0; i < BUZZER_QUEUE_LEN; i++){
+        if(!buzzer_queue[i].used){
+            continue;
+        }
+        if((best == NO_SOUND) || (buzzer_queue[i].priority > buzzer_queue[best].priority)
+            || ((buzzer_queue[i].priority == buzzer_queue[best].priority)
+            && ((int32_t)(buzzer_queue[i].order - buzzer_queue[best].order) < 0))){
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Make the timer callback run now to re-evaluate the queue
+ */
+static void buzzer_kick(void){
+    /* If the callback re-arms the timer between both calls it has already
+     * seen the new queue, so a failed start can be ignored */
+    esp_timer_stop(buzzer_timer);
+    esp_timer_start_once(buzzer_timer, 0);
+}
+
+/**
+ * @brief Timer callback: ends the current note and starts the next one
+ *
+ * Besides the end of each note, it runs when a sound is queued over a lower
+ * priority one or the queue is emptied (see buzzer_kick()).
+ */
+static void buzzer_next(void *arg){
+    int64_t now = esp_timer_get_time();
+    buzzer_sound_t *sound;
+    int8_t next;
+    uint16_t freq = RTTTL_PAUSE;
+    portENTER_CRITICAL(&buzzer_mux);
+    if((buzzer_playing != NO_SOUND) && (now >= buzzer_note_end)){
+        sound = &buzzer_queue[buzzer_playing];
+        if(sound->used && (++sound->position >= sound->length)){
+            sound->used = false;
+        }
+    }
+    next = buzzer_select();
+    if((next != NO_SOUND) && (next == buzzer_playing) && (now < buzzer_note_end)){
+        /* Early call that does not change the sound: wait for the end of the note */
+        esp_timer_start_once(buzzer_timer, buzzer_note_end - now);
+        portEXIT_CRITICAL(&buzzer_mux);
+        return;
+    }
+    if(next != NO_SOUND){
+        sound = &buzzer_queue[next];
+        if(next == buzzer_playing){
+            /* Next note of the same sound: timed from the end of the previous one */
+            buzzer_note_end += sound->notes[sound->position].duration * 1000LL;
+        } else{
+            buzzer_note_end = now + sound->notes[sound->position].duration * 1000LL;
+        }
+        freq = sound->notes[sound->position].freq;
+        esp_timer_start_once(buzzer_timer, (buzzer_note_end > now) ? (buzzer_note_end - now) : 0);
+    }
+    buzzer_playing = next;
+    portEXIT_CRITICAL(&buzzer_mux);
+
+    if(freq != RTTTL_PAUSE){
+        PWMSetFreq(PWM_BUZZER, freq);
+        PWMOn(PWM_BUZZER);
+    } else{
+        PWMOff(PWM_BUZZER);
     }
 }
 /*==================[external functions definition]==========================*/
 void BuzzerInit(gpio_t pin){
+    const esp_timer_create_args_t timer_args = {
+        .callback = buzzer_next,
+        .name = "buzzer",
+    };
     PWMInit(PWM_BUZZER, pin, NOTE_C4);
     PWMSetDutyCycle(PWM_BUZZER, PWM_DC);
     PWMOff(PWM_BUZZER);
+    if(buzzer_timer == NULL){
+        if(esp_timer_create(&timer_args, &buzzer_timer) != ESP_OK){
+            buzzer_timer = NULL;
+        }
+    }
 }
 
 void BuzzerOn(void){
@@ -66,129 +152,91 @@ void BuzzerPlayTone(uint16_t freq, uint16_t duration){
 }
 
 void BuzzerPlayRtttl(const char * rtttl_melody){
-    uint8_t default_dur = 4;
-    uint8_t default_oct = 6;
-    int bpm = 63;
-    int num;
-    long wholenote;
-    long duration;
-    uint8_t note;
-    uint8_t scale;
-
-    /* find the start (skip name, etc) */
-    while(*rtttl_melody != ':') rtttl_melody++; // ignore name
-    rtttl_melody++;                             // skip ':'
-
-    /* get default duration */
-    if(*rtttl_melody == 'd'){
-        rtttl_melody++; 
-        rtttl_melody++;     // skip "d="
-        num = 0;
-        while(isDigit(*rtttl_melody)){
-        num = (num * 10) + (*rtttl_melody++ - '0');
+    rtttl_parser_t parser;
+    rtttl_note_t note;
+    if(!RtttlBegin(&parser, rtttl_melody)){
+        return;
+    }
+    while(RtttlNext(&parser, &note)){
+        if(note.freq != RTTTL_PAUSE){
+            BuzzerPlayTone(note.freq, note.duration);
         }
-        if(num > 0) default_dur = num;
-        rtttl_melody++;     // skip comma
-    }
-
-    /* get default octave */
-    if(*rtttl_melody == 'o'){
-        rtttl_melody++; 
-        rtttl_melody++;     // skip "o="
-        num = *rtttl_melody++ - '0';
-        if(num >= 3 && num <=7) default_oct = num;
-        rtttl_melody++;     // skip comma
-    }
-
-    /* get BPM */
-    if(*rtttl_melody == 'b'){
-        rtttl_melody++; 
-        rtttl_melody++;     // skip "b="
-        num = 0;
-        while(isDigit(*rtttl_melody)){
-        num = (num * 10) + (*rtttl_melody++ - '0');
+        else{
+            DelayMs(note.duration);
         }
-        bpm = num;
-        rtttl_melody++;     // skip colon
     }
+}
 
-    /* BPM usually expresses the number of quarter notes per minute */
-    wholenote = (60 * 1000L / bpm) * 4;  // this is the time for whole note (in milliseconds)
-
-    /* now begin note loop */
-    while(*rtttl_melody){
-        /* first, get note duration, if available */
-        num = 0;
-        while(isDigit(*rtttl_melody)){
-            num = (num * 10) + (*rtttl_melody++ - '0');
-        }
-        if(num){
-            duration = wholenote / num;
-        }else{
-            duration = wholenote / default_dur;  // we will need to check if we are a dotted note after
-        } 
-        /* now get the note */
-        note = 0;
-        switch(*rtttl_melody){
-        case 'c':
-            note = 1;
-            break;
-        case 'd':
-            note = 3;
-            break;
-        case 'e':
-            note = 5;
-            break;
-        case 'f':
-            note = 6;
-            break;
-        case 'g':
-            note = 8;
-            break;
-        case 'a':
-            note = 10;
-            break;
-        case 'b':
-            note = 12;
+bool BuzzerPlay(const rtttl_note_t *notes, uint16_t length, uint8_t priority){
+    int8_t slot = NO_SOUND;
+    bool kick;
+    if((buzzer_timer == NULL) || (notes == NULL) || (length == 0)){
+        return false;
+    }
+    portENTER_CRITICAL(&buzzer_mux);
+    for(int8_t i = 0; i < BUZZER_QUEUE_LEN; i++){
+        if(!buzzer_queue[i].used){
+            slot = i;
             break;
-        case 'p':
-        default:
-            note = 0;
-        }
-        rtttl_melody++;
-        /* now, get optional '#' sharp */
-        if(*rtttl_melody == '#'){
-            note++;
-            rtttl_melody++;
-        }
-        /* now, get optional '.' dotted note */
-        if(*rtttl_melody == '.'){
-            duration += duration/2;
-            rtttl_melody++;
         }
-        /* now, get scale */
-        if(isDigit(*rtttl_melody)){
-            scale = *rtttl_melody - '0';
-            rtttl_melody++;
-        }else{
-            scale = default_oct;
+        /* Queue full: lowest priority sound, the newest among equals */
+        if((slot == NO_SOUND) || (buzzer_queue[i].priority < buzzer_queue[slot].priority)
+            || ((buzzer_queue[i].priority == buzzer_queue[slot].priority)
+            && ((int32_t)(buzzer_queue[i].order - buzzer_queue[slot].order) > 0))){
+            slot = i;
         }
-        scale += OCTAVE_OFFSET;
+    }
+    if(buzzer_queue[slot].used && (buzzer_queue[slot].priority >= priority)){
+        portEXIT_CRITICAL(&buzzer_mux);
+        return false;
+    }
+    buzzer_queue[slot].notes = notes;
+    buzzer_queue[slot].length = length;
+    buzzer_queue[slot].position = 0;
+    buzzer_queue[slot].priority = priority;
+    buzzer_queue[slot].order = buzzer_order++;
+    buzzer_queue[slot].used = true;
+    if(slot == buzzer_playing){
+        /* The sound being played was replaced: the new one starts from its first note */
+        buzzer_playing = NO_SOUND;
+    }
+    kick = (buzzer_playing == NO_SOUND) || (priority > buzzer_queue[buzzer_playing].priority);
+    portEXIT_CRITICAL(&buzzer_mux);
+    if(kick){
+        buzzer_kick();
+    }
+    return true;
+}
 
-        if(*rtttl_melody == ','){
-            rtttl_melody++; // skip comma for next note (or we may be at the end)
-        }
-        /* now play the note */
-        if(note){
-            BuzzerPlayTone(notes[(scale - 4) * 12 + note], duration);
-        }
-        else{
-            DelayMs(duration);
-        }
+void BuzzerStop(void){
+    portENTER_CRITICAL(&buzzer_mux);
+    for(uint8_t i = 0; i < BUZZER_QUEUE_LEN; i++){
+        buzzer_queue[i].used = false;
     }
+    portEXIT_CRITICAL(&buzzer_mux);
+    if(buzzer_timer != NULL){
+        buzzer_kick();
+    }
+}
+
+bool BuzzerBusy(void){
+    bool busy = false;
+    portENTER_CRITICAL(&buzzer_mux);
+    for(uint8_t i = 0; i < BUZZER_QUEUE_LEN; i++){
+        busy |= buzzer_queue[i].used;
+    }
+    portEXIT_CRITICAL(&buzzer_mux);
+    return busy;
 }
 
 void BuzzerDeinit(void){
-    
+    BuzzerStop();
+    if(buzzer_timer != NULL){
+        esp_timer_stop(buzzer_timer);
+        esp_timer_delete(buzzer_timer);
+        buzzer_timer = NULL;
+    }
+    buzzer_playing = NO_SOUND;
+    PWMOff(PWM_BUZZER);
 }
-/*==================[end of file]============================================*/
+/*==================[end of file]============================================*/
\ No newline at end of file
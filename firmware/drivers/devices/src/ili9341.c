@@ -86,6 +86,12 @@ typedef struct {
 
 /*==================[internal functions declaration]=========================*/
 
+/**
+ * @brief  		Queue command and parameters/data to LCD without waiting for the transfer
+ * @param[in]  	data: command and data to send (data must remain valid until SpiFlush())
+ */
+void QueueLCD(lcd_cmd_t * data);
+
 /**
  * @brief  		Send command and parameters/data to LCD
  * @param[in]  	data: Structure with the command and parameters/data to send
@@ -180,7 +186,8 @@ spi_mcu_config_t spi_conf = {
 	.bitrate = SPI_BR, 
 	.transfer_mode = SPI_POLLING, 
 	.func_p = NULL,
-	.param_p = NULL };
+	.param_p = NULL,
+	.dc_enable = true };
 
 static spi_dev_t ili9341_spi;				/*!< uC SPI port */
 static gpio_t ili9341_dc, ili9341_rst;		/*!< uC GPIO ports to use as CS, DC and RST */
@@ -193,20 +200,22 @@ static orientation_properties_t lcd_orientation = {
 
 /*==================[internal functions definition]==========================*/
 
+void QueueLCD(lcd_cmd_t * data){
+	/* If command is NULL don't send command. The command byte (DC low) and its
+	 * parameters or data (DC high) are queued together, DC is driven by the SPI driver */
+	spi_mcu_trans_t trans = {
+		.flags = (data->cmd != NULL) ? SPI_TRANS_CMD : 0,
+		.cmd = data->cmd,
+		.tx_buffer = data->data,
+		.length = data->databytes,
+	};
+	SpiQueue(ili9341_spi, &trans, SPI_WAIT_FOREVER);
+}
+
 void WriteLCD(lcd_cmd_t * data){
-	SpiInit(&spi_conf);
-	/* If command is NULL don't send command */
-	if (data->cmd != NULL){
-		/* Send command */
-		GPIOOff(ili9341_dc);
-		SpiWrite(ili9341_spi, &data->cmd, 1);
-	}
-	/* If there are parameters or data to send */
-	if (data->databytes != NULL){
-		/* Send parameters or data */
-		GPIOOn(ili9341_dc);
-		SpiWrite(ili9341_spi, data->data, data->databytes);
-	}
+	QueueLCD(data);
+	/* data is usually a local array: wait until it has been sent */
+	SpiFlush(ili9341_spi);
 }
 
 void SetCursorPosition(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1){
@@ -258,9 +267,10 @@ void Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
 	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
 	WriteLCD(&lcd_write);
 
+	/* pixel does not change, so every block is queued and sent back to back */
 	while(bytes_count - MAX_VALUE_SIZE > 0){
 		lcd_cmd_t lcd_pixel = {NULL, MAX_VALUE_SIZE, pixel};
-		WriteLCD(&lcd_pixel);
+		QueueLCD(&lcd_pixel);
 		bytes_count -= MAX_VALUE_SIZE;
 	}
 	lcd_cmd_t lcd_pixel = {NULL, bytes_count, pixel};
@@ -276,8 +286,10 @@ uint8_t ILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst){
 	/* GPIOs configuration and initialization */
 	ili9341_dc = gpio_dc;
 	ili9341_rst = gpio_rst;
-	GPIOInit(ili9341_dc, GPIO_OUTPUT);
+	spi_conf.dc_gpio = gpio_dc;
 	GPIOInit(ili9341_rst, GPIO_OUTPUT);
+	/* DC is initialized and driven by the SPI driver */
+	SpiInit(&spi_conf);
 
 	/* RST must be held low for minimum 10µsec after VCC have been applied */
 	DelayUs(10);
@@ -49,53 +49,43 @@ uint8_t L293Init(void){
 }
 
 uint8_t L293SetSpeed(l293_motor_t motor, int8_t speed){
-	uint8_t err = 0;
+	if (speed > MAX_F_SPEED) speed = MAX_F_SPEED;
+	if (speed < MAX_B_SPEED) speed = MAX_B_SPEED;
+	int16_t duty = PWM_DUTY_FROM_PERCENT((speed < 0) ? -speed : speed);
+	return L293SetDuty(motor, (speed < 0) ? -duty : duty);
+}
 
+uint8_t L293SetDuty(l293_motor_t motor, int16_t duty){
+	uint32_t dir_mask, forward, backward;
+	pwm_out_t out;
 	switch(motor){
 	case MOTOR_1:
-		if(speed == 0){
-			PWMSetDutyCycle(PWM_0, speed);
-			GPIOOff(A_1);
-			GPIOOff(A_2);
-		}
-		if(speed > 0){
-			if (speed > MAX_F_SPEED) speed = MAX_F_SPEED;
-			PWMSetDutyCycle(PWM_0, speed);
-			GPIOOn(A_1);
-			GPIOOff(A_2);
-		}
-		if(speed < 0){
-			if (speed < MAX_B_SPEED) speed = MAX_B_SPEED;
-			PWMSetDutyCycle(PWM_0, -speed);
-			GPIOOn(A_1);
-			GPIOOff(A_2);
-		}
+		out = PWM_0;
+		forward = GPIO_BIT(A_1);
+		backward = GPIO_BIT(A_2);
 		break;
 	case MOTOR_2:
-		if(speed == 0){
-			PWMSetDutyCycle(PWM_1, speed);
-			GPIOOff(A_3);
-			GPIOOff(A_4);
-		}
-		if(speed > 0){
-			if (speed > MAX_F_SPEED) speed = MAX_F_SPEED;
-			PWMSetDutyCycle(PWM_1, speed);
-			GPIOOn(A_3);
-			GPIOOff(A_4);
-		}
-		if(speed < 0){
-			if (speed < MAX_B_SPEED) speed = MAX_B_SPEED;
-			PWMSetDutyCycle(PWM_1, -speed);
-			GPIOOn(A_3);
-			GPIOOff(A_4);
-		}
+		out = PWM_1;
+		forward = GPIO_BIT(A_3);
+		backward = GPIO_BIT(A_4);
 		break;
 	default:
-		err = 1;
-		break;
+		return 1;
 	}
-
-	return err;
+	dir_mask = forward | backward;
+	if(duty > PWM_DUTY_MAX) duty = PWM_DUTY_MAX;
+	if(duty < -PWM_DUTY_MAX) duty = -PWM_DUTY_MAX;
+	if(duty == 0){
+		PWMSetDuty(out, 0);
+		GPIOWriteMask(dir_mask, 0);
+	} else if(duty > 0){
+		PWMSetDuty(out, duty);
+		GPIOWriteMask(dir_mask, forward);
+	} else{
+		PWMSetDuty(out, -duty);
+		GPIOWriteMask(dir_mask, backward);
+	}
+	return 0;
 }
 
 uint8_t L293DeInit(void){
@@ -12,6 +12,9 @@
 /*==================[inclusions]=============================================*/
 #include "lcditse0803.h"
 #include "gpio_mcu.h"
+#include "bcd_frame.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
 /*==================[macros and definitions]=================================*/
 #define GPIO_BCD_1	GPIO_20
 #define GPIO_BCD_2	GPIO_21
@@ -20,21 +23,34 @@
 #define GPIO_SEL_1	GPIO_19
 #define GPIO_SEL_2	GPIO_18
 #define GPIO_SEL_3	GPIO_9
+#define LCD_DIGITS	3
+#define LCD_MAX		999
 /*==================[internal data definition]===============================*/
 static uint16_t actual_value = 0; /*variable that saves the value to be shown in the display LCD*/
+static bcd_frame_table_t lcd_table;						/* Port value of each BCD code */
+static uint32_t lcd_frame[LCD_DIGITS];					/* Shadow buffer: port value of each digit */
+static const uint32_t lcd_sel[LCD_DIGITS] = {GPIO_BIT(GPIO_SEL_1), GPIO_BIT(GPIO_SEL_2), GPIO_BIT(GPIO_SEL_3)};
+static uint8_t lcd_digit = 0;							/* Next digit to refresh */
+static esp_timer_handle_t lcd_timer = NULL;
+static portMUX_TYPE lcd_mux = portMUX_INITIALIZER_UNLOCKED;
 /*==================[internal functions declaration]=========================*/
-/** @brief Aux function to load a digit to the LCD Display
- *
+/**
+ * @brief Refresh timer callback: writes and latches one digit
  */
-bool LcdItsE0803BCDtoPin(uint8_t value){
-	GPIOState(GPIO_BCD_1, (value & (1<<0))>>0);
-	GPIOState(GPIO_BCD_2, (value & (1<<1))>>1);
-	GPIOState(GPIO_BCD_3, (value & (1<<2))>>2);
-	GPIOState(GPIO_BCD_4, (value & (1<<3))>>3);
-	return true;
+static void LcdItsE0803Refresh(void *arg){
+	uint32_t pattern = lcd_frame[lcd_digit];
+	/* Data and latch enable in one port write, the digit latches on the falling edge */
+	GPIOWriteMask(lcd_table.mask | lcd_sel[lcd_digit], pattern | lcd_sel[lcd_digit]);
+	GPIOWriteMask(lcd_sel[lcd_digit], 0);
+	lcd_digit = (lcd_digit + 1) % LCD_DIGITS;
 }
 /*==================[external functions definition]==========================*/
 bool LcdItsE0803Init(void){
+	const uint8_t bcd_pins[BCD_FRAME_BITS] = {GPIO_BCD_1, GPIO_BCD_2, GPIO_BCD_3, GPIO_BCD_4};
+	const esp_timer_create_args_t timer_args = {
+		.callback = LcdItsE0803Refresh,
+		.name = "lcd",
+	};
 	/* Configuration of pins of data*/
 	GPIOInit(GPIO_BCD_1, GPIO_OUTPUT);
 	GPIOInit(GPIO_BCD_2, GPIO_OUTPUT);
@@ -46,38 +62,41 @@ bool LcdItsE0803Init(void){
 	GPIOInit(GPIO_SEL_2, GPIO_OUTPUT);
 	GPIOInit(GPIO_SEL_3, GPIO_OUTPUT);
 
-	actual_value=0;
-	LcdItsE0803Write(actual_value);
+	BcdFrameTableInit(&lcd_table, bcd_pins);
+	actual_value = 0;
+	BcdFrameEncode(&lcd_table, actual_value, lcd_frame, LCD_DIGITS);
+	lcd_digit = 0;
+	if(lcd_timer == NULL){
+		if(esp_timer_create(&timer_args, &lcd_timer) != ESP_OK){
+			lcd_timer = NULL;
+			return false;
+		}
+		if(esp_timer_start_periodic(lcd_timer, LCD_REFRESH_MS * 1000) != ESP_OK){
+			esp_timer_delete(lcd_timer);
+			lcd_timer = NULL;
+			return false;
+		}
+	}
 	return true;
 };
 
-bool LcdItsE0803Write(uint16_t value) {
-	uint8_t units, tens, hundreds;
-	if(value<1000)	 {
-		actual_value = value;
-
-		hundreds = value/100;
-		tens = (value-(hundreds*100))/10;
-		units = (value-(hundreds*100)-(tens*10));
-
-		/* Write hundreds */
-		LcdItsE0803BCDtoPin(hundreds);
-		GPIOOn(GPIO_SEL_1);
-		GPIOOff(GPIO_SEL_1);
-
-		/* Write tens */
-		LcdItsE0803BCDtoPin(tens);
-		GPIOOn(GPIO_SEL_2);
-		GPIOOff(GPIO_SEL_2);
-
-		/* Write units */
-		LcdItsE0803BCDtoPin(units);
-		GPIOOn(GPIO_SEL_3);
-		GPIOOff(GPIO_SEL_3);
-		return true; /* return 1 for values lower than 999 */
+bool LcdItsE0803Set(uint16_t value){
+	uint32_t frame[LCD_DIGITS];
+	if(value > LCD_MAX){
+		return false;
 	}
-	else
-		return false; /* return 0 for values higher than 999 */
+	BcdFrameEncode(&lcd_table, value, frame, LCD_DIGITS);
+	portENTER_CRITICAL(&lcd_mux);
+	lcd_frame[0] = frame[0];
+	lcd_frame[1] = frame[1];
+	lcd_frame[2] = frame[2];
+	actual_value = value;
+	portEXIT_CRITICAL(&lcd_mux);
+	return true;
+}
+
+bool LcdItsE0803Write(uint16_t value) {
+	return LcdItsE0803Set(value);
 }
 
 uint16_t LcdItsE0803Read(void){
@@ -85,20 +104,21 @@ uint16_t LcdItsE0803Read(void){
 }
 
 void LcdItsE0803Off(void){
-	LcdItsE0803BCDtoPin(0x0F);
-	GPIOOn(GPIO_SEL_1);
-	GPIOOff(GPIO_SEL_1);
-
-	LcdItsE0803BCDtoPin(0x0F);
-	GPIOOn(GPIO_SEL_2);
-	GPIOOff(GPIO_SEL_2);
-
-	LcdItsE0803BCDtoPin(0x0F);
-	GPIOOn(GPIO_SEL_3);
-	GPIOOff(GPIO_SEL_3);
+	uint32_t frame[LCD_DIGITS];
+	BcdFrameBlank(&lcd_table, frame, LCD_DIGITS);
+	portENTER_CRITICAL(&lcd_mux);
+	lcd_frame[0] = frame[0];
+	lcd_frame[1] = frame[1];
+	lcd_frame[2] = frame[2];
+	portEXIT_CRITICAL(&lcd_mux);
 }
 
 bool LcdItsE0803DeInit(void){
+	if(lcd_timer != NULL){
+		esp_timer_stop(lcd_timer);
+		esp_timer_delete(lcd_timer);
+		lcd_timer = NULL;
+	}
 	GPIODeinit();
 	return true;
 }
@@ -0,0 +1,289 @@
+/**
+ * @file motion.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "motion.h"
+#include "motion_profile.h"
+#include "servo_sg90.h"
+#include "l293.h"
+#include "pwm_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+/*==================[macros and definitions]=================================*/
+#define SERVO_AXES		4			/* MOTION_SERVO_0 to MOTION_SERVO_3 */
+#define SERVO_MIN		-90.0f
+#define SERVO_MAX		90.0f
+#define MOTOR_MIN		-100.0f
+#define MOTOR_MAX		100.0f
+#define TICK_S			(MOTION_TICK_MS / 1000.0f)
+
+typedef struct {
+	motion_limits_t limits;			/*!< Axis limits */
+	motion_profile_t profile;		/*!< Current move */
+	float position;					/*!< Last value sent to the output */
+	float time;						/*!< Time since the start of the current move (s) */
+	bool enabled;					/*!< Axis initialized */
+	bool moving;					/*!< Current move not finished */
+	bool pending;					/*!< A move is waiting to start */
+	float pending_target;			/*!< Target of the waiting move */
+	uint8_t pending_group;			/*!< Axes (bit mask) that start together with this one */
+} motion_state_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static motion_state_t motion_axes[MOTION_AXES];
+static portMUX_TYPE motion_mux = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t motion_timer = NULL;
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static bool is_servo(uint8_t axis){
+	return axis < SERVO_AXES;
+}
+
+/**
+ * @brief Axes that can not be enabled together with an axis
+ *
+ * SERVO_0 and SERVO_1 use PWM_0 and PWM_1, the outputs that L293Init()
+ * configures for MOTOR_1 and MOTOR_2 (at another frequency).
+ */
+static uint8_t motion_conflicts(uint8_t axis){
+	const uint8_t servos = (1 << MOTION_SERVO_0) | (1 << MOTION_SERVO_1);
+	const uint8_t motors = (1 << MOTION_MOTOR_1) | (1 << MOTION_MOTOR_2);
+	if(servos & (1 << axis)){
+		return motors;
+	}
+	if(motors & (1 << axis)){
+		return servos;
+	}
+	return 0;
+}
+
+static float clamp_target(uint8_t axis, float value){
+	float min = is_servo(axis) ? SERVO_MIN : MOTOR_MIN;
+	float max = is_servo(axis) ? SERVO_MAX : MOTOR_MAX;
+	if(value < min){
+		return min;
+	}
+	if(value > max){
+		return max;
+	}
+	return value;
+}
+
+/**
+ * @brief Send the values of the axes in mask to the servos and motors
+ */
+static void motion_output(uint8_t mask){
+	servo_out_t servos[SERVO_AXES];
+	float angles[SERVO_AXES];
+	uint8_t n = 0;
+	for(uint8_t i = 0; i < MOTION_AXES; i++){
+		if(!(mask & (1 << i))){
+			continue;
+		}
+		if(is_servo(i)){
+			servos[n] = (servo_out_t)i;
+			angles[n] = motion_axes[i].position;
+			n++;
+		} else{
+			L293SetDuty((i == MOTION_MOTOR_1) ? MOTOR_1 : MOTOR_2,
+				(int16_t)(motion_axes[i].position * PWM_DUTY_MAX / MOTOR_MAX));
+		}
+	}
+	if(n > 0){
+		/* Servos moving together change in the same PWM period */
+		ServoMoveAngles(servos, angles, n);
+	}
+}
+
+/**
+ * @brief Plan a group of moves and stretch them to the longest one
+ */
+static void motion_start(uint8_t group, const float *targets){
+	motion_state_t *axis;
+	float longest = 0;
+	for(uint8_t i = 0; i < MOTION_AXES; i++){
+		if(group & (1 << i)){
+			axis = &motion_axes[i];
+			if(is_servo(i)){
+				MotionProfilePlan(&axis->profile, axis->position, targets[i],
+					axis->limits.max_rate, axis->limits.max_accel, axis->limits.max_jerk);
+			} else{
+				/* Speed axis: its rate is the acceleration and has no jerk stage */
+				MotionProfilePlan(&axis->profile, axis->position, targets[i],
+					axis->limits.max_rate, axis->limits.max_accel, 0);
+			}
+			if(MotionProfileDuration(&axis->profile) > longest){
+				longest = MotionProfileDuration(&axis->profile);
+			}
+		}
+	}
+	for(uint8_t i = 0; i < MOTION_AXES; i++){
+		if(group & (1 << i)){
+			MotionProfileStretch(&motion_axes[i].profile, longest);
+			motion_axes[i].time = 0;
+		}
+	}
+}
+
+/**
+ * @brief Controller tick: starts waiting moves and advances the profiles
+ */
+static void motion_tick(void *arg){
+	float targets[MOTION_AXES];
+	uint8_t groups[MOTION_AXES];
+	uint8_t start = 0, moving = 0, group, busy;
+	/* Waiting moves whose axes are all stopped */
+	portENTER_CRITICAL(&motion_mux);
+	for(uint8_t i = 0; i < MOTION_AXES; i++){
+		if(!motion_axes[i].pending || (start & (1 << i))){
+			continue;
+		}
+		group = 0;
+		busy = 0;
+		for(uint8_t j = 0; j < MOTION_AXES; j++){
+			if((motion_axes[i].pending_group & (1 << j)) && motion_axes[j].pending
+				&& (motion_axes[j].pending_group == motion_axes[i].pending_group)){
+				group |= 1 << j;
+				busy |= motion_axes[j].moving;
+			}
+		}
+		if(!busy){
+			for(uint8_t j = 0; j < MOTION_AXES; j++){
+				if(group & (1 << j)){
+					targets[j] = motion_axes[j].pending_target;
+					groups[j] = group;
+					motion_axes[j].pending = false;
+					motion_axes[j].moving = true;
+				}
+			}
+			start |= group;
+		}
+	}
+	portEXIT_CRITICAL(&motion_mux);
+
+	/* Planning is done outside the critical section: only this tick uses the profiles.
+	 * MotionMoveSync() can queue the next move meanwhile, so the groups are the copies taken above */
+	for(uint8_t i = 0; i < MOTION_AXES; i++){
+		if(start & (1 << i)){
+			motion_start(groups[i], targets);
+			start &= ~groups[i];
+		}
+	}
+
+	for(uint8_t i = 0; i < MOTION_AXES; i++){
+		motion_state_t *axis = &motion_axes[i];
+		if(!axis->moving){
+			continue;
+		}
+		axis->time += TICK_S;
+		MotionProfileSample(&axis->profile, axis->time, &axis->position, NULL);
+		moving |= 1 << i;
+		if(axis->time >= MotionProfileDuration(&axis->profile)){
+			axis->moving = false;
+		}
+	}
+	if(moving){
+		motion_output(moving);
+	}
+}
+/*==================[external functions definition]==========================*/
+bool MotionInit(void){
+	const esp_timer_create_args_t timer_args = {
+		.callback = motion_tick,
+		.name = "motion",
+	};
+	if(motion_timer != NULL){
+		return true;
+	}
+	if(esp_timer_create(&timer_args, &motion_timer) != ESP_OK){
+		motion_timer = NULL;
+		return false;
+	}
+	esp_timer_start_periodic(motion_timer, MOTION_TICK_MS * 1000);
+	return true;
+}
+
+bool MotionAxisInit(motion_axis_t axis, const motion_limits_t *limits, float position){
+	if((axis >= MOTION_AXES) || (limits->max_rate <= 0) || (limits->max_accel <= 0) || (limits->max_jerk < 0)){
+		return false;
+	}
+	portENTER_CRITICAL(&motion_mux);
+	for(uint8_t i = 0; i < MOTION_AXES; i++){
+		if((motion_conflicts(axis) & (1 << i)) && motion_axes[i].enabled){
+			portEXIT_CRITICAL(&motion_mux);
+			return false;
+		}
+	}
+	motion_axes[axis].limits = *limits;
+	motion_axes[axis].position = clamp_target(axis, position);
+	motion_axes[axis].moving = false;
+	motion_axes[axis].pending = false;
+	motion_axes[axis].enabled = true;
+	portEXIT_CRITICAL(&motion_mux);
+	motion_output(1 << axis);
+	return true;
+}
+
+bool MotionMoveTo(motion_axis_t axis, float target){
+	return MotionMoveSync(&axis, &target, 1);
+}
+
+bool MotionMoveSync(const motion_axis_t *axes, const float *targets, uint8_t n){
+	uint8_t group = 0;
+	uint8_t i;
+	for(i = 0; i < n; i++){
+		if((axes[i] >= MOTION_AXES) || !motion_axes[axes[i]].enabled){
+			return false;
+		}
+		group |= 1 << axes[i];
+	}
+	/* The move starts in the next tick, when all its axes are stopped */
+	portENTER_CRITICAL(&motion_mux);
+	for(i = 0; i < n; i++){
+		motion_axes[axes[i]].pending_target = clamp_target(axes[i], targets[i]);
+		motion_axes[axes[i]].pending_group = group;
+		motion_axes[axes[i]].pending = true;
+	}
+	portEXIT_CRITICAL(&motion_mux);
+	return true;
+}
+
+bool MotionBusy(motion_axis_t axis){
+	bool busy;
+	if(axis >= MOTION_AXES){
+		return false;
+	}
+	portENTER_CRITICAL(&motion_mux);
+	busy = motion_axes[axis].moving || motion_axes[axis].pending;
+	portEXIT_CRITICAL(&motion_mux);
+	return busy;
+}
+
+float MotionPosition(motion_axis_t axis){
+	if(axis >= MOTION_AXES){
+		return 0;
+	}
+	return motion_axes[axis].position;
+}
+
+void MotionDeinit(void){
+	if(motion_timer != NULL){
+		esp_timer_stop(motion_timer);
+		esp_timer_delete(motion_timer);
+		motion_timer = NULL;
+	}
+}
+
+/*==================[end of file]============================================*/
@@ -9,7 +9,7 @@
 #define ANG_RANGE	180.0
 #define PERIOD_MS   20.0
 #define PULSEW_MS   1.0
-#define PERCENT   	100.0
+#define SERVO_QTY	4
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
@@ -19,14 +19,18 @@
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
-uint8_t Angle2DutyCicle(int8_t angle){
-	static float h_time;
-	static float duty_cicle;
-	static int16_t deg;
-	deg = 2 * angle + MAX_ANG;	// NOTE: adjusted (angle x 2) for the available servos
-	h_time = (float)(deg/ANG_RANGE) + PULSEW_MS;
-	duty_cicle = (float)(h_time/PERIOD_MS) * PERCENT;
-	return (uint8_t) duty_cicle;
+/**
+ * @brief Angle to PWM duty in timer counts (finer than a duty cycle in %)
+ */
+static uint16_t Angle2Duty(float angle){
+	float h_time;
+	if(angle < MIN_ANG){
+		angle = MIN_ANG;
+	} else if(angle > MAX_ANG){
+		angle = MAX_ANG;
+	}
+	h_time = (2 * angle + MAX_ANG) / ANG_RANGE + PULSEW_MS;	// NOTE: adjusted (angle x 2) for the available servos
+	return (uint16_t)((h_time / PERIOD_MS) * PWM_DUTY_MAX + 0.5f);
 }
 /*==================[external functions definition]==========================*/
 
@@ -49,27 +53,23 @@ uint8_t ServoInit(servo_out_t servo, gpio_t gpio){
 }
 
 void ServoMove(servo_out_t servo, int8_t ang){
-	static uint8_t dc;
-	if(ang < MIN_ANG){
-		ang = MIN_ANG;
-	} else if(ang > MAX_ANG){
-		ang = MAX_ANG;
+	float angle = ang;
+	ServoMoveAngles(&servo, &angle, 1);
+}
+
+void ServoMoveAngles(const servo_out_t *servos, const float *angles, uint8_t n){
+	/* SERVO_n uses PWM_n */
+	pwm_out_t outs[SERVO_QTY];
+	uint16_t duties[SERVO_QTY];
+	uint8_t i;
+	if(n > SERVO_QTY){
+		n = SERVO_QTY;
 	}
-	dc = Angle2DutyCicle(ang);
-	switch(servo){
-		case SERVO_0:
-			PWMSetDutyCycle(PWM_0, dc);
-			break;
-		case SERVO_1:
-			PWMSetDutyCycle(PWM_1, dc);
-			break;
-		case SERVO_2:
-			PWMSetDutyCycle(PWM_2, dc);
-			break;
-		case SERVO_3:
-			PWMSetDutyCycle(PWM_3, dc);
-			break;
+	for(i = 0; i < n; i++){
+		outs[i] = (pwm_out_t)servos[i];
+		duties[i] = Angle2Duty(angles[i]);
 	}
+	PWMSetDuties(outs, duties, n);
 }
 
 /*==================[end of file]============================================*/
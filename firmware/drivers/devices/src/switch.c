@@ -12,26 +12,66 @@
 /*==================[inclusions]=============================================*/
 #include "switch.h"
 #include "gpio_mcu.h"
+#include "debounce.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
 /*==================[macros and definitions]=================================*/
 #define GPIO_SWITCH1 GPIO_4
 #define GPIO_SWITCH2 GPIO_15
+#define SWITCH_QTY	 2
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
+static const gpio_t switch_gpio[SWITCH_QTY] = {GPIO_SWITCH1, GPIO_SWITCH2};
+static const switch_t switch_id[SWITCH_QTY] = {SWITCH_1, SWITCH_2};
+static const debounce_config_t debounce_config = {
+	.integrator_max = SWITCH_DEBOUNCE_MS / SWITCH_TICK_MS,
+	.long_ticks = SWITCH_LONG_PRESS_MS / SWITCH_TICK_MS,
+	.double_ticks = SWITCH_DOUBLE_CLICK_MS / SWITCH_TICK_MS,
+};
+static debounce_t switch_state[SWITCH_QTY];
+static bool switches_ready = false;
+static QueueHandle_t switch_queue = NULL;
+static esp_timer_handle_t switch_timer = NULL;
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Switch service tick: runs the debouncers and queues the events
+ */
+static void switch_tick(void *arg){
+	static const switch_event_type_t types[] = {SWITCH_PRESSED, SWITCH_DOUBLE_CLICK, SWITCH_LONG_PRESS, SWITCH_RELEASED};
+	static const uint8_t flags[] = {DEBOUNCE_EVT_PRESS, DEBOUNCE_EVT_DOUBLE, DEBOUNCE_EVT_LONG, DEBOUNCE_EVT_RELEASE};
+	switch_event_t event;
+	uint8_t events;
+	for(uint8_t i = 0; i < SWITCH_QTY; i++){
+		events = DebounceUpdate(&switch_state[i], &debounce_config, !GPIORead(switch_gpio[i]));
+		for(uint8_t j = 0; (j < sizeof(flags)) && events; j++){
+			if(events & flags[j]){
+				event.sw = switch_id[i];
+				event.type = types[j];
+				/* If nobody reads the events the newest ones are dropped */
+				xQueueSend(switch_queue, &event, 0);
+			}
+		}
+	}
+}
 
 /*==================[external functions definition]==========================*/
 int8_t SwitchesInit(void){
 	/* GPIO configurations */
 	GPIOInit(GPIO_SWITCH1, GPIO_INPUT);	// SWITCH_1
 	GPIOInit(GPIO_SWITCH2, GPIO_INPUT);	// SWITCH_2
-	GPIOInputFilter(GPIO_SWITCH1);		
-	GPIOInputFilter(GPIO_SWITCH2);
+	if(!switches_ready){
+		/* Glitch filters are a limited resource: configure them once */
+		GPIOInputFilter(GPIO_SWITCH1);		
+		GPIOInputFilter(GPIO_SWITCH2);
+		switches_ready = true;
+	}
 	return true;
 }
 
@@ -54,4 +94,63 @@ void SwitchActivInt(switch_t sw, void *ptr_int_func, void *args){
 		break;
 	}
 }
+
+bool SwitchServiceInit(void){
+	const esp_timer_create_args_t timer_args = {
+		.callback = switch_tick,
+		.name = "switches",
+	};
+	if(switch_timer != NULL){
+		return true;
+	}
+	SwitchesInit();
+	for(uint8_t i = 0; i < SWITCH_QTY; i++){
+		DebounceInit(&switch_state[i]);
+	}
+	if(switch_queue == NULL){
+		switch_queue = xQueueCreate(SWITCH_QUEUE_LEN, sizeof(switch_event_t));
+		if(switch_queue == NULL){
+			return false;
+		}
+	}
+	xQueueReset(switch_queue);
+	if(esp_timer_create(&timer_args, &switch_timer) != ESP_OK){
+		switch_timer = NULL;
+		return false;
+	}
+	esp_timer_start_periodic(switch_timer, SWITCH_TICK_MS * 1000);
+	return true;
+}
+
+bool SwitchReadEvent(switch_event_t *event, uint32_t timeout_ms){
+	TickType_t ticks = (timeout_ms == SWITCH_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+	if(switch_queue == NULL){
+		return false;
+	}
+	return xQueueReceive(switch_queue, event, ticks) == pdTRUE;
+}
+
+int8_t SwitchesState(void){
+	int8_t mask = 0;
+	for(uint8_t i = 0; i < SWITCH_QTY; i++){
+		if(switch_state[i].pressed){
+			mask |= switch_id[i];
+		}
+	}
+	return mask;
+}
+
+void SwitchServiceDeinit(void){
+	if(switch_timer != NULL){
+		esp_timer_stop(switch_timer);
+		esp_timer_delete(switch_timer);
+		switch_timer = NULL;
+	}
+	if(switch_queue != NULL){
+		xQueueReset(switch_queue);
+	}
+	for(uint8_t i = 0; i < SWITCH_QTY; i++){
+		DebounceInit(&switch_state[i]);
+	}
+}
 /*==================[end of file]============================================*/
@@ -13,6 +13,11 @@
  * so it can be used to communicate with common Android apps, like "Bluetooth Electronics"
  * (https://play.google.com/store/apps/details?id=com.keuwl.arduinobluetooth)
  * 
+ * @note Reports are not sent when the functions are called: they are queued
+ * (see hid_scheduler.h) and a driver task sends them once per connection
+ * interval. Keyboard reports keep their order, consecutive mouse movements
+ * are merged into one report, and the functions never block.
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -20,6 +25,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 22/03/2024 | Document creation		                         						|
+ * | 18/10/2026 | Report scheduler, BleHidType()										|
  * 
  **/
 
@@ -192,13 +198,15 @@ void BleHidInit(char * hid_dev_name);
 ble_status_t BleHidStatus(void);
 
 /**
- * @brief Send a group of keys to be pressed together
+ * @brief Send a group of keys to be pressed together (press and release)
  * 
  * @param special_key_mask      Modifier keys mask
  * @param keyboard_cmd          Array with keys (max: 6)
  * @param num_key               Number of keys (in keyboard_cmd array) to be pressed together (max: 6)
+ * @return true Keys queued
+ * @return false Not connected, queue full or too many keys
  */
-void BleHidSendKeyboard(key_mask_t special_key_mask, keyboard_cmd_t *keyboard_cmd, uint8_t num_key);
+bool BleHidSendKeyboard(key_mask_t special_key_mask, keyboard_cmd_t *keyboard_cmd, uint8_t num_key);
 
 /**
  * @brief Send mouse position and click event
@@ -206,8 +214,27 @@ void BleHidSendKeyboard(key_mask_t special_key_mask, keyboard_cmd_t *keyboard_cm
  * @param mouse_button      Button to be clicked
  * @param delta_x           X cursor relative position
  * @param delta_y           Y cursor relative position
+ * @return true Movement queued (or merged with a queued one)
+ * @return false Not connected or queue full
+ */
+bool BleHidSendMouse(mouse_cmd_t mouse_button, int8_t delta_x, int8_t delta_y);
+
+/**
+ * @brief Type a text (US keyboard layout)
+ * 
+ * @note Printable ASCII characters, '\n', '\t' and '\b' are supported.
+ * 
+ * @param text '\0' terminated text
+ * @return uint32_t Number of characters queued (less than the text length if the queue got full)
+ */
+uint32_t BleHidType(const char *text);
+
+/**
+ * @brief Gets the number of reports waiting to be sent
+ * 
+ * @return uint16_t Queued reports
  */
-void BleHidSendMouse(mouse_cmd_t mouse_button, int8_t delta_x, int8_t delta_y);
+uint16_t BleHidPending(void);
 
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -13,6 +13,16 @@
  * so it can be used to communicate with common Android apps, like "Bluetooth Electronics"
  * (https://play.google.com/store/apps/details?id=com.keuwl.arduinobluetooth)
  * 
+ * @note On connection the driver requests a 247 bytes MTU, a 7.5-15 ms connection
+ * interval and 251 bytes link layer packets; the central decides what is used.
+ * Data is sent as notifications of the negotiated MTU size (MTU - 3 bytes), and
+ * sending waits while the stack reports congestion instead of dropping data.
+ * 
+ * @note Send functions never block waiting for the link: data is copied once
+ * into a 2 KB outgoing buffer that a driver task drains, and the number of bytes
+ * accepted is returned (less than requested if the buffer is full). They can be
+ * called from several tasks, but not from an ISR.
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -20,6 +30,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 22/03/2024 | Document creation		                         						|
+ * | 18/10/2026 | MTU negotiation, congestion control and throughput benchmark			|
+ * | 18/10/2026 | Non-blocking send through an outgoing ring buffer						|
  * 
  **/
 
@@ -72,27 +84,72 @@ void BleInit(ble_config_t * ble_device);
  */
 ble_status_t BleStatus(void);
 
+/**
+ * @brief Send data trough BLE (if connected) without waiting for the link
+ * 
+ * @param data Pointer to data to be transmitted
+ * @param nbytes Number of bytes to be sent
+ * @return uint32_t Number of bytes accepted (0 if not connected)
+ */
+uint32_t BleSend(const void *data, uint32_t nbytes);
+
+/**
+ * @brief Gets the free space in the outgoing buffer
+ * 
+ * @return uint32_t Number of bytes that BleSend() can accept right now
+ */
+uint32_t BleSendFree(void);
+
 /**
  * @brief Send a single byte trough BLE (if connected)
  * 
  * @param data Pointer to variable with data to be transmitted
+ * @return uint32_t Number of bytes accepted
  */
-void BleSendByte(const char *data);
+uint32_t BleSendByte(const char *data);
 
 /**
  * @brief Send a string trough BLE (if connected)
  * 
  * @param msg Pointer to string to be transmitted
+ * @return uint32_t Number of bytes accepted
  */
-void BleSendString(const char *msg);
+uint32_t BleSendString(const char *msg);
 
 /**
- * @brief Send multiple bytes through serial port
+ * @brief Send multiple bytes trough BLE (if connected)
  * 
  * @param data Pointer to array of data to be transmitted
  * @param nbytes Number of bytes to be sended
+ * @return uint32_t Number of bytes accepted
+ */
+uint32_t BleSendBuffer(const char *data, uint32_t nbytes);
+
+/**
+ * @brief Gets the negotiated GATT MTU
+ * 
+ * @return uint16_t MTU (23 until the central requests a larger one). Notifications carry MTU - 3 bytes.
+ */
+uint16_t BleMtu(void);
+
+/**
+ * @brief Start or stop the throughput benchmark
+ * 
+ * While enabled and connected, the driver streams notifications as fast as the
+ * link allows. The payload is an incrementing 8 bit counter that continues
+ * across notifications, so the receiver can detect lost bytes. The measured
+ * rate is logged every second and can be read with BleBenchmarkRate().
+ * 
+ * @param enable true to start streaming, false to stop
+ */
+void BleBenchmark(bool enable);
+
+/**
+ * @brief Gets the last throughput measured by the benchmark
+ * 
+ * @return uint32_t Bytes per second (0 until the first measurement)
  */
-void BleSendBuffer(const char *data, uint8_t nbytes);
+uint32_t BleBenchmarkRate(void);
 
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -8,7 +8,20 @@
  ** @{ */
 
 /** \brief GPIO driver to use gpio ouputs with faster functions than gpio_mcu.
- * 
+ *
+ * GPIOs are grouped in bundles (up to 8 pins each) connected to the CPU
+ * dedicated GPIO channels. A bundle is read or written as a single value
+ * (bit i: pin i of the list given to GPIOFastBundleInit()) with one CPU
+ * instruction: GPIOFastWriteMask(), GPIOFastWriteBundle() and
+ * GPIOFastReadBundle() are inline functions, safe to call from IRAM code.
+ *
+ * @note The ESP32-C6 has 8 output and 8 input dedicated channels, shared by
+ * all bundles: an output bundle of 3 pins and a bidirectional bundle of 2 pins
+ * use 5 output and 2 input channels.
+ *
+ * @note GPIOFastInit() and GPIOFastWrite() handle GPIO_FAST_A as an output
+ * bundle (original interface).
+ *
  * @author Albano Peñalva
  *
  * @section changelog
@@ -16,39 +29,147 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/11/2023 | Document creation		                         						|
- * 
+ * | 18/10/2026 | Several bundles, inputs, masked accesses and inline fast path			|
+ *
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdbool.h>
 #include <stdint.h>
 #include "gpio_mcu.h"
+#include "fast_io_map.h"
+#include "hal/dedic_gpio_cpu_ll.h"
 /*==================[macros]=================================================*/
-
+#define GPIO_FAST_PINS_MAX	FAST_IO_MAP_MAX		/*!< Maximum number of pins in a bundle */
 /*==================[typedef]================================================*/
+/**
+ * @brief Bundles
+ */
+typedef enum {
+	GPIO_FAST_A = 0,
+	GPIO_FAST_B,
+	GPIO_FAST_C,
+	GPIO_FAST_D,
+	GPIO_FAST_BUNDLES,		/*!< Number of bundles */
+} gpio_fast_t;
 
-/*==================[external data declaration]==============================*/
+/**
+ * @brief Bundle direction
+ */
+typedef enum {
+	GPIO_FAST_OUTPUT = 0,		/*!< Output */
+	GPIO_FAST_INPUT,			/*!< Input with pull-up resistor */
+	GPIO_FAST_BIDIRECTIONAL,	/*!< Open-drain output with pull-up resistor, the pin level can be read */
+} gpio_fast_dir_t;
 
+/**
+ * @brief Bundle state (used by the inline functions)
+ */
+typedef struct {
+	void *handle;				/*!< Dedicated GPIO bundle handle, NULL if not initialized */
+	fast_io_map_t map;			/*!< Pin map */
+	uint8_t out_offset;			/*!< First output channel */
+	uint8_t in_offset;			/*!< First input channel */
+	uint8_t out_mask;			/*!< Writable bundle bits (0 for input bundles) */
+	uint8_t in_mask;			/*!< Readable bundle bits (0 for output bundles) */
+} gpio_fast_bundle_t;
+/*==================[external data declaration]==============================*/
+extern gpio_fast_bundle_t gpio_fast_bundles[GPIO_FAST_BUNDLES];
 /*==================[external functions declaration]=========================*/
 
 /**
- * @brief 
- * 
- * @param pin_list 
- * @param pin_qty 
+ * @brief Bundle initialization
+ *
+ * @param bundle Bundle
+ * @param pin_list Array of GPIOs (bundle bit 0 first)
+ * @param pin_qty Number of GPIOs (up to GPIO_FAST_PINS_MAX)
+ * @param dir Bundle direction
+ * @return true Bundle initialized
+ * @return false Invalid pins, bundle in use or not enough dedicated channels
  */
-void GPIOFastInit(gpio_t *pin_list, uint8_t pin_qty);
+bool GPIOFastBundleInit(gpio_fast_t bundle, const gpio_t *pin_list, uint8_t pin_qty, gpio_fast_dir_t dir);
 
 /**
- * @brief 
- * 
- * @param value 
+ * @brief Bundle de-initialization (its channels can be used by other bundles)
+ *
+ * @param bundle Bundle
+ */
+void GPIOFastBundleDeinit(gpio_fast_t bundle);
+
+/**
+ * @brief Write the GPIOs of a bundle selected with a port mask
+ *
+ * @note Slower than GPIOFastWriteMask() (the port bits are converted to bundle bits).
+ *
+ * @param bundle Bundle (out of range bundles are ignored)
+ * @param mask GPIOs to be written (bit n: GPIO_n, see GPIO_BIT())
+ * @param values New states (bit n: GPIO_n)
+ */
+void GPIOFastWritePort(gpio_fast_t bundle, uint32_t mask, uint32_t values);
+
+/**
+ * @brief Read the GPIOs of a bundle as port bits
+ *
+ * @param bundle Bundle
+ * @return uint32_t GPIO levels (bit n: GPIO_n), 0 if bundle is out of range
+ */
+uint32_t GPIOFastReadPort(gpio_fast_t bundle);
+
+/**
+ * @brief Output bundle GPIO_FAST_A initialization
+ *
+ * @param pin_list Array of GPIOs (bit 0 first)
+ * @param pin_qty Number of GPIOs (up to GPIO_FAST_PINS_MAX)
+ * @return true Bundle initialized
+ * @return false Invalid pins or not enough free dedicated channels (logged, GPIOFastWrite() does nothing)
+ */
+bool GPIOFastInit(gpio_t *pin_list, uint8_t pin_qty);
+
+/**
+ * @brief Write some GPIOs of a bundle at the same time
+ *
+ * @param bundle Bundle
+ * @param mask Bundle bits to be written
+ * @param value New states (bit i: pin i)
+ */
+static inline void GPIOFastWriteMask(gpio_fast_t bundle, uint8_t mask, uint8_t value){
+	const gpio_fast_bundle_t *b = &gpio_fast_bundles[bundle];
+	dedic_gpio_cpu_ll_write_mask((uint32_t)(mask & b->out_mask) << b->out_offset, (uint32_t)value << b->out_offset);
+}
+
+/**
+ * @brief Write every GPIO of a bundle at the same time
+ *
+ * @param bundle Bundle
+ * @param value New states (bit i: pin i)
+ */
+static inline void GPIOFastWriteBundle(gpio_fast_t bundle, uint8_t value){
+	GPIOFastWriteMask(bundle, 0xFF, value);
+}
+
+/**
+ * @brief Read every GPIO of a bundle at the same time
+ *
+ * @param bundle Bundle
+ * @return uint8_t GPIO levels (bit i: pin i)
+ */
+static inline uint8_t GPIOFastReadBundle(gpio_fast_t bundle){
+	const gpio_fast_bundle_t *b = &gpio_fast_bundles[bundle];
+	return (uint8_t)(dedic_gpio_cpu_ll_read_in() >> b->in_offset) & b->in_mask;
+}
+
+/**
+ * @brief Write every GPIO of bundle GPIO_FAST_A
+ *
+ * @param value New states (bit i: pin i)
  */
-void GPIOFastWrite(uint16_t value);
+static inline void GPIOFastWrite(uint16_t value){
+	GPIOFastWriteBundle(GPIO_FAST_A, (uint8_t)value);
+}
 
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
-#endif 
+#endif
 
 /*==================[end of file]============================================*/
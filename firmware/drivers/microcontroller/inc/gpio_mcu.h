@@ -19,6 +19,11 @@
  * @note GPIO_12 and GPIO_13 are not recommended for use, because using them will
  * overwrite the flash and debug functionalities via USB.
  * 
+ * @note GPIOWriteMask() and GPIOReadPort() access every pin of the port in a
+ * single register operation: the pins written together change at the same
+ * time, without the intermediate states of a sequence of GPIOState() calls.
+ * Pins are selected with a bit mask (bit n: GPIO_n, see GPIO_BIT()).
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -26,6 +31,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 18/10/2026 | Port-wide access: GPIOWriteMask() and GPIOReadPort()					|
  * 
  **/
 
@@ -33,6 +39,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 /*==================[macros]=================================================*/
+#define GPIO_BIT(pin)		(1UL << (pin))	/*!< Port mask bit of a GPIO */
+#define GPIO_PORT_MASK		0x00FFBFFFUL	/*!< Pins of the port (GPIO_0 to GPIO_23, except GPIO_14) */
 
 /*==================[typedef]================================================*/
 /**
@@ -124,6 +132,23 @@ void GPIOToggle(gpio_t pin);
  */
 bool GPIORead(gpio_t pin);
 
+/**
+ * @brief Change the state of several GPIOs at the same time
+ * 
+ * @note Only GPIOs initialized as outputs are affected.
+ * 
+ * @param mask GPIOs to be written (bit n: GPIO_n)
+ * @param values New states of the GPIOs in mask (bit n: GPIO_n, 1: high - 0: low)
+ */
+void GPIOWriteMask(uint32_t mask, uint32_t values);
+
+/**
+ * @brief Reads the state of every GPIO at the same time
+ * 
+ * @return uint32_t GPIO input levels (bit n: GPIO_n)
+ */
+uint32_t GPIOReadPort(void);
+
 /**
  * @brief Configure GPIO input interruption
  * 
@@ -14,6 +14,15 @@
  * @note It can setup up to 4 PWM outputs, with independet duty 
  * cycle and frequency configuration
  *
+ * @note Outputs with the same frequency share a hardware timer, so timers
+ * are only used up by outputs with different frequencies (up to 4).
+ * PWMOn() and PWMOff() act on a single output, not on its timer.
+ *
+ * @note Besides PWMSetDutyCycle() (in %), PWMSetDuty(), PWMSetDuties() and
+ * PWMFade() take the duty in timer counts (0 to PWM_DUTY_MAX), for a finer
+ * resolution. PWMSetDuties() changes several outputs in the same PWM period
+ * (outputs sharing a timer) and PWMFade() ramps the duty in hardware.
+ *
  * @author Albano Peñalva
  * 
  * @section changelog
@@ -21,13 +30,17 @@
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 23/01/2024 | Document creation		                         |
+ * | 18/10/2026 | Timer sharing, hardware fade, batched duty     |
  *
  */
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 #include <gpio_mcu.h>
 /*==================[macros]=================================================*/
+#define PWM_DUTY_MAX	1023		/*!< Duty in timer counts for 100% (10 bit resolution) */
+#define PWM_DUTY_FROM_PERCENT(p)	((uint16_t)(((uint32_t)(p) * PWM_DUTY_MAX) / 100))	/*!< Duty in counts from % */
 
 /*==================[typedef]================================================*/
 typedef enum pwm_out {
@@ -48,7 +61,7 @@ typedef enum pwm_out {
  * @param out PWM output
  * @param gpio GPIO pin number
  * @param freq PWM wave frequency
- * @return uint8_t 
+ * @return uint8_t 0: OK, 1: every timer in use with other frequencies
  */
 uint8_t PWMInit(pwm_out_t out, gpio_t gpio, uint16_t freq);
 
@@ -74,12 +87,48 @@ void PWMOff(pwm_out_t out);
  */
 void PWMSetDutyCycle(pwm_out_t out, uint8_t duty_cycle);
 
+/**
+ * @brief Change PWM duty of an PWM output (in timer counts)
+ * 
+ * @param out PWM output 
+ * @param duty duty in timer counts (0 to PWM_DUTY_MAX)
+ */
+void PWMSetDuty(pwm_out_t out, uint16_t duty);
+
+/**
+ * @brief Change the duty of several PWM outputs at the same time
+ * 
+ * @note Outputs sharing a timer (same frequency) change in the same PWM period.
+ * 
+ * @param outs Array of PWM outputs
+ * @param duties Array of duties in timer counts (0 to PWM_DUTY_MAX), one per output
+ * @param n Number of outputs
+ * @return uint8_t 0: OK, 1: invalid output (no output is changed)
+ */
+uint8_t PWMSetDuties(const pwm_out_t *outs, const uint16_t *duties, uint8_t n);
+
+/**
+ * @brief Ramp the duty of an PWM output in hardware, without CPU intervention
+ * 
+ * @note The function returns immediately. Other duty changes on the output stop the fade.
+ * 
+ * @param out PWM output 
+ * @param duty Final duty in timer counts (0 to PWM_DUTY_MAX)
+ * @param time_ms Fade duration (in ms)
+ * @return true Fade started
+ * @return false Fade could not be configured
+ */
+bool PWMFade(pwm_out_t out, uint16_t duty, uint32_t time_ms);
+
 /**
  * @brief Change frequency of an PWM output
  * 
+ * @note If the timer is shared with other outputs, the output is moved to
+ * another timer (and the others keep their frequency).
+ * 
  * @param out PWM output 
  * @param freq Frequency of PWM output (40kHz máx)
- * @return uint8_t 
+ * @return uint8_t 0: OK, 1: output not initialized or no timer available for the new frequency
  */
 uint8_t PWMSetFreq(pwm_out_t out, uint32_t freq);
 
@@ -87,7 +136,7 @@ uint8_t PWMSetFreq(pwm_out_t out, uint32_t freq);
  * @brief PWM output de-inicialization
  * 
  * @param out PWM output 
- * @return uint8_t 
+ * @return uint8_t 0: OK, 1: output not initialized
  */
 uint8_t PWMDeinit(pwm_out_t out);
 
@@ -14,6 +14,22 @@
  * 
  * @note MISO: GPIO_22, MOSI: GPIO_21, SCLK: GPIO_20, CS1: GPIO_19, CS2: GPIO_18, CS3: GPIO_9
  * 
+ * Besides the blocking SpiRead(), SpiWrite() and SpiReadWrite() functions, each
+ * device has a pool of SPI_QUEUE_SIZE preallocated transactions: SpiQueue()
+ * hands a transaction to the DMA and returns immediately, and SpiGetResult()
+ * collects finished transactions in the same order they were queued. Several
+ * transactions can be in flight at the same time, so the bus never waits for
+ * the CPU between them.
+ * 
+ * Devices can be configured with a command and/or address phase (register
+ * based sensors and memories), or with a D/C line (displays such as the
+ * ILI9341): the D/C pin is driven by the driver right before each transaction
+ * starts, so a command byte and its parameters are queued together instead of
+ * toggling the pin between blocking writes.
+ * 
+ * @note Do not call the blocking functions on a device that has queued
+ * transactions still in flight: collect them with SpiGetResult() first.
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -21,12 +37,18 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 09/02/2024 | Document creation		                         						|
+ * | 18/10/2026 | Transaction queue, command/address phases and D/C line				|
  * 
  **/
 /*==================[inclusions]=============================================*/
 #include <stdbool.h>
 #include <stdint.h>
 /*==================[macros]=================================================*/
+#define SPI_QUEUE_SIZE		8			/*!< Transactions that can be in flight per device */
+#define SPI_WAIT_FOREVER	UINT32_MAX	/*!< Timeout value to wait indefinitely */
+
+#define SPI_TRANS_CMD		0x01		/*!< Transaction flag: send the command (phase or D/C byte) */
+#define SPI_TRANS_ADDR		0x02		/*!< Transaction flag: send the address phase */
 
 /*==================[typedef]================================================*/
 
@@ -68,7 +90,26 @@ typedef struct{
 	transfer_mode_t transfer_mode;	/*!< Transfer mode */
 	void *func_p;					/*!< Pointer to callback function for transaction end */
 	void *param_p;					/*!< Pointer to callback parameter */
+	uint8_t command_bits;			/*!< Length of the command phase (0 to 16 bits, 0: no command phase) */
+	uint8_t address_bits;			/*!< Length of the address phase (0 to 64 bits, 0: no address phase) */
+	bool dc_enable;					/*!< Drive a D/C line: low while sending commands, high for data */
+	uint8_t dc_gpio;				/*!< GPIO used as D/C line (if dc_enable is set) */
 } spi_mcu_config_t;
+
+/**
+ * @brief Queued transaction descriptor
+ * 
+ * @note Buffers must remain valid until the transaction is returned by SpiGetResult().
+ */
+typedef struct{
+	uint8_t flags;					/*!< SPI_TRANS_CMD and/or SPI_TRANS_ADDR */
+	uint16_t cmd;					/*!< Command: sent in the command phase, or as a byte with D/C low on D/C devices */
+	uint64_t addr;					/*!< Address sent in the address phase */
+	const uint8_t *tx_buffer;		/*!< Data to write (NULL to send zeros) */
+	uint8_t *rx_buffer;				/*!< Buffer for read data (NULL to discard it) */
+	uint32_t length;				/*!< Data length in bytes (0 for command/address only transactions) */
+	void *user;						/*!< User pointer, returned by SpiGetResult() */
+} spi_mcu_trans_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -108,6 +149,48 @@ void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size);
  */
 void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, uint32_t buffer_size);
 
+/**
+ * @brief Queue a transaction without waiting for it
+ * 
+ * On devices configured with a D/C line and SPI_TRANS_CMD set, the command byte
+ * (with D/C low) and the data (with D/C high) are queued as two consecutive
+ * transactions that take two slots of the pool, but are reported as a single
+ * transaction by SpiGetResult().
+ * 
+ * @param device SPI device
+ * @param trans Transaction descriptor (copied, can be a local variable)
+ * @param timeout_ms Time to wait for room in the queue (0 to return immediately, SPI_WAIT_FOREVER)
+ * @return true Transaction queued
+ * @return false No free transaction in the pool, or driver error
+ */
+bool SpiQueue(spi_dev_t device, const spi_mcu_trans_t *trans, uint32_t timeout_ms);
+
+/**
+ * @brief Wait for the oldest queued transaction to finish
+ * 
+ * @param device SPI device
+ * @param user Pointer to store the user pointer of the finished transaction (can be NULL)
+ * @param timeout_ms Time to wait (0 to return immediately, SPI_WAIT_FOREVER)
+ * @return true A transaction was finished and its slot was released
+ * @return false Timeout, or no transaction in flight
+ */
+bool SpiGetResult(spi_dev_t device, void **user, uint32_t timeout_ms);
+
+/**
+ * @brief Number of queued transactions not yet collected with SpiGetResult()
+ * 
+ * @param device SPI device
+ * @return uint8_t Transactions in flight (D/C commands count as one)
+ */
+uint8_t SpiPending(spi_dev_t device);
+
+/**
+ * @brief Wait until every queued transaction of a device is finished
+ * 
+ * @param device SPI device
+ */
+void SpiFlush(spi_dev_t device);
+
 /**
  * @brief De-Initialize SPI module with the corresponding configuration
  * 
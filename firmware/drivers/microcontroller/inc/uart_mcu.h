@@ -17,11 +17,15 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 02/07/2024 | Document creation		                         						|
+ * | 18/10/2026 | Add ring buffered stream mode and scatter-gather send					|
+ * | 18/10/2026 | Add line/packet assembler and error counters							|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "ring_buffer.h"
+#include "packet_assembler.h"
 /*==================[macros]=================================================*/
 #define UART_NO_INT	0		/*!< Flag used when no reading interruption is required */
 /*==================[typedef]================================================*/
@@ -40,17 +44,45 @@ typedef struct {
 	uint32_t baud_rate;		/*!< baudrate (bits per second) */
 	void *func_p;			/*!< Pointer to callback function to call when receiving data (= UART_NO_INT if not requiered)*/
 	void *param_p;			/*!< Pointer to callback function parameters */
+	packet_assembler_t *assembler_p;	/*!< Pointer to an initialized assembler to receive complete lines/packets (NULL if not requiered) */
 } serial_config_t;
+/**
+ * @brief Reception error counters
+ */
+typedef struct {
+	uint32_t fifo_overflows;	/*!< Hardware FIFO overflows (UART_FIFO_OVF events) */
+	uint32_t buffer_full;		/*!< Driver RX buffer full (UART_BUFFER_FULL events) */
+	uint32_t frame_errors;		/*!< Frame errors */
+	uint32_t parity_errors;		/*!< Parity errors */
+} uart_stats_t;
+/**
+ * @brief Memory segment used by UartSendVector()
+ */
+typedef ring_buffer_iovec_t uart_iovec_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
 /**
  * @brief Serial port initialization
  * 
+ * @note If assembler_p is set, received data is read in blocks by the driver
+ * event task and passed to AssemblerFeed(), so the assembler callback is called
+ * once per complete line or packet (func_p is not called for received data).
+ * 
  * @param port_config 
  */
 void UartInit(serial_config_t *port_config);
 
+/**
+ * @brief Get reception error counters
+ * 
+ * @note Counters are only updated when the port was initialized with func_p or assembler_p.
+ * 
+ * @param port Port to query
+ * @param stats Pointer to struct where counters will be stored
+ */
+void UartGetStats(uart_mcu_port_t port, uart_stats_t *stats);
+
 /**
  * @brief Read a single byte from serial port
  * 
@@ -68,11 +100,15 @@ uint8_t UartReadByte(uart_mcu_port_t port, uint8_t *data);
  * @param nbytes Number of bytes to be readed
  * @return uint8_t 
  */
-uint8_t UartReadBuffer(uart_mcu_port_t port, uint8_t *data, uint16_t nbytes);
+uint8_t UartReadBuffer(uart_mcu_port_t port, uint8_t *data, uint32_t nbytes);
 
 /**
  * @brief Send a single byte trough serial port
  * 
+ * @note With TX stream enabled (see UartStreamInit()) the byte is queued in the TX
+ * ring buffer after any pending record, blocking while the ring is full. The same
+ * applies to UartSendString() and UartSendBuffer().
+ * 
  * @param port Port for sending data
  * @param data Pointer to variable with data to be transmitted
  */
@@ -95,11 +131,85 @@ void UartSendString(uart_mcu_port_t port, const char *msg);
  * @param data Pointer to array of data to be transmitted
  * @param nbytes Number of bytes to be sended
  */
-void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes);
+void UartSendBuffer(uart_mcu_port_t port, const char *data, uint32_t nbytes);
+
+/**
+ * @brief Send several memory segments as one record, without concatenating them
+ * 
+ * @note If stream mode is enabled for the port the record is queued in the TX ring
+ * buffer (all segments or none) and the function returns immediately. Otherwise
+ * segments are copied to the driver buffer, blocking until there is room.
+ * 
+ * @param port Port for sending data
+ * @param iov Array of segments
+ * @param count Number of segments
+ * @return uint32_t Number of bytes accepted
+ */
+uint32_t UartSendVector(uart_mcu_port_t port, const uart_iovec_t *iov, uint8_t count);
+
+/**
+ * @brief Enable high-throughput stream mode on a serial port
+ * 
+ * TX data is queued in a lock-free ring buffer and a background task hands the
+ * largest contiguous blocks to the UART driver. RX data is moved by a background
+ * task straight from the driver into the RX ring buffer.
+ * 
+ * @note Must be called after UartInit(). Buffer sizes must be a power of two and
+ * can be larger than 64 KB. Pass NULL/0 to leave a direction unbuffered. Each ring
+ * supports a single producer (TX) and a single consumer (RX) task.
+ * 
+ * @note When RX stream is enabled incoming data must be read with UartStreamRead().
+ * RX stream can not be enabled on a port initialized with func_p or assembler_p:
+ * its event task already reads the received data.
+ * 
+ * @note With TX stream enabled UartSendByte(), UartSendString() and UartSendBuffer()
+ * also go through the TX ring buffer, from the same single producer task.
+ * 
+ * @param port Port to configure
+ * @param tx_buf Storage for TX ring buffer (NULL if not requiered)
+ * @param tx_size TX ring buffer size
+ * @param rx_buf Storage for RX ring buffer (NULL if not requiered)
+ * @param rx_size RX ring buffer size
+ * @return uint8_t true if stream mode was enabled, false if a size is not a power
+ * of two or rx_buf was given for a port with func_p or assembler_p
+ */
+uint8_t UartStreamInit(uart_mcu_port_t port, uint8_t *tx_buf, uint32_t tx_size, uint8_t *rx_buf, uint32_t rx_size);
+
+/**
+ * @brief Queue data for transmission without blocking
+ * 
+ * @param port Port for sending data
+ * @param data Pointer to data to be transmitted
+ * @param nbytes Number of bytes to be sended
+ * @return uint32_t Number of bytes accepted (less than nbytes if TX ring buffer is full)
+ */
+uint32_t UartStreamSend(uart_mcu_port_t port, const void *data, uint32_t nbytes);
+
+/**
+ * @brief Read received data from the RX ring buffer without blocking
+ * 
+ * @param port Port to read from
+ * @param data Pointer to array where data will be stored
+ * @param nbytes Maximum number of bytes to be readed
+ * @return uint32_t Number of bytes readed
+ */
+uint32_t UartStreamRead(uart_mcu_port_t port, uint8_t *data, uint32_t nbytes);
+
+/**
+ * @brief Number of received bytes waiting in the RX ring buffer
+ * 
+ * @param port Port to query
+ * @return uint32_t Number of bytes available
+ */
+uint32_t UartStreamAvailable(uart_mcu_port_t port);
 
 /**
  * @brief Convert a number to a String (char array ended with '\0')
  * 
+ * @note The returned pointer refers to a static buffer shared by all callers, so
+ * this function is not re-entrant. Use FormatU32(), FormatHex() or FormatPrint()
+ * (format.h) to convert into a caller supplied buffer.
+ * 
  * @param val Number to be converted
  * @param base Base of the converted number (2: binary, 10: decimal, 16: hexadecimal)
  * @return uint8_t* 
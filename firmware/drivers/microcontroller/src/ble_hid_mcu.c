@@ -27,8 +27,13 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "hid_scheduler.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "ble_hid"
+#define HID_QUEUE_LEN						32	/* Reports waiting to be sent */
+#define HID_REPORTS_PER_INTERVAL			4	/* Reports sent in each connection interval */
+#define HID_DEFAULT_INTERVAL_MS				15	/* Sending period until the connection interval is known */
+#define HID_TYPE_CHUNK						8	/* Characters queued per critical section by BleHidType() */
 /********************esp_hidd_prf_api**********************/
 // HID keyboard input report length
 #define HID_KEYBOARD_IN_RPT_LEN     		8
@@ -952,6 +957,11 @@ static esp_ble_adv_params_t hidd_adv_params = {
 static uint16_t hid_conn_id = 0;
 static bool sec_conn = false;
 ble_status_t status = BLE_OFF;
+static hid_sched_report_t hid_queue[HID_QUEUE_LEN];	/* Storage for hid_sched */
+static hid_scheduler_t hid_sched;						/* Reports waiting to be sent */
+static portMUX_TYPE hid_sched_mux = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t hid_interval_ms = HID_DEFAULT_INTERVAL_MS;	/* Connection interval */
+static TaskHandle_t hid_task_handle = NULL;			/* Task sending the queued reports */
 
 /*==================[external data definition]===============================*/
 /********************esp_hidd_prf_api**********************/
@@ -1310,6 +1320,9 @@ static void hidd_event_callback(esp_hidd_cb_event_t event, esp_hidd_cb_param_t *
         case ESP_HIDD_EVENT_BLE_DISCONNECT: {
             status = BLE_DISCONNECTED;
             sec_conn = false;
+            hid_interval_ms = HID_DEFAULT_INTERVAL_MS;
+            /* wake up the sending task so it drops pending reports */
+            xTaskNotifyGive(hid_task_handle);
             ESP_LOGI(TAG, "ESP_HIDD_EVENT_BLE_DISCONNECT");
             status = BLE_DISCONNECTED;
             esp_ble_gap_start_advertising(&hidd_adv_params);
@@ -1343,9 +1356,14 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param
         }
         esp_ble_gap_security_rsp(param->ble_security.ble_req.bd_addr, true);
 	 break;
+     case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT:
+        /* conn_int is in 1.25 ms units */
+        hid_interval_ms = (param->update_conn_params.conn_int * 5 + 3) / 4;
+        break;
      case ESP_GAP_BLE_AUTH_CMPL_EVT:
         status = BLE_CONNECTED;
         sec_conn = true;
+        xTaskNotifyGive(hid_task_handle);
         esp_bd_addr_t bd_addr;
         memcpy(bd_addr, param->ble_security.auth_cmpl.bd_addr, sizeof(esp_bd_addr_t));
         ESP_LOGI(TAG, "remote BD_ADDR: %08x%04x",\
@@ -1362,6 +1380,41 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param
     }
 }
 
+/**
+ * @brief Sends the queued reports
+ *
+ * Up to HID_REPORTS_PER_INTERVAL reports are sent every connection interval.
+ * Mouse movements queued while waiting are coalesced by the scheduler, so the
+ * link is never asked for more reports than it can deliver.
+ */
+static void hid_send_task(void *arg){
+    hid_sched_report_t report;
+    bool available;
+    while(1){
+        if((status != BLE_CONNECTED) || (HidSchedulerPending(&hid_sched) == 0)){
+            if(status != BLE_CONNECTED){
+                portENTER_CRITICAL(&hid_sched_mux);
+                HidSchedulerClear(&hid_sched);
+                portEXIT_CRITICAL(&hid_sched_mux);
+            }
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        for(uint8_t i = 0; i < HID_REPORTS_PER_INTERVAL; i++){
+            portENTER_CRITICAL(&hid_sched_mux);
+            available = HidSchedulerNext(&hid_sched, &report);
+            portEXIT_CRITICAL(&hid_sched_mux);
+            if(!available){
+                break;
+            }
+            hid_dev_send_report(hidd_le_env.gatt_if, hid_conn_id,
+                                (report.type == HID_SCHED_MOUSE) ? HID_RPT_ID_MOUSE_IN : HID_RPT_ID_KEY_IN,
+                                HID_REPORT_TYPE_INPUT, report.len, report.data);
+        }
+        vTaskDelay(pdMS_TO_TICKS(hid_interval_ms) ? pdMS_TO_TICKS(hid_interval_ms) : 1);
+    }
+}
+
 /*==================[external functions definition]==========================*/
 void BleHidInit(char * hid_dev_name){
     esp_err_t ret;
@@ -1373,6 +1426,8 @@ void BleHidInit(char * hid_dev_name){
         ret = nvs_flash_init();
     }
     ESP_ERROR_CHECK( ret );
+    HidSchedulerInit(&hid_sched, hid_queue, HID_QUEUE_LEN);
+    xTaskCreate(hid_send_task, "hid_send", 1024*3, NULL, 9, &hid_task_handle);
     ESP_ERROR_CHECK(esp_bt_controller_mem_release(ESP_BT_MODE_CLASSIC_BT));
     esp_bt_controller_config_t bt_cfg = BT_CONTROLLER_INIT_CONFIG_DEFAULT();
     ret = esp_bt_controller_init(&bt_cfg);
@@ -1418,40 +1473,75 @@ ble_status_t BleHidStatus(void){
 	return status;
 }
 
-void BleHidSendKeyboard(key_mask_t special_key_mask, keyboard_cmd_t *keyboard_cmd, uint8_t num_key){
-    if (num_key > HID_KEYBOARD_IN_RPT_LEN - 2) {
-        ESP_LOGE(TAG, "%s(), the number key should not be more than %d", __func__, HID_KEYBOARD_IN_RPT_LEN);
-        return;
+bool BleHidSendKeyboard(key_mask_t special_key_mask, keyboard_cmd_t *keyboard_cmd, uint8_t num_key){
+    uint8_t keys[HID_SCHED_KEYS_MAX];
+    bool queued;
+    if (num_key > HID_SCHED_KEYS_MAX) {
+        ESP_LOGE(TAG, "%s(), the number key should not be more than %d", __func__, HID_SCHED_KEYS_MAX);
+        return false;
     }
-    uint8_t buffer[HID_KEYBOARD_IN_RPT_LEN] = {0};
-    if(status == BLE_CONNECTED){
-        buffer[0] = special_key_mask;
-        for (int i = 0; i < num_key; i++) {
-            buffer[i+2] = keyboard_cmd[i];
-        }
-        hid_dev_send_report(hidd_le_env.gatt_if, hid_conn_id,
-                            HID_RPT_ID_KEY_IN, HID_REPORT_TYPE_INPUT, HID_KEYBOARD_IN_RPT_LEN, buffer);
-        for (int i = 0; i < num_key; i++) {
-            buffer[i+2] = 0;
-        }
-        hid_dev_send_report(hidd_le_env.gatt_if, hid_conn_id,
-                            HID_RPT_ID_KEY_IN, HID_REPORT_TYPE_INPUT, HID_KEYBOARD_IN_RPT_LEN, buffer);
+    if(status != BLE_CONNECTED){
+        return false;
     }
-    return;
+    for (int i = 0; i < num_key; i++) {
+        keys[i] = keyboard_cmd[i];
+    }
+    portENTER_CRITICAL(&hid_sched_mux);
+    queued = HidSchedulerKeyboard(&hid_sched, special_key_mask, keys, num_key);
+    portEXIT_CRITICAL(&hid_sched_mux);
+    xTaskNotifyGive(hid_task_handle);
+    return queued;
 }
 
-void BleHidSendMouse(mouse_cmd_t mouse_button, int8_t delta_x, int8_t delta_y){
-    uint8_t buffer[HID_MOUSE_IN_RPT_LEN];
-    buffer[0] = mouse_button;       // Buttons
-    buffer[1] = delta_x;            // X
-    buffer[2] = delta_y;            // Y
-    buffer[3] = 0;                  // Wheel
-    buffer[4] = 0;                  // AC Pan
-    if(status == BLE_CONNECTED){
-        hid_dev_send_report(hidd_le_env.gatt_if, hid_conn_id,
-                            HID_RPT_ID_MOUSE_IN, HID_REPORT_TYPE_INPUT, HID_MOUSE_IN_RPT_LEN, buffer);
+bool BleHidSendMouse(mouse_cmd_t mouse_button, int8_t delta_x, int8_t delta_y){
+    uint8_t buttons = 0;
+    bool queued;
+    if(status != BLE_CONNECTED){
+        return false;
     }
-    return;
+    /* Commands to report button bits */
+    switch(mouse_button){
+        case HID_MOUSE_LEFT:
+            buttons = HID_SCHED_BUTTON_LEFT;
+            break;
+        case HID_MOUSE_MIDDLE:
+            buttons = HID_SCHED_BUTTON_MIDDLE;
+            break;
+        case HID_MOUSE_RIGHT:
+            buttons = HID_SCHED_BUTTON_RIGHT;
+            break;
+        default:
+            break;
+    }
+    portENTER_CRITICAL(&hid_sched_mux);
+    queued = HidSchedulerMouse(&hid_sched, buttons, delta_x, delta_y, 0);
+    portEXIT_CRITICAL(&hid_sched_mux);
+    xTaskNotifyGive(hid_task_handle);
+    return queued;
+}
+
+uint32_t BleHidType(const char *text){
+    uint32_t typed = 0, n;
+    if(status != BLE_CONNECTED){
+        return 0;
+    }
+    /* Queue a few characters at a time to keep the critical sections short */
+    do{
+        char chunk[HID_TYPE_CHUNK + 1];
+        for(n = 0; (n < HID_TYPE_CHUNK) && (text[typed + n] != '\0'); n++){
+            chunk[n] = text[typed + n];
+        }
+        chunk[n] = '\0';
+        portENTER_CRITICAL(&hid_sched_mux);
+        n = HidSchedulerType(&hid_sched, chunk);
+        portEXIT_CRITICAL(&hid_sched_mux);
+        typed += n;
+    } while((n == HID_TYPE_CHUNK) && (text[typed] != '\0'));
+    xTaskNotifyGive(hid_task_handle);
+    return typed;
 }
 
+uint16_t BleHidPending(void){
+    return HidSchedulerPending(&hid_sched);
+}
 /*==================[end of file]============================================*/
\ No newline at end of file
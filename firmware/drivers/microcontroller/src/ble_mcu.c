@@ -23,19 +23,32 @@
 #include "esp_gatts_api.h"
 #include "esp_bt_defs.h"
 #include "esp_bt_main.h"
+#include "esp_gatt_common_api.h"
+#include "esp_timer.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "ring_buffer.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "ble_mcu"
-#define MTU_MAX_BYTES		20	 /* GATT Maximum Transmission Unit */
-#define PAYLOAD_SIZE        128  /* Maximun number of bytes transmitted in one transaction */
+#define MTU_DEFAULT			23	 /* GATT Maximum Transmission Unit before the MTU exchange */
+#define MTU_MAX_BYTES		247	 /* GATT MTU requested: 244 bytes notifications fit in one 251 bytes LL packet */
+#define ATT_HEADER_SIZE		3	 /* Notification header (opcode + handle) */
+#define PAYLOAD_SIZE        (MTU_MAX_BYTES - ATT_HEADER_SIZE)  /* Maximun number of bytes transmitted in one transaction */
+#define LL_DATA_LEN_MAX		251	 /* Link layer payload requested with data length extension */
+#define CONN_INT_MIN		0x06 /* Connection interval requested: 7.5 ms (units of 1.25 ms) */
+#define CONN_INT_MAX		0x0C /* Connection interval requested: 15 ms (units of 1.25 ms) */
+#define CONN_TIMEOUT		400	 /* Supervision timeout: 4 s (units of 10 ms) */
+#define CONGEST_WAIT_MS		100	 /* Maximum wait for the link to be uncongested before checking the connection again */
+#define BENCH_REPORT_US		1000000	/* Benchmark report period */
+#define TX_BUFFER_SIZE		2048 /* Outgoing data buffer (power of two) */
 #define SPP_PROFILE_NUM     1       
 #define SPP_PROFILE_APP_IDX 0
 #define ESP_SPP_APP_ID      0x56
 #define SPP_SVC_INST_ID     0
-#define SPP_DATA_MAX_LEN    (128) /* Maximun number of bytes transmitted in one transaction */
+#define SPP_DATA_MAX_LEN    PAYLOAD_SIZE /* Maximun number of bytes transmitted in one transaction */
 /* List of attributes to be added to the service database */
 enum{
     SPP_IDX_SVC,
@@ -59,16 +72,18 @@ typedef enum {
     CMD_BLUETOOTH_AUTH,          /* device authentification */
     CMD_BLUETOOTH_DATA,          /* data reception */
     CMD_BLUETOOTH_DISCONNECT,    /* device disconnection */
-    CMD_SEND_DATA,               /* data transmission */
 } comd_bt_ev_t;
 /* Struct used to handle Bluetooth events */
 typedef struct {
 	uint16_t spp_conn_id;
 	esp_gatt_if_t spp_gatts_if;
 	uint16_t command;
+} EVT_t;
+/* Struct used to handle received data */
+typedef struct {
+	uint16_t command;
 	size_t length;
 	uint8_t payload[PAYLOAD_SIZE];
-	TaskHandle_t taskHandle;
 } CMD_t;
 /*==================[internal data declaration]==============================*/
 char * device_name; /* Device name */
@@ -92,6 +107,18 @@ struct gatts_profile_inst {
 };
 QueueHandle_t xQueueEvents = NULL;  /* Queue for handling Bluettoth events */
 QueueHandle_t xQueueRead = NULL;    /* Queue for handling received data */
+static volatile uint16_t ble_mtu = MTU_DEFAULT;     /* Negotiated GATT MTU */
+static volatile bool ble_congested = false;         /* Stack buffers full, sending must wait */
+static SemaphoreHandle_t xUncongested = NULL;       /* Given when the link is uncongested or disconnected */
+static volatile uint32_t bench_rate = 0;            /* Last benchmark measurement (bytes/s) */
+static volatile bool bench_enable = false;          /* Benchmark streaming active */
+static volatile bool bench_restart = false;         /* Benchmark measurement must start again */
+static uint16_t spp_conn_id = 0xffff;               /* Current connection */
+static esp_gatt_if_t spp_gatts_if = 0xff;           /* GATT interface of the current connection */
+static ring_buffer_t tx_buffer;                     /* Outgoing data, drained by ble_tx_task */
+static uint8_t tx_storage[TX_BUFFER_SIZE];          /* Storage for tx_buffer */
+static SemaphoreHandle_t xTxMutex = NULL;           /* Serializes producers writing to tx_buffer */
+static TaskHandle_t tx_task_handle = NULL;          /* Task sending notifications */
 
 /*==================[internal functions declaration]=========================*/
 static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
@@ -198,7 +225,7 @@ static const esp_gatts_attr_db_t spp_gatt_db[SPP_IDX_NB] = {
 
 /*==================[internal functions definition]==========================*/
 static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
-	CMD_t cmdBuf;
+	EVT_t evtBuf;
 	static uint8_t adv_config_done = 0;
 	switch (event) {
 		case ESP_GAP_BLE_SCAN_RSP_DATA_SET_COMPLETE_EVT:
@@ -215,6 +242,14 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param
 				status = BLE_DISCONNECTED;
 			}
 			break;
+		case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT:
+			ESP_LOGI(TAG, "Connection interval: %d x 1.25 ms, latency %d", param->update_conn_params.conn_int,
+				param->update_conn_params.latency);
+			break;
+		case ESP_GAP_BLE_SET_PKT_LENGTH_COMPLETE_EVT:
+			ESP_LOGI(TAG, "Data length: tx %d, rx %d bytes", param->pkt_data_length_cmpl.params.tx_len,
+				param->pkt_data_length_cmpl.params.rx_len);
+			break;
 		case ESP_GAP_BLE_ADV_START_COMPLETE_EVT:
 			//advertising start complete event to indicate advertising start successfully or failed
 			if (param->adv_start_cmpl.status != ESP_BT_STATUS_SUCCESS) {
@@ -255,8 +290,8 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param
 
 			break;
 		case ESP_GAP_BLE_AUTH_CMPL_EVT: {
-			cmdBuf.command = CMD_BLUETOOTH_AUTH;
-			xQueueSend(xQueueEvents, &cmdBuf, 0);
+			evtBuf.command = CMD_BLUETOOTH_AUTH;
+			xQueueSend(xQueueEvents, &evtBuf, 0);
 			break;
 	}
 	case ESP_GAP_BLE_REMOVE_BOND_DEV_COMPLETE_EVT: {
@@ -294,6 +329,7 @@ static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 										esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param) {
     esp_ble_gatts_cb_param_t *p_data = (esp_ble_gatts_cb_param_t *) param;
 	CMD_t cmdBuf;
+	EVT_t evtBuf;
 
 	switch (event) {
 		case ESP_GATTS_REG_EVT:
@@ -307,13 +343,15 @@ static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 			break;
 		case ESP_GATTS_WRITE_EVT:
 			cmdBuf.command = CMD_BLUETOOTH_DATA;
-			memcpy(cmdBuf.payload, param->write.value, param->write.len);
-			cmdBuf.length = param->write.len;
+			cmdBuf.length = (param->write.len < PAYLOAD_SIZE) ? param->write.len : PAYLOAD_SIZE;
+			memcpy(cmdBuf.payload, param->write.value, cmdBuf.length);
 			xQueueSend(xQueueRead, &cmdBuf, 0);
 			break;
 		case ESP_GATTS_EXEC_WRITE_EVT:
 			break;
 		case ESP_GATTS_MTU_EVT:
+			ble_mtu = param->mtu.mtu;
+			ESP_LOGI(TAG, "MTU: %d", ble_mtu);
 			break;
 		case ESP_GATTS_CONF_EVT:
 			break;
@@ -328,15 +366,31 @@ static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 		case ESP_GATTS_CONNECT_EVT:
 			/* start security connect with peer device when receive the connect event sent by the master */
 			esp_ble_set_encryption(param->connect.remote_bda, ESP_BLE_SEC_ENCRYPT_MITM);
-			cmdBuf.command = CMD_BLUETOOTH_CONNECT;
-			cmdBuf.spp_conn_id = p_data->connect.conn_id;
-			cmdBuf.spp_gatts_if = gatts_if;
-			xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
+			/* ask for a short connection interval and long link layer packets (the central decides) */
+			esp_ble_conn_update_params_t conn_params = {
+				.min_int = CONN_INT_MIN,
+				.max_int = CONN_INT_MAX,
+				.latency = 0,
+				.timeout = CONN_TIMEOUT,
+			};
+			memcpy(conn_params.bda, param->connect.remote_bda, sizeof(esp_bd_addr_t));
+			esp_ble_gap_update_conn_params(&conn_params);
+			esp_ble_gap_set_pkt_data_len(param->connect.remote_bda, LL_DATA_LEN_MAX);
+			ble_mtu = MTU_DEFAULT;
+			ble_congested = false;
+			evtBuf.command = CMD_BLUETOOTH_CONNECT;
+			evtBuf.spp_conn_id = p_data->connect.conn_id;
+			evtBuf.spp_gatts_if = gatts_if;
+			xQueueSend(xQueueEvents, &evtBuf, portMAX_DELAY);
 			break;
 		case ESP_GATTS_DISCONNECT_EVT:
-			cmdBuf.command = CMD_BLUETOOTH_DISCONNECT;
+			evtBuf.command = CMD_BLUETOOTH_DISCONNECT;
 			status = BLE_DISCONNECTED;
-			xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
+			ble_congested = false;
+			xSemaphoreGive(xUncongested);
+			/* wake up the sending task so it drops pending data */
+			xTaskNotifyGive(tx_task_handle);
+			xQueueSend(xQueueEvents, &evtBuf, portMAX_DELAY);
 			/* start advertising again when missing the connect */
 			esp_ble_gap_start_advertising(&spp_adv_params);
 			break;
@@ -349,6 +403,10 @@ static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 		case ESP_GATTS_LISTEN_EVT:
 			break;
 		case ESP_GATTS_CONGEST_EVT:
+			ble_congested = param->congest.congested;
+			if(!ble_congested){
+				xSemaphoreGive(xUncongested);
+			}
 			break;
 		case ESP_GATTS_CREAT_ATTR_TAB_EVT: {
 			if (param->create.status == ESP_GATT_OK){
@@ -403,47 +461,111 @@ static void read_task(void* pvParameters) {
 	} 
 }
 
+/**
+ * @brief Send one notification
+ *
+ * @return false if the stack did not accept it: the caller waits (at most
+ * CONGEST_WAIT_MS, less if the link gets uncongested) and retries.
+ */
+static bool ble_notify(const uint8_t *data, uint16_t length){
+	if(esp_ble_gatts_send_indicate(spp_gatts_if, spp_conn_id, spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL],
+								   length, (uint8_t *)data, false) != ESP_OK){
+		xSemaphoreTake(xUncongested, pdMS_TO_TICKS(CONGEST_WAIT_MS));
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Send one notification of the benchmark counter pattern and update the rate report
+ */
+static void ble_benchmark_step(void){
+	static uint8_t pattern[PAYLOAD_SIZE];
+	static uint8_t counter = 0;
+	static uint32_t bytes = 0;
+	static int64_t start = 0;
+	uint16_t chunk = ble_mtu - ATT_HEADER_SIZE;
+	int64_t now;
+	if(bench_restart){
+		bench_restart = false;
+		bytes = 0;
+		start = 0;
+	}
+	/* Every byte continues the counter of the previous one, so the receiver can check for losses */
+	for(uint16_t i = 0; i < chunk; i++){
+		pattern[i] = counter + i;
+	}
+	if(!ble_notify(pattern, chunk)){
+		return;
+	}
+	counter += chunk;
+	bytes += chunk;
+	now = esp_timer_get_time();
+	if(start == 0){
+		start = now;
+	} else if(now - start >= BENCH_REPORT_US){
+		bench_rate = (uint32_t)((int64_t)bytes * 1000000 / (now - start));
+		ESP_LOGI(TAG, "Throughput: %lu bytes/s (MTU %d)", (unsigned long)bench_rate, ble_mtu);
+		bytes = 0;
+		start = now;
+	}
+}
+
+/**
+ * @brief Sends the outgoing buffer as notifications of the negotiated MTU size
+ *
+ * Notifications are sent straight from the ring buffer storage. While the
+ * stack reports congestion the task waits instead of sending, so no data is
+ * dropped while connected. Pending data is discarded on disconnection.
+ */
+static void ble_tx_task(void * arg) {
+	const uint8_t *block;
+	uint32_t length;
+	while(1){
+		if(status != BLE_CONNECTED){
+			RingBufferConsume(&tx_buffer, RingBufferUsed(&tx_buffer));
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			continue;
+		}
+		if(ble_congested){
+			xSemaphoreTake(xUncongested, pdMS_TO_TICKS(CONGEST_WAIT_MS));
+			continue;
+		}
+		length = RingBufferPeek(&tx_buffer, &block);
+		if(length > 0){
+			if(length > (uint32_t)(ble_mtu - ATT_HEADER_SIZE)){
+				length = ble_mtu - ATT_HEADER_SIZE;
+			}
+			if(ble_notify(block, length)){
+				RingBufferConsume(&tx_buffer, length);
+			}
+		} else if(bench_enable){
+			ble_benchmark_step();
+		} else{
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		}
+	}
+}
+
 void bluetooth_events_task(void * arg) {
-	CMD_t cmdBuf;
-	uint16_t spp_conn_id = 0xffff;
-	esp_gatt_if_t spp_gatts_if = 0xff;
-	int data_sent, i;
+	EVT_t evtBuf;
 
 	while(1){
-		vTaskDelay(50 / portTICK_PERIOD_MS);
-		xQueueReceive(xQueueEvents, &cmdBuf, portMAX_DELAY);
-        switch(cmdBuf.command){
+		xQueueReceive(xQueueEvents, &evtBuf, portMAX_DELAY);
+        switch(evtBuf.command){
             case CMD_BLUETOOTH_CONNECT:
-                spp_conn_id = cmdBuf.spp_conn_id;
-                spp_gatts_if = cmdBuf.spp_gatts_if;
+                spp_conn_id = evtBuf.spp_conn_id;
+                spp_gatts_if = evtBuf.spp_gatts_if;
             break;
             case CMD_BLUETOOTH_AUTH:
                 ESP_LOGI(TAG, "Device connected");
 				status = BLE_CONNECTED;
+				xTaskNotifyGive(tx_task_handle);
             break;
             case CMD_BLUETOOTH_DISCONNECT:
                 ESP_LOGI(TAG, "Device disconnected");
 				status = BLE_DISCONNECTED;
             break;
-            case CMD_SEND_DATA:
-                if (status == BLE_CONNECTED) {
-					data_sent = 0;
-					i = 0;
-					while(data_sent < cmdBuf.length){
-						if((cmdBuf.length - data_sent) > MTU_MAX_BYTES){
-							esp_ble_gatts_send_indicate(spp_gatts_if, spp_conn_id, spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL], MTU_MAX_BYTES, &cmdBuf.payload[i*MTU_MAX_BYTES], false);
-							data_sent += MTU_MAX_BYTES;
-							i++;
-						}else{
-							esp_ble_gatts_send_indicate(spp_gatts_if, spp_conn_id, spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL], cmdBuf.length - data_sent, &cmdBuf.payload[i*MTU_MAX_BYTES], false);
-							data_sent += MTU_MAX_BYTES;
-						}
-					}
-                }
-            break;
-            case CMD_BLUETOOTH_DATA:
-                xQueueSend(xQueueRead, &cmdBuf, portMAX_DELAY);
-            break;
         }
 	} 
 }
@@ -497,6 +619,10 @@ esp_err_t ret;
 		ESP_LOGE(TAG, "gatts app register error, error code = %x", ret);
 		return;
 	}
+	ret = esp_ble_gatt_set_local_mtu(MTU_MAX_BYTES);
+	if (ret){
+		ESP_LOGE(TAG, "set local MTU failed, error code = %x", ret);
+	}
 	/* set the security iocap & auth_req & key size & init key response key parameters to the stack*/
 	esp_ble_auth_req_t auth_req = ESP_LE_AUTH_REQ_SC_MITM_BOND;		//bonding with peer device after authentication
 	esp_ble_io_cap_t iocap = ESP_IO_CAP_NONE;			//set the IO capability to No output No input
@@ -517,50 +643,68 @@ esp_err_t ret;
 	esp_ble_gap_set_security_param(ESP_BLE_SM_SET_RSP_KEY, &rsp_key, sizeof(uint8_t));
 	
     /* Create Queue */
-	xQueueEvents = xQueueCreate(10, sizeof(CMD_t));
+	xQueueEvents = xQueueCreate(10, sizeof(EVT_t));
 	configASSERT(xQueueEvents);
 	xQueueRead = xQueueCreate( 10, sizeof(CMD_t) );
 	configASSERT(xQueueRead);
+	xUncongested = xSemaphoreCreateBinary();
+	configASSERT(xUncongested);
+	xTxMutex = xSemaphoreCreateMutex();
+	configASSERT(xTxMutex);
+	RingBufferInit(&tx_buffer, tx_storage, TX_BUFFER_SIZE);
 
 	/* Start tasks */
 	xTaskCreate(read_task, "read", 1024*4, NULL, 2, NULL);
 	xTaskCreate(bluetooth_events_task, "bluetooth_events", 1024*4, NULL, 10, NULL);
+	xTaskCreate(ble_tx_task, "bluetooth_tx", 1024*3, NULL, 9, &tx_task_handle);
 }
 
 ble_status_t BleStatus(void){
 	return status;
 }
 
-void BleSendByte(const char *data){
-	CMD_t cmdBuf;
-	if(status == BLE_CONNECTED){
-		cmdBuf.command = CMD_SEND_DATA;
-		cmdBuf.length = 1;
-		memcpy(cmdBuf.payload, data, cmdBuf.length);
-		xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
+uint32_t BleSend(const void *data, uint32_t nbytes){
+	uint32_t sent;
+	if((status != BLE_CONNECTED) || (nbytes == 0)){
+		return 0;
 	}
+	xSemaphoreTake(xTxMutex, portMAX_DELAY);
+	sent = RingBufferWrite(&tx_buffer, data, nbytes);
+	xSemaphoreGive(xTxMutex);
+	if(sent > 0){
+		xTaskNotifyGive(tx_task_handle);
+	}
+	return sent;
 }
 
-void BleSendString(const char *msg){
-	CMD_t cmdBuf;
-	if(status == BLE_CONNECTED){
-		cmdBuf.command = CMD_SEND_DATA;
-		cmdBuf.length = 0;
-		while(msg[cmdBuf.length] != '\0'){
-			cmdBuf.length++;
-		}
-		memcpy(cmdBuf.payload, msg, cmdBuf.length);
-		xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
-	}
+uint32_t BleSendFree(void){
+	return RingBufferFree(&tx_buffer);
 }
 
-void BleSendBuffer(const char *data, uint8_t nbytes){
-	CMD_t cmdBuf;
-	if(status == BLE_CONNECTED){
-		cmdBuf.command = CMD_SEND_DATA;
-		cmdBuf.length = nbytes;
-		memcpy(cmdBuf.payload, data, cmdBuf.length);
-		xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
-	}
+uint32_t BleSendByte(const char *data){
+	return BleSend(data, 1);
+}
+
+uint32_t BleSendString(const char *msg){
+	return BleSend(msg, strlen(msg));
+}
+
+uint32_t BleSendBuffer(const char *data, uint32_t nbytes){
+	return BleSend(data, nbytes);
+}
+
+uint16_t BleMtu(void){
+	return ble_mtu;
+}
+
+void BleBenchmark(bool enable){
+	bench_rate = 0;
+	bench_restart = true;
+	bench_enable = enable;
+	xTaskNotifyGive(tx_task_handle);
+}
+
+uint32_t BleBenchmarkRate(void){
+	return bench_rate;
 }
 /*==================[end of file]============================================*/
\ No newline at end of file
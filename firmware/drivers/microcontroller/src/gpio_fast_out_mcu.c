@@ -1,58 +1,137 @@
 /**
  * @file gpio_fast_out_mcu.c
  * @author Albano Peñalva (albano.penalva@uner.edu.ar)
- * @brief 
+ * @brief
  * @version 0.1
  * @date 2023-11-20
- * 
+ *
  * @copyright Copyright (c) 2023
- * 
+ *
  */
 
 /*==================[inclusions]=============================================*/
 #include "gpio_fast_out_mcu.h"
 #include "gpio_mcu.h"
 #include <stdint.h>
-#include <string.h>
 #include "driver/gpio.h"
 #include "driver/dedic_gpio.h"
+#include "esp_log.h"
 /*==================[macros and definitions]=================================*/
+#define TAG "gpio_fast"
 
 /*==================[internal data declaration]==============================*/
-dedic_gpio_bundle_handle_t bundleA = NULL;
-int bundleA_gpios[16];
+
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
-
+gpio_fast_bundle_t gpio_fast_bundles[GPIO_FAST_BUNDLES];
 /*==================[internal functions definition]==========================*/
 
 /*==================[external functions definition]==========================*/
-
-void GPIOFastInit(gpio_t *pin_list, uint8_t pin_qty){
-    memcpy(bundleA_gpios, pin_list, pin_qty);
+bool GPIOFastBundleInit(gpio_fast_t bundle, const gpio_t *pin_list, uint8_t pin_qty, gpio_fast_dir_t dir){
+    gpio_fast_bundle_t *b;
+    uint8_t pins[GPIO_FAST_PINS_MAX];
+    int gpios[GPIO_FAST_PINS_MAX];
+    dedic_gpio_bundle_handle_t handle = NULL;
+    uint32_t offset;
+    uint8_t i;
+    if((bundle >= GPIO_FAST_BUNDLES) || (pin_qty == 0) || (pin_qty > GPIO_FAST_PINS_MAX)){
+        return false;
+    }
+    b = &gpio_fast_bundles[bundle];
+    if(b->handle != NULL){
+        return false;
+    }
+    for(i = 0; i < pin_qty; i++){
+        pins[i] = pin_list[i];
+        gpios[i] = pin_list[i];
+    }
+    if(!FastIoMapInit(&b->map, pins, pin_qty, GPIO_PORT_MASK)){
+        return false;
+    }
     gpio_config_t io_conf = {
-        .mode = GPIO_MODE_OUTPUT,
+        .pin_bit_mask = b->map.port_mask,
     };
-    for (int i = 0; i < pin_qty; i++) {
-        io_conf.pin_bit_mask = 1ULL << bundleA_gpios[i];
-        gpio_config(&io_conf);
+    if(dir == GPIO_FAST_OUTPUT){
+        io_conf.mode = GPIO_MODE_OUTPUT;
+    } else if(dir == GPIO_FAST_INPUT){
+        io_conf.mode = GPIO_MODE_INPUT;
+        io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+    } else{
+        io_conf.mode = GPIO_MODE_INPUT_OUTPUT_OD;
+        io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
     }
-    // Create bundleA, output only
-    dedic_gpio_bundle_config_t bundleA_config = {
-        .gpio_array = bundleA_gpios,
+    gpio_config(&io_conf);
+    dedic_gpio_bundle_config_t bundle_config = {
+        .gpio_array = gpios,
         .array_size = pin_qty,
         .flags = {
-            .out_en = 1,
+            .out_en = (dir != GPIO_FAST_INPUT),
+            .in_en = (dir != GPIO_FAST_OUTPUT),
         },
     };
-    ESP_ERROR_CHECK(dedic_gpio_new_bundle(&bundleA_config, &bundleA));
+    if(dedic_gpio_new_bundle(&bundle_config, &handle) != ESP_OK){
+        return false;
+    }
+    b->out_offset = 0;
+    b->in_offset = 0;
+    b->out_mask = 0;
+    b->in_mask = 0;
+    if(bundle_config.flags.out_en){
+        dedic_gpio_get_out_offset(handle, &offset);
+        b->out_offset = offset;
+        b->out_mask = b->map.mask;
+    }
+    if(bundle_config.flags.in_en){
+        dedic_gpio_get_in_offset(handle, &offset);
+        b->in_offset = offset;
+        b->in_mask = b->map.mask;
+    }
+    b->handle = handle;
+    return true;
 }
 
-void GPIOFastWrite(uint16_t value){
-    dedic_gpio_bundle_write(bundleA, 0xFF, value);
+void GPIOFastBundleDeinit(gpio_fast_t bundle){
+    gpio_fast_bundle_t *b;
+    if(bundle >= GPIO_FAST_BUNDLES){
+        return;
+    }
+    b = &gpio_fast_bundles[bundle];
+    /* Inline accesses become no-ops before the channels are released */
+    b->out_mask = 0;
+    b->in_mask = 0;
+    if(b->handle != NULL){
+        dedic_gpio_del_bundle(b->handle);
+        b->handle = NULL;
+    }
+}
+
+void GPIOFastWritePort(gpio_fast_t bundle, uint32_t mask, uint32_t values){
+    const fast_io_map_t *map;
+    if(bundle >= GPIO_FAST_BUNDLES){
+        return;
+    }
+    map = &gpio_fast_bundles[bundle].map;
+    GPIOFastWriteMask(bundle, FastIoMapFromPort(map, mask), FastIoMapFromPort(map, values));
+}
+
+uint32_t GPIOFastReadPort(gpio_fast_t bundle){
+    if(bundle >= GPIO_FAST_BUNDLES){
+        return 0;
+    }
+    return FastIoMapToPort(&gpio_fast_bundles[bundle].map, GPIOFastReadBundle(bundle));
+}
+
+bool GPIOFastInit(gpio_t *pin_list, uint8_t pin_qty){
+    GPIOFastBundleDeinit(GPIO_FAST_A);
+    if(!GPIOFastBundleInit(GPIO_FAST_A, pin_list, pin_qty, GPIO_FAST_OUTPUT)){
+        /* GPIOFastWrite() does nothing until a successful init */
+        ESP_LOGE(TAG, "GPIO_FAST_A init failed (invalid pins or no free dedicated channels)");
+        return false;
+    }
+    return true;
 }
 
-/*==================[end of file]============================================*/
\ No newline at end of file
+/*==================[end of file]============================================*/
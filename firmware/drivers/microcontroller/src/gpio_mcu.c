@@ -14,9 +14,16 @@
 #include <stdint.h>
 #include "driver/gpio.h"
 #include "driver/gpio_filter.h"
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
+#include "freertos/FreeRTOS.h"
 /*==================[macros and definitions]=================================*/
 #define GPIO_QTY 	24
 #define FILTER_QTY	8
+/* Port registers: a single read or write accesses every pin */
+#define GPIO_PORT_OUT_READ()			REG_READ(GPIO_OUT_REG)
+#define GPIO_PORT_OUT_WRITE(value)		REG_WRITE(GPIO_OUT_REG, (value))
+#define GPIO_PORT_IN_READ()				REG_READ(GPIO_IN_REG)
 typedef struct{
 	uint64_t pin;				/*!< GPIO pin */
 	gpio_mode_t mode;			/*!< Input/Output mode */
@@ -54,6 +61,8 @@ digital_io_t gpio_list[GPIO_QTY] = {
 	{GPIO_NUM_22, GPIO_MODE_DISABLE, GPIO_PULLUP_ONLY, false}, /* Configuration GPIO22*/
 	{GPIO_NUM_23, GPIO_MODE_DISABLE, GPIO_PULLUP_ONLY, false}, /* Configuration GPIO23*/
 };
+static uint32_t output_mask = 0;		/* Pins initialized as outputs */
+static portMUX_TYPE port_mux = portMUX_INITIALIZER_UNLOCKED;
 gpio_flex_glitch_filter_config_t filter_config = {
 	.clk_src = GLITCH_FILTER_CLK_SRC_DEFAULT,
 	.window_width_ns = 700,
@@ -70,8 +79,10 @@ void GPIOInit(gpio_t pin, io_t io){
 	}
 	if(io == GPIO_INPUT){
 		gpio_list[pin].mode = GPIO_MODE_INPUT;
+		output_mask &= ~GPIO_BIT(pin);
 	} else if(io == GPIO_OUTPUT){
 		gpio_list[pin].mode = GPIO_MODE_OUTPUT;
+		output_mask |= GPIO_BIT(pin);
 	}
 	gpio_reset_pin(gpio_list[pin].pin);
 	gpio_set_direction(gpio_list[pin].pin, gpio_list[pin].mode);
@@ -102,6 +113,29 @@ bool GPIORead(gpio_t pin){
 	return gpio_get_level(gpio_list[pin].pin);
 }
 
+void GPIOWriteMask(uint32_t mask, uint32_t values){
+	uint32_t out;
+	uint8_t pin;
+	mask &= output_mask;
+	if(mask == 0){
+		return;
+	}
+	/* Read-modify-write of the output register: every pin in mask changes with the same store */
+	portENTER_CRITICAL(&port_mux);
+	out = GPIO_PORT_OUT_READ();
+	GPIO_PORT_OUT_WRITE((out & ~mask) | (values & mask));
+	for(pin = 0; pin < GPIO_QTY; pin++){
+		if(mask & GPIO_BIT(pin)){
+			gpio_list[pin].state = (values & GPIO_BIT(pin)) != 0;
+		}
+	}
+	portEXIT_CRITICAL(&port_mux);
+}
+
+uint32_t GPIOReadPort(void){
+	return GPIO_PORT_IN_READ() & GPIO_PORT_MASK;
+}
+
 void GPIOActivInt(gpio_t pin, void *ptr_int_func, bool edge, void *args){
 	static bool isr_service_installed = false;
 	if(edge){
@@ -1,20 +1,23 @@
 /**
  * @file pwm_mcu.c
  * @author Albano Peñalva (albano.penalva@uner.edu.ar)
- * @brief 
+ * @brief
  * @version 0.1
  * @date 2024-01-23
- * 
+ *
  * @copyright Copyright (c) 2023
- * 
+ *
  */
 
 /*==================[inclusions]=============================================*/
 #include "pwm_mcu.h"
+#include "pwm_alloc.h"
 #include "driver/ledc.h"
+#include "freertos/FreeRTOS.h"
 /*==================[macros and definitions]=================================*/
-#define DC_MAX  1023
+#define DC_MAX  PWM_DUTY_MAX
 #define DC_100  100
+#define PWM_QTY 4
 /*==================[internal data declaration]==============================*/
 static ledc_timer_config_t pwm_timer_cfg = {
     .speed_mode       = LEDC_LOW_SPEED_MODE,
@@ -30,147 +33,191 @@ static ledc_channel_config_t ledc_channel_cfg = {
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
-
+static pwm_alloc_t pwm_alloc;                   /* Timer used by each output */
+static bool pwm_alloc_ready = false;
+static uint16_t pwm_duty[PWM_QTY];              /* Last duty of each output (restored by PWMOn()) */
+static bool pwm_fading[PWM_QTY];                /* A hardware fade was started on the output */
+static bool fade_installed = false;
+static portMUX_TYPE pwm_mux = portMUX_INITIALIZER_UNLOCKED;
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Attach an output to a timer running at freq, configuring the timer if needed
+ */
+static bool pwm_attach(pwm_out_t out, uint32_t freq){
+    bool configure = true;
+    int8_t previous, timer;
+    esp_err_t err;
+    if(!pwm_alloc_ready){
+        PwmAllocInit(&pwm_alloc);
+        pwm_alloc_ready = true;
+    }
+    previous = PwmAllocTimer(&pwm_alloc, out);
+    timer = PwmAllocAttach(&pwm_alloc, out, freq, &configure);
+    if(timer == PWM_ALLOC_NONE){
+        return false;
+    }
+    if(configure){
+        if(timer == previous){
+            /* Only user of its timer: change the frequency without resetting the timer */
+            err = ledc_set_freq(LEDC_LOW_SPEED_MODE, (ledc_timer_t)timer, freq);
+        } else{
+            pwm_timer_cfg.freq_hz = freq;
+            pwm_timer_cfg.timer_num = (ledc_timer_t)timer;
+            err = ledc_timer_config(&pwm_timer_cfg);
+        }
+        if(err != ESP_OK){
+            PwmAllocDetach(&pwm_alloc, out);
+            return false;
+        }
+    }
+    return true;
+}
 
+/**
+ * @brief Stop a running hardware fade so the duty can be written directly
+ */
+static void pwm_stop_fade(pwm_out_t out){
+    if(pwm_fading[out]){
+        ledc_fade_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out);
+        pwm_fading[out] = false;
+    }
+}
+
+/**
+ * @brief Convert a duty cycle in % to timer counts
+ */
+static uint16_t pwm_percent_to_duty(uint8_t duty_cycle){
+    if(duty_cycle > DC_100){
+        duty_cycle = DC_100;
+    }
+    return ((uint32_t)duty_cycle * DC_MAX) / DC_100;
+}
 /*==================[external functions definition]==========================*/
 uint8_t PWMInit(pwm_out_t out, gpio_t gpio, uint16_t freq){
-    switch(out){
-        case PWM_0:
-            pwm_timer_cfg.freq_hz = freq;
-            pwm_timer_cfg.timer_num = LEDC_TIMER_0;
-            ledc_timer_config(&pwm_timer_cfg);
-            ledc_channel_cfg.channel = LEDC_CHANNEL_0;
-            ledc_channel_cfg.timer_sel = LEDC_TIMER_0;
-            ledc_channel_cfg.gpio_num = gpio;
-            ledc_channel_config(&ledc_channel_cfg);
-            break;
-        case PWM_1:
-            pwm_timer_cfg.freq_hz = freq;
-            pwm_timer_cfg.timer_num = LEDC_TIMER_1;
-            ledc_timer_config(&pwm_timer_cfg);
-            ledc_channel_cfg.channel = LEDC_CHANNEL_1;
-            ledc_channel_cfg.timer_sel = LEDC_TIMER_1;
-            ledc_channel_cfg.gpio_num = gpio;
-            ledc_channel_config(&ledc_channel_cfg);
-            break;
-        case PWM_2:
-            pwm_timer_cfg.freq_hz = freq;
-            pwm_timer_cfg.timer_num = LEDC_TIMER_2;
-            ledc_timer_config(&pwm_timer_cfg);
-            ledc_channel_cfg.channel = LEDC_CHANNEL_2;
-            ledc_channel_cfg.timer_sel = LEDC_TIMER_2;
-            ledc_channel_cfg.gpio_num = gpio;
-            ledc_channel_config(&ledc_channel_cfg);
-            break;
-        case PWM_3:
-            pwm_timer_cfg.freq_hz = freq;
-            pwm_timer_cfg.timer_num = LEDC_TIMER_3;
-            ledc_timer_config(&pwm_timer_cfg);
-            ledc_channel_cfg.channel = LEDC_CHANNEL_3;
-            ledc_channel_cfg.timer_sel = LEDC_TIMER_3;
-            ledc_channel_cfg.gpio_num = gpio;
-            ledc_channel_config(&ledc_channel_cfg);
-            break;
+    if(out >= PWM_QTY){
+        return 1;
     }
+    if(!pwm_attach(out, freq)){
+        return 1;
+    }
+    ledc_channel_cfg.channel = (ledc_channel_t)out;
+    ledc_channel_cfg.timer_sel = (ledc_timer_t)PwmAllocTimer(&pwm_alloc, out);
+    ledc_channel_cfg.gpio_num = gpio;
+    ledc_channel_config(&ledc_channel_cfg);
+    pwm_duty[out] = 0;
+    pwm_fading[out] = false;
     return 0;
 }
 
 void PWMOn(pwm_out_t out){
-    switch(out){
-        case PWM_0:
-            ledc_timer_resume(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0);
-            break;
-        case PWM_1:
-            ledc_timer_resume(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1);
-            break;
-        case PWM_2:
-            ledc_timer_resume(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2);
-            break;
-        case PWM_3:
-            ledc_timer_resume(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3);
-            break;
-    }
+    /* The timer can be shared with other outputs: only this channel is enabled */
+    pwm_stop_fade(out);
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out, pwm_duty[out]);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out);
 }
 
 void PWMOff(pwm_out_t out){
-    switch(out){
-        case PWM_0:
-            ledc_timer_pause(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0);
-            break;
-        case PWM_1:
-            ledc_timer_pause(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1);
-            break;
-        case PWM_2:
-            ledc_timer_pause(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2);
-            break;
-        case PWM_3:
-            ledc_timer_pause(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3);
-            break;
-    }
+    pwm_stop_fade(out);
+    ledc_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out, 0);
 }
 
 void PWMSetDutyCycle(pwm_out_t out, uint8_t duty_cycle){
-    if(duty_cycle > DC_100){
-        duty_cycle = DC_100;
+    PWMSetDuty(out, pwm_percent_to_duty(duty_cycle));
+}
+
+void PWMSetDuty(pwm_out_t out, uint16_t duty){
+    if(out >= PWM_QTY){
+        return;
+    }
+    if(duty > DC_MAX){
+        duty = DC_MAX;
+    }
+    pwm_stop_fade(out);
+    pwm_duty[out] = duty;
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out, duty);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out);
+}
+
+uint8_t PWMSetDuties(const pwm_out_t *outs, const uint16_t *duties, uint8_t n){
+    uint8_t i;
+    /* All or nothing: no output changes if any of them is invalid */
+    for(i = 0; i < n; i++){
+        if(outs[i] >= PWM_QTY){
+            return 1;
+        }
     }
-    uint32_t dc = ((uint32_t)duty_cycle * DC_MAX) / DC_100;
-    switch(out){
-        case PWM_0:
-            ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0, dc);
-            ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0);
-            break;
-        case PWM_1:
-            ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1, dc);
-            ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1);
-            break;
-        case PWM_2:
-            ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2, dc);
-            ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2);
-            break;
-        case PWM_3:
-            ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3, dc);
-            ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3);
-            break;
+    for(i = 0; i < n; i++){
+        pwm_stop_fade(outs[i]);
+        pwm_duty[outs[i]] = (duties[i] > DC_MAX) ? DC_MAX : duties[i];
+        ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)outs[i], pwm_duty[outs[i]]);
     }
+    /* New duties are latched at the end of the period: updating every channel
+     * back to back makes outputs sharing a timer change in the same period */
+    portENTER_CRITICAL(&pwm_mux);
+    for(i = 0; i < n; i++){
+        ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)outs[i]);
+    }
+    portEXIT_CRITICAL(&pwm_mux);
+    return 0;
+}
+
+bool PWMFade(pwm_out_t out, uint16_t duty, uint32_t time_ms){
+    if(out >= PWM_QTY){
+        return false;
+    }
+    if(!fade_installed){
+        if(ledc_fade_func_install(0) != ESP_OK){
+            return false;
+        }
+        fade_installed = true;
+    }
+    if(duty > DC_MAX){
+        duty = DC_MAX;
+    }
+    pwm_stop_fade(out);
+    if(ledc_set_fade_with_time(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out, duty, time_ms) != ESP_OK){
+        return false;
+    }
+    pwm_duty[out] = duty;
+    pwm_fading[out] = true;
+    return ledc_fade_start(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out, LEDC_FADE_NO_WAIT) == ESP_OK;
 }
 
 uint8_t PWMSetFreq(pwm_out_t out, uint32_t freq){
-    switch(out){
-        case PWM_0:
-            ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0, freq);
-            break;
-        case PWM_1:
-            ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1, freq);
-            break;
-        case PWM_2:
-            ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2, freq);
-            break;
-        case PWM_3:
-            ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3, freq);
-            break;
+    int8_t previous, timer;
+    uint32_t previous_freq;
+    /* Before PWMInit() the allocator is not initialized: timer 0 would look attached */
+    if((out >= PWM_QTY) || !pwm_alloc_ready){
+        return 1;
+    }
+    previous = PwmAllocTimer(&pwm_alloc, out);
+    if(previous == PWM_ALLOC_NONE){
+        return 1;
+    }
+    previous_freq = pwm_alloc.timers[previous].freq;
+    if(!pwm_attach(out, freq)){
+        /* Keep the output running at its previous frequency */
+        pwm_attach(out, previous_freq);
+        return 1;
+    }
+    timer = PwmAllocTimer(&pwm_alloc, out);
+    if(timer != previous){
+        /* Moved to a timer shared with outputs of the same frequency */
+        ledc_bind_channel_timer(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out, (ledc_timer_t)timer);
     }
     return 0;
 }
 
 uint8_t PWMDeinit(pwm_out_t out){
-    switch(out){
-        case PWM_0:
-            ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, 0);
-            break;
-        case PWM_1:
-            ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_1, 0);
-            break;
-        case PWM_2:
-            ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_2, 0);
-            break;
-        case PWM_3:
-            ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_3, 0);
-            break;
+    if((out >= PWM_QTY) || !pwm_alloc_ready || (PwmAllocTimer(&pwm_alloc, out) == PWM_ALLOC_NONE)){
+        return 1;
     }
+    pwm_stop_fade(out);
+    ledc_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)out, 0);
+    PwmAllocDetach(&pwm_alloc, out);
     return 0;
 }
 
-/*==================[end of file]============================================*/
\ No newline at end of file
+/*==================[end of file]============================================*/
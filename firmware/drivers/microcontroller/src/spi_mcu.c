@@ -1,20 +1,23 @@
 /**
  * @file spi_mcu.c
  * @author Albano Peñalva (albano.penalva@uner.edu.ar)
- * @brief 
+ * @brief
  * @version 0.1
  * @date 2024-02-09
- * 
+ *
  * @copyright Copyright (c) 2024
- * 
+ *
  */
 
 /*==================[inclusions]=============================================*/
 #include "spi_mcu.h"
 #include <stdint.h>
 #include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "driver/spi_master.h"
 #include "gpio_mcu.h"
+#include "slot_pool.h"
 /*==================[macros and definitions]=================================*/
 #define PIN_NUM_MISO	GPIO_22	/*!<  */
 #define PIN_NUM_MOSI	GPIO_21	/*!<  */
@@ -22,207 +25,303 @@
 #define PIN_NUM_CS1		GPIO_19	/*!<  */
 #define PIN_NUM_CS2		GPIO_18	/*!<  */
 #define PIN_NUM_CS3		GPIO_9	/*!<  */
+#define SPI_DEVICES		3		/*!< Devices on the bus (one per CS pin) */
+#define SPI_MAX_TRANSFER	4092	/*!< Maximum transaction length in bytes */
+#define DC_UNCHANGED	(-1)	/*!< Transaction does not drive the D/C line */
 /*==================[internal data declaration]==============================*/
-spi_device_handle_t spi_1, spi_2, spi_3;
-const spi_bus_config_t bus_cfg = {
+/**
+ * @brief Driver information attached to every transaction (spi_transaction_t.user)
+ */
+typedef struct spi_slot_s {
+	struct spi_device_s *dev;	/*!< Device owning the transaction */
+	int8_t dc;					/*!< D/C level during the transaction, or DC_UNCHANGED */
+	bool internal;				/*!< Command byte of a D/C transaction: not reported to the user */
+	void *user;					/*!< User pointer of the queued transaction */
+} spi_slot_t;
+
+/**
+ * @brief Per-device state
+ */
+typedef struct spi_device_s {
+	spi_device_handle_t handle;						/*!< IDF device handle (NULL if not initialized) */
+	transfer_mode_t transfer_mode;					/*!< Blocking transfer mode */
+	void (*func_p)(void*);							/*!< Transaction end callback (SPI_INTERRUPT) */
+	void *param_p;									/*!< Transaction end callback parameter */
+	uint8_t command_bits;							/*!< Command phase length */
+	uint8_t address_bits;							/*!< Address phase length */
+	bool dc_enable;									/*!< Device uses a D/C line */
+	gpio_t dc_gpio;									/*!< D/C line */
+	slot_pool_t pool;								/*!< Free transaction descriptors */
+	SemaphoreHandle_t free_sem;						/*!< Counts free descriptors, to wait for room in the queue */
+	StaticSemaphore_t free_sem_buffer;				/*!< Storage for free_sem */
+	uint8_t pending;								/*!< Queued transactions not yet collected */
+	spi_transaction_ext_t trans[SPI_QUEUE_SIZE];	/*!< Preallocated transactions */
+	spi_slot_t slot[SPI_QUEUE_SIZE];				/*!< Driver information of each transaction */
+	spi_slot_t sync_slot;							/*!< Driver information for blocking transfers */
+} spi_device_t;
+
+static const spi_bus_config_t bus_cfg = {
     .miso_io_num = PIN_NUM_MISO,
     .mosi_io_num = PIN_NUM_MOSI,
     .sclk_io_num = PIN_NUM_CLK,
     .quadwp_io_num = -1,
     .quadhd_io_num = -1,
-    .max_transfer_sz = 4092
+    .max_transfer_sz = SPI_MAX_TRANSFER
 };
-transfer_mode_t transfer_mode_1, transfer_mode_2, transfer_mode_3;
-void (*spi_1_isr_p)(void*);	/*!<  */
-void (*spi_2_isr_p)(void*);	/*!<  */
-void (*spi_3_isr_p)(void*);	/*!<  */
-void *spi_1_user_data;	    /*!<  */
-void *spi_2_user_data;	    /*!<  */
-void *spi_3_user_data;	    /*!<  */
+static const gpio_t cs_pins[SPI_DEVICES] = {PIN_NUM_CS1, PIN_NUM_CS2, PIN_NUM_CS3};
+static spi_device_t spi_devices[SPI_DEVICES];
+static portMUX_TYPE spi_mux = portMUX_INITIALIZER_UNLOCKED;
 /*==================[internal functions declaration]=========================*/
-static void IRAM_ATTR spi_1_isr(spi_transaction_t *t){
-	spi_1_isr_p(spi_1_user_data);
-}
-static void IRAM_ATTR spi_2_isr(spi_transaction_t *t){
-	spi_2_isr_p(spi_2_user_data);
+/**
+ * @brief Called by the driver right before a transaction starts: drives the D/C line
+ */
+static void IRAM_ATTR spi_pre_cb(spi_transaction_t *t){
+	spi_slot_t *slot = t->user;
+	if(slot->dc != DC_UNCHANGED){
+		GPIOState(slot->dev->dc_gpio, slot->dc);
+	}
 }
-static void IRAM_ATTR spi_3_isr(spi_transaction_t *t){
-	spi_3_isr_p(spi_3_user_data);
+
+/**
+ * @brief Called by the driver when a transaction ends: user callback in SPI_INTERRUPT mode
+ */
+static void IRAM_ATTR spi_post_cb(spi_transaction_t *t){
+	spi_slot_t *slot = t->user;
+	spi_device_t *dev = slot->dev;
+	if(!slot->internal && (dev->transfer_mode == SPI_INTERRUPT) && (dev->func_p != NULL)){
+		dev->func_p(dev->param_p);
+	}
 }
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static TickType_t spi_ticks(uint32_t timeout_ms){
+	return (timeout_ms == SPI_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+}
+
+/**
+ * @brief Fill a transaction, enabling the command/address phases the device has configured
+ */
+static void spi_fill(spi_device_t *dev, spi_transaction_ext_t *t, uint8_t flags, uint16_t cmd, uint64_t addr,
+					 const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length){
+	memset(t, 0, sizeof(*t));
+	if(dev->command_bits){
+		t->base.flags |= SPI_TRANS_VARIABLE_CMD;
+		t->command_bits = (flags & SPI_TRANS_CMD) ? dev->command_bits : 0;
+		t->base.cmd = cmd;
+	}
+	if(dev->address_bits){
+		t->base.flags |= SPI_TRANS_VARIABLE_ADDR;
+		t->address_bits = (flags & SPI_TRANS_ADDR) ? dev->address_bits : 0;
+		t->base.addr = addr;
+	}
+	t->base.length = length * 8;	// length is in bytes, transaction length is in bits.
+	t->base.tx_buffer = tx_buffer;
+	t->base.rx_buffer = rx_buffer;
+}
 
+static void spi_transfer(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, uint32_t buffer_size){
+    spi_device_t *dev = &spi_devices[device];
+    spi_transaction_ext_t t;
+    spi_fill(dev, &t, 0, 0, 0, tx_buffer, rx_buffer, buffer_size);
+    t.base.user = &dev->sync_slot;
+    switch(dev->transfer_mode){
+        case SPI_POLLING:
+            spi_device_polling_transmit(dev->handle, &t.base);
+            break;
+        case SPI_INTERRUPT:
+            spi_device_transmit(dev->handle, &t.base);
+            break;
+    }
+}
+
+/**
+ * @brief Take a descriptor from the pool (waiting on free_sem)
+ */
+static int8_t spi_alloc(spi_device_t *dev, TickType_t ticks){
+	if(xSemaphoreTake(dev->free_sem, ticks) != pdTRUE){
+		return SLOT_POOL_NONE;
+	}
+	return SlotPoolAlloc(&dev->pool);
+}
+
+/**
+ * @brief Attach the driver information to a filled descriptor
+ */
+static spi_transaction_t *spi_prepare(spi_device_t *dev, int8_t n, int8_t dc, bool internal, void *user){
+	dev->slot[n].dc = dc;
+	dev->slot[n].internal = internal;
+	dev->slot[n].user = user;
+	dev->trans[n].base.user = &dev->slot[n];
+	return &dev->trans[n].base;
+}
+
+static void spi_release(spi_device_t *dev, spi_transaction_t *t){
+	SlotPoolRelease(&dev->pool, (spi_transaction_ext_t *)t - dev->trans);
+	xSemaphoreGive(dev->free_sem);
+}
 /*==================[external functions definition]==========================*/
 uint8_t SpiInit(spi_mcu_config_t* spi){
     static bool spi_initialized = false;
+    spi_device_t *dev = &spi_devices[spi->device];
     if(!spi_initialized){
 	    spi_bus_initialize(SPI2_HOST, &bus_cfg, SPI_DMA_CH_AUTO);
         spi_initialized = true;
+    }
+    if(dev->handle != NULL){
+        /* Reconfiguration: the device is added again with the new settings */
+        SpiDeInit(spi->device);
     }
 	spi_device_interface_config_t dev_cfg = {
-        .clock_speed_hz = spi->bitrate,     	
-        .mode = spi->clk_mode,                  
-        .queue_size = 8,                        
+        .command_bits = spi->command_bits,
+        .address_bits = spi->address_bits,
+        .clock_speed_hz = spi->bitrate,
+        .mode = spi->clk_mode,
+        .spics_io_num = cs_pins[spi->device],
+        .queue_size = SPI_QUEUE_SIZE,
+        .pre_cb = spi_pre_cb,
+        .post_cb = spi_post_cb,
     };
-    switch(spi->device){
-        case SPI_1:
-            dev_cfg.spics_io_num = PIN_NUM_CS1;
-            transfer_mode_1 = spi->transfer_mode;
-            if(transfer_mode_1 == SPI_INTERRUPT){
-                dev_cfg.post_cb = spi_1_isr;
-            } 
-            spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_1);
-            spi_1_isr_p = spi->func_p;
-            spi_1_user_data = spi->param_p;
-            break;
-        case SPI_2:
-            dev_cfg.spics_io_num = PIN_NUM_CS2;
-            if(transfer_mode_2 == SPI_INTERRUPT){
-                dev_cfg.post_cb = spi_2_isr;
-            } 
-            transfer_mode_1 = spi->transfer_mode;
-            spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_2);
-            spi_2_isr_p = spi->func_p;
-            spi_2_user_data = spi->param_p;
-            break;
-        case SPI_3:
-            dev_cfg.spics_io_num = PIN_NUM_CS3;
-            if(transfer_mode_3 == SPI_INTERRUPT){
-                dev_cfg.post_cb = spi_3_isr;
-            } 
-            transfer_mode_1 = spi->transfer_mode;
-            spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_3);
-            spi_3_isr_p = spi->func_p;
-            spi_3_user_data = spi->param_p;
-            break;
+    dev->transfer_mode = spi->transfer_mode;
+    dev->func_p = spi->func_p;
+    dev->param_p = spi->param_p;
+    dev->command_bits = spi->command_bits;
+    dev->address_bits = spi->address_bits;
+    dev->dc_enable = spi->dc_enable;
+    dev->dc_gpio = spi->dc_gpio;
+    if(dev->dc_enable){
+        GPIOInit(dev->dc_gpio, GPIO_OUTPUT);
+    }
+    dev->sync_slot.dev = dev;
+    dev->sync_slot.dc = dev->dc_enable ? 1 : DC_UNCHANGED;
+    dev->sync_slot.internal = false;
+    for(uint8_t i = 0; i < SPI_QUEUE_SIZE; i++){
+        dev->slot[i].dev = dev;
+    }
+    SlotPoolInit(&dev->pool, SPI_QUEUE_SIZE);
+    dev->free_sem = xSemaphoreCreateCountingStatic(SPI_QUEUE_SIZE, SPI_QUEUE_SIZE, &dev->free_sem_buffer);
+    dev->pending = 0;
+    if(spi_bus_add_device(SPI2_HOST, &dev_cfg, &dev->handle) != ESP_OK){
+        dev->handle = NULL;
+        return 1;
     }
     return 0;
 }
 
 void SpiRead(spi_dev_t device, uint8_t * rx_buffer, uint32_t rx_buffer_size){
-    spi_transaction_t t;
-    memset(&t, 0, sizeof(t));       // Zero out the transaction
-    t.length = rx_buffer_size * 8;  // tx_buffer_size is in bytes, transaction length is in bits.
-    t.rxlength = rx_buffer_size * 8;
-    t.rx_buffer = rx_buffer;        // Data
-    switch(device){
-        case SPI_1:
-            switch(transfer_mode_1){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_1, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_1, &t); 
-                    break;
-            }
-            break;
-        case SPI_2:
-            switch(transfer_mode_2){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_2, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_2, &t); 
-                    break;
-            }
-            break;
-        case SPI_3:
-            switch(transfer_mode_3){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_3, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_3, &t); 
-                    break;
-            }
-            break;
-    }
+    spi_transfer(device, NULL, rx_buffer, rx_buffer_size);
 }
 
 void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size){
-    spi_transaction_t t;
-    memset(&t, 0, sizeof(t));       // Zero out the transaction
-    t.length = tx_buffer_size * 8;  // tx_buffer_size is in bytes, transaction length is in bits.
-    t.tx_buffer = tx_buffer;        // Data
-    switch(device){
-        case SPI_1:
-            switch(transfer_mode_1){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_1, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_1, &t); 
-                    break;
-            }
-            break;
-        case SPI_2:
-            switch(transfer_mode_2){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_2, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_2, &t); 
-                    break;
-            }
-            break;
-        case SPI_3:
-            switch(transfer_mode_3){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_3, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_3, &t); 
-                    break;
-            }
-            break;
-    }
+    spi_transfer(device, tx_buffer, NULL, tx_buffer_size);
 }
 
 void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, uint32_t buffer_size){
-    spi_transaction_t t;
-    memset(&t, 0, sizeof(t));       // Zero out the transaction
-    t.length = buffer_size * 8;     // tx_buffer_size is in bytes, transaction length is in bits.
-    t.rxlength = buffer_size * 8;
-    t.tx_buffer = tx_buffer;        // Data
-    t.rx_buffer = rx_buffer;        
-    switch(device){
-        case SPI_1:
-            switch(transfer_mode_1){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_1, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_1, &t); 
-                    break;
-            }
-            break;
-        case SPI_2:
-            switch(transfer_mode_2){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_2, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_2, &t); 
-                    break;
-            }
-            break;
-        case SPI_3:
-            switch(transfer_mode_3){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_3, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_3, &t); 
-                    break;
-            }
-            break;
+    spi_transfer(device, tx_buffer, rx_buffer, buffer_size);
+}
+
+bool SpiQueue(spi_dev_t device, const spi_mcu_trans_t *trans, uint32_t timeout_ms){
+    spi_device_t *dev = &spi_devices[device];
+    TickType_t ticks = spi_ticks(timeout_ms);
+    spi_transaction_t *t_cmd = NULL, *t_data = NULL;
+    int8_t n_cmd = SLOT_POOL_NONE, n_data = SLOT_POOL_NONE;
+    bool dc_cmd = dev->dc_enable && (trans->flags & SPI_TRANS_CMD);
+    bool has_data = (trans->length > 0) || !dc_cmd;
+    if((dev->handle == NULL) || (trans->length > SPI_MAX_TRANSFER)){
+        return false;
+    }
+    /* Take every descriptor needed before queueing anything, so a D/C command
+     * is never left on the bus without its data */
+    if(dc_cmd && ((n_cmd = spi_alloc(dev, ticks)) == SLOT_POOL_NONE)){
+        return false;
+    }
+    if(has_data && ((n_data = spi_alloc(dev, ticks)) == SLOT_POOL_NONE)){
+        if(n_cmd != SLOT_POOL_NONE){
+            spi_release(dev, &dev->trans[n_cmd].base);
+        }
+        return false;
+    }
+    if(dc_cmd){
+        spi_fill(dev, &dev->trans[n_cmd], 0, 0, 0, NULL, NULL, 1);
+        dev->trans[n_cmd].base.flags |= SPI_TRANS_USE_TXDATA;
+        dev->trans[n_cmd].base.tx_data[0] = (uint8_t)trans->cmd;
+        t_cmd = spi_prepare(dev, n_cmd, 0, has_data, trans->user);
+    }
+    if(has_data){
+        spi_fill(dev, &dev->trans[n_data], dc_cmd ? (trans->flags & ~SPI_TRANS_CMD) : trans->flags, trans->cmd,
+                 trans->addr, trans->tx_buffer, trans->rx_buffer, trans->length);
+        t_data = spi_prepare(dev, n_data, dev->dc_enable ? 1 : DC_UNCHANGED, false, trans->user);
+    }
+    /* Queueing never waits: the driver queue has an entry for every descriptor */
+    if((t_cmd != NULL) && (spi_device_queue_trans(dev->handle, t_cmd, 0) != ESP_OK)){
+        spi_release(dev, t_cmd);
+        if(t_data != NULL){
+            spi_release(dev, t_data);
+        }
+        return false;
+    }
+    if((t_data != NULL) && (spi_device_queue_trans(dev->handle, t_data, 0) != ESP_OK)){
+        spi_release(dev, t_data);
+        if(t_cmd == NULL){
+            return false;
+        }
+        /* The command is already on the bus: it is reported in place of the data */
+        dev->slot[n_cmd].internal = false;
+    }
+    portENTER_CRITICAL(&spi_mux);
+    dev->pending++;
+    portEXIT_CRITICAL(&spi_mux);
+    return true;
+}
+
+bool SpiGetResult(spi_dev_t device, void **user, uint32_t timeout_ms){
+    spi_device_t *dev = &spi_devices[device];
+    TickType_t ticks = spi_ticks(timeout_ms);
+    spi_transaction_t *t;
+    spi_slot_t *slot;
+    bool internal;
+    void *slot_user;
+    if((dev->handle == NULL) || (dev->pending == 0)){
+        return false;
     }
+    do{
+        if(spi_device_get_trans_result(dev->handle, &t, ticks) != ESP_OK){
+            return false;
+        }
+        /* Once released, the slot can be taken (and overwritten) by another task */
+        slot = t->user;
+        internal = slot->internal;
+        slot_user = slot->user;
+        spi_release(dev, t);
+    } while(internal);
+    if(user != NULL){
+        *user = slot_user;
+    }
+    portENTER_CRITICAL(&spi_mux);
+    dev->pending--;
+    portEXIT_CRITICAL(&spi_mux);
+    return true;
+}
+
+uint8_t SpiPending(spi_dev_t device){
+    return spi_devices[device].pending;
+}
+
+void SpiFlush(spi_dev_t device){
+    while(SpiGetResult(device, NULL, SPI_WAIT_FOREVER));
 }
 
 uint8_t SpiDeInit(spi_dev_t device){
+    spi_device_t *dev = &spi_devices[device];
+    if(dev->handle == NULL){
+        return 0;
+    }
+    SpiFlush(device);
+    spi_bus_remove_device(dev->handle);
+    dev->handle = NULL;
+    vSemaphoreDelete(dev->free_sem);
     return 0;
 }
 
@@ -10,26 +10,50 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
 #include "uart_mcu.h"
 #include "gpio_mcu.h"
 #include "driver/uart.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/task.h"
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
 #define UART_CONN_TX        GPIO_18         /*!<  */
 #define UART_CONN_RX        GPIO_19         /*!<  */
-#define TX_BUFFER_SIZE      256             /*!<  */
-#define RX_BUFFER_SIZE      256             /*!<  */
+#define TX_BUFFER_SIZE      1024            /*!<  */
+#define RX_BUFFER_SIZE      1024            /*!<  */
 #define EVENT_QUEUE_SIZE    16              /*!<  */
 #define READ_TIMEOUT        100             /*!<  */
+#define UART_PORT_QTY       2               /*!< Number of ports handled by this driver */
+#define STREAM_TASK_STACK   2048            /*!< Stack size of stream mode tasks */
+#define STREAM_TASK_PRIO    12              /*!< Priority of stream mode tasks */
+#define RX_CHUNK_SIZE       128             /*!< Bytes read from the driver per call when assembling messages */
+/**
+ * @brief Stream mode state for one serial port
+ */
+typedef struct {
+    uart_port_t uart_num;                   /*!< IDF port number */
+    ring_buffer_t tx;                       /*!< TX ring buffer */
+    ring_buffer_t rx;                       /*!< RX ring buffer */
+    TaskHandle_t tx_task;                   /*!< Task draining the TX ring buffer (NULL if TX stream disabled) */
+    TaskHandle_t rx_task;                   /*!< Task filling the RX ring buffer (NULL if RX stream disabled) */
+} uart_stream_t;
 /*==================[internal data declaration]==============================*/
 void (*uart_pc_isr_p)(void*);	            /*!<  */
 void (*uart_conn_isr_p)(void*);	            /*!<  */
 void *uart_pc_user_data;	                /*!<  */
 void *uart_conn_user_data;	                /*!<  */
+static packet_assembler_t *uart_pc_assembler;   /*!< Assembler for UART_PC received data */
+static packet_assembler_t *uart_conn_assembler; /*!< Assembler for UART_CONNECTOR received data */
+static uart_stats_t uart_pc_stats;          /*!< Error counters for UART_PC */
+static uart_stats_t uart_conn_stats;        /*!< Error counters for UART_CONNECTOR */
 static QueueHandle_t uart_pc_queue;         /*!<  */
 static QueueHandle_t uart_conn_queue;       /*!<  */
+static uart_stream_t uart_stream[UART_PORT_QTY] = {
+    {.uart_num = UART_NUM_0},
+    {.uart_num = UART_NUM_1},
+};
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -37,6 +61,111 @@ static QueueHandle_t uart_conn_queue;       /*!<  */
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Hands the largest contiguous blocks of the TX ring buffer to the driver
+ */
+static void uart_stream_tx_task(void *pvParameters){
+    uart_stream_t *stream = pvParameters;
+    const uint8_t *block;
+    uint32_t len;
+    int sent;
+    while(1){
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while((len = RingBufferPeek(&stream->tx, &block)) > 0){
+            sent = uart_write_bytes(stream->uart_num, block, len);
+            if(sent > 0){
+                RingBufferConsume(&stream->tx, sent);
+            } else{
+                /* Driver not installed yet */
+                vTaskDelay(1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Moves received data from the driver straight into the RX ring buffer
+ */
+static void uart_stream_rx_task(void *pvParameters){
+    uart_stream_t *stream = pvParameters;
+    uint8_t *block;
+    uint32_t len;
+    size_t pending;
+    int received;
+    while(1){
+        len = RingBufferReserve(&stream->rx, &block);
+        if(len == 0){
+            /* RX ring buffer full, wait for the application to read it */
+            vTaskDelay(1);
+            continue;
+        }
+        /* Block until at least one byte arrives, then take everything buffered */
+        received = uart_read_bytes(stream->uart_num, block, 1, portMAX_DELAY);
+        if(received <= 0){
+            vTaskDelay(1);
+            continue;
+        }
+        if((len > 1) && (uart_get_buffered_data_len(stream->uart_num, &pending) == ESP_OK) && (pending > 0)){
+            if(pending > len - 1){
+                pending = len - 1;
+            }
+            received += uart_read_bytes(stream->uart_num, block + 1, pending, 0);
+        }
+        RingBufferCommit(&stream->rx, received);
+    }
+}
+
+/**
+ * @brief Reads a whole UART_DATA event in blocks and feeds it to an assembler
+ */
+static void uart_rx_assemble(uart_port_t uart_num, packet_assembler_t *assembler, size_t size){
+    uint8_t chunk[RX_CHUNK_SIZE];
+    int len;
+    while(size > 0){
+        len = uart_read_bytes(uart_num, chunk, (size < RX_CHUNK_SIZE) ? size : RX_CHUNK_SIZE, 0);
+        if(len <= 0){
+            break;
+        }
+        AssemblerFeed(assembler, chunk, len);
+        size -= len;
+    }
+}
+
+/**
+ * @brief Handles reception errors: counts them and discards corrupted data
+ *
+ * The assembler (if any) also drops the partial message: the rest of it was flushed.
+ */
+static void uart_rx_error(uart_port_t uart_num, QueueHandle_t queue, packet_assembler_t *assembler,
+                          uart_event_type_t type, uart_stats_t *stats){
+    switch(type){
+        case UART_FIFO_OVF:
+            stats->fifo_overflows++;
+            uart_flush_input(uart_num);
+            xQueueReset(queue);
+            if(assembler != NULL){
+                AssemblerReset(assembler);
+            }
+            break;
+        case UART_BUFFER_FULL:
+            stats->buffer_full++;
+            uart_flush_input(uart_num);
+            xQueueReset(queue);
+            if(assembler != NULL){
+                AssemblerReset(assembler);
+            }
+            break;
+        case UART_FRAME_ERR:
+            stats->frame_errors++;
+            break;
+        case UART_PARITY_ERR:
+            stats->parity_errors++;
+            break;
+        default:
+            break;
+    }
+}
+
 static void uart_pc_event_task(void *pvParameters){
     uart_event_t event;
     uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_pc_queue, 0);
@@ -45,17 +174,19 @@ static void uart_pc_event_task(void *pvParameters){
         if (xQueueReceive(uart_pc_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
             switch(event.type) {
                 case UART_DATA:
-                    uart_pc_isr_p(uart_pc_user_data);
+                    if(uart_pc_assembler != NULL){
+                        uart_rx_assemble(UART_NUM_0, uart_pc_assembler, event.size);
+                    } else if(uart_pc_isr_p != NULL){
+                        uart_pc_isr_p(uart_pc_user_data);
+                    }
                     break;
                 case UART_BREAK:
                     break;
                 case UART_BUFFER_FULL:
-                    break;
                 case UART_FIFO_OVF:
-                    break;
                 case UART_FRAME_ERR:
-                    break;
                 case UART_PARITY_ERR:
+                    uart_rx_error(UART_NUM_0, uart_pc_queue, uart_pc_assembler, event.type, &uart_pc_stats);
                     break;
                 case UART_DATA_BREAK:
                     break;
@@ -78,17 +209,19 @@ static void uart_conn_event_task(void *pvParameters){
         if(xQueueReceive(uart_conn_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
             switch(event.type) {
                 case UART_DATA:
-                    uart_conn_isr_p(uart_conn_user_data);
+                    if(uart_conn_assembler != NULL){
+                        uart_rx_assemble(UART_NUM_1, uart_conn_assembler, event.size);
+                    } else if(uart_conn_isr_p != NULL){
+                        uart_conn_isr_p(uart_conn_user_data);
+                    }
                     break;
                 case UART_BREAK:
                     break;
                 case UART_BUFFER_FULL:
-                    break;
                 case UART_FIFO_OVF:
-                    break;
                 case UART_FRAME_ERR:
-                    break;
                 case UART_PARITY_ERR:
+                    uart_rx_error(UART_NUM_1, uart_conn_queue, uart_conn_assembler, event.type, &uart_conn_stats);
                     break;
                 case UART_DATA_BREAK:
                     break;
@@ -102,6 +235,40 @@ static void uart_conn_event_task(void *pvParameters){
         }
     }
 }
+/**
+ * @brief Whether the event task of the port reads the received data (callback or assembler)
+ */
+static bool uart_event_reader(uart_mcu_port_t port){
+    if(port == UART_PC){
+        return (uart_pc_isr_p != NULL) || (uart_pc_assembler != NULL);
+    }
+    return (uart_conn_isr_p != NULL) || (uart_conn_assembler != NULL);
+}
+
+/**
+ * @brief Blocking send. With TX stream enabled the data goes through the ring buffer,
+ * so it can not land in the middle of a record queued by UartStreamSend() or UartSendVector()
+ */
+static void uart_send(uart_mcu_port_t port, const char *data, uint32_t nbytes){
+    uart_stream_t *stream = &uart_stream[port];
+    uint32_t sent;
+    if(stream->tx_task == NULL){
+        uart_write_bytes(stream->uart_num, data, nbytes);
+        return;
+    }
+    while(nbytes > 0){
+        sent = RingBufferWrite(&stream->tx, data, nbytes);
+        if(sent > 0){
+            xTaskNotifyGive(stream->tx_task);
+        }
+        data += sent;
+        nbytes -= sent;
+        if(nbytes > 0){
+            /* Ring full: wait for the TX task, as uart_write_bytes() waits for the driver */
+            vTaskDelay(1);
+        }
+    }
+}
 /*==================[external functions definition]==========================*/
 
 void UartInit(serial_config_t *port_config){
@@ -117,10 +284,11 @@ void UartInit(serial_config_t *port_config){
         case UART_PC:
             uart_param_config(UART_NUM_0, &uart_config);
             uart_set_pin(UART_NUM_0, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-            if(port_config->func_p != UART_NO_INT){
+            if((port_config->func_p != UART_NO_INT) || (port_config->assembler_p != NULL)){
                 uart_pc_isr_p = port_config->func_p;
-                uart_pc_queue = port_config->param_p;
-                xTaskCreate(uart_pc_event_task, "uart_pc_event_task", 2048, NULL, 12, 0);
+                uart_pc_user_data = port_config->param_p;
+                uart_pc_assembler = port_config->assembler_p;
+                xTaskCreate(uart_pc_event_task, "uart_pc_event_task", 3072, NULL, 12, 0);
             }else{
                 uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
             }
@@ -128,10 +296,11 @@ void UartInit(serial_config_t *port_config){
         case UART_CONNECTOR:
             uart_param_config(UART_NUM_1, &uart_config);
             uart_set_pin(UART_NUM_1, UART_CONN_TX, UART_CONN_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-            if(port_config->func_p != UART_NO_INT){
+            if((port_config->func_p != UART_NO_INT) || (port_config->assembler_p != NULL)){
                 uart_conn_isr_p = port_config->func_p;
-                uart_conn_queue = port_config->param_p;
-                xTaskCreate(uart_conn_event_task, "uart_conn_event_task", 2048, NULL, 12, NULL);
+                uart_conn_user_data = port_config->param_p;
+                uart_conn_assembler = port_config->assembler_p;
+                xTaskCreate(uart_conn_event_task, "uart_conn_event_task", 3072, NULL, 12, NULL);
             }else{
                 uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
             }
@@ -139,6 +308,17 @@ void UartInit(serial_config_t *port_config){
     }
 }
 
+void UartGetStats(uart_mcu_port_t port, uart_stats_t *stats){
+    switch(port){
+        case UART_PC:
+            *stats = uart_pc_stats;
+            break;
+        case UART_CONNECTOR:
+            *stats = uart_conn_stats;
+            break;
+    }
+}
+
 uint8_t UartReadByte(uart_mcu_port_t port, uint8_t* data){
     uart_port_t uart_num = UART_NUM_0;
     uint16_t length = 0;
@@ -158,9 +338,9 @@ uint8_t UartReadByte(uart_mcu_port_t port, uint8_t* data){
     }
 }
 
-uint8_t UartReadBuffer(uart_mcu_port_t port, uint8_t* data, uint16_t nbytes){
+uint8_t UartReadBuffer(uart_mcu_port_t port, uint8_t* data, uint32_t nbytes){
     uart_port_t uart_num = UART_NUM_0;
-    uint16_t length = 0;
+    int length = 0;
     switch(port){
         case UART_PC:
                 uart_num = UART_NUM_0;
@@ -178,45 +358,87 @@ uint8_t UartReadBuffer(uart_mcu_port_t port, uint8_t* data, uint16_t nbytes){
 }
 
 void UartSendByte(uart_mcu_port_t port, const char *data){
-    uart_port_t uart_num = UART_NUM_0;
-    switch(port){
-        case UART_PC:
-                uart_num = UART_NUM_0;
-            break;
-        case UART_CONNECTOR:
-                uart_num = UART_NUM_1;
-            break;
-    }
-    uart_tx_chars(uart_num, data, 1);
+    uart_send(port, data, 1);
 }
 
 void UartSendString(uart_mcu_port_t port, const char *msg){
-    uart_port_t uart_num = UART_NUM_0;
-    switch(port){
-        case UART_PC:
-                uart_num = UART_NUM_0;
-            break;
-        case UART_CONNECTOR:
-                uart_num = UART_NUM_1;
-            break;
+    uart_send(port, msg, strlen(msg));
+}
+
+void UartSendBuffer(uart_mcu_port_t port, const char *data, uint32_t nbytes){
+    uart_send(port, data, nbytes);
+}
+
+uint32_t UartSendVector(uart_mcu_port_t port, const uart_iovec_t *iov, uint8_t count){
+    uart_stream_t *stream = &uart_stream[port];
+    uint32_t sent = 0;
+    if(stream->tx_task != NULL){
+        sent = RingBufferWriteVector(&stream->tx, iov, count);
+        if(sent > 0){
+            xTaskNotifyGive(stream->tx_task);
+        }
+    } else{
+        for(uint8_t i = 0; i < count; i++){
+            if(uart_write_bytes(stream->uart_num, iov[i].data, iov[i].len) > 0){
+                sent += iov[i].len;
+            }
+        }
     }
-	while(*msg != 0){
-        uart_tx_chars(uart_num, msg, 1);
-		msg++;
-	}
+    return sent;
 }
 
-void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes){
-    uart_port_t uart_num = UART_NUM_0;
-    switch(port){
-        case UART_PC:
-                uart_num = UART_NUM_0;
-            break;
-        case UART_CONNECTOR:
-                uart_num = UART_NUM_1;
-            break;
+uint8_t UartStreamInit(uart_mcu_port_t port, uint8_t *tx_buf, uint32_t tx_size, uint8_t *rx_buf, uint32_t rx_size){
+    uart_stream_t *stream = &uart_stream[port];
+    /* The event task already reads the port: two readers would split the received bytes */
+    if((rx_buf != NULL) && uart_event_reader(port)){
+        return false;
+    }
+    if(tx_buf != NULL){
+        if(!RingBufferInit(&stream->tx, tx_buf, tx_size)){
+            return false;
+        }
+    }
+    if(rx_buf != NULL){
+        if(!RingBufferInit(&stream->rx, rx_buf, rx_size)){
+            return false;
+        }
+    }
+    if((tx_buf != NULL) && (stream->tx_task == NULL)){
+        xTaskCreate(uart_stream_tx_task, "uart_stream_tx", STREAM_TASK_STACK, stream, STREAM_TASK_PRIO, &stream->tx_task);
+    }
+    if((rx_buf != NULL) && (stream->rx_task == NULL)){
+        xTaskCreate(uart_stream_rx_task, "uart_stream_rx", STREAM_TASK_STACK, stream, STREAM_TASK_PRIO, &stream->rx_task);
+    }
+    return true;
+}
+
+uint32_t UartStreamSend(uart_mcu_port_t port, const void *data, uint32_t nbytes){
+    uart_stream_t *stream = &uart_stream[port];
+    uint32_t sent;
+    if(stream->tx_task == NULL){
+        return 0;
+    }
+    sent = RingBufferWrite(&stream->tx, data, nbytes);
+    if(sent > 0){
+        xTaskNotifyGive(stream->tx_task);
+    }
+    return sent;
+}
+
+uint32_t UartStreamRead(uart_mcu_port_t port, uint8_t *data, uint32_t nbytes){
+    uart_stream_t *stream = &uart_stream[port];
+    if(stream->rx_task == NULL){
+        return 0;
+    }
+    return RingBufferRead(&stream->rx, data, nbytes);
+}
+
+uint32_t UartStreamAvailable(uart_mcu_port_t port){
+    uart_stream_t *stream = &uart_stream[port];
+    if(stream->rx_task == NULL){
+        return 0;
     }
-    uart_tx_chars(uart_num, data, nbytes);
+    return RingBufferUsed(&stream->rx);
 }
 
 uint8_t* UartItoa(uint32_t val, uint8_t base){
@@ -0,0 +1,83 @@
+#ifndef BCD_FRAME_H
+#define BCD_FRAME_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup BCD_Frame BCD Frame
+ ** @{ */
+
+/** \brief Encoding of numbers for displays with BCD inputs.
+ *
+ * Displays such as the ITS-E0803 receive each digit as a 4 bit BCD code on
+ * four GPIOs. This module precomputes, for every code, the port value
+ * (bit n: GPIO_n) that sets the four data pins, so a digit is written with a
+ * single port access and no bit shuffling. A number is encoded as a frame:
+ * one port value per digit, most significant digit first.
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define BCD_FRAME_BITS		4		/*!< Data pins per digit */
+#define BCD_FRAME_CODES		16		/*!< Codes of a digit (0 to 9: numbers, 10 to 15: driver dependent) */
+#define BCD_FRAME_BLANK		0x0F	/*!< Code of a blank digit (CD4543 and similar decoders) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Port values of the codes
+ */
+typedef struct {
+	uint32_t pattern[BCD_FRAME_CODES];	/*!< Port value of each code */
+	uint32_t mask;						/*!< Port bits of the data pins */
+} bcd_frame_table_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Compute the port value of every code
+ *
+ * @param table Pointer to the table
+ * @param pins GPIO numbers of the data pins (bit 0 of the code first)
+ */
+void BcdFrameTableInit(bcd_frame_table_t *table, const uint8_t pins[BCD_FRAME_BITS]);
+
+/**
+ * @brief Encode a number
+ *
+ * @param table Pointer to the table
+ * @param value Number to encode
+ * @param frame Array of port values, one per digit (most significant first)
+ * @param digits Number of digits
+ * @return true Number encoded
+ * @return false The number has more digits than the frame (frame unchanged)
+ */
+bool BcdFrameEncode(const bcd_frame_table_t *table, uint32_t value, uint32_t *frame, uint8_t digits);
+
+/**
+ * @brief Fill a frame with blank digits
+ *
+ * @param table Pointer to the table
+ * @param frame Array of port values, one per digit
+ * @param digits Number of digits
+ */
+void BcdFrameBlank(const bcd_frame_table_t *table, uint32_t *frame, uint8_t digits);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* BCD_FRAME_H */
+
+/*==================[end of file]============================================*/
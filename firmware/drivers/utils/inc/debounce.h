@@ -0,0 +1,89 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Debounce Debounce
+ ** @{ */
+
+/** \brief Switch debouncing and gesture detection.
+ *
+ * DebounceUpdate() is called once per tick with the raw switch level. An
+ * integrator counts up while the switch reads pressed and down while it reads
+ * released; the debounced state only changes when the count reaches one of
+ * its limits, so bounces shorter than integrator_max ticks are ignored.
+ *
+ * On top of the debounced state it detects:
+ * - press and release,
+ * - long press: the switch is held for long_ticks (reported once per press),
+ * - double click: a press less than double_ticks after the release of a short
+ *   press (the press is reported too).
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define DEBOUNCE_EVT_PRESS		0x01	/*!< Switch pressed */
+#define DEBOUNCE_EVT_RELEASE	0x02	/*!< Switch released */
+#define DEBOUNCE_EVT_LONG		0x04	/*!< Switch held for long_ticks */
+#define DEBOUNCE_EVT_DOUBLE		0x08	/*!< Second press of a double click */
+/*==================[typedef]================================================*/
+/**
+ * @brief Debounce times (in ticks)
+ */
+typedef struct {
+	uint8_t integrator_max;		/*!< Ticks of stable level needed to change state */
+	uint16_t long_ticks;		/*!< Hold time of a long press */
+	uint16_t double_ticks;		/*!< Maximum time from release to the second press of a double click */
+} debounce_config_t;
+
+/**
+ * @brief Switch state
+ */
+typedef struct {
+	uint8_t integrator;			/*!< Integrator count (0 to integrator_max) */
+	bool pressed;				/*!< Debounced state */
+	bool long_sent;				/*!< Long press already reported for this press */
+	bool click;					/*!< Short press released, waiting for a second one */
+	uint16_t ticks;				/*!< Ticks since the last state change */
+} debounce_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Switch state initialization (released)
+ *
+ * @param sw Pointer to switch state
+ */
+void DebounceInit(debounce_t *sw);
+
+/**
+ * @brief Process one tick
+ *
+ * @param sw Pointer to switch state
+ * @param config Pointer to debounce times
+ * @param raw Raw switch level (true: pressed)
+ * @return uint8_t Events detected in this tick (DEBOUNCE_EVT_x bits, 0 if none)
+ */
+uint8_t DebounceUpdate(debounce_t *sw, const debounce_config_t *config, bool raw);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* DEBOUNCE_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,85 @@
+#ifndef FAST_IO_MAP_H
+#define FAST_IO_MAP_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Fast_IO_Map Fast IO Map
+ ** @{ */
+
+/** \brief Pin mapping of a fast IO bundle.
+ *
+ * A bundle groups up to FAST_IO_MAP_MAX pins that are accessed as a single
+ * value: bit i of the bundle value is the pin in position i of the list given
+ * at initialization. This module validates the list and converts values
+ * between the bundle order and the port order used by GPIOWriteMask() and
+ * GPIOReadPort() (bit n: GPIO_n).
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define FAST_IO_MAP_MAX		8		/*!< Maximum number of pins in a bundle (dedicated GPIO channels) */
+#define FAST_IO_MAP_PINS	32		/*!< Pins are numbered 0 to FAST_IO_MAP_PINS - 1 */
+/*==================[typedef]================================================*/
+/**
+ * @brief Bundle pin map
+ */
+typedef struct {
+	uint8_t pins[FAST_IO_MAP_MAX];	/*!< Pin of each bundle bit */
+	uint8_t qty;					/*!< Number of pins */
+	uint8_t mask;					/*!< Valid bundle bits ((1 << qty) - 1) */
+	uint32_t port_mask;				/*!< Port bits of the pins in the bundle */
+} fast_io_map_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Pin map initialization
+ *
+ * @param map Pointer to map struct
+ * @param pins Array of pin numbers, bundle bit 0 first
+ * @param qty Number of pins (1 to FAST_IO_MAP_MAX)
+ * @param valid_mask Pins that can be mapped (bit n: pin n)
+ * @return true Map initialized
+ * @return false Invalid quantity, pin outside valid_mask or repeated pin (the map is not modified)
+ */
+bool FastIoMapInit(fast_io_map_t *map, const uint8_t *pins, uint8_t qty, uint32_t valid_mask);
+
+/**
+ * @brief Convert a port value (bit n: pin n) to a bundle value
+ *
+ * @param map Pointer to map struct
+ * @param port Port value (bits of pins outside the bundle are ignored)
+ * @return uint8_t Bundle value
+ */
+uint8_t FastIoMapFromPort(const fast_io_map_t *map, uint32_t port);
+
+/**
+ * @brief Convert a bundle value to a port value (bit n: pin n)
+ *
+ * @param map Pointer to map struct
+ * @param value Bundle value
+ * @return uint32_t Port value (only bits of pins in the bundle can be set)
+ */
+uint32_t FastIoMapToPort(const fast_io_map_t *map, uint8_t value);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FAST_IO_MAP_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,131 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Format Format
+ ** @{ */
+
+/** \brief Re-entrant number to text conversion.
+ *
+ * Every function writes into a buffer supplied by the caller and returns the
+ * number of characters written (the string is always terminated with '\0',
+ * which is not counted). Nothing is allocated and there is no shared static
+ * state, so the functions can be called from several tasks at the same time.
+ *
+ * Decimal conversion emits two digits per division using a digit-pair table,
+ * and float conversion only uses integer arithmetic after one scaling
+ * multiply, which matters on the FPU-less ESP32-C6.
+ *
+ * @note Buffer sizes: FORMAT_U32_LEN / FORMAT_I32_LEN are enough for any 32 bit value.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdarg.h>
+/*==================[macros]=================================================*/
+#define FORMAT_U32_LEN		11		/*!< Buffer size for any uint32_t in decimal (including '\0') */
+#define FORMAT_I32_LEN		12		/*!< Buffer size for any int32_t in decimal (including '\0') */
+#define FORMAT_HEX_LEN		9		/*!< Buffer size for any uint32_t in hexadecimal (including '\0') */
+#define FORMAT_MAX_DECIMALS	9		/*!< Maximum number of decimals for float and fixed-point conversion */
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Convert an unsigned integer to decimal text
+ *
+ * @param buf Array to store the string (at least FORMAT_U32_LEN bytes)
+ * @param val Value to convert
+ * @return uint8_t Number of characters written
+ */
+uint8_t FormatU32(char *buf, uint32_t val);
+
+/**
+ * @brief Convert a signed integer to decimal text
+ *
+ * @param buf Array to store the string (at least FORMAT_I32_LEN bytes)
+ * @param val Value to convert
+ * @return uint8_t Number of characters written
+ */
+uint8_t FormatI32(char *buf, int32_t val);
+
+/**
+ * @brief Convert an unsigned integer to hexadecimal text (lower case, no prefix)
+ *
+ * @param buf Array to store the string (at least FORMAT_HEX_LEN bytes)
+ * @param val Value to convert
+ * @param min_digits Minimum number of digits (left padded with '0', 0 or 1 for no padding)
+ * @return uint8_t Number of characters written
+ */
+uint8_t FormatHex(char *buf, uint32_t val, uint8_t min_digits);
+
+/**
+ * @brief Convert a fixed-point value to decimal text
+ *
+ * Example: FormatFixed(buf, -12345, 2) writes "-123.45".
+ *
+ * @param buf Array to store the string (at least FORMAT_I32_LEN + 2 bytes)
+ * @param val Value multiplied by 10^decimals
+ * @param decimals Number of decimal digits of val (0 to FORMAT_MAX_DECIMALS)
+ * @return uint8_t Number of characters written
+ */
+uint8_t FormatFixed(char *buf, int32_t val, uint8_t decimals);
+
+/**
+ * @brief Convert a float to decimal text with a fixed number of decimals (rounded half away from zero)
+ *
+ * @note Values whose integer part does not fit in 32 bits are written as "ovf",
+ * and NaN/infinity as "nan"/"inf".
+ *
+ * @param buf Array to store the string (at least FORMAT_I32_LEN + FORMAT_MAX_DECIMALS + 1 bytes)
+ * @param val Value to convert
+ * @param decimals Number of decimals (0 to FORMAT_MAX_DECIMALS)
+ * @return uint8_t Number of characters written
+ */
+uint8_t FormatFloat(char *buf, float val, uint8_t decimals);
+
+/**
+ * @brief Minimal snprintf() that does not allocate memory
+ *
+ * Supported conversions: %d %i %u %x %X %c %s %f %%, with optional '-' and '0'
+ * flags, field width and precision (number of decimals for %f, default 2).
+ * The 'l' length modifier is accepted and ignored (long is 32 bit).
+ *
+ * @param buf Array to store the string
+ * @param size Size of buf
+ * @param fmt Format string
+ * @param ... Arguments
+ * @return uint32_t Number of characters written (output is truncated to size - 1)
+ */
+uint32_t FormatPrint(char *buf, uint32_t size, const char *fmt, ...);
+
+/**
+ * @brief va_list version of FormatPrint()
+ *
+ * @param buf Array to store the string
+ * @param size Size of buf
+ * @param fmt Format string
+ * @param args Arguments
+ * @return uint32_t Number of characters written
+ */
+uint32_t FormatPrintV(char *buf, uint32_t size, const char *fmt, va_list args);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FORMAT_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,160 @@
+#ifndef HID_SCHEDULER_H
+#define HID_SCHEDULER_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup HID_Scheduler HID Scheduler
+ ** @{ */
+
+/** \brief Queue of HID input reports waiting to be sent.
+ *
+ * Reports are queued by the application without blocking and taken by the
+ * driver once per connection interval:
+ *
+ * - Keyboard reports keep their order: every key press is queued together
+ *   with its release, so press/release pairs are never reordered or merged.
+ * - Mouse movements are coalesced: a new delta is added to the newest queued
+ *   report if it is a mouse report with the same buttons, so a burst of small
+ *   movements between two connection events becomes a single report.
+ * - Text is converted to key press/release sequences (US layout).
+ *
+ * @note The scheduler is not thread safe: the caller must serialize access
+ * (the BLE HID driver uses a critical section).
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define HID_SCHED_REPORT_MAX	8		/*!< Longest report (keyboard) */
+#define HID_SCHED_KEYS_MAX		6		/*!< Keys pressed at the same time in a keyboard report */
+#define HID_SCHED_KEYBOARD_LEN	8		/*!< Keyboard report: modifiers, reserved, 6 keys */
+#define HID_SCHED_MOUSE_LEN		5		/*!< Mouse report: buttons, X, Y, wheel, AC pan */
+
+#define HID_SCHED_BUTTON_LEFT	0x01	/*!< Mouse button bits */
+#define HID_SCHED_BUTTON_RIGHT	0x02
+#define HID_SCHED_BUTTON_MIDDLE	0x04
+/*==================[typedef]================================================*/
+/**
+ * @brief Report types
+ */
+typedef enum {
+	HID_SCHED_KEYBOARD,			/*!< Keyboard input report */
+	HID_SCHED_MOUSE,			/*!< Mouse input report */
+} hid_sched_type_t;
+
+/**
+ * @brief Queued report
+ */
+typedef struct {
+	uint8_t type;							/*!< hid_sched_type_t */
+	uint8_t len;							/*!< Report length */
+	uint8_t data[HID_SCHED_REPORT_MAX];		/*!< Report bytes */
+} hid_sched_report_t;
+
+/**
+ * @brief Scheduler control struct
+ */
+typedef struct {
+	hid_sched_report_t *reports;	/*!< Storage */
+	uint16_t size;					/*!< Number of reports in storage */
+	uint16_t head;					/*!< Index of the oldest report */
+	uint16_t count;					/*!< Reports queued */
+	uint32_t coalesced;				/*!< Mouse reports merged into a queued one (statistics) */
+} hid_scheduler_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Scheduler initialization (empty queue)
+ *
+ * @param sched Pointer to scheduler control struct
+ * @param storage Array of reports used as queue
+ * @param size Number of reports in storage
+ */
+void HidSchedulerInit(hid_scheduler_t *sched, hid_sched_report_t *storage, uint16_t size);
+
+/**
+ * @brief Discard every queued report
+ *
+ * @param sched Pointer to scheduler control struct
+ */
+void HidSchedulerClear(hid_scheduler_t *sched);
+
+/**
+ * @brief Number of reports queued
+ *
+ * @param sched Pointer to scheduler control struct
+ * @return uint16_t Reports waiting to be sent
+ */
+uint16_t HidSchedulerPending(const hid_scheduler_t *sched);
+
+/**
+ * @brief Queue a key press and its release
+ *
+ * @param sched Pointer to scheduler control struct
+ * @param modifiers Modifier keys mask
+ * @param keys Array of key usage IDs
+ * @param num_keys Number of keys (up to HID_SCHED_KEYS_MAX)
+ * @return true Both reports queued
+ * @return false Not enough room (nothing queued) or too many keys
+ */
+bool HidSchedulerKeyboard(hid_scheduler_t *sched, uint8_t modifiers, const uint8_t *keys, uint8_t num_keys);
+
+/**
+ * @brief Queue a mouse movement, coalescing it with the newest queued report if possible
+ *
+ * The report range is -127 to 127: -128 is sent as -127, and a movement whose
+ * sum with the newest report would leave that range is queued as a new report.
+ *
+ * @param sched Pointer to scheduler control struct
+ * @param buttons Pressed buttons (HID_SCHED_BUTTON_x bits)
+ * @param delta_x X relative movement
+ * @param delta_y Y relative movement
+ * @param wheel Wheel relative movement
+ * @return true Movement queued or merged
+ * @return false Queue full
+ */
+bool HidSchedulerMouse(hid_scheduler_t *sched, uint8_t buttons, int8_t delta_x, int8_t delta_y, int8_t wheel);
+
+/**
+ * @brief Queue the key sequence that types a text
+ *
+ * Supports printable ASCII plus '\\n', '\\t' and '\\b' (US keyboard layout);
+ * other characters are skipped.
+ *
+ * @param sched Pointer to scheduler control struct
+ * @param text '\\0' terminated text
+ * @return uint32_t Number of characters of text consumed (less than its length if the queue got full)
+ */
+uint32_t HidSchedulerType(hid_scheduler_t *sched, const char *text);
+
+/**
+ * @brief Take the oldest queued report
+ *
+ * @param sched Pointer to scheduler control struct
+ * @param report Pointer where the report is copied
+ * @return true Report copied and removed from the queue
+ * @return false Queue empty
+ */
+bool HidSchedulerNext(hid_scheduler_t *sched, hid_sched_report_t *report);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* HID_SCHEDULER_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,111 @@
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Motion_Profile Motion Profile
+ ** @{ */
+
+/** \brief Rest-to-rest motion profiles with velocity, acceleration and jerk limits.
+ *
+ * MotionProfilePlan() computes the fastest move between two values that
+ * starts and ends at rest and respects the given limits:
+ *
+ * - jerk limit > 0: S-curve profile (7 segments: jerk +J, 0, -J, cruise, -J, 0, +J),
+ *   the acceleration changes linearly and there are no acceleration steps,
+ * - jerk limit = 0: trapezoidal velocity profile (acceleration steps).
+ *
+ * When the distance is too short, the cruise velocity (and the acceleration)
+ * is reduced. MotionProfileSample() evaluates the profile at any time with
+ * closed-form polynomials, so there is no integration error.
+ *
+ * Several profiles can be synchronized (coordinated moves) by stretching them
+ * to the longest duration with MotionProfileStretch(): the profile is scaled
+ * in time, which also scales down its velocity, acceleration and jerk.
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define MOTION_PROFILE_SEGMENTS		7		/*!< Segments of an S-curve profile */
+/*==================[typedef]================================================*/
+/**
+ * @brief Motion profile
+ */
+typedef struct {
+	float start;							/*!< Initial value */
+	float target;							/*!< Final value */
+	float sign;								/*!< Direction of the move (1 or -1) */
+	float scale;							/*!< Time scale (1: fastest profile, < 1: stretched) */
+	float duration;							/*!< Duration of the fastest profile (s) */
+	float t[MOTION_PROFILE_SEGMENTS];		/*!< Start time of each segment (s) */
+	float p[MOTION_PROFILE_SEGMENTS];		/*!< Distance at the start of each segment */
+	float v[MOTION_PROFILE_SEGMENTS];		/*!< Velocity at the start of each segment */
+	float a[MOTION_PROFILE_SEGMENTS];		/*!< Acceleration at the start of each segment */
+	float j[MOTION_PROFILE_SEGMENTS];		/*!< Jerk of each segment */
+} motion_profile_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Plan the fastest rest-to-rest move from start to target
+ *
+ * @param prof Pointer to profile
+ * @param start Initial value
+ * @param target Final value
+ * @param max_vel Velocity limit (> 0)
+ * @param max_acc Acceleration limit (> 0)
+ * @param max_jerk Jerk limit (0: trapezoidal profile)
+ * @return true Profile planned
+ * @return false Invalid limits
+ */
+bool MotionProfilePlan(motion_profile_t *prof, float start, float target, float max_vel, float max_acc, float max_jerk);
+
+/**
+ * @brief Duration of a profile
+ *
+ * @param prof Pointer to profile
+ * @return float Duration (s)
+ */
+float MotionProfileDuration(const motion_profile_t *prof);
+
+/**
+ * @brief Make a profile last longer (same shape, scaled in time)
+ *
+ * @param prof Pointer to profile
+ * @param duration New duration (s), not shorter than the fastest one
+ * @return true Profile stretched
+ * @return false duration shorter than the fastest profile (profile unchanged)
+ */
+bool MotionProfileStretch(motion_profile_t *prof, float duration);
+
+/**
+ * @brief Evaluate a profile
+ *
+ * @param prof Pointer to profile
+ * @param time Time from the start of the move (s); the target is returned after the end
+ * @param pos Pointer where the value is stored
+ * @param vel Pointer where the velocity is stored (can be NULL)
+ */
+void MotionProfileSample(const motion_profile_t *prof, float time, float *pos, float *vel);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* MOTION_PROFILE_H */
+
+/*==================[end of file]============================================*/
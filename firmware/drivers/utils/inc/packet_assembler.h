@@ -0,0 +1,123 @@
+#ifndef PACKET_ASSEMBLER_H
+#define PACKET_ASSEMBLER_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Packet_Assembler Packet Assembler
+ ** @{ */
+
+/** \brief Reassembles a received byte stream into lines or packets.
+ *
+ * Bytes are fed in blocks of any size (as they come out of the serial
+ * driver) and a callback is invoked once per complete message:
+ *
+ * - ASSEMBLER_LINE: text lines ended with a delimiter (usually '\\n'). A '\\r'
+ *   before the delimiter is removed and empty lines are ignored. The line is
+ *   also '\\0' terminated in the buffer.
+ * - ASSEMBLER_LENGTH_PREFIXED: binary packets with the layout
+ *   [sync][length LSB][length MSB][payload]. Bytes before a sync byte are
+ *   discarded, so the assembler recovers from lost or corrupted bytes.
+ *
+ * Messages that do not fit in the buffer are dropped and counted. A length
+ * prefixed packet that does not fit is dropped right after its header: the
+ * sync byte is searched again from there, so a corrupted length only loses
+ * that packet.
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define ASSEMBLER_DEFAULT_SYNC	0xA5	/*!< Suggested sync byte for length prefixed packets */
+/*==================[typedef]================================================*/
+/**
+ * @brief Message framing
+ */
+typedef enum {
+	ASSEMBLER_LINE,				/*!< Text lines ended with a delimiter */
+	ASSEMBLER_LENGTH_PREFIXED,	/*!< Sync byte + 16 bit little endian length + payload */
+} assembler_mode_t;
+
+/**
+ * @brief Prototype of callback function called with each complete message
+ *
+ * @param data Pointer to message (without delimiter or header)
+ * @param len Message length in bytes
+ * @param param Pointer to callback function parameters
+ */
+typedef void (*assembler_func_t)(const uint8_t *data, uint16_t len, void *param);
+
+/**
+ * @brief Assembler state
+ *
+ * @note Fill the configuration fields and call AssemblerInit() before use.
+ */
+typedef struct {
+	/* Configuration */
+	assembler_mode_t mode;		/*!< Message framing */
+	uint8_t marker;				/*!< Line delimiter (ASSEMBLER_LINE) or sync byte (ASSEMBLER_LENGTH_PREFIXED) */
+	uint8_t *buf;				/*!< Buffer for the message being assembled */
+	uint16_t size;				/*!< Buffer size (maximum message length, + 2 in line mode for '\r' and '\0') */
+	assembler_func_t func_p;	/*!< Callback function */
+	void *param_p;				/*!< Pointer to callback function parameters */
+	/* Internal state */
+	uint8_t state;				/*!< Parser state */
+	uint16_t len;				/*!< Bytes stored in buf */
+	uint16_t expected;			/*!< Payload length of the packet being received */
+	/* Statistics */
+	uint32_t messages;			/*!< Messages delivered */
+	uint32_t overflows;			/*!< Messages dropped because they did not fit in buf */
+	uint32_t discarded;			/*!< Bytes discarded while looking for a sync byte */
+} packet_assembler_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Reset parser state and statistics
+ *
+ * @param assembler Pointer to assembler with configuration fields set
+ */
+void AssemblerInit(packet_assembler_t *assembler);
+
+/**
+ * @brief Discard the message being assembled, keeping the statistics
+ *
+ * @note Call it when the received stream is interrupted (e.g. the serial
+ * driver flushes its input after an overflow), so the next message is not
+ * glued to the remains of the previous one.
+ *
+ * @param assembler Pointer to assembler
+ */
+void AssemblerReset(packet_assembler_t *assembler);
+
+/**
+ * @brief Feed received bytes to the assembler
+ *
+ * @note The callback is called from this function once for every message
+ * completed by data.
+ *
+ * @param assembler Pointer to assembler
+ * @param data Received bytes
+ * @param len Number of bytes
+ */
+void AssemblerFeed(packet_assembler_t *assembler, const uint8_t *data, uint32_t len);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* PACKET_ASSEMBLER_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,112 @@
+#ifndef PWM_ALLOC_H
+#define PWM_ALLOC_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup PWM_Alloc PWM Alloc
+ ** @{ */
+
+/** \brief Assignment of PWM channels to shared timers.
+ *
+ * Every PWM channel needs a timer that sets its frequency, and a timer can
+ * drive any number of channels of the same frequency. This module keeps track
+ * of which timer each channel uses: channels with the same frequency share a
+ * timer, and a timer is only taken when no timer with that frequency exists.
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define PWM_ALLOC_TIMERS	4		/*!< Number of timers */
+#define PWM_ALLOC_CHANNELS	6		/*!< Number of channels */
+#define PWM_ALLOC_NONE		(-1)	/*!< No timer */
+/*==================[typedef]================================================*/
+/**
+ * @brief Timer state
+ */
+typedef struct {
+	uint32_t freq;			/*!< Configured frequency (Hz) */
+	uint8_t users;			/*!< Channels using the timer (0: free) */
+} pwm_alloc_timer_t;
+
+/**
+ * @brief Allocator state
+ */
+typedef struct {
+	pwm_alloc_timer_t timers[PWM_ALLOC_TIMERS];		/*!< Timers */
+	int8_t channel_timer[PWM_ALLOC_CHANNELS];		/*!< Timer of each channel, PWM_ALLOC_NONE if not attached */
+} pwm_alloc_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Allocator initialization (every timer free, no channel attached)
+ *
+ * @param alloc Pointer to allocator state
+ */
+void PwmAllocInit(pwm_alloc_t *alloc);
+
+/**
+ * @brief Attach a channel to a timer running at a frequency
+ *
+ * If the channel was attached to another timer it is detached first. When the
+ * channel was the only user of its timer, that timer can be reused with the
+ * new frequency.
+ *
+ * @param alloc Pointer to allocator state
+ * @param channel Channel number
+ * @param freq Frequency (Hz)
+ * @param configure Set to true if the returned timer has to be configured
+ * with freq (it was free or changes its frequency), false if it already runs at freq
+ * @return int8_t Timer number, or PWM_ALLOC_NONE if every timer is in use
+ * with other frequencies (the channel keeps its previous timer)
+ */
+int8_t PwmAllocAttach(pwm_alloc_t *alloc, uint8_t channel, uint32_t freq, bool *configure);
+
+/**
+ * @brief Detach a channel from its timer (the timer is freed when it has no users left)
+ *
+ * @param alloc Pointer to allocator state
+ * @param channel Channel number
+ * @return int8_t Timer the channel was using, PWM_ALLOC_NONE if it was not attached
+ */
+int8_t PwmAllocDetach(pwm_alloc_t *alloc, uint8_t channel);
+
+/**
+ * @brief Timer of a channel
+ *
+ * @param alloc Pointer to allocator state
+ * @param channel Channel number
+ * @return int8_t Timer number, PWM_ALLOC_NONE if the channel is not attached
+ */
+int8_t PwmAllocTimer(const pwm_alloc_t *alloc, uint8_t channel);
+
+/**
+ * @brief Number of channels using a timer
+ *
+ * @param alloc Pointer to allocator state
+ * @param timer Timer number
+ * @return uint8_t Channels attached to the timer (0: free)
+ */
+uint8_t PwmAllocUsers(const pwm_alloc_t *alloc, uint8_t timer);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* PWM_ALLOC_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,170 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Ring_Buffer Ring Buffer
+ ** @{ */
+
+/** \brief Lock-free single producer / single consumer byte ring buffer.
+ *
+ * The buffer is safe to use between one producer and one consumer running in
+ * different tasks (or a task and an ISR) without any lock. Indexes are free
+ * running 32 bit counters, so storage sizes up to 2 GB are supported.
+ *
+ * Besides the copying read/write functions, the buffer exposes its storage as
+ * contiguous blocks (RingBufferPeek()/RingBufferConsume() and
+ * RingBufferReserve()/RingBufferCommit()) so a driver can hand the memory
+ * directly to a peripheral without intermediate copies.
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Ring buffer control struct
+ */
+typedef struct {
+	uint8_t *data;				/*!< Storage array */
+	uint32_t size;				/*!< Storage size (power of two) */
+	uint32_t mask;				/*!< size - 1 */
+	atomic_uint_least32_t head;	/*!< Write counter (only modified by the producer) */
+	atomic_uint_least32_t tail;	/*!< Read counter (only modified by the consumer) */
+} ring_buffer_t;
+
+/**
+ * @brief Memory segment used by scatter-gather writes
+ */
+typedef struct {
+	const void *data;			/*!< Pointer to segment data */
+	uint32_t len;				/*!< Segment length in bytes */
+} ring_buffer_iovec_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Ring buffer initialization
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @param storage Array used as storage
+ * @param size Storage size in bytes (must be a power of two)
+ * @return true Ring buffer initialized
+ * @return false Size is not a power of two
+ */
+bool RingBufferInit(ring_buffer_t *rb, uint8_t *storage, uint32_t size);
+
+/**
+ * @brief Discard all stored data
+ *
+ * @note Must only be called when neither producer nor consumer are active.
+ *
+ * @param rb Pointer to ring buffer control struct
+ */
+void RingBufferReset(ring_buffer_t *rb);
+
+/**
+ * @brief Number of bytes available for reading
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @return uint32_t Stored bytes
+ */
+uint32_t RingBufferUsed(const ring_buffer_t *rb);
+
+/**
+ * @brief Number of bytes available for writing
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @return uint32_t Free bytes
+ */
+uint32_t RingBufferFree(const ring_buffer_t *rb);
+
+/**
+ * @brief Copy data into the buffer (producer side)
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @param data Data to be stored
+ * @param len Number of bytes to store
+ * @return uint32_t Number of bytes accepted (may be less than len if buffer is full)
+ */
+uint32_t RingBufferWrite(ring_buffer_t *rb, const void *data, uint32_t len);
+
+/**
+ * @brief Copy several memory segments into the buffer as a single record (producer side)
+ *
+ * @note The record is published all at once: either every segment is stored
+ * or nothing is.
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @param iov Array of segments
+ * @param count Number of segments
+ * @return uint32_t Number of bytes stored (0 if the record does not fit)
+ */
+uint32_t RingBufferWriteVector(ring_buffer_t *rb, const ring_buffer_iovec_t *iov, uint32_t count);
+
+/**
+ * @brief Copy data out of the buffer (consumer side)
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @param data Array where data will be stored
+ * @param len Maximum number of bytes to read
+ * @return uint32_t Number of bytes read
+ */
+uint32_t RingBufferRead(ring_buffer_t *rb, void *data, uint32_t len);
+
+/**
+ * @brief Get the largest contiguous block available for reading (consumer side)
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @param block Pointer where the block address will be stored
+ * @return uint32_t Block length in bytes (0 if buffer is empty)
+ */
+uint32_t RingBufferPeek(const ring_buffer_t *rb, const uint8_t **block);
+
+/**
+ * @brief Release bytes previously obtained with RingBufferPeek() (consumer side)
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @param len Number of bytes to release
+ */
+void RingBufferConsume(ring_buffer_t *rb, uint32_t len);
+
+/**
+ * @brief Get the largest contiguous block available for writing (producer side)
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @param block Pointer where the block address will be stored
+ * @return uint32_t Block length in bytes (0 if buffer is full)
+ */
+uint32_t RingBufferReserve(ring_buffer_t *rb, uint8_t **block);
+
+/**
+ * @brief Publish bytes written in a block obtained with RingBufferReserve() (producer side)
+ *
+ * @param rb Pointer to ring buffer control struct
+ * @param len Number of bytes written
+ */
+void RingBufferCommit(ring_buffer_t *rb, uint32_t len);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* RING_BUFFER_H */
+
+/*==================[end of file]============================================*/
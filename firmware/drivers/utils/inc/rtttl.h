@@ -0,0 +1,194 @@
+#ifndef RTTTL_H
+#define RTTTL_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup RTTTL RTTTL
+ ** @{ */
+
+/** \brief RTTTL (Ring Tone Text Transfer Language) melody compiler.
+ *
+ * Converts a melody such as "Name:d=4,o=5,b=160:c.6,e6,8a" into an array of
+ * notes (frequency and duration in ms) that can be played without parsing
+ * text, e.g. with BuzzerPlay() (see buzzer.h). A melody is usually compiled
+ * once at start-up:
+ *
+ * @code
+ * static rtttl_note_t simpsons[64];
+ * uint16_t len = RtttlCompile(songSimpsons, simpsons, 64);
+ * @endcode
+ *
+ * RtttlBegin() and RtttlNext() give the notes one by one instead, without a
+ * buffer.
+ *
+ * Octaves 3 to 7 are supported. The dot of a dotted note can be written
+ * before or after the octave ("c.6" or "c6.").
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+/* Note frequency (in Hz) */
+#define NOTE_B0  31
+#define NOTE_C1  33
+#define NOTE_CS1 35
+#define NOTE_D1  37
+#define NOTE_DS1 39
+#define NOTE_E1  41
+#define NOTE_F1  44
+#define NOTE_FS1 46
+#define NOTE_G1  49
+#define NOTE_GS1 52
+#define NOTE_A1  55
+#define NOTE_AS1 58
+#define NOTE_B1  62
+#define NOTE_C2  65
+#define NOTE_CS2 69
+#define NOTE_D2  73
+#define NOTE_DS2 78
+#define NOTE_E2  82
+#define NOTE_F2  87
+#define NOTE_FS2 93
+#define NOTE_G2  98
+#define NOTE_GS2 104
+#define NOTE_A2  110
+#define NOTE_AS2 117
+#define NOTE_B2  123
+#define NOTE_C3  131
+#define NOTE_CS3 139
+#define NOTE_D3  147
+#define NOTE_DS3 156
+#define NOTE_E3  165
+#define NOTE_F3  175
+#define NOTE_FS3 185
+#define NOTE_G3  196
+#define NOTE_GS3 208
+#define NOTE_A3  220
+#define NOTE_AS3 233
+#define NOTE_B3  247
+#define NOTE_C4  262
+#define NOTE_CS4 277
+#define NOTE_D4  294
+#define NOTE_DS4 311
+#define NOTE_E4  330
+#define NOTE_F4  349
+#define NOTE_FS4 370
+#define NOTE_G4  392
+#define NOTE_GS4 415
+#define NOTE_A4  440
+#define NOTE_AS4 466
+#define NOTE_B4  494
+#define NOTE_C5  523
+#define NOTE_CS5 554
+#define NOTE_D5  587
+#define NOTE_DS5 622
+#define NOTE_E5  659
+#define NOTE_F5  698
+#define NOTE_FS5 740
+#define NOTE_G5  784
+#define NOTE_GS5 831
+#define NOTE_A5  880
+#define NOTE_AS5 932
+#define NOTE_B5  988
+#define NOTE_C6  1047
+#define NOTE_CS6 1109
+#define NOTE_D6  1175
+#define NOTE_DS6 1245
+#define NOTE_E6  1319
+#define NOTE_F6  1397
+#define NOTE_FS6 1480
+#define NOTE_G6  1568
+#define NOTE_GS6 1661
+#define NOTE_A6  1760
+#define NOTE_AS6 1865
+#define NOTE_B6  1976
+#define NOTE_C7  2093
+#define NOTE_CS7 2217
+#define NOTE_D7  2349
+#define NOTE_DS7 2489
+#define NOTE_E7  2637
+#define NOTE_F7  2794
+#define NOTE_FS7 2960
+#define NOTE_G7  3136
+#define NOTE_GS7 3322
+#define NOTE_A7  3520
+#define NOTE_AS7 3729
+#define NOTE_B7  3951
+#define NOTE_C8  4186
+#define NOTE_CS8 4435
+#define NOTE_D8  4699
+#define NOTE_DS8 4978
+
+#define RTTTL_PAUSE	0		/*!< Frequency of a pause */
+/*==================[typedef]================================================*/
+/**
+ * @brief Compiled note
+ */
+typedef struct {
+	uint16_t freq;			/*!< Frequency (Hz), RTTTL_PAUSE for a pause */
+	uint16_t duration;		/*!< Duration (ms) */
+} rtttl_note_t;
+
+/**
+ * @brief Parser state
+ */
+typedef struct {
+	const char *next;		/*!< Next character to parse */
+	uint8_t default_dur;	/*!< Default duration (1, 2, 4 ... 32) */
+	uint8_t default_oct;	/*!< Default octave */
+	uint32_t wholenote;		/*!< Duration of a whole note (ms) */
+	bool error;				/*!< Syntax error found */
+} rtttl_parser_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Parse the name and the defaults section of a melody
+ *
+ * @param parser Pointer to parser state
+ * @param melody String with the RTTTL melody (must be kept until the last RtttlNext())
+ * @return true Ready for RtttlNext()
+ * @return false Invalid header
+ */
+bool RtttlBegin(rtttl_parser_t *parser, const char *melody);
+
+/**
+ * @brief Parse the next note of a melody
+ *
+ * @param parser Pointer to parser state (see RtttlBegin())
+ * @param note Pointer to the note
+ * @return true Note parsed
+ * @return false End of the melody, or syntax error (parser->error is set)
+ */
+bool RtttlNext(rtttl_parser_t *parser, rtttl_note_t *note);
+
+/**
+ * @brief Compile a whole melody
+ *
+ * @param melody String with the RTTTL melody
+ * @param notes Array for the notes, NULL to get the number of notes
+ * @param max Size of notes
+ * @return uint16_t Number of notes, 0 if the melody is invalid or does not fit in notes
+ */
+uint16_t RtttlCompile(const char *melody, rtttl_note_t *notes, uint16_t max);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* RTTTL_H */
+
+/*==================[end of file]============================================*/
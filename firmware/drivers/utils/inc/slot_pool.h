@@ -0,0 +1,88 @@
+#ifndef SLOT_POOL_H
+#define SLOT_POOL_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Slot_Pool Slot Pool
+ ** @{ */
+
+/** \brief Lock-free allocator for a fixed array of preallocated objects.
+ *
+ * The pool only hands out indexes (0 to size - 1) into an array owned by the
+ * caller, e.g. the transaction descriptors a driver keeps queued on a
+ * peripheral. Allocation and release are single atomic operations on a bit
+ * mask, so slots can be taken in one task and given back in another (or in an
+ * ISR) without locks and without dynamic memory.
+ *
+ * @note This module has no ESP-IDF dependencies and can be compiled on a host.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+/*==================[macros]=================================================*/
+#define SLOT_POOL_MAX		32		/*!< Maximum number of slots in a pool */
+#define SLOT_POOL_NONE		(-1)	/*!< Returned by SlotPoolAlloc() when the pool is exhausted */
+/*==================[typedef]================================================*/
+/**
+ * @brief Slot pool control struct
+ */
+typedef struct {
+	atomic_uint_least32_t free;	/*!< Bit n set: slot n is free */
+	uint8_t size;				/*!< Number of slots */
+} slot_pool_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Slot pool initialization (all slots free)
+ *
+ * @param pool Pointer to pool control struct
+ * @param size Number of slots (1 to SLOT_POOL_MAX)
+ * @return true Pool initialized
+ * @return false Invalid size
+ */
+bool SlotPoolInit(slot_pool_t *pool, uint8_t size);
+
+/**
+ * @brief Take a free slot
+ *
+ * @param pool Pointer to pool control struct
+ * @return int8_t Slot index, or SLOT_POOL_NONE if every slot is in use
+ */
+int8_t SlotPoolAlloc(slot_pool_t *pool);
+
+/**
+ * @brief Give back a slot taken with SlotPoolAlloc()
+ *
+ * @param pool Pointer to pool control struct
+ * @param slot Slot index
+ */
+void SlotPoolRelease(slot_pool_t *pool, int8_t slot);
+
+/**
+ * @brief Number of slots currently in use
+ *
+ * @param pool Pointer to pool control struct
+ * @return uint8_t Slots in use
+ */
+uint8_t SlotPoolUsed(const slot_pool_t *pool);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* SLOT_POOL_H */
+
+/*==================[end of file]============================================*/
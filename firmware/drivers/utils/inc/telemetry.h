@@ -0,0 +1,204 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Telemetry Telemetry
+ ** @{ */
+
+/** \brief Binary telemetry framing for serial links (UART and BLE).
+ *
+ * Several typed channels (arrays of uint16_t, int16_t or float samples) are
+ * packed in one packet, protected with a CRC-16 and framed with COBS, so the
+ * 0x00 byte only appears as frame delimiter and a receiver can resynchronize
+ * after any lost byte.
+ *
+ * Packet layout before COBS encoding (multi-byte fields are little endian):
+ *
+ * | Field        | Size     | Description                                      |
+ * |:------------:|:--------:|:-------------------------------------------------|
+ * | seq          | 1        | Packet sequence number                           |
+ * | timestamp    | 4        | Time of the first sample of every channel (us)   |
+ * | n_channels   | 1        | Number of channel blocks                         |
+ * | channel id   | 1        | \                                                |
+ * | type         | 1        |  \ repeated                                      |
+ * | period       | 4        |  / n_channels times (period in us between        |
+ * | count        | 2        | /  samples, count samples of type)               |
+ * | samples      | count*sz |                                                  |
+ * | crc          | 2        | CRC-16/CCITT-FALSE of all previous bytes         |
+ *
+ * The encoded frame ends with a 0x00 delimiter and can be sent as is with
+ * UartSendBuffer() or BleSendBuffer().
+ *
+ * @note This module has no ESP-IDF dependencies and is shared with the host
+ * decoder (firmware/tools/telemetry_decoder).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define TELEMETRY_HEADER_SIZE		6	/*!< seq + timestamp + n_channels */
+#define TELEMETRY_CHANNEL_SIZE		8	/*!< Channel block header size */
+#define TELEMETRY_CRC_SIZE			2	/*!< CRC size */
+/**
+ * @brief Worst case size of a COBS frame (including delimiter) for a raw packet of n bytes
+ */
+#define TELEMETRY_FRAME_SIZE(n)		((n) + ((n) / 254) + 2)
+/*==================[typedef]================================================*/
+/**
+ * @brief Sample types
+ */
+typedef enum {
+	TELEMETRY_U16 = 0,		/*!< uint16_t samples */
+	TELEMETRY_I16,			/*!< int16_t samples */
+	TELEMETRY_F32,			/*!< float samples */
+} telemetry_type_t;
+
+/**
+ * @brief Packet under construction
+ */
+typedef struct {
+	uint8_t *buf;			/*!< Raw packet buffer */
+	uint16_t size;			/*!< Raw packet buffer size */
+	uint16_t len;			/*!< Bytes used */
+	bool overflow;			/*!< A channel did not fit in the buffer */
+} telemetry_packet_t;
+
+/**
+ * @brief Decoded packet header
+ */
+typedef struct {
+	uint8_t seq;			/*!< Sequence number */
+	uint32_t timestamp;		/*!< Timestamp of first sample (us) */
+	uint8_t n_channels;		/*!< Number of channels */
+} telemetry_header_t;
+
+/**
+ * @brief Decoded channel block
+ */
+typedef struct {
+	uint8_t id;				/*!< Channel identifier */
+	telemetry_type_t type;	/*!< Sample type */
+	uint32_t period;		/*!< Period between samples (us) */
+	uint16_t count;			/*!< Number of samples */
+	const uint8_t *samples;	/*!< Little endian samples (use TelemetrySample() to read them) */
+} telemetry_channel_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Start a new packet
+ *
+ * @param pkt Pointer to packet struct
+ * @param buf Raw packet buffer
+ * @param size Raw packet buffer size
+ * @param seq Sequence number
+ * @param timestamp Time of the first sample (us)
+ */
+void TelemetryBegin(telemetry_packet_t *pkt, uint8_t *buf, uint16_t size, uint8_t seq, uint32_t timestamp);
+
+/**
+ * @brief Append a channel of samples to a packet
+ *
+ * @param pkt Pointer to packet struct
+ * @param id Channel identifier
+ * @param type Sample type
+ * @param period Period between samples (us)
+ * @param samples Array of samples of the given type
+ * @param count Number of samples
+ * @return true Channel added
+ * @return false Not enough room in the packet buffer
+ */
+bool TelemetryAddChannel(telemetry_packet_t *pkt, uint8_t id, telemetry_type_t type, uint32_t period, const void *samples, uint16_t count);
+
+/**
+ * @brief Close a packet and encode it as a COBS frame
+ *
+ * @param pkt Pointer to packet struct
+ * @param frame Array to store the frame (see TELEMETRY_FRAME_SIZE())
+ * @param frame_size Size of frame array
+ * @return uint16_t Frame length including the 0x00 delimiter (0 on error)
+ */
+uint16_t TelemetryEnd(telemetry_packet_t *pkt, uint8_t *frame, uint16_t frame_size);
+
+/**
+ * @brief COBS encode a block of data
+ *
+ * @param src Data to encode
+ * @param len Number of bytes to encode
+ * @param dst Array to store encoded data (at least len + len / 254 + 1 bytes)
+ * @return uint16_t Encoded length (without delimiter)
+ */
+uint16_t TelemetryCobsEncode(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+/**
+ * @brief COBS decode a frame (without delimiter)
+ *
+ * @note src and dst may be the same array.
+ *
+ * @param src Encoded data
+ * @param len Encoded length
+ * @param dst Array to store decoded data (at least len bytes)
+ * @return int32_t Decoded length (-1 if frame is malformed)
+ */
+int32_t TelemetryCobsDecode(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+/**
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ *
+ * @param data Data array
+ * @param len Number of bytes
+ * @return uint16_t CRC value
+ */
+uint16_t TelemetryCrc16(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Validate a decoded packet and read its header
+ *
+ * @param raw Decoded packet (output of TelemetryCobsDecode())
+ * @param len Decoded length
+ * @param header Pointer to store the header
+ * @return true Packet is valid (CRC and channel layout)
+ * @return false Packet is corrupted
+ */
+bool TelemetryParse(const uint8_t *raw, uint16_t len, telemetry_header_t *header);
+
+/**
+ * @brief Iterate the channels of a packet validated with TelemetryParse()
+ *
+ * @param raw Decoded packet
+ * @param len Decoded length
+ * @param offset Iteration state (must be 0 on the first call)
+ * @param channel Pointer to store the channel
+ * @return true Channel read
+ * @return false No more channels
+ */
+bool TelemetryNextChannel(const uint8_t *raw, uint16_t len, uint16_t *offset, telemetry_channel_t *channel);
+
+/**
+ * @brief Read one sample of a channel as float
+ *
+ * @param channel Pointer to channel
+ * @param index Sample index
+ * @return float Sample value
+ */
+float TelemetrySample(const telemetry_channel_t *channel, uint16_t index);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* TELEMETRY_H */
+
+/*==================[end of file]============================================*/
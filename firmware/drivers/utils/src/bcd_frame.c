@@ -0,0 +1,69 @@
+/**
+ * @file bcd_frame.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "bcd_frame.h"
+/*==================[macros and definitions]=================================*/
+#define BCD_FRAME_MAX_DIGITS	10		/* Digits of a uint32_t */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void BcdFrameTableInit(bcd_frame_table_t *table, const uint8_t pins[BCD_FRAME_BITS]){
+	uint8_t code, bit;
+	table->mask = 0;
+	for(bit = 0; bit < BCD_FRAME_BITS; bit++){
+		table->mask |= 1UL << pins[bit];
+	}
+	for(code = 0; code < BCD_FRAME_CODES; code++){
+		table->pattern[code] = 0;
+		for(bit = 0; bit < BCD_FRAME_BITS; bit++){
+			if(code & (1 << bit)){
+				table->pattern[code] |= 1UL << pins[bit];
+			}
+		}
+	}
+}
+
+bool BcdFrameEncode(const bcd_frame_table_t *table, uint32_t value, uint32_t *frame, uint8_t digits){
+	uint32_t encoded[BCD_FRAME_MAX_DIGITS];
+	uint8_t i;
+	if((digits == 0) || (digits > BCD_FRAME_MAX_DIGITS)){
+		return false;
+	}
+	for(i = digits; i > 0; i--){
+		encoded[i - 1] = table->pattern[value % 10];
+		value /= 10;
+	}
+	if(value != 0){
+		return false;
+	}
+	for(i = 0; i < digits; i++){
+		frame[i] = encoded[i];
+	}
+	return true;
+}
+
+void BcdFrameBlank(const bcd_frame_table_t *table, uint32_t *frame, uint8_t digits){
+	uint8_t i;
+	for(i = 0; i < digits; i++){
+		frame[i] = table->pattern[BCD_FRAME_BLANK];
+	}
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,74 @@
+/**
+ * @file debounce.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "debounce.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void DebounceInit(debounce_t *sw){
+	sw->integrator = 0;
+	sw->pressed = false;
+	sw->long_sent = false;
+	sw->click = false;
+	sw->ticks = 0;
+}
+
+uint8_t DebounceUpdate(debounce_t *sw, const debounce_config_t *config, bool raw){
+	uint8_t events = 0;
+	if(sw->ticks < UINT16_MAX){
+		sw->ticks++;
+	}
+	if(raw){
+		if(sw->integrator < config->integrator_max){
+			sw->integrator++;
+		}
+	} else if(sw->integrator > 0){
+		sw->integrator--;
+	}
+
+	if(!sw->pressed && (sw->integrator >= config->integrator_max)){
+		sw->pressed = true;
+		sw->long_sent = false;
+		events |= DEBOUNCE_EVT_PRESS;
+		if(sw->click && (sw->ticks <= config->double_ticks)){
+			events |= DEBOUNCE_EVT_DOUBLE;
+			sw->click = false;
+		} else{
+			sw->click = true;
+		}
+		sw->ticks = 0;
+	} else if(sw->pressed && (sw->integrator == 0)){
+		sw->pressed = false;
+		events |= DEBOUNCE_EVT_RELEASE;
+		/* Only a short press can be the first click of a double click */
+		if(sw->long_sent){
+			sw->click = false;
+		}
+		sw->ticks = 0;
+	} else if(sw->pressed && !sw->long_sent && (sw->ticks >= config->long_ticks)){
+		sw->long_sent = true;
+		events |= DEBOUNCE_EVT_LONG;
+	}
+	return events;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,70 @@
+/**
+ * @file fast_io_map.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "fast_io_map.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+bool FastIoMapInit(fast_io_map_t *map, const uint8_t *pins, uint8_t qty, uint32_t valid_mask){
+	uint32_t port_mask = 0;
+	uint8_t i;
+	if((qty == 0) || (qty > FAST_IO_MAP_MAX)){
+		return false;
+	}
+	for(i = 0; i < qty; i++){
+		if((pins[i] >= FAST_IO_MAP_PINS) || !(valid_mask & (1UL << pins[i])) || (port_mask & (1UL << pins[i]))){
+			return false;
+		}
+		port_mask |= 1UL << pins[i];
+	}
+	/* The map only changes once the whole list is valid */
+	memcpy(map->pins, pins, qty);
+	map->qty = qty;
+	map->mask = (uint8_t)((1U << qty) - 1);
+	map->port_mask = port_mask;
+	return true;
+}
+
+uint8_t FastIoMapFromPort(const fast_io_map_t *map, uint32_t port){
+	uint8_t value = 0;
+	uint8_t i;
+	for(i = 0; i < map->qty; i++){
+		if(port & (1UL << map->pins[i])){
+			value |= 1U << i;
+		}
+	}
+	return value;
+}
+
+uint32_t FastIoMapToPort(const fast_io_map_t *map, uint8_t value){
+	uint32_t port = 0;
+	uint8_t i;
+	for(i = 0; i < map->qty; i++){
+		if(value & (1U << i)){
+			port |= 1UL << map->pins[i];
+		}
+	}
+	return port;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,329 @@
+/**
+ * @file format.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "format.h"
+#include <stdbool.h>
+#include <stddef.h>
+/*==================[macros and definitions]=================================*/
+#define FLOAT_U32_LIMIT		4294967296.0f	/*!< First float whose integer part does not fit in 32 bits */
+#define FRAC_SCALE			18446744073709551616.0f	/*!< 2^64 */
+#define PRINT_DEFAULT_DEC	2				/*!< Default %f precision */
+#define PRINT_TMP_LEN		(FORMAT_I32_LEN + FORMAT_MAX_DECIMALS + 1)
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+/**
+ * @brief "00" to "99" digit pairs
+ */
+static const char digit_pairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const char hex_digits[] = "0123456789abcdef";
+
+static const uint32_t pow10_table[FORMAT_MAX_DECIMALS + 1] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Number of decimal digits of val
+ */
+static uint8_t count_digits(uint32_t val){
+	if(val < 100000){
+		if(val < 100){
+			return (val < 10) ? 1 : 2;
+		}
+		return (val < 1000) ? 3 : (val < 10000) ? 4 : 5;
+	}
+	if(val < 10000000){
+		return (val < 1000000) ? 6 : 7;
+	}
+	return (val < 100000000) ? 8 : (val < 1000000000) ? 9 : 10;
+}
+
+/**
+ * @brief Write exactly digits decimal characters of val (left padded with '0'), without terminator
+ */
+static void write_digits(char *buf, uint32_t val, uint8_t digits){
+	char *p = buf + digits;
+	while(digits >= 2){
+		uint32_t pair = (val % 100) * 2;
+		val /= 100;
+		*--p = digit_pairs[pair + 1];
+		*--p = digit_pairs[pair];
+		digits -= 2;
+	}
+	if(digits){
+		*--p = '0' + (val % 10);
+	}
+}
+
+static uint8_t copy_str(char *buf, const char *str){
+	uint8_t n = 0;
+	while(str[n]){
+		buf[n] = str[n];
+		n++;
+	}
+	buf[n] = '\0';
+	return n;
+}
+/*==================[external functions definition]==========================*/
+uint8_t FormatU32(char *buf, uint32_t val){
+	uint8_t n = count_digits(val);
+	char *p = buf + n;
+	*p = '\0';
+	while(val >= 100){
+		uint32_t pair = (val % 100) * 2;
+		val /= 100;
+		*--p = digit_pairs[pair + 1];
+		*--p = digit_pairs[pair];
+	}
+	if(val >= 10){
+		*--p = digit_pairs[val * 2 + 1];
+		*--p = digit_pairs[val * 2];
+	} else{
+		*--p = '0' + val;
+	}
+	return n;
+}
+
+uint8_t FormatI32(char *buf, int32_t val){
+	if(val < 0){
+		buf[0] = '-';
+		return 1 + FormatU32(buf + 1, 0u - (uint32_t)val);
+	}
+	return FormatU32(buf, val);
+}
+
+uint8_t FormatHex(char *buf, uint32_t val, uint8_t min_digits){
+	uint8_t n = 1;
+	while((n < 8) && (val >> (4 * n))){
+		n++;
+	}
+	if(min_digits > 8){
+		min_digits = 8;
+	}
+	if(n < min_digits){
+		n = min_digits;
+	}
+	for(int8_t i = n - 1; i >= 0; i--){
+		buf[i] = hex_digits[val & 0xF];
+		val >>= 4;
+	}
+	buf[n] = '\0';
+	return n;
+}
+
+uint8_t FormatFixed(char *buf, int32_t val, uint8_t decimals){
+	uint32_t mag = (val < 0) ? 0u - (uint32_t)val : (uint32_t)val;
+	uint8_t n = 0;
+	if(decimals > FORMAT_MAX_DECIMALS){
+		decimals = FORMAT_MAX_DECIMALS;
+	}
+	if(val < 0){
+		buf[n++] = '-';
+	}
+	n += FormatU32(&buf[n], mag / pow10_table[decimals]);
+	if(decimals){
+		buf[n++] = '.';
+		write_digits(&buf[n], mag % pow10_table[decimals], decimals);
+		n += decimals;
+		buf[n] = '\0';
+	}
+	return n;
+}
+
+uint8_t FormatFloat(char *buf, float val, uint8_t decimals){
+	uint32_t int_part, frac_part, scale;
+	uint64_t frac, mid;
+	bool neg = false;
+	uint8_t n = 0;
+	if(val != val){
+		return copy_str(buf, "nan");
+	}
+	if(decimals > FORMAT_MAX_DECIMALS){
+		decimals = FORMAT_MAX_DECIMALS;
+	}
+	if(val < 0){
+		neg = true;
+		val = -val;
+	}
+	if(val >= FLOAT_U32_LIMIT){
+		if(neg){
+			buf[n++] = '-';
+		}
+		return n + copy_str(&buf[n], ((val - val) != 0) ? "inf" : "ovf");
+	}
+	scale = pow10_table[decimals];
+	int_part = (uint32_t)val;
+	/* The fraction is exact as a 0.64 fixed point number (scaling by 2^64 does not round) */
+	frac = (uint64_t)((val - (float)int_part) * FRAC_SCALE);
+	/* frac_part = (frac * scale + 2^63) >> 64, in 32 x 32 bit products */
+	mid = (uint64_t)(uint32_t)(frac >> 32) * scale + (((uint64_t)(uint32_t)frac * scale) >> 32);
+	frac_part = (uint32_t)((mid + (1ULL << 31)) >> 32);
+	if(frac_part >= scale){
+		frac_part -= scale;
+		int_part++;
+	}
+	if(neg && (int_part || frac_part)){
+		buf[n++] = '-';
+	}
+	n += FormatU32(&buf[n], int_part);
+	if(decimals){
+		buf[n++] = '.';
+		write_digits(&buf[n], frac_part, decimals);
+		n += decimals;
+		buf[n] = '\0';
+	}
+	return n;
+}
+
+uint32_t FormatPrint(char *buf, uint32_t size, const char *fmt, ...){
+	va_list args;
+	uint32_t n;
+	va_start(args, fmt);
+	n = FormatPrintV(buf, size, fmt, args);
+	va_end(args);
+	return n;
+}
+
+uint32_t FormatPrintV(char *buf, uint32_t size, const char *fmt, va_list args){
+	char tmp[PRINT_TMP_LEN];
+	const char *str;
+	uint32_t out = 0;
+	uint32_t len, pad;
+	uint8_t width, precision;
+	bool left, zero, has_precision;
+	char fill;
+	if(size == 0){
+		return 0;
+	}
+	size--;		/* room for '\0' */
+	while(*fmt && (out < size)){
+		if(*fmt != '%'){
+			buf[out++] = *fmt++;
+			continue;
+		}
+		fmt++;
+		left = false;
+		zero = false;
+		while((*fmt == '-') || (*fmt == '0')){
+			if(*fmt == '-'){
+				left = true;
+			} else{
+				zero = true;
+			}
+			fmt++;
+		}
+		width = 0;
+		while((*fmt >= '0') && (*fmt <= '9')){
+			width = width * 10 + (*fmt++ - '0');
+		}
+		precision = PRINT_DEFAULT_DEC;
+		has_precision = false;
+		if(*fmt == '.'){
+			fmt++;
+			has_precision = true;
+			precision = 0;
+			while((*fmt >= '0') && (*fmt <= '9')){
+				precision = precision * 10 + (*fmt++ - '0');
+			}
+		}
+		while(*fmt == 'l'){
+			fmt++;
+		}
+		str = tmp;
+		switch(*fmt){
+			case 'd':
+			case 'i':
+				len = FormatI32(tmp, va_arg(args, int));
+				break;
+			case 'u':
+				len = FormatU32(tmp, va_arg(args, unsigned int));
+				break;
+			case 'x':
+			case 'X':
+				len = FormatHex(tmp, va_arg(args, unsigned int), 0);
+				if(*fmt == 'X'){
+					for(uint32_t i = 0; i < len; i++){
+						if(tmp[i] >= 'a'){
+							tmp[i] -= 'a' - 'A';
+						}
+					}
+				}
+				break;
+			case 'c':
+				tmp[0] = (char)va_arg(args, int);
+				len = 1;
+				break;
+			case 's':
+				str = va_arg(args, const char *);
+				if(str == NULL){
+					str = "(null)";
+				}
+				for(len = 0; str[len] && (!has_precision || (len < precision)); len++);
+				break;
+			case 'f':
+				len = FormatFloat(tmp, (float)va_arg(args, double), precision);
+				break;
+			case '%':
+				tmp[0] = '%';
+				len = 1;
+				break;
+			case '\0':
+				continue;
+			default:
+				/* Unknown conversion: copy it as is */
+				tmp[0] = '%';
+				tmp[1] = *fmt;
+				len = 2;
+				break;
+		}
+		fmt++;
+		pad = (width > len) ? width - len : 0;
+		fill = (zero && !left) ? '0' : ' ';
+		if(!left){
+			/* Keep the sign in front of zero padding */
+			if((fill == '0') && (*str == '-') && (out < size)){
+				buf[out++] = *str++;
+				len--;
+			}
+			while(pad-- && (out < size)){
+				buf[out++] = fill;
+			}
+		}
+		for(uint32_t i = 0; (i < len) && (out < size); i++){
+			buf[out++] = str[i];
+		}
+		if(left){
+			while(pad-- && (out < size)){
+				buf[out++] = ' ';
+			}
+		}
+	}
+	buf[out] = '\0';
+	return out;
+}
+
+/*==================[end of file]============================================*/
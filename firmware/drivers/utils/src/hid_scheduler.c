@@ -0,0 +1,189 @@
+/**
+ * @file hid_scheduler.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "hid_scheduler.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define ASCII_FIRST			0x20	/*!< First character of ascii_keys */
+#define ASCII_LAST			0x7E	/*!< Last character of ascii_keys */
+#define ASCII_SHIFT			0x80	/*!< ascii_keys flag: the character needs shift */
+#define MOD_LEFT_SHIFT		0x02	/*!< Left shift modifier bit */
+#define KEY_RETURN			0x28	/*!< Usage IDs of control characters */
+#define KEY_BACKSPACE		0x2A
+#define KEY_TAB				0x2B
+#define MOUSE_DELTA_MIN		(-127)	/*!< Logical minimum of the mouse report (-128 is not valid) */
+#define MOUSE_DELTA_MAX		127
+#define MOUSE_CLAMP(x)		(((x) < MOUSE_DELTA_MIN) ? MOUSE_DELTA_MIN : (x))
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+/**
+ * @brief Key usage ID (and ASCII_SHIFT flag) of each printable character, US layout
+ */
+static const uint8_t ascii_keys[ASCII_LAST - ASCII_FIRST + 1] = {
+	0x2C, 0x9E, 0xB4, 0xA0, 0xA1, 0xA2, 0xA4, 0x34, 0xA6, 0xA7, 0xA5, 0xAE, 0x36, 0x2D, 0x37, 0x38,	/*  !"#$%&'()*+,-./ */
+	0x27, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0xB3, 0x33, 0xB6, 0x2E, 0xB7, 0xB8,	/* 0123456789:;<=>? */
+	0x9F, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x90, 0x91, 0x92,	/* @ABCDEFGHIJKLMNO */
+	0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x2F, 0x31, 0x30, 0xA3, 0xAD,	/* PQRSTUVWXYZ[\]^_ */
+	0x35, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12,	/* `abcdefghijklmno */
+	0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0xAF, 0xB1, 0xB0, 0xB5,		/* pqrstuvwxyz{|}~ */
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Slot for a new report at the end of the queue (the queue must not be full)
+ */
+static hid_sched_report_t *push(hid_scheduler_t *sched, uint8_t type, uint8_t len){
+	uint16_t index = sched->head + sched->count;
+	hid_sched_report_t *report;
+	if(index >= sched->size){
+		index -= sched->size;
+	}
+	sched->count++;
+	report = &sched->reports[index];
+	report->type = type;
+	report->len = len;
+	memset(report->data, 0, sizeof(report->data));
+	return report;
+}
+
+/**
+ * @brief Newest queued report, NULL if the queue is empty
+ */
+static hid_sched_report_t *newest(hid_scheduler_t *sched){
+	uint16_t index;
+	if(sched->count == 0){
+		return NULL;
+	}
+	index = sched->head + sched->count - 1;
+	if(index >= sched->size){
+		index -= sched->size;
+	}
+	return &sched->reports[index];
+}
+
+/**
+ * @brief Key usage ID and modifiers for a character, false if it can not be typed
+ */
+static bool char_to_key(char c, uint8_t *key, uint8_t *modifiers){
+	*modifiers = 0;
+	switch(c){
+		case '\n':
+			*key = KEY_RETURN;
+			return true;
+		case '\t':
+			*key = KEY_TAB;
+			return true;
+		case '\b':
+			*key = KEY_BACKSPACE;
+			return true;
+		default:
+			break;
+	}
+	if(((uint8_t)c < ASCII_FIRST) || ((uint8_t)c > ASCII_LAST)){
+		return false;
+	}
+	*key = ascii_keys[c - ASCII_FIRST] & ~ASCII_SHIFT;
+	if(ascii_keys[c - ASCII_FIRST] & ASCII_SHIFT){
+		*modifiers = MOD_LEFT_SHIFT;
+	}
+	return true;
+}
+/*==================[external functions definition]==========================*/
+void HidSchedulerInit(hid_scheduler_t *sched, hid_sched_report_t *storage, uint16_t size){
+	sched->reports = storage;
+	sched->size = size;
+	sched->coalesced = 0;
+	HidSchedulerClear(sched);
+}
+
+void HidSchedulerClear(hid_scheduler_t *sched){
+	sched->head = 0;
+	sched->count = 0;
+}
+
+uint16_t HidSchedulerPending(const hid_scheduler_t *sched){
+	return sched->count;
+}
+
+bool HidSchedulerKeyboard(hid_scheduler_t *sched, uint8_t modifiers, const uint8_t *keys, uint8_t num_keys){
+	hid_sched_report_t *report;
+	if((num_keys > HID_SCHED_KEYS_MAX) || (sched->size - sched->count < 2)){
+		return false;
+	}
+	report = push(sched, HID_SCHED_KEYBOARD, HID_SCHED_KEYBOARD_LEN);
+	report->data[0] = modifiers;
+	memcpy(&report->data[2], keys, num_keys);
+	/* Release: keys and modifiers up */
+	push(sched, HID_SCHED_KEYBOARD, HID_SCHED_KEYBOARD_LEN);
+	return true;
+}
+
+bool HidSchedulerMouse(hid_scheduler_t *sched, uint8_t buttons, int8_t delta_x, int8_t delta_y, int8_t wheel){
+	hid_sched_report_t *report = newest(sched);
+	delta_x = MOUSE_CLAMP(delta_x);
+	delta_y = MOUSE_CLAMP(delta_y);
+	wheel = MOUSE_CLAMP(wheel);
+	if((report != NULL) && (report->type == HID_SCHED_MOUSE) && (report->data[0] == buttons)){
+		int16_t x = (int8_t)report->data[1] + delta_x;
+		int16_t y = (int8_t)report->data[2] + delta_y;
+		int16_t w = (int8_t)report->data[3] + wheel;
+		/* Merge only while the sums fit in the report */
+		if((x >= MOUSE_DELTA_MIN) && (x <= MOUSE_DELTA_MAX) && (y >= MOUSE_DELTA_MIN) && (y <= MOUSE_DELTA_MAX)
+			&& (w >= MOUSE_DELTA_MIN) && (w <= MOUSE_DELTA_MAX)){
+			report->data[1] = (uint8_t)x;
+			report->data[2] = (uint8_t)y;
+			report->data[3] = (uint8_t)w;
+			sched->coalesced++;
+			return true;
+		}
+	}
+	if(sched->count == sched->size){
+		return false;
+	}
+	report = push(sched, HID_SCHED_MOUSE, HID_SCHED_MOUSE_LEN);
+	report->data[0] = buttons;
+	report->data[1] = (uint8_t)delta_x;
+	report->data[2] = (uint8_t)delta_y;
+	report->data[3] = (uint8_t)wheel;
+	return true;
+}
+
+uint32_t HidSchedulerType(hid_scheduler_t *sched, const char *text){
+	uint32_t n = 0;
+	uint8_t key, modifiers;
+	while(text[n] != '\0'){
+		if(char_to_key(text[n], &key, &modifiers) && !HidSchedulerKeyboard(sched, modifiers, &key, 1)){
+			break;
+		}
+		n++;
+	}
+	return n;
+}
+
+bool HidSchedulerNext(hid_scheduler_t *sched, hid_sched_report_t *report){
+	if(sched->count == 0){
+		return false;
+	}
+	*report = sched->reports[sched->head];
+	sched->head++;
+	if(sched->head == sched->size){
+		sched->head = 0;
+	}
+	sched->count--;
+	return true;
+}
+
+/*==================[end of file]============================================*/
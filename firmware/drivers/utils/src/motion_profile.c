@@ -0,0 +1,146 @@
+/**
+ * @file motion_profile.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "motion_profile.h"
+#include <stddef.h>
+#include <math.h>
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+bool MotionProfilePlan(motion_profile_t *prof, float start, float target, float max_vel, float max_acc, float max_jerk){
+	float dist = fabsf(target - start);
+	float vel = max_vel;		/* Cruise velocity */
+	float acc = max_acc;		/* Peak acceleration */
+	float t_jerk = 0;			/* Duration of each jerk segment */
+	float t_acc;				/* Duration of the acceleration phase */
+	float t_cruise;
+	float dur[MOTION_PROFILE_SEGMENTS];
+	uint8_t i;
+	if((max_vel <= 0) || (max_acc <= 0) || (max_jerk < 0)){
+		return false;
+	}
+	/* Acceleration phase reaching max_vel */
+	if((max_jerk > 0) && (max_vel * max_jerk < max_acc * max_acc)){
+		t_jerk = sqrtf(max_vel / max_jerk);		/* max_acc is not reached */
+		acc = max_jerk * t_jerk;
+	} else if(max_jerk > 0){
+		t_jerk = max_acc / max_jerk;
+	}
+	t_acc = vel / acc + t_jerk;
+	/* Acceleration and deceleration cover vel * t_acc; reduce vel if the distance is shorter */
+	if(vel * t_acc > dist){
+		if(max_jerk == 0){
+			vel = sqrtf(dist * max_acc);
+			t_acc = vel / max_acc;
+		} else{
+			/* Peak acceleration reached: vel^2 / acc + vel * acc / jerk = dist */
+			float a_j = max_acc / max_jerk;
+			vel = 0.5f * max_acc * (sqrtf(a_j * a_j + 4.0f * dist / max_acc) - a_j);
+			acc = max_acc;
+			t_jerk = a_j;
+			if(vel < max_acc * a_j){
+				/* Peak acceleration not reached: 2 * vel * sqrt(vel / jerk) = dist */
+				vel = cbrtf(0.25f * dist * dist * max_jerk);
+				t_jerk = sqrtf(vel / max_jerk);
+				acc = max_jerk * t_jerk;
+			}
+			t_acc = (t_jerk > 0) ? (vel / acc + t_jerk) : 0;
+		}
+	}
+	t_cruise = (vel > 0) ? ((dist - vel * t_acc) / vel) : 0;
+	if(t_cruise < 0){
+		t_cruise = 0;
+	}
+
+	dur[0] = t_jerk;
+	dur[1] = t_acc - 2.0f * t_jerk;
+	dur[2] = t_jerk;
+	dur[3] = t_cruise;
+	dur[4] = t_jerk;
+	dur[5] = t_acc - 2.0f * t_jerk;
+	dur[6] = t_jerk;
+	if(dur[1] < 0){
+		dur[1] = dur[5] = 0;
+	}
+	prof->j[0] = prof->j[6] = max_jerk;
+	prof->j[2] = prof->j[4] = -max_jerk;
+	prof->j[1] = prof->j[3] = prof->j[5] = 0;
+	prof->a[0] = prof->a[3] = prof->a[4] = 0;
+	prof->a[1] = prof->a[2] = acc;
+	prof->a[5] = prof->a[6] = -acc;
+	/* Segment start states, integrated exactly */
+	prof->t[0] = 0;
+	prof->p[0] = 0;
+	prof->v[0] = 0;
+	for(i = 1; i < MOTION_PROFILE_SEGMENTS; i++){
+		float T = dur[i - 1];
+		prof->t[i] = prof->t[i - 1] + T;
+		prof->p[i] = prof->p[i - 1] + T * (prof->v[i - 1] + T * (prof->a[i - 1] / 2.0f + T * prof->j[i - 1] / 6.0f));
+		prof->v[i] = prof->v[i - 1] + T * (prof->a[i - 1] + T * prof->j[i - 1] / 2.0f);
+	}
+	prof->duration = prof->t[MOTION_PROFILE_SEGMENTS - 1] + dur[MOTION_PROFILE_SEGMENTS - 1];
+	prof->start = start;
+	prof->target = target;
+	prof->sign = (target < start) ? -1.0f : 1.0f;
+	prof->scale = 1.0f;
+	return true;
+}
+
+float MotionProfileDuration(const motion_profile_t *prof){
+	return prof->duration / prof->scale;
+}
+
+bool MotionProfileStretch(motion_profile_t *prof, float duration){
+	if(duration < prof->duration){
+		return false;
+	}
+	/* A null move stays null */
+	if(prof->duration > 0){
+		prof->scale = prof->duration / duration;
+	}
+	return true;
+}
+
+void MotionProfileSample(const motion_profile_t *prof, float time, float *pos, float *vel){
+	float t = time * prof->scale;
+	uint8_t i = MOTION_PROFILE_SEGMENTS - 1;
+	if(t >= prof->duration){
+		*pos = prof->target;
+		if(vel != NULL){
+			*vel = 0;
+		}
+		return;
+	}
+	if(t < 0){
+		t = 0;
+	}
+	while((i > 0) && (t < prof->t[i])){
+		i--;
+	}
+	t -= prof->t[i];
+	*pos = prof->start + prof->sign * (prof->p[i] + t * (prof->v[i] + t * (prof->a[i] / 2.0f + t * prof->j[i] / 6.0f)));
+	if(vel != NULL){
+		*vel = prof->sign * prof->scale * (prof->v[i] + t * (prof->a[i] + t * prof->j[i] / 2.0f));
+	}
+}
+
+/*==================[end of file]============================================*/
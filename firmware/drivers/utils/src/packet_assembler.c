@@ -0,0 +1,155 @@
+/**
+ * @file packet_assembler.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "packet_assembler.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+/**
+ * @brief Parser states
+ */
+enum {
+	STATE_SYNC,			/*!< Waiting for sync byte (length prefixed) */
+	STATE_LEN_LSB,		/*!< Waiting for length LSB (length prefixed) */
+	STATE_LEN_MSB,		/*!< Waiting for length MSB (length prefixed) */
+	STATE_PAYLOAD,		/*!< Receiving payload / line characters */
+	STATE_SKIP,			/*!< Dropping bytes of an oversized line */
+};
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void deliver(packet_assembler_t *assembler, uint16_t len){
+	assembler->messages++;
+	if(assembler->func_p != NULL){
+		assembler->func_p(assembler->buf, len, assembler->param_p);
+	}
+}
+
+static void feed_line(packet_assembler_t *assembler, const uint8_t *data, uint32_t len){
+	const uint8_t *end;
+	uint32_t chunk;
+	uint16_t line_len;
+	while(len){
+		/* Copy everything up to the next delimiter in one go */
+		end = memchr(data, assembler->marker, len);
+		chunk = (end != NULL) ? (uint32_t)(end - data) : len;
+		if(assembler->state != STATE_SKIP){
+			if(assembler->len + chunk < assembler->size){
+				memcpy(&assembler->buf[assembler->len], data, chunk);
+				assembler->len += chunk;
+			} else{
+				assembler->overflows++;
+				assembler->state = STATE_SKIP;
+			}
+		}
+		if(end == NULL){
+			return;
+		}
+		if(assembler->state != STATE_SKIP){
+			line_len = assembler->len;
+			if((line_len > 0) && (assembler->buf[line_len - 1] == '\r')){
+				line_len--;
+			}
+			if(line_len > 0){
+				assembler->buf[line_len] = '\0';
+				deliver(assembler, line_len);
+			}
+		}
+		assembler->state = STATE_PAYLOAD;
+		assembler->len = 0;
+		data += chunk + 1;
+		len -= chunk + 1;
+	}
+}
+
+static void feed_packet(packet_assembler_t *assembler, const uint8_t *data, uint32_t len){
+	const uint8_t *sync;
+	uint32_t chunk;
+	while(len){
+		switch(assembler->state){
+			case STATE_SYNC:
+				sync = memchr(data, assembler->marker, len);
+				if(sync == NULL){
+					assembler->discarded += len;
+					return;
+				}
+				assembler->discarded += sync - data;
+				len -= sync - data + 1;
+				data = sync + 1;
+				assembler->state = STATE_LEN_LSB;
+				break;
+			case STATE_LEN_LSB:
+				assembler->expected = *data++;
+				len--;
+				assembler->state = STATE_LEN_MSB;
+				break;
+			case STATE_LEN_MSB:
+				assembler->expected |= (uint16_t)(*data++) << 8;
+				len--;
+				assembler->len = 0;
+				if(assembler->expected > assembler->size){
+					/* Possibly a corrupted length: look for the next sync byte
+					 * instead of skipping up to 64 KiB of valid packets */
+					assembler->overflows++;
+					assembler->state = STATE_SYNC;
+				} else if(assembler->expected == 0){
+					deliver(assembler, 0);
+					assembler->state = STATE_SYNC;
+				} else{
+					assembler->state = STATE_PAYLOAD;
+				}
+				break;
+			default:
+				chunk = assembler->expected - assembler->len;
+				if(chunk > len){
+					chunk = len;
+				}
+				memcpy(&assembler->buf[assembler->len], data, chunk);
+				assembler->len += chunk;
+				data += chunk;
+				len -= chunk;
+				if(assembler->len == assembler->expected){
+					deliver(assembler, assembler->len);
+					assembler->state = STATE_SYNC;
+				}
+				break;
+		}
+	}
+}
+/*==================[external functions definition]==========================*/
+void AssemblerInit(packet_assembler_t *assembler){
+	AssemblerReset(assembler);
+	assembler->messages = 0;
+	assembler->overflows = 0;
+	assembler->discarded = 0;
+}
+
+void AssemblerReset(packet_assembler_t *assembler){
+	assembler->state = (assembler->mode == ASSEMBLER_LINE) ? STATE_PAYLOAD : STATE_SYNC;
+	assembler->len = 0;
+	assembler->expected = 0;
+}
+
+void AssemblerFeed(packet_assembler_t *assembler, const uint8_t *data, uint32_t len){
+	if(assembler->mode == ASSEMBLER_LINE){
+		feed_line(assembler, data, len);
+	} else{
+		feed_packet(assembler, data, len);
+	}
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,105 @@
+/**
+ * @file pwm_alloc.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "pwm_alloc.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void PwmAllocInit(pwm_alloc_t *alloc){
+	uint8_t i;
+	for(i = 0; i < PWM_ALLOC_TIMERS; i++){
+		alloc->timers[i].freq = 0;
+		alloc->timers[i].users = 0;
+	}
+	for(i = 0; i < PWM_ALLOC_CHANNELS; i++){
+		alloc->channel_timer[i] = PWM_ALLOC_NONE;
+	}
+}
+
+int8_t PwmAllocAttach(pwm_alloc_t *alloc, uint8_t channel, uint32_t freq, bool *configure){
+	int8_t previous, timer = PWM_ALLOC_NONE;
+	uint8_t i;
+	if(channel >= PWM_ALLOC_CHANNELS){
+		return PWM_ALLOC_NONE;
+	}
+	previous = PwmAllocDetach(alloc, channel);
+	/* A timer already running at freq */
+	for(i = 0; i < PWM_ALLOC_TIMERS; i++){
+		if((alloc->timers[i].users > 0) && (alloc->timers[i].freq == freq)){
+			timer = i;
+			*configure = false;
+			break;
+		}
+	}
+	/* A free timer, preferably the one the channel had (no need to move the channel) */
+	if((timer == PWM_ALLOC_NONE) && (previous != PWM_ALLOC_NONE) && (alloc->timers[previous].users == 0)){
+		timer = previous;
+	}
+	for(i = 0; (timer == PWM_ALLOC_NONE) && (i < PWM_ALLOC_TIMERS); i++){
+		if(alloc->timers[i].users == 0){
+			timer = i;
+		}
+	}
+	if(timer == PWM_ALLOC_NONE){
+		if(previous != PWM_ALLOC_NONE){
+			alloc->timers[previous].users++;
+			alloc->channel_timer[channel] = previous;
+		}
+		return PWM_ALLOC_NONE;
+	}
+	if(alloc->timers[timer].users == 0){
+		*configure = (alloc->timers[timer].freq != freq) || (timer != previous);
+		alloc->timers[timer].freq = freq;
+	}
+	alloc->timers[timer].users++;
+	alloc->channel_timer[channel] = timer;
+	return timer;
+}
+
+int8_t PwmAllocDetach(pwm_alloc_t *alloc, uint8_t channel){
+	int8_t timer;
+	if(channel >= PWM_ALLOC_CHANNELS){
+		return PWM_ALLOC_NONE;
+	}
+	timer = alloc->channel_timer[channel];
+	if(timer != PWM_ALLOC_NONE){
+		alloc->timers[timer].users--;
+		alloc->channel_timer[channel] = PWM_ALLOC_NONE;
+	}
+	return timer;
+}
+
+int8_t PwmAllocTimer(const pwm_alloc_t *alloc, uint8_t channel){
+	if(channel >= PWM_ALLOC_CHANNELS){
+		return PWM_ALLOC_NONE;
+	}
+	return alloc->channel_timer[channel];
+}
+
+uint8_t PwmAllocUsers(const pwm_alloc_t *alloc, uint8_t timer){
+	if(timer >= PWM_ALLOC_TIMERS){
+		return 0;
+	}
+	return alloc->timers[timer].users;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,156 @@
+/**
+ * @file ring_buffer.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "ring_buffer.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Copy data into the storage starting at a free running index, wrapping if needed
+ */
+static void copy_in(ring_buffer_t *rb, uint32_t index, const uint8_t *src, uint32_t len){
+	uint32_t offset = index & rb->mask;
+	uint32_t first = rb->size - offset;
+	if(first > len){
+		first = len;
+	}
+	memcpy(&rb->data[offset], src, first);
+	memcpy(rb->data, src + first, len - first);
+}
+
+/**
+ * @brief Copy data out of the storage starting at a free running index, wrapping if needed
+ */
+static void copy_out(const ring_buffer_t *rb, uint32_t index, uint8_t *dst, uint32_t len){
+	uint32_t offset = index & rb->mask;
+	uint32_t first = rb->size - offset;
+	if(first > len){
+		first = len;
+	}
+	memcpy(dst, &rb->data[offset], first);
+	memcpy(dst + first, rb->data, len - first);
+}
+/*==================[external functions definition]==========================*/
+bool RingBufferInit(ring_buffer_t *rb, uint8_t *storage, uint32_t size){
+	if((size == 0) || (size & (size - 1))){
+		return false;
+	}
+	rb->data = storage;
+	rb->size = size;
+	rb->mask = size - 1;
+	atomic_init(&rb->head, 0);
+	atomic_init(&rb->tail, 0);
+	return true;
+}
+
+void RingBufferReset(ring_buffer_t *rb){
+	atomic_store(&rb->head, 0);
+	atomic_store(&rb->tail, 0);
+}
+
+uint32_t RingBufferUsed(const ring_buffer_t *rb){
+	uint32_t head = atomic_load_explicit(&rb->head, memory_order_acquire);
+	uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+	return head - tail;
+}
+
+uint32_t RingBufferFree(const ring_buffer_t *rb){
+	return rb->size - RingBufferUsed(rb);
+}
+
+uint32_t RingBufferWrite(ring_buffer_t *rb, const void *data, uint32_t len){
+	uint32_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+	uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+	uint32_t free = rb->size - (head - tail);
+	if(len > free){
+		len = free;
+	}
+	if(len){
+		copy_in(rb, head, data, len);
+		atomic_store_explicit(&rb->head, head + len, memory_order_release);
+	}
+	return len;
+}
+
+uint32_t RingBufferWriteVector(ring_buffer_t *rb, const ring_buffer_iovec_t *iov, uint32_t count){
+	uint32_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+	uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+	uint32_t total = 0;
+	for(uint32_t i = 0; i < count; i++){
+		total += iov[i].len;
+	}
+	if(total > rb->size - (head - tail)){
+		return 0;
+	}
+	uint32_t index = head;
+	for(uint32_t i = 0; i < count; i++){
+		copy_in(rb, index, iov[i].data, iov[i].len);
+		index += iov[i].len;
+	}
+	atomic_store_explicit(&rb->head, index, memory_order_release);
+	return total;
+}
+
+uint32_t RingBufferRead(ring_buffer_t *rb, void *data, uint32_t len){
+	uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+	uint32_t head = atomic_load_explicit(&rb->head, memory_order_acquire);
+	uint32_t used = head - tail;
+	if(len > used){
+		len = used;
+	}
+	if(len){
+		copy_out(rb, tail, data, len);
+		atomic_store_explicit(&rb->tail, tail + len, memory_order_release);
+	}
+	return len;
+}
+
+uint32_t RingBufferPeek(const ring_buffer_t *rb, const uint8_t **block){
+	uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+	uint32_t head = atomic_load_explicit(&rb->head, memory_order_acquire);
+	uint32_t used = head - tail;
+	uint32_t offset = tail & rb->mask;
+	uint32_t contiguous = rb->size - offset;
+	*block = &rb->data[offset];
+	return (used < contiguous) ? used : contiguous;
+}
+
+void RingBufferConsume(ring_buffer_t *rb, uint32_t len){
+	uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+	atomic_store_explicit(&rb->tail, tail + len, memory_order_release);
+}
+
+uint32_t RingBufferReserve(ring_buffer_t *rb, uint8_t **block){
+	uint32_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+	uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+	uint32_t free = rb->size - (head - tail);
+	uint32_t offset = head & rb->mask;
+	uint32_t contiguous = rb->size - offset;
+	*block = &rb->data[offset];
+	return (free < contiguous) ? free : contiguous;
+}
+
+void RingBufferCommit(ring_buffer_t *rb, uint32_t len){
+	uint32_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+	atomic_store_explicit(&rb->head, head + len, memory_order_release);
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,219 @@
+/**
+ * @file rtttl.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "rtttl.h"
+#include <stddef.h>
+/*==================[macros and definitions]=================================*/
+#define DEFAULT_DUR		4
+#define DEFAULT_OCT		6
+#define DEFAULT_BPM		63
+#define OCT_MIN			3
+#define OCT_MAX			7
+#define SEMITONES		12
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static const uint16_t note_freq[] = {
+	NOTE_C3, NOTE_CS3, NOTE_D3, NOTE_DS3, NOTE_E3, NOTE_F3, NOTE_FS3, NOTE_G3, NOTE_GS3, NOTE_A3, NOTE_AS3, NOTE_B3,
+	NOTE_C4, NOTE_CS4, NOTE_D4, NOTE_DS4, NOTE_E4, NOTE_F4, NOTE_FS4, NOTE_G4, NOTE_GS4, NOTE_A4, NOTE_AS4, NOTE_B4,
+	NOTE_C5, NOTE_CS5, NOTE_D5, NOTE_DS5, NOTE_E5, NOTE_F5, NOTE_FS5, NOTE_G5, NOTE_GS5, NOTE_A5, NOTE_AS5, NOTE_B5,
+	NOTE_C6, NOTE_CS6, NOTE_D6, NOTE_DS6, NOTE_E6, NOTE_F6, NOTE_FS6, NOTE_G6, NOTE_GS6, NOTE_A6, NOTE_AS6, NOTE_B6,
+	NOTE_C7, NOTE_CS7, NOTE_D7, NOTE_DS7, NOTE_E7, NOTE_F7, NOTE_FS7, NOTE_G7, NOTE_GS7, NOTE_A7, NOTE_AS7, NOTE_B7,
+	NOTE_C8
+};
+/* Semitone of each note letter from 'a' to 'g' */
+static const uint8_t letter_semitone[] = {9, 11, 0, 2, 4, 5, 7};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static bool is_digit(char c){
+	return (c >= '0') && (c <= '9');
+}
+
+static char to_lower(char c){
+	return ((c >= 'A') && (c <= 'Z')) ? (c - 'A' + 'a') : c;
+}
+
+static const char *skip_spaces(const char *s){
+	while((*s == ' ') || (*s == '\t') || (*s == '\r') || (*s == '\n')){
+		s++;
+	}
+	return s;
+}
+
+/**
+ * @brief Parse a decimal number, returns false if there are no digits
+ */
+static bool parse_number(const char **s, uint32_t *num){
+	if(!is_digit(**s)){
+		return false;
+	}
+	*num = 0;
+	while(is_digit(**s)){
+		if(*num < 100000){
+			*num = (*num * 10) + (**s - '0');
+		}
+		(*s)++;
+	}
+	return true;
+}
+/*==================[external functions definition]==========================*/
+bool RtttlBegin(rtttl_parser_t *parser, const char *melody){
+	const char *s = melody;
+	uint32_t bpm = DEFAULT_BPM;
+	uint32_t num;
+	char key;
+	parser->default_dur = DEFAULT_DUR;
+	parser->default_oct = DEFAULT_OCT;
+	parser->error = true;
+	/* Name */
+	while((*s != ':') && (*s != '\0')){
+		s++;
+	}
+	if(*s == '\0'){
+		return false;
+	}
+	s++;
+	/* Defaults: "d=4,o=5,b=160:" (any order, all optional) */
+	s = skip_spaces(s);
+	while(*s != ':'){
+		if(*s == '\0'){
+			return false;
+		}
+		key = to_lower(*s);
+		s = skip_spaces(s + 1);
+		if(*s != '='){
+			return false;
+		}
+		s = skip_spaces(s + 1);
+		if(!parse_number(&s, &num)){
+			return false;
+		}
+		if((key == 'd') && (num > 0) && (num <= 32)){
+			parser->default_dur = num;
+		} else if((key == 'o') && (num >= OCT_MIN) && (num <= OCT_MAX)){
+			parser->default_oct = num;
+		} else if((key == 'b') && (num > 0)){
+			bpm = num;
+		} else{
+			return false;
+		}
+		s = skip_spaces(s);
+		if(*s == ','){
+			s = skip_spaces(s + 1);
+		} else if(*s != ':'){
+			return false;
+		}
+	}
+	/* BPM usually expresses the number of quarter notes per minute */
+	parser->wholenote = (60 * 1000L / bpm) * 4;
+	parser->next = s + 1;
+	parser->error = false;
+	return true;
+}
+
+bool RtttlNext(rtttl_parser_t *parser, rtttl_note_t *note){
+	const char *s;
+	uint32_t num, duration, octave;
+	int8_t semitone = -1;
+	char letter;
+	if(parser->error){
+		return false;
+	}
+	s = skip_spaces(parser->next);
+	if(*s == '\0'){
+		return false;
+	}
+	parser->error = true;
+	/* Duration */
+	if(parse_number(&s, &num) && (num > 0)){
+		duration = parser->wholenote / num;
+	} else{
+		duration = parser->wholenote / parser->default_dur;
+	}
+	/* Note */
+	letter = to_lower(*s);
+	if((letter >= 'a') && (letter <= 'g')){
+		semitone = letter_semitone[letter - 'a'];
+	} else if(letter != 'p'){
+		return false;
+	}
+	s++;
+	if(*s == '#'){
+		semitone++;
+		s++;
+	}
+	/* Dot and octave, the dot can be on either side of the octave */
+	if(*s == '.'){
+		duration += duration / 2;
+		s++;
+	}
+	if(is_digit(*s)){
+		octave = *s - '0';
+		s++;
+	} else{
+		octave = parser->default_oct;
+	}
+	if(*s == '.'){
+		duration += duration / 2;
+		s++;
+	}
+	s = skip_spaces(s);
+	if(*s == ','){
+		s++;
+	} else if(*s != '\0'){
+		return false;
+	}
+	if(duration > UINT16_MAX){
+		return false;
+	}
+	if(semitone < 0){
+		note->freq = RTTTL_PAUSE;
+	} else{
+		/* A pause with an invalid octave is accepted, a note is not */
+		num = (octave - OCT_MIN) * SEMITONES + semitone;
+		if((octave < OCT_MIN) || (num >= sizeof(note_freq) / sizeof(note_freq[0]))){
+			return false;
+		}
+		note->freq = note_freq[num];
+	}
+	note->duration = duration;
+	parser->next = s;
+	parser->error = false;
+	return true;
+}
+
+uint16_t RtttlCompile(const char *melody, rtttl_note_t *notes, uint16_t max){
+	rtttl_parser_t parser;
+	rtttl_note_t note;
+	uint16_t n = 0;
+	if(!RtttlBegin(&parser, melody)){
+		return 0;
+	}
+	while(RtttlNext(&parser, &note)){
+		if(notes != NULL){
+			if(n >= max){
+				return 0;
+			}
+			notes[n] = note;
+		}
+		if(n == UINT16_MAX){
+			return 0;
+		}
+		n++;
+	}
+	return parser.error ? 0 : n;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,58 @@
+/**
+ * @file slot_pool.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "slot_pool.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+bool SlotPoolInit(slot_pool_t *pool, uint8_t size){
+	if((size == 0) || (size > SLOT_POOL_MAX)){
+		return false;
+	}
+	pool->size = size;
+	atomic_init(&pool->free, (size == SLOT_POOL_MAX) ? UINT32_MAX : ((1UL << size) - 1));
+	return true;
+}
+
+int8_t SlotPoolAlloc(slot_pool_t *pool){
+	uint32_t free = atomic_load(&pool->free);
+	uint32_t bit;
+	do{
+		if(free == 0){
+			return SLOT_POOL_NONE;
+		}
+		bit = free & (0u - free);	/* lowest free slot */
+	} while(!atomic_compare_exchange_weak(&pool->free, &free, free & ~bit));
+	return (int8_t)__builtin_ctz(bit);
+}
+
+void SlotPoolRelease(slot_pool_t *pool, int8_t slot){
+	if((slot >= 0) && (slot < pool->size)){
+		atomic_fetch_or(&pool->free, 1UL << slot);
+	}
+}
+
+uint8_t SlotPoolUsed(const slot_pool_t *pool){
+	return pool->size - __builtin_popcount(atomic_load(&pool->free));
+}
+
+/*==================[end of file]============================================*/
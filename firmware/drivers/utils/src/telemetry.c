@@ -0,0 +1,244 @@
+/**
+ * @file telemetry.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "telemetry.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define CRC_INIT		0xFFFF
+#define COBS_MAX_CODE	0xFF
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+/**
+ * @brief CRC-16/CCITT lookup table (polynomial 0x1021)
+ */
+static const uint16_t crc16_table[256] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7, 0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+	0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6, 0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+	0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485, 0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+	0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4, 0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+	0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823, 0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+	0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12, 0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+	0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41, 0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+	0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70, 0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+	0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F, 0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+	0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E, 0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+	0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D, 0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+	0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C, 0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+	0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB, 0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+	0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A, 0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+	0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9, 0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+	0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8, 0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static uint8_t sample_size(telemetry_type_t type){
+	return (type == TELEMETRY_F32) ? 4 : 2;
+}
+
+static void put_u16(uint8_t *dst, uint16_t val){
+	dst[0] = val;
+	dst[1] = val >> 8;
+}
+
+static void put_u32(uint8_t *dst, uint32_t val){
+	dst[0] = val;
+	dst[1] = val >> 8;
+	dst[2] = val >> 16;
+	dst[3] = val >> 24;
+}
+
+static uint16_t get_u16(const uint8_t *src){
+	return (uint16_t)src[0] | ((uint16_t)src[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *src){
+	return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+/*==================[external functions definition]==========================*/
+void TelemetryBegin(telemetry_packet_t *pkt, uint8_t *buf, uint16_t size, uint8_t seq, uint32_t timestamp){
+	pkt->buf = buf;
+	pkt->size = size;
+	pkt->len = 0;
+	pkt->overflow = (size < TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE);
+	if(pkt->overflow){
+		return;
+	}
+	buf[0] = seq;
+	put_u32(&buf[1], timestamp);
+	buf[5] = 0;
+	pkt->len = TELEMETRY_HEADER_SIZE;
+}
+
+bool TelemetryAddChannel(telemetry_packet_t *pkt, uint8_t id, telemetry_type_t type, uint32_t period, const void *samples, uint16_t count){
+	uint32_t data_len = (uint32_t)count * sample_size(type);
+	uint8_t *dst;
+	if(pkt->overflow || (pkt->buf[5] == UINT8_MAX) ||
+	   ((uint32_t)pkt->len + TELEMETRY_CHANNEL_SIZE + data_len + TELEMETRY_CRC_SIZE > pkt->size)){
+		pkt->overflow = true;
+		return false;
+	}
+	dst = &pkt->buf[pkt->len];
+	dst[0] = id;
+	dst[1] = type;
+	put_u32(&dst[2], period);
+	put_u16(&dst[6], count);
+	dst += TELEMETRY_CHANNEL_SIZE;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	memcpy(dst, samples, data_len);
+#else
+	for(uint16_t i = 0; i < count; i++){
+		if(type == TELEMETRY_F32){
+			uint32_t raw;
+			memcpy(&raw, (const uint8_t *)samples + 4 * i, 4);
+			put_u32(&dst[4 * i], raw);
+		} else{
+			put_u16(&dst[2 * i], ((const uint16_t *)samples)[i]);
+		}
+	}
+#endif
+	pkt->len += TELEMETRY_CHANNEL_SIZE + data_len;
+	pkt->buf[5]++;
+	return true;
+}
+
+uint16_t TelemetryEnd(telemetry_packet_t *pkt, uint8_t *frame, uint16_t frame_size){
+	uint16_t crc;
+	uint16_t len;
+	if(pkt->overflow || (frame_size < TELEMETRY_FRAME_SIZE(pkt->len + TELEMETRY_CRC_SIZE))){
+		return 0;
+	}
+	crc = TelemetryCrc16(pkt->buf, pkt->len);
+	put_u16(&pkt->buf[pkt->len], crc);
+	len = TelemetryCobsEncode(pkt->buf, pkt->len + TELEMETRY_CRC_SIZE, frame);
+	frame[len++] = 0x00;
+	return len;
+}
+
+uint16_t TelemetryCobsEncode(const uint8_t *src, uint16_t len, uint8_t *dst){
+	uint16_t code_idx = 0;
+	uint16_t out = 1;
+	uint8_t code = 1;
+	for(uint16_t i = 0; i < len; i++){
+		if(src[i] == 0){
+			dst[code_idx] = code;
+			code_idx = out++;
+			code = 1;
+		} else{
+			dst[out++] = src[i];
+			code++;
+			if(code == COBS_MAX_CODE){
+				dst[code_idx] = code;
+				code_idx = out++;
+				code = 1;
+			}
+		}
+	}
+	dst[code_idx] = code;
+	return out;
+}
+
+int32_t TelemetryCobsDecode(const uint8_t *src, uint16_t len, uint8_t *dst){
+	uint16_t in = 0;
+	uint16_t out = 0;
+	uint8_t code;
+	while(in < len){
+		code = src[in++];
+		if((code == 0) || (in + code - 1 > len)){
+			return -1;
+		}
+		for(uint8_t i = 1; i < code; i++){
+			if(src[in] == 0){
+				return -1;
+			}
+			dst[out++] = src[in++];
+		}
+		if((code != COBS_MAX_CODE) && (in < len)){
+			dst[out++] = 0;
+		}
+	}
+	return out;
+}
+
+uint16_t TelemetryCrc16(const uint8_t *data, uint16_t len){
+	uint16_t crc = CRC_INIT;
+	while(len--){
+		crc = (crc << 8) ^ crc16_table[((crc >> 8) ^ *data++) & 0xFF];
+	}
+	return crc;
+}
+
+bool TelemetryParse(const uint8_t *raw, uint16_t len, telemetry_header_t *header){
+	uint16_t offset = TELEMETRY_HEADER_SIZE;
+	uint16_t payload_len;
+	uint32_t block_len;
+	if(len < TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE){
+		return false;
+	}
+	payload_len = len - TELEMETRY_CRC_SIZE;
+	if(TelemetryCrc16(raw, payload_len) != get_u16(&raw[payload_len])){
+		return false;
+	}
+	header->seq = raw[0];
+	header->timestamp = get_u32(&raw[1]);
+	header->n_channels = raw[5];
+	for(uint8_t i = 0; i < header->n_channels; i++){
+		if((offset + TELEMETRY_CHANNEL_SIZE > payload_len) || (raw[offset + 1] > TELEMETRY_F32)){
+			return false;
+		}
+		block_len = TELEMETRY_CHANNEL_SIZE + (uint32_t)get_u16(&raw[offset + 6]) * sample_size(raw[offset + 1]);
+		if(offset + block_len > payload_len){
+			return false;
+		}
+		offset += block_len;
+	}
+	return offset == payload_len;
+}
+
+bool TelemetryNextChannel(const uint8_t *raw, uint16_t len, uint16_t *offset, telemetry_channel_t *channel){
+	const uint8_t *block;
+	if(*offset == 0){
+		*offset = TELEMETRY_HEADER_SIZE;
+	}
+	if(*offset + TELEMETRY_CHANNEL_SIZE > len - TELEMETRY_CRC_SIZE){
+		return false;
+	}
+	block = &raw[*offset];
+	channel->id = block[0];
+	channel->type = block[1];
+	channel->period = get_u32(&block[2]);
+	channel->count = get_u16(&block[6]);
+	channel->samples = &block[TELEMETRY_CHANNEL_SIZE];
+	*offset += TELEMETRY_CHANNEL_SIZE + channel->count * sample_size(channel->type);
+	return true;
+}
+
+float TelemetrySample(const telemetry_channel_t *channel, uint16_t index){
+	uint32_t raw;
+	float value;
+	switch(channel->type){
+		case TELEMETRY_U16:
+			return (float)get_u16(&channel->samples[2 * index]);
+		case TELEMETRY_I16:
+			return (float)(int16_t)get_u16(&channel->samples[2 * index]);
+		case TELEMETRY_F32:
+			raw = get_u32(&channel->samples[4 * index]);
+			memcpy(&value, &raw, sizeof(value));
+			return value;
+	}
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,30 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal helpers shared by the _rv32 fixed point kernels (not part of the public API)
+
+#ifndef _dsp_rv32_common_H_
+#define _dsp_rv32_common_H_
+#include <stdint.h>
+
+// Negated sum of two 16 bit products. a0 * b0 + a1 * b1 reaches 2^31 when the
+// four values are -32768, but its negation always fits in 32 bits: the products
+// are computed with 32 bit mul instructions and each pair needs only one
+// 64 bit (two register) subtraction from the accumulator.
+static inline int32_t dsp_rv32_pair_neg(int32_t a0, int32_t b0, int32_t a1, int32_t b1)
+{
+    return -(a0 * b0) - a1 * b1;
+}
+
+#endif // _dsp_rv32_common_H_
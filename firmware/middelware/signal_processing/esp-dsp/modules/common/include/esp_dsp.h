@@ -33,6 +33,7 @@ extern "C"
 #include "dsps_wind.h"
 #include "dsps_conv.h"
 #include "dsps_corr.h"
+#include "dsps_conv_fft.h"
 
 #include "dsps_d_gen.h"
 #include "dsps_h_gen.h"
@@ -0,0 +1,383 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <stdbool.h>
+#include "malloc.h"
+#include "dsps_conv_fft.h"
+#include "dsps_conv.h"
+#include "dsps_corr.h"
+#include "dsps_ccorr.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+
+// Input samples per call of the direct path in the streaming convolution
+#define CONV_FFT_DIRECT_BLOCK   64
+
+// Operations per multiply-accumulate of the direct convolution, relative to the
+// operations of the FFT butterflies (see conv_fft_pair_cost())
+#define CONV_FFT_DIRECT_OPS     2.0f
+
+// Operations to convolve two blocks with an FFT of size N: two complex FFTs
+// (N/2*log2(N) butterflies of 10 operations), bit reversals, spectrum product
+// and copies, plus about 30% of loop and memory overhead measured against the
+// direct path (the FFT becomes faster from about 48 taps).
+static float conv_fft_pair_cost(int N)
+{
+    return 13.0f * N * dsp_power_of_two(N) + 16.0f * N;
+}
+
+int dsps_conv_fft_size(int kernlen, int siglen)
+{
+    if (kernlen < 1) {
+        return 0;
+    }
+    int max_size = dsps_fft2r_initialized ? dsps_fft_w_table_size : CONFIG_DSP_MAX_FFT_SIZE;
+    int best_size = 0;
+    // Operations per output sample
+    float best_cost = CONV_FFT_DIRECT_OPS * kernlen;
+    int outputs = (siglen > 0) ? siglen + kernlen - 1 : 1;
+    if (siglen > 0) {
+        best_cost = CONV_FFT_DIRECT_OPS * kernlen * siglen / outputs;
+    }
+
+    for (int N = 2; N <= max_size; N <<= 1) {
+        int block = N - kernlen + 1;
+        if (block < 1) {
+            continue;
+        }
+        float cost;
+        if (siglen > 0) {
+            // Kernel FFT and pairs of blocks of the signal
+            int pairs = (siglen + 2 * block - 1) / (2 * block);
+            cost = (conv_fft_pair_cost(N) * (pairs + 0.5f)) / outputs;
+        } else {
+            cost = conv_fft_pair_cost(N) / (2 * block);
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_size = N;
+        }
+        if ((siglen > 0) && (block >= siglen)) {
+            break;
+        }
+    }
+    return best_size;
+}
+
+// Convolution of the two real blocks stored as real and imaginary parts of
+// conv->buff with the kernel: buff = conj(IFFT(FFT(buff) * FFT(kernel))).
+// The real part is the result of the first block, the imaginary part the
+// negated result of the second one (the kernel FFT is divided by N).
+static void conv_fft_pair(conv_fft_f32_t *conv)
+{
+    float *buff = conv->buff;
+    const float *h = conv->kernel;
+    int N = conv->fft_size;
+
+    dsps_fft2r_fc32(buff, N);
+    dsps_bit_rev_fc32(buff, N);
+    for (int i = 0; i < N; i++) {
+        float re = buff[2 * i] * h[2 * i] - buff[2 * i + 1] * h[2 * i + 1];
+        float im = buff[2 * i] * h[2 * i + 1] + buff[2 * i + 1] * h[2 * i];
+        // Inverse FFT as conj(FFT(conj(x)))
+        buff[2 * i] = re;
+        buff[2 * i + 1] = -im;
+    }
+    dsps_fft2r_fc32(buff, N);
+    dsps_bit_rev_fc32(buff, N);
+}
+
+// Copy of len real values to one part (0: real, 1: imaginary) of conv->buff, the rest of that part is cleared
+static void conv_fft_fill(conv_fft_f32_t *conv, int part, const float *src, int len)
+{
+    float *buff = &conv->buff[part];
+    int i;
+    for (i = 0; i < len; i++) {
+        buff[2 * i] = src[i];
+    }
+    for (; i < conv->fft_size; i++) {
+        buff[2 * i] = 0;
+    }
+}
+
+static esp_err_t conv_fft_init(conv_fft_f32_t *conv, const float *Kernel, int kernlen, int fft_size, bool reverse, bool stream)
+{
+    if (NULL == conv) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == Kernel) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (kernlen < 1) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_initialized) {
+        esp_err_t ret = dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    if (fft_size == 0) {
+        fft_size = dsps_conv_fft_size(kernlen, 0);
+    } else if ((!dsp_is_power_of_two(fft_size)) || (fft_size < kernlen) || (fft_size > dsps_fft_w_table_size)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+
+    memset(conv, 0, sizeof(conv_fft_f32_t));
+    conv->kernlen = kernlen;
+    conv->fft_size = fft_size;
+    if (fft_size == 0) {
+        // Direct path with dsps_corr_f32(): reversed convolution kernel
+        conv->block = CONV_FFT_DIRECT_BLOCK;
+        conv->kernel = (float *)malloc(kernlen * sizeof(float));
+        if (conv->kernel == NULL) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        for (int i = 0; i < kernlen; i++) {
+            conv->kernel[i] = reverse ? Kernel[i] : Kernel[kernlen - 1 - i];
+        }
+    } else {
+        conv->block = fft_size - kernlen + 1;
+        conv->kernel = (float *)malloc(2 * fft_size * sizeof(float));
+        conv->buff = (float *)malloc(2 * fft_size * sizeof(float));
+        if ((conv->kernel == NULL) || (conv->buff == NULL)) {
+            dsps_conv_fft_free_f32(conv);
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        // FFT of the convolution kernel divided by N (scale of the inverse FFT)
+        float *h = conv->kernel;
+        for (int i = 0; i < fft_size; i++) {
+            float value = 0;
+            if (i < kernlen) {
+                value = (reverse ? Kernel[kernlen - 1 - i] : Kernel[i]) / fft_size;
+            }
+            h[2 * i] = value;
+            h[2 * i + 1] = 0;
+        }
+        dsps_fft2r_fc32(h, fft_size);
+        dsps_bit_rev_fc32(h, fft_size);
+    }
+    if (stream) {
+        int line_len = kernlen - 1 + ((fft_size == 0) ? conv->block : 2 * conv->block);
+        conv->delay = (float *)calloc(line_len, sizeof(float));
+        if (conv->delay == NULL) {
+            dsps_conv_fft_free_f32(conv);
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_conv_fft_init_f32(conv_fft_f32_t *conv, const float *Kernel, int kernlen, int fft_size)
+{
+    return conv_fft_init(conv, Kernel, kernlen, fft_size, false, true);
+}
+
+esp_err_t dsps_corr_fft_init_f32(conv_fft_f32_t *conv, const float *Pattern, int patlen, int fft_size)
+{
+    return conv_fft_init(conv, Pattern, patlen, fft_size, true, true);
+}
+
+esp_err_t dsps_conv_fft_free_f32(conv_fft_f32_t *conv)
+{
+    free(conv->kernel);
+    free(conv->buff);
+    free(conv->delay);
+    conv->kernel = NULL;
+    conv->buff = NULL;
+    conv->delay = NULL;
+    return ESP_OK;
+}
+
+esp_err_t dsps_conv_fft_stream_f32(conv_fft_f32_t *conv, const float *input, float *output, int len)
+{
+    if ((NULL == conv) || (NULL == conv->delay)) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if (NULL == input) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    // Input line: last kernlen - 1 samples followed by the new ones
+    float *line = conv->delay;
+    int hist = conv->kernlen - 1;
+    int pos = 0;
+    while (pos < len) {
+        if (conv->fft_size == 0) {
+            int L = (len - pos < conv->block) ? len - pos : conv->block;
+            memcpy(&line[hist], &input[pos], L * sizeof(float));
+            dsps_corr_f32(line, hist + L, conv->kernel, conv->kernlen, &output[pos]);
+            memmove(line, &line[L], hist * sizeof(float));
+            pos += L;
+            continue;
+        }
+        // Overlap-save, two blocks per FFT
+        int L1 = (len - pos < conv->block) ? len - pos : conv->block;
+        int L2 = (len - pos - L1 < conv->block) ? len - pos - L1 : conv->block;
+        memcpy(&line[hist], &input[pos], (L1 + L2) * sizeof(float));
+        conv_fft_fill(conv, 0, line, hist + L1);
+        conv_fft_fill(conv, 1, &line[L1], (L2 > 0) ? hist + L2 : 0);
+        conv_fft_pair(conv);
+        // The first kernlen - 1 results have circular wrap
+        for (int n = 0; n < L1; n++) {
+            output[pos + n] = conv->buff[2 * (hist + n)];
+        }
+        for (int n = 0; n < L2; n++) {
+            output[pos + L1 + n] = -conv->buff[2 * (hist + n) + 1];
+        }
+        memmove(line, &line[L1 + L2], hist * sizeof(float));
+        pos += L1 + L2;
+    }
+    return ESP_OK;
+}
+
+// Accumulates len results of one part of conv->buff (0: real, 1: negated imaginary),
+// that start at index start of the convolution, to the output indices [first, first + count)
+static void conv_fft_add(conv_fft_f32_t *conv, int part, int start, int len, float *out, int first, int count)
+{
+    const float *result = &conv->buff[part];
+    float sign = part ? -1.0f : 1.0f;
+    int i0 = (first > start) ? first - start : 0;
+    int i1 = (first + count - start < len) ? first + count - start : len;
+    for (int i = i0; i < i1; i++) {
+        out[start + i - first] += sign * result[2 * i];
+    }
+}
+
+// Overlap-add: indices [first, first + count) of the convolution of Signal with the kernel
+static void conv_fft_ola(conv_fft_f32_t *conv, const float *Signal, int siglen, float *out, int first, int count)
+{
+    int B = conv->block;
+    int hist = conv->kernlen - 1;
+    memset(out, 0, count * sizeof(float));
+    for (int s = 0; s < siglen; s += 2 * B) {
+        int L1 = (siglen - s < B) ? siglen - s : B;
+        int L2 = (siglen - s - L1 < B) ? siglen - s - L1 : B;
+        conv_fft_fill(conv, 0, &Signal[s], L1);
+        conv_fft_fill(conv, 1, &Signal[s + L1], L2);
+        conv_fft_pair(conv);
+        conv_fft_add(conv, 0, s, L1 + hist, out, first, count);
+        if (L2 > 0) {
+            conv_fft_add(conv, 1, s + L1, L2 + hist, out, first, count);
+        }
+    }
+}
+
+esp_err_t dsps_conv_fft_f32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *convout)
+{
+    if (NULL == Signal) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == Kernel) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == convout) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    const float *sig = Signal;
+    const float *kern = Kernel;
+    int lsig = siglen;
+    int lkern = kernlen;
+
+    if (siglen < kernlen) {
+        sig = Kernel;
+        kern = Signal;
+        lsig = kernlen;
+        lkern = siglen;
+    }
+
+    int fft_size = dsps_conv_fft_size(lkern, lsig);
+    if (fft_size == 0) {
+        return dsps_conv_f32(Signal, siglen, Kernel, kernlen, convout);
+    }
+    conv_fft_f32_t conv;
+    esp_err_t ret = conv_fft_init(&conv, kern, lkern, fft_size, false, false);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    conv_fft_ola(&conv, sig, lsig, convout, 0, lsig + lkern - 1);
+    return dsps_conv_fft_free_f32(&conv);
+}
+
+esp_err_t dsps_corr_fft_f32(const float *Signal, const int siglen, const float *Pattern, const int patlen, float *dest)
+{
+    if (NULL == Signal) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == Pattern) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == dest) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (siglen < patlen) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    int fft_size = dsps_conv_fft_size(patlen, siglen);
+    if (fft_size == 0) {
+        return dsps_corr_f32(Signal, siglen, Pattern, patlen, dest);
+    }
+    conv_fft_f32_t conv;
+    esp_err_t ret = conv_fft_init(&conv, Pattern, patlen, fft_size, true, false);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Convolution with the reversed pattern, without the partial overlaps
+    conv_fft_ola(&conv, Signal, siglen, dest, patlen - 1, siglen - patlen + 1);
+    return dsps_conv_fft_free_f32(&conv);
+}
+
+esp_err_t dsps_ccorr_fft_f32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *corrvout)
+{
+    if (NULL == Signal) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == Kernel) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == corrvout) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    const float *sig = Signal;
+    const float *kern = Kernel;
+    int lsig = siglen;
+    int lkern = kernlen;
+
+    if (siglen < kernlen) {
+        sig = Kernel;
+        kern = Signal;
+        lsig = kernlen;
+        lkern = siglen;
+    }
+
+    int fft_size = dsps_conv_fft_size(lkern, lsig);
+    if (fft_size == 0) {
+        return dsps_ccorr_f32(Signal, siglen, Kernel, kernlen, corrvout);
+    }
+    conv_fft_f32_t conv;
+    esp_err_t ret = conv_fft_init(&conv, kern, lkern, fft_size, true, false);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Convolution with the reversed kernel
+    conv_fft_ola(&conv, sig, lsig, corrvout, 0, lsig + lkern - 1);
+    return dsps_conv_fft_free_f32(&conv);
+}
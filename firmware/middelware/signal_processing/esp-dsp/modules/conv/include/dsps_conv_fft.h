@@ -0,0 +1,143 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_conv_fft_H_
+#define _dsps_conv_fft_H_
+#include "dsp_err.h"
+
+#include "dsps_conv_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of f32 FFT convolution
+ *
+ * This structure is used by the streaming convolution and correlation internally.
+ * A user should access this structure only in case of extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_conv_fft_init_f32(...) and
+ * dsps_corr_fft_init_f32(...) functions, and freed by dsps_conv_fft_free_f32(...).
+ */
+typedef struct conv_fft_f32_s {
+    float  *kernel;     /*!< FFT of the kernel divided by fft_size (complex, fft_size elements), or reversed kernel for the direct path.*/
+    float  *buff;       /*!< Work buffer for the FFT (complex, fft_size elements).*/
+    float  *delay;      /*!< Input line: last kernlen - 1 input samples followed by the new ones.*/
+    int     kernlen;    /*!< Kernel length.*/
+    int     fft_size;   /*!< FFT size, 0 for the direct path.*/
+    int     block;      /*!< New input samples per FFT (fft_size - kernlen + 1) or per direct call.*/
+} conv_fft_f32_t;
+
+/**
+ * @brief   Convolution with FFT size selection
+ *
+ * Selects the FFT size that needs less operations per output sample to
+ * convolve a signal with a kernel, or the direct path when it is faster.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] kernlen: length of the kernel
+ * @param[in] siglen: length of the signal, 0 for streaming (unbounded) use
+ *
+ * @return
+ *      - FFT size (power of two)
+ *      - 0 if the direct convolution should be used
+ */
+int dsps_conv_fft_size(int kernlen, int siglen);
+
+/**@{*/
+/**
+ * @brief   initialize structure for streaming FFT convolution or correlation
+ *
+ * Function allocates the buffers, calculates the FFT of the kernel and clears the input line.
+ * The dsps_fft2r tables are initialized with CONFIG_DSP_MAX_FFT_SIZE if they were not.
+ * dsps_conv_fft_init_f32: output[n] = sum(Kernel[k]*input[n - k]), k = 0..kernlen-1 (FIR filter).
+ * dsps_corr_fft_init_f32: output[n] = sum(Pattern[m]*input[n - patlen + 1 + m]), m = 0..patlen-1,
+ * the correlation of the pattern with the last patlen input samples (matched filter).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param conv: pointer to convolution structure, that must be preallocated
+ * @param[in] Kernel: convolution kernel (Pattern for the correlation)
+ * @param[in] kernlen: length of the Kernel array
+ * @param[in] fft_size: FFT size (power of two, bigger than kernlen), 0 to select it with
+ *                      dsps_conv_fft_size(kernlen, 0), which could select the direct path
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if fft_size is not valid
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_conv_fft_init_f32(conv_fft_f32_t *conv, const float *Kernel, int kernlen, int fft_size);
+esp_err_t dsps_corr_fft_init_f32(conv_fft_f32_t *conv, const float *Pattern, int patlen, int fft_size);
+/**@}*/
+
+/**
+ * @brief   Streaming FFT convolution or correlation
+ *
+ * Function processes len input samples with overlap-save and returns len output samples.
+ * The last kernlen - 1 input samples are kept in the structure for the next call, so a
+ * signal could be processed in blocks of any length. Two blocks are processed with each
+ * complex FFT (as real and imaginary parts). The input and output arrays could be the same.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param conv: pointer to convolution structure, that must be initialized before
+ * @param[in] input: input array
+ * @param[out] output: output array
+ * @param[in] len: length of input and output arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_conv_fft_stream_f32(conv_fft_f32_t *conv, const float *input, float *output, int len);
+
+/**
+ * @brief   Free the buffers of the FFT convolution structure
+ *
+ * @param conv: pointer to convolution structure
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t dsps_conv_fft_free_f32(conv_fft_f32_t *conv);
+
+/**@{*/
+/**
+ * @brief   FFT convolution and correlation
+ *
+ * Same results as dsps_conv_f32(...), dsps_corr_f32(...) and dsps_ccorr_f32(...), computed
+ * with overlap-add FFT convolution. The FFT size is selected by dsps_conv_fft_size(...);
+ * short kernels use the direct functions. The buffers are allocated during the call.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] Signal: input array with signal
+ * @param[in] siglen: length of the input signal
+ * @param[in] Kernel: input array with convolution kernel (Pattern for the correlation)
+ * @param[in] kernlen: length of the Kernel array. For dsps_corr_fft_f32 siglen must be bigger than kernlen
+ * @param out: output array, with length siglen + kernlen - 1 (siglen - kernlen + 1 for dsps_corr_fft_f32)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_conv_fft_f32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *convout);
+esp_err_t dsps_corr_fft_f32(const float *Signal, const int siglen, const float *Pattern, const int patlen, float *dest);
+esp_err_t dsps_ccorr_fft_f32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *corrvout);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_conv_fft_H_
@@ -0,0 +1,108 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <malloc.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_conv.h"
+#include "dsps_corr.h"
+#include "dsps_conv_fft.h"
+#include "dsps_fft2r.h"
+#include "esp_attr.h"
+
+static const char *TAG = "dsps_conv_fft";
+
+#define sig_len     2048
+#define kern_len    200
+
+static float max_rel_error(const float *ref, const float *test, int len)
+{
+    float max_ref = 1e-30f;
+    float max_diff = 0;
+    for (int i = 0; i < len; i++) {
+        max_ref = fmaxf(max_ref, fabsf(ref[i]));
+        max_diff = fmaxf(max_diff, fabsf(ref[i] - test[i]));
+    }
+    return max_diff / max_ref;
+}
+
+TEST_CASE("dsps_conv_fft_f32 functionality", "[dsps]")
+{
+    float *x = (float *)malloc(sig_len * sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    float *y = (float *)malloc(kern_len * sizeof(float));
+    TEST_ASSERT_NOT_NULL(y);
+    float *ref = (float *)malloc((sig_len + kern_len) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(ref);
+    float *out = (float *)malloc((sig_len + kern_len) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(out);
+
+    for (int i = 0 ; i < sig_len ; i++) {
+        x[i] = (float)rand() / INT32_MAX - 0.5f;
+    }
+    for (int i = 0 ; i < kern_len ; i++) {
+        y[i] = (float)rand() / INT32_MAX - 0.5f;
+    }
+
+    dsps_conv_f32_ansi(x, sig_len, y, kern_len, ref);
+    TEST_ASSERT_EQUAL(ESP_OK, dsps_conv_fft_f32(x, sig_len, y, kern_len, out));
+    TEST_ASSERT_LESS_THAN(10, (int)(1e6 * max_rel_error(ref, out, sig_len + kern_len - 1)));
+
+    dsps_corr_f32_ansi(x, sig_len, y, kern_len, ref);
+    TEST_ASSERT_EQUAL(ESP_OK, dsps_corr_fft_f32(x, sig_len, y, kern_len, out));
+    TEST_ASSERT_LESS_THAN(10, (int)(1e6 * max_rel_error(ref, out, sig_len - kern_len + 1)));
+
+    // Streaming correlation in blocks of 100 samples
+    conv_fft_f32_t corr;
+    TEST_ASSERT_EQUAL(ESP_OK, dsps_corr_fft_init_f32(&corr, y, kern_len, 0));
+    for (int pos = 0; pos < sig_len; pos += 100) {
+        int len = (sig_len - pos < 100) ? sig_len - pos : 100;
+        TEST_ASSERT_EQUAL(ESP_OK, dsps_conv_fft_stream_f32(&corr, &x[pos], &out[pos], len));
+    }
+    dsps_conv_fft_free_f32(&corr);
+    TEST_ASSERT_LESS_THAN(10, (int)(1e6 * max_rel_error(ref, &out[kern_len - 1], sig_len - kern_len + 1)));
+
+    free(x);
+    free(y);
+    free(ref);
+    free(out);
+}
+
+TEST_CASE("dsps_conv_fft_f32 benchmark", "[dsps]")
+{
+    float *x = (float *)calloc(sig_len, sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    float *y = (float *)calloc(kern_len, sizeof(float));
+    TEST_ASSERT_NOT_NULL(y);
+    float *z = (float *)malloc(sig_len * sizeof(float));
+    TEST_ASSERT_NOT_NULL(z);
+
+    unsigned int start_b = xthal_get_ccount();
+    dsps_corr_f32_ansi(x, sig_len, y, kern_len, z);
+    unsigned int end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "dsps_corr_f32_ansi - %i cycles for signal %i and pattern %i", end_b - start_b, sig_len, kern_len);
+
+    start_b = xthal_get_ccount();
+    dsps_corr_fft_f32(x, sig_len, y, kern_len, z);
+    end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "dsps_corr_fft_f32 - %i cycles for signal %i and pattern %i (FFT size %i)", end_b - start_b, sig_len, kern_len, dsps_conv_fft_size(kern_len, sig_len));
+
+    free(x);
+    free(y);
+    free(z);
+}
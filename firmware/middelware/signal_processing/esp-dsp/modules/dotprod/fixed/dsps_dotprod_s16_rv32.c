@@ -0,0 +1,43 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_dotprod.h"
+#include "dsp_rv32_common.h"
+
+#if (dsps_dotprod_s16_rv32_enabled == 1)
+
+esp_err_t dsps_dotprod_s16_rv32(const int16_t *src1, const int16_t *src2, int16_t *dest, int len, int8_t shift)
+{
+    // Same rounding and result as dsps_dotprod_s16_ansi()
+    long long acc = 0x7fff >> shift;
+    int i = 0;
+
+    for (; i < len - 3; i += 4) {
+        acc -= dsp_rv32_pair_neg(src1[i], src2[i], src1[i + 1], src2[i + 1]);
+        acc -= dsp_rv32_pair_neg(src1[i + 2], src2[i + 2], src1[i + 3], src2[i + 3]);
+    }
+    for (; i < len; i++) {
+        acc += (int32_t)src1[i] * (int32_t)src2[i];
+    }
+
+    int final_shift = shift - 15;
+    if (final_shift > 0) {
+        *dest = (acc << final_shift);
+    } else {
+        *dest = (acc >> (-final_shift));
+    }
+    return ESP_OK;
+}
+
+#endif // dsps_dotprod_s16_rv32_enabled
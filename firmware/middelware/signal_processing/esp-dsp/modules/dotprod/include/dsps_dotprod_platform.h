@@ -22,6 +22,11 @@
 #endif //
 #endif // __XTENSA__
 
+#ifdef __riscv
+// RV32IMC integer kernels (ESP32-C3, ESP32-C6, ESP32-H2)
+#define dsps_dotprod_s16_rv32_enabled 1
+#endif // __riscv
+
 
 #if CONFIG_IDF_TARGET_ESP32S3
 #define dsps_dotprod_s16_aes3_enabled 1
@@ -0,0 +1,91 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+
+unsigned short reverse(unsigned short x, unsigned short N, int order);
+
+static inline int16_t sat16(int64_t value)
+{
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
+
+esp_err_t dsps_cplx2real2r_sc16_ansi(int16_t *data, int N)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_sc16_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if (2 * N > dsps_fft_w_table_sc16_size) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int order = dsp_power_of_two(N);
+    sc16_t *result = (sc16_t *)data;
+    sc16_t *table = (sc16_t *)dsps_fft_w_table_sc16;
+
+    // X[0] / 2N and X[N] / 2N (the FFT of N points already divides by N)
+    int32_t tmp_re = result[0].re;
+    result[0].re = sat16((tmp_re + result[0].im + 1) >> 1);
+    result[0].im = sat16((tmp_re - result[0].im + 1) >> 1);
+
+    for (int k = 1; k <= N / 2; k++) {
+        // 17 bit sums: E[k] and O[k] can be twice as big as the 16 bit Z[k]
+        sc16_t zk = result[k];
+        sc16_t znk = result[N - k];
+        int32_t sum_re = (int32_t)zk.re + znk.re;
+        int32_t sum_im = (int32_t)zk.im - znk.im;
+        int32_t diff_re = (int32_t)zk.re - znk.re;
+        int32_t diff_im = (int32_t)zk.im + znk.im;
+
+        // W = exp(-j*pi*k/N) in Q15, the table stores cos and sin of +pi*k/N
+        sc16_t w = table[reverse(k, N, order)];
+        int64_t tw_re = (int64_t)w.re * diff_im - (int64_t)w.im * diff_re;
+        int64_t tw_im = -(int64_t)w.re * diff_re - (int64_t)w.im * diff_im;
+
+        // (E[k] +- W*O[k]) / 2, rounded: sums << 15 to add them to the Q15 products
+        const int64_t round = 1 << 16;
+        result[k].re = sat16((((int64_t)sum_re << 15) + tw_re + round) >> 17);
+        result[k].im = sat16((((int64_t)sum_im << 15) + tw_im + round) >> 17);
+        result[N - k].re = sat16((((int64_t)sum_re << 15) - tw_re + round) >> 17);
+        result[N - k].im = sat16((tw_im - ((int64_t)sum_im << 15) + round) >> 17);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft2r_real_sc16(int16_t *data, int N)
+{
+    if ((N < 4) || !dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    // Even samples as real parts and odd samples as imaginary parts of N/2 complex values
+    esp_err_t ret = dsps_fft2r_sc16(data, N / 2);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = dsps_bit_rev_sc16_ansi(data, N / 2);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return dsps_cplx2real2r_sc16_ansi(data, N / 2);
+}
@@ -0,0 +1,70 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+
+#if (dsps_fft2r_sc16_rv32_enabled == 1)
+
+// Same results as dsps_fft2r_sc16_ansi_(). Each butterfly computes the twiddle
+// product once (4 mul instead of 8) and a * 0x7fff with a shift. The sums are
+// done in uint32_t: they wrap exactly like the int arithmetic of the ANSI
+// version, without signed overflow.
+esp_err_t dsps_fft2r_sc16_rv32_(int16_t *data, int N, int16_t *sc_table)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_sc16_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+
+    uint32_t *w = (uint32_t *)sc_table;
+    uint32_t *in_data = (uint32_t *)data;
+
+    int ie = 1;
+    for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+        uint32_t *a_ptr = in_data;
+        for (int j = 0; j < ie; j++) {
+            sc16_t cs;
+            cs.data = w[j];
+            const int32_t c = cs.re;
+            const int32_t s = cs.im;
+            uint32_t *m_ptr = a_ptr + N2;
+            for (int i = 0; i < N2; i++) {
+                sc16_t a, m, out;
+                a.data = a_ptr[i];
+                m.data = m_ptr[i];
+                uint32_t re = (uint32_t)(c * m.re) + (uint32_t)(s * m.im);
+                uint32_t im = (uint32_t)(c * m.im) - (uint32_t)(s * m.re);
+                // a * 0x7fff plus rounding
+                uint32_t a_re = ((uint32_t)a.re << 15) - (uint32_t)a.re + 0x7fff;
+                uint32_t a_im = ((uint32_t)a.im << 15) - (uint32_t)a.im + 0x7fff;
+
+                out.re = (int16_t)((int32_t)(a_re - re) >> 16);
+                out.im = (int16_t)((int32_t)(a_im - im) >> 16);
+                m_ptr[i] = out.data;
+                out.re = (int16_t)((int32_t)(a_re + re) >> 16);
+                out.im = (int16_t)((int32_t)(a_im + im) >> 16);
+                a_ptr[i] = out.data;
+            }
+            a_ptr += 2 * N2;
+        }
+        ie <<= 1;
+    }
+    return ESP_OK;
+}
+
+#endif // dsps_fft2r_sc16_rv32_enabled
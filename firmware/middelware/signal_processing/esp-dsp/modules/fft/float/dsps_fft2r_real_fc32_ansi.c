@@ -0,0 +1,82 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+
+unsigned short reverse(unsigned short x, unsigned short N, int order);
+
+esp_err_t dsps_cplx2real2r_fc32_ansi(float *data, int N)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    // The twiddles of the real FFT of 2*N points are the first N entries of the (bit reversed) table
+    if (2 * N > dsps_fft_w_table_size) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int order = dsp_power_of_two(N);
+    fc32_t *result = (fc32_t *)data;
+    fc32_t *table = (fc32_t *)dsps_fft_w_table_fc32;
+
+    // X[0] and X[N] are real: stored as the real and imaginary parts of the first element
+    float tmp_re = result[0].re;
+    result[0].re = tmp_re + result[0].im;
+    result[0].im = tmp_re - result[0].im;
+
+    for (int k = 1; k <= N / 2; k++) {
+        // Z[k] = E[k] + j*O[k]: E and O are the FFTs of the even and the odd samples
+        fc32_t zk = result[k];
+        fc32_t znk = result[N - k];
+        fc32_t sum, diff;
+        sum.re = zk.re + znk.re;    // 2*E[k]
+        sum.im = zk.im - znk.im;
+        diff.re = zk.re - znk.re;   // 2*j*O[k]
+        diff.im = zk.im + znk.im;
+
+        // W = exp(-j*pi*k/N), the table stores cos and sin of +pi*k/N
+        fc32_t w = table[reverse(k, N, order)];
+        fc32_t tw;                  // 2*W*O[k]
+        tw.re = w.re * diff.im - w.im * diff.re;
+        tw.im = -w.re * diff.re - w.im * diff.im;
+
+        // X[k] = E[k] + W*O[k], X[N-k] = conj(E[k] - W*O[k])
+        result[k].re = 0.5f * (sum.re + tw.re);
+        result[k].im = 0.5f * (sum.im + tw.im);
+        result[N - k].re = 0.5f * (sum.re - tw.re);
+        result[N - k].im = 0.5f * (tw.im - sum.im);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft2r_real_fc32(float *data, int N)
+{
+    if ((N < 4) || !dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    // Even samples as real parts and odd samples as imaginary parts of N/2 complex values
+    esp_err_t ret = dsps_fft2r_fc32(data, N / 2);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = dsps_bit_rev_fc32(data, N / 2);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return dsps_cplx2real2r_fc32_ansi(data, N / 2);
+}
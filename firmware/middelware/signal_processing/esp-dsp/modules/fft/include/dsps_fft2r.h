@@ -81,6 +81,7 @@ void dsps_fft2r_deinit_sc16(void);
  * Complex FFT of radix 2
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_rv32) is optimized for RISC-V chips (ESP32-C6, sc16 only), with the same results as _ansi.
  *
  * @param[inout] data: input/output complex array. An elements located: Re[0], Im[0], ... Re[N-1], Im[N-1]
  *               result of FFT will be stored to this array.
@@ -97,6 +98,7 @@ esp_err_t dsps_fft2r_fc32_aes3_(float *data, int N, float *w);
 esp_err_t dsps_fft2r_sc16_ansi_(int16_t *data, int N, int16_t *w);
 esp_err_t dsps_fft2r_sc16_ae32_(int16_t *data, int N, int16_t *w);
 esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
+esp_err_t dsps_fft2r_sc16_rv32_(int16_t *data, int N, int16_t *w);
 /**@}*/
 // This is workaround because linker generates permanent error when assembler uses
 // direct access to the table pointer
@@ -106,6 +108,7 @@ esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
 #define dsps_fft2r_sc16_aes3(data, N) dsps_fft2r_sc16_aes3_(data, N, dsps_fft_w_table_sc16)
 #define dsps_fft2r_fc32_ansi(data, N) dsps_fft2r_fc32_ansi_(data, N, dsps_fft_w_table_fc32)
 #define dsps_fft2r_sc16_ansi(data, N) dsps_fft2r_sc16_ansi_(data, N, dsps_fft_w_table_sc16)
+#define dsps_fft2r_sc16_rv32(data, N) dsps_fft2r_sc16_rv32_(data, N, dsps_fft_w_table_sc16)
 
 
 /**@{*/
@@ -194,6 +197,55 @@ esp_err_t dsps_cplx2reC_sc16(int16_t *data, int N);
  */
 esp_err_t dsps_cplx2real_sc16_ansi(int16_t *data, int N);
 /**@}*/
+
+/**@{*/
+/**
+ * @brief      Convert the FFT of packed real samples to the FFT of the real signal
+ *
+ * Post-processing of the real FFT: the input is the FFT (bit reversed back to the
+ * normal order) of N complex values holding 2*N real samples (even samples as real
+ * parts, odd samples as imaginary parts). The result is the first half of the FFT
+ * of the 2*N real samples: X[0] and X[N] (both real) as the real and imaginary parts
+ * of the first element, and X[1] .. X[N-1] as complex elements.
+ * Uses the table of dsps_fft2r_init_fc32(...) / dsps_fft2r_init_sc16(...), that must
+ * be generated for 2*N points or more.
+ * The float result is not scaled. The sc16 result is the FFT divided by 2*N, as the
+ * sc16 FFT of 2*N complex values, with 32 bit intermediate values (no overflow).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[inout] data: result of the FFT of N complex elements, 2*N values.
+ *               result will be stored to the same array.
+ * @param[in] N: Number of complex elements in input array
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_cplx2real2r_fc32_ansi(float *data, int N);
+esp_err_t dsps_cplx2real2r_sc16_ansi(int16_t *data, int N);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief      FFT of a real signal
+ *
+ * FFT of N real samples computed with a complex FFT of N/2 points (dsps_fft2r_fc32 /
+ * dsps_fft2r_sc16, the even samples as real parts and the odd samples as imaginary
+ * parts), bit reverse and dsps_cplx2real2r_fc32_ansi(...) / dsps_cplx2real2r_sc16_ansi(...).
+ * Half of the work of the complex FFT of N points with zero imaginary parts.
+ *
+ * @param[inout] data: input array of N real samples. The result is stored in the same
+ *               array: Re(X[0]), Re(X[N/2]), Re(X[1]), Im(X[1]), ... Re(X[N/2-1]), Im(X[N/2-1]).
+ *               The sc16 result is divided by N (same scale as dsps_fft2r_sc16 of N points).
+ * @param[in] N: Number of real samples (power of two, 4 or more, up to the size of the table)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft2r_real_fc32(float *data, int N);
+esp_err_t dsps_fft2r_real_sc16(int16_t *data, int N);
+/**@}*/
 esp_err_t dsps_cplx2real256_fc32_ansi(float *data);
 
 esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
@@ -218,6 +270,8 @@ esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
 #define dsps_fft2r_sc16 dsps_fft2r_sc16_aes3
 #elif (dsps_fft2r_sc16_ae32_enabled == 1)
 #define dsps_fft2r_sc16 dsps_fft2r_sc16_ae32
+#elif (dsps_fft2r_sc16_rv32_enabled == 1)
+#define dsps_fft2r_sc16 dsps_fft2r_sc16_rv32
 #else
 #define dsps_fft2r_sc16 dsps_fft2r_sc16_ansi
 #endif
@@ -239,6 +293,12 @@ esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
 #define dsps_cplx2reC_fc32 dsps_cplx2reC_fc32_ansi
 #define dsps_bit_rev_sc16 dsps_bit_rev_sc16_ansi
 #define dsps_bit_rev_lookup_fc32 dsps_bit_rev_lookup_fc32_ansi
+// The RISC-V kernels give the same results as the ANSI ones
+#if (dsps_fft2r_sc16_rv32_enabled == 1)
+#define dsps_fft2r_sc16 dsps_fft2r_sc16_rv32
+#else
+#define dsps_fft2r_sc16 dsps_fft2r_sc16_ansi
+#endif
 
 #endif // CONFIG_DSP_OPTIMIZED
 
@@ -0,0 +1,102 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <malloc.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fft2r.h"
+#include "esp_attr.h"
+
+static const char *TAG = "dsps_fft2r_real";
+
+#define N_real      1024
+
+TEST_CASE("dsps_fft2r_real_fc32 functionality", "[dsps]")
+{
+    float *x = (float *)malloc(N_real * sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    float *ref = (float *)malloc(2 * N_real * sizeof(float));
+    TEST_ASSERT_NOT_NULL(ref);
+
+    TEST_ASSERT_EQUAL(ESP_OK, dsps_fft2r_init_fc32(NULL, N_real));
+    for (int i = 0 ; i < N_real ; i++) {
+        x[i] = (float)rand() / INT32_MAX - 0.5f;
+        ref[2 * i + 0] = x[i];
+        ref[2 * i + 1] = 0;
+    }
+    dsps_fft2r_fc32(ref, N_real);
+    dsps_bit_rev_fc32(ref, N_real);
+
+    unsigned int start_b = xthal_get_ccount();
+    TEST_ASSERT_EQUAL(ESP_OK, dsps_fft2r_real_fc32(x, N_real));
+    unsigned int end_b = xthal_get_ccount();
+
+    // x[0] = X[0], x[1] = X[N/2], x[2*k], x[2*k+1] = X[k]
+    float max_diff = fmaxf(fabsf(x[0] - ref[0]), fabsf(x[1] - ref[N_real]));
+    float max_ref = 1e-30f;
+    for (int k = 1 ; k < N_real / 2 ; k++) {
+        max_diff = fmaxf(max_diff, fabsf(x[2 * k + 0] - ref[2 * k + 0]));
+        max_diff = fmaxf(max_diff, fabsf(x[2 * k + 1] - ref[2 * k + 1]));
+        max_ref = fmaxf(max_ref, hypotf(ref[2 * k + 0], ref[2 * k + 1]));
+    }
+    TEST_ASSERT_LESS_THAN(10, (int)(1e6 * max_diff / max_ref));
+    ESP_LOGI(TAG, "dsps_fft2r_real_fc32 - %i cycles for N = %i", end_b - start_b, N_real);
+
+    dsps_fft2r_deinit_fc32();
+    free(x);
+    free(ref);
+}
+
+TEST_CASE("dsps_fft2r_real_sc16 functionality", "[dsps]")
+{
+    int16_t *x = (int16_t *)malloc(N_real * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(x);
+    int16_t *ref = (int16_t *)malloc(2 * N_real * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(ref);
+
+    TEST_ASSERT_EQUAL(ESP_OK, dsps_fft2r_init_sc16(NULL, N_real));
+    int check_bin = 32;
+    for (int i = 0 ; i < N_real ; i++) {
+        x[i] = (int16_t)(16384 * cosf(2 * M_PI * check_bin * i / N_real));
+        ref[2 * i + 0] = x[i];
+        ref[2 * i + 1] = 0;
+    }
+    dsps_fft2r_sc16(ref, N_real);
+    dsps_bit_rev_sc16_ansi(ref, N_real);
+
+    unsigned int start_b = xthal_get_ccount();
+    TEST_ASSERT_EQUAL(ESP_OK, dsps_fft2r_real_sc16(x, N_real));
+    unsigned int end_b = xthal_get_ccount();
+
+    // Both transforms are scaled by 1/N: the tone is 16384 / 2 = 8192 in its bin
+    int max_diff = 0;
+    for (int k = 1 ; k < N_real / 2 ; k++) {
+        int diff_re = abs(x[2 * k + 0] - ref[2 * k + 0]);
+        int diff_im = abs(x[2 * k + 1] - ref[2 * k + 1]);
+        max_diff = (diff_re > max_diff) ? diff_re : max_diff;
+        max_diff = (diff_im > max_diff) ? diff_im : max_diff;
+    }
+    TEST_ASSERT_LESS_THAN(8, abs(x[2 * check_bin] - 8192));
+    TEST_ASSERT_LESS_OR_EQUAL(2, max_diff);
+    ESP_LOGI(TAG, "dsps_fft2r_real_sc16 - %i cycles for N = %i", end_b - start_b, N_real);
+
+    dsps_fft2r_deinit_sc16();
+    free(x);
+    free(ref);
+}
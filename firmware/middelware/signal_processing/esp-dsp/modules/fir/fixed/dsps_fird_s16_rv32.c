@@ -0,0 +1,80 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fir.h"
+#include "dsp_rv32_common.h"
+
+#if (dsps_fird_s16_rv32_enabled == 1)
+
+// Products of len delay samples and len coefficients, the coefficients read backwards from coeffs
+static inline long long dot_rev(const int16_t *coeffs, const int16_t *delay, int len)
+{
+    long long acc = 0;
+    int n = 0;
+    for (; n < len - 3; n += 4) {
+        acc -= dsp_rv32_pair_neg(coeffs[-n], delay[n], coeffs[-n - 1], delay[n + 1]);
+        acc -= dsp_rv32_pair_neg(coeffs[-n - 2], delay[n + 2], coeffs[-n - 3], delay[n + 3]);
+    }
+    for (; n < len; n++) {
+        acc += (int32_t)coeffs[-n] * (int32_t)delay[n];
+    }
+    return acc;
+}
+
+int32_t dsps_fird_s16_rv32(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len)
+{
+    int32_t input_pos = 0;
+    int32_t result = 0;
+    long long rounding = 0;
+    const int32_t final_shift = fir->shift - 15;
+
+    // Same rounding and results as dsps_fird_s16_ansi()
+    rounding = (long long)(fir->rounding_val);
+
+    if (fir->shift >= 0) {
+        rounding = (rounding >> fir->shift) & 0xFFFFFFFFFF;         // 40-bit mask
+    } else {
+        rounding = (rounding << (-fir->shift)) & 0xFFFFFFFFFF;      // 40-bit mask
+    }
+
+    // len is already a length of the *output array, calculated as (length of the input array / decimation)
+    for (int i = 0; i < len; i++) {
+
+        for (int j = 0; j < fir->decim - fir->d_pos; j++) {
+
+            if (fir->pos >= fir->coeffs_len) {
+                fir->pos = 0;
+            }
+            fir->delay[fir->pos++] = input[input_pos++];
+        }
+        fir->d_pos = 0;
+
+        // Oldest samples (pos to the end of the delay line) with the last coefficients
+        long long acc = rounding;
+        acc += dot_rev(&fir->coeffs[fir->coeffs_len - 1], &fir->delay[fir->pos], fir->coeffs_len - fir->pos);
+        if (fir->pos > 0) {
+            acc += dot_rev(&fir->coeffs[fir->pos - 1], fir->delay, fir->pos);
+        }
+
+        if (final_shift > 0) {
+            output[result++] = (int16_t)(acc << final_shift);
+        } else {
+            output[result++] = (int16_t)(acc >> (-final_shift));
+        }
+
+    }
+    return result;
+}
+
+#endif // dsps_fird_s16_rv32_enabled
@@ -166,6 +166,7 @@ int dsps_fird_f32_aes3(fir_f32_t *fir, const float *input, float *output, int le
  * Function implements FIR filter with decimation
  * The extension (_ansi) uses ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_rv32) is optimized for RISC-V chips (ESP32-C6), with the same results as _ansi.
  *
  * @param fir: pointer to fir filter structure, that must be initialized before
  * @param input: input array
@@ -178,6 +179,7 @@ int dsps_fird_f32_aes3(fir_f32_t *fir, const float *input, float *output, int le
 int32_t dsps_fird_s16_ansi(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
 int32_t dsps_fird_s16_ae32(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
 int32_t dsps_fird_s16_aes3(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
+int32_t dsps_fird_s16_rv32(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
 /**@}*/
 
 
@@ -260,6 +262,9 @@ esp_err_t dsps_16_array_rev(int16_t *arr, int16_t len);
 #elif (dsps_fird_s16_aes3_enabled == 1)
 #define dsps_fird_s16 dsps_fird_s16_aes3
 
+#elif (dsps_fird_s16_rv32_enabled == 1)
+#define dsps_fird_s16 dsps_fird_s16_rv32
+
 #else
 #define dsps_fird_s16 dsps_fird_s16_ansi
 #endif
@@ -268,7 +273,12 @@ esp_err_t dsps_16_array_rev(int16_t *arr, int16_t len);
 
 #define dsps_fir_f32 dsps_fir_f32_ansi
 #define dsps_fird_f32 dsps_fird_f32_ansi
+// The RISC-V kernels give the same results as the ANSI ones
+#if (dsps_fird_s16_rv32_enabled == 1)
+#define dsps_fird_s16 dsps_fird_s16_rv32
+#else
 #define dsps_fird_s16 dsps_fird_s16_ansi
+#endif
 
 #endif // CONFIG_DSP_OPTIMIZED
 
@@ -28,4 +28,9 @@
 #endif //
 #endif // __XTENSA__
 
+#ifdef __riscv
+// RV32IMC integer kernels (ESP32-C3, ESP32-C6, ESP32-H2)
+#define dsps_fird_s16_rv32_enabled 1
+#endif // __riscv
+
 #endif // _dsps_fir_platform_H_
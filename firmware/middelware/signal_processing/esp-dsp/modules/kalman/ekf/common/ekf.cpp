@@ -15,6 +15,9 @@
 #include "ekf.h"
 #include <float.h>
 
+// Arena size (floats) for the temporary matrices of a filter with x states and w noise inputs
+#define EKF_ARENA_SIZE(x, w) (12 * (x) * (x) + 4 * (x) * (w) + 64 * dspm::Mat::ARENA_HEADER)
+
 ekf::ekf(int x, int w) : NUMX(x),
     NUMW(w),
     X(*new dspm::Mat(x, 1)),
@@ -22,7 +25,9 @@ ekf::ekf(int x, int w) : NUMX(x),
     F(*new dspm::Mat(x, x)),
     G(*new dspm::Mat(x, w)),
     P(*new dspm::Mat(x, x)),
-    Q(*new dspm::Mat(w, w))
+    Q(*new dspm::Mat(w, w)),
+    sequential_update(false),
+    arena(new float[EKF_ARENA_SIZE(x, w)], EKF_ARENA_SIZE(x, w))
 {
 
     this->P *= 0;
@@ -47,10 +52,12 @@ ekf::~ekf()
 
     delete this->HP;
     delete this->Km;
+    delete[] this->arena.buffer;
 }
 
 void ekf::Process(float *u, float dt)
 {
+    dspm::Mat::ArenaScope scope(this->arena);
     this->LinearizeFG(this->X, (float *)u);
     this->RungeKutta(this->X, u, dt);
     this->CovariancePrediction(dt);
@@ -78,13 +85,19 @@ void ekf::RungeKutta(dspm::Mat &x, float *U, float dt)
 }
 
 dspm::Mat ekf::SkewSym4x4(float w[3])
+{
+    dspm::SMat<4, 4> result;
+    SkewSym4x4(w, result);
+    return result.toMat();
+}
+
+void ekf::SkewSym4x4(const float *w, dspm::SMat<4, 4> &result)
 {
     //={    0,  -w[0],  -w[1],  -w[2],
     //   w[0],      0,   w[2],  -w[1],
     //   w[1],  -w[2],      0,   w[0],
     //   w[2],   w[1],  -w[0],     0 };
 
-    dspm::Mat result(4, 4);
     result.data[0] = 0;
     result.data[1] = -w[0];
     result.data[2] = -w[1];
@@ -104,14 +117,17 @@ dspm::Mat ekf::SkewSym4x4(float w[3])
     result.data[13] = w[1];
     result.data[14] = -w[0];
     result.data[15] = 0;
-
-    return result;
 }
 
 dspm::Mat ekf::qProduct(float *q)
 {
-    dspm::Mat result(4, 4);
+    dspm::SMat<4, 4> result;
+    qProduct(q, result);
+    return result.toMat();
+}
 
+void ekf::qProduct(const float *q, dspm::SMat<4, 4> &result)
+{
     result.data[0] = q[0];
     result.data[1] = -q[1];
     result.data[2] = -q[2];
@@ -131,8 +147,6 @@ dspm::Mat ekf::qProduct(float *q)
     result.data[13] = -q[2];
     result.data[14] = q[1];
     result.data[15] = q[0];
-
-    return result;
 }
 
 void ekf::CovariancePrediction(float dt)
@@ -147,10 +161,24 @@ void ekf::CovariancePrediction(float dt)
 
 void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
 {
+    dspm::Mat::ArenaScope scope(this->arena);
     float HPHR, Error;
     dspm::Mat Y(measured, H.rows, 1);
     dspm::Mat Z(expected, H.rows, 1);
 
+    if (this->sequential_update) {
+        dspm::Mat X0 = this->X;
+        for (int m = 0; m < H.rows; m++) {
+            // Expected value for the state updated by the previous rows: Z + H*(X - X0)
+            float expected_m = Z(m, 0);
+            for (int k = 0; k < this->NUMX; k++) {
+                expected_m += H(m, k) * (X(k, 0) - X0(k, 0));
+            }
+            this->UpdateScalar(&H(m, 0), Y(m, 0), expected_m, R[m]);
+        }
+        return;
+    }
+
     for (int m = 0; m < H.rows; m++) {
         for (int j = 0; j < this->NUMX; j++) {
             // Find Hp = H*P
@@ -185,15 +213,58 @@ void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
     }
 }
 
+void ekf::UpdateScalar(const float *h, float measured, float expected, float R)
+{
+    float HPHR, Error;
+
+    for (int j = 0; j < this->NUMX; j++) {
+        // Find Hp = H*P
+        HP[j] = 0;
+    }
+    for (int k = 0; k < this->NUMX; k++) {
+        if (h[k] == 0) {
+            continue;
+        }
+        for (int j = 0; j < this->NUMX; j++) {
+            // Find Hp = H*P
+            HP[j] += h[k] * P(k, j);
+        }
+    }
+    HPHR = R; // Find  HPHR = H*P*H' + R
+    for (int k = 0; k < this->NUMX; k++) {
+        HPHR += HP[k] * h[k];
+    }
+    float invHPHR = 1.0f / HPHR;
+    for (int k = 0; k < this->NUMX; k++) {
+        Km[k] = HP[k] * invHPHR; // find K = HP/HPHR
+    }
+    for (int i = 0; i < this->NUMX; i++) {
+        // Find P(m) = (I - K*H)*P(m-1)*(I - K*H)' + K*R*K'
+        //           = P(m-1) - K*HP - HP'*K' + HPHR*K*K'
+        float HPHRK = HPHR * Km[i];
+        for (int j = i; j < NUMX; j++) {
+            P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j] - HP[i] * Km[j] + HPHRK * Km[j];
+        }
+    }
+
+    Error = measured - expected;
+    for (int i = 0; i < this->NUMX; i++) {
+        // Find X(m)= X(m-1) + K*Error
+        X(i, 0) = X(i, 0) + Km[i] * Error;
+    }
+}
+
 void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
 {
+    dspm::Mat::ArenaScope scope(this->arena);
     dspm::Mat h_t = H.t();
     dspm::Mat S = H * P * h_t; // +diag(R);
     for (size_t i = 0; i < H.rows; i++) {
         S(i, i) += R[i];
     }
 
-    dspm::Mat S_ = S.pinv(); // 1 / S
+    // S is a covariance (symmetric positive definite): LDL' inverse
+    dspm::Mat S_ = S.inverseSPD(); // 1 / S
 
     dspm::Mat K = (P * h_t) * S_;
     this->P = (dspm::Mat::eye(this->NUMX) - K * H) * P;
@@ -206,12 +277,18 @@ void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
 }
 
 dspm::Mat ekf::quat2rotm(float q[4])
+{
+    dspm::SMat<3, 3> Rm;
+    quat2rotm(q, Rm);
+    return Rm.toMat();
+}
+
+void ekf::quat2rotm(const float q[4], dspm::SMat<3, 3> &Rm)
 {
     float q0 = q[0];
     float q1 = q[1];
     float q2 = q[2];
     float q3 = q[3];
-    dspm::Mat Rm(3, 3);
 
     Rm(0, 0) = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
     Rm(1, 0) = 2.0f * (q1 * q2 + q0 * q3);
@@ -222,8 +299,6 @@ dspm::Mat ekf::quat2rotm(float q[4])
     Rm(0, 2) = 2.0f * (q1 * q3 + q0 * q2);
     Rm(1, 2) = 2.0f * (q2 * q3 - q0 * q1);
     Rm(2, 2) = (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3);
-
-    return Rm;
 }
 
 dspm::Mat ekf::quat2eul(const float q[4])
@@ -365,7 +440,12 @@ dspm::Mat ekf::rotm2quat(dspm::Mat &m)
 
 dspm::Mat ekf::dFdq(dspm::Mat &vector, dspm::Mat &q)
 {
-    dspm::Mat result(3, 4);
+    return dFdq(dspm::SMat<3, 1>(vector.data), dspm::SMat<4, 1>(q.data)).toMat();
+}
+
+dspm::SMat<3, 4> ekf::dFdq(const dspm::SMat<3, 1> &vector, const dspm::SMat<4, 1> &q)
+{
+    dspm::SMat<3, 4> result;
     result(0, 0) = q.data[0] * vector.data[0] - q.data[3] * vector.data[1] + q.data[2] * vector.data[2];
     result(0, 1) = q.data[1] * vector.data[0] + q.data[2] * vector.data[1] + q.data[3] * vector.data[2];
     result(0, 2) = -q.data[2] * vector.data[0] + q.data[1] * vector.data[1] + q.data[0] * vector.data[2];
@@ -387,7 +467,12 @@ dspm::Mat ekf::dFdq(dspm::Mat &vector, dspm::Mat &q)
 
 dspm::Mat ekf::dFdq_inv(dspm::Mat &vector, dspm::Mat &q)
 {
-    dspm::Mat result(3, 4);
+    return dFdq_inv(dspm::SMat<3, 1>(vector.data), dspm::SMat<4, 1>(q.data)).toMat();
+}
+
+dspm::SMat<3, 4> ekf::dFdq_inv(const dspm::SMat<3, 1> &vector, const dspm::SMat<4, 1> &q)
+{
+    dspm::SMat<3, 4> result;
     result(0, 0) = q.data[0] * vector.data[0] + q.data[3] * vector.data[1] - q.data[2] * vector.data[2];
     result(0, 1) = q.data[1] * vector.data[0] + q.data[2] * vector.data[1] + q.data[3] * vector.data[2];
     result(0, 2) = -q.data[2] * vector.data[0] + q.data[1] * vector.data[1] - q.data[0] * vector.data[2];
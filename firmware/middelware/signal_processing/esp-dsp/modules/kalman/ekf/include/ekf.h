@@ -21,6 +21,7 @@
 #include <math.h>
 #include <stdint.h>
 #include <mat.h>
+#include <smat.h>
 
 /**
  * The ekf is a base class for Extended Kalman Filter.
@@ -133,12 +134,25 @@ public:
      * Update of current state by measured values.
      * Optimized method for non correlated values
      * Calculate Kalman gain and update matrix P and vector X.
+     * With sequential_update every row of H is processed by UpdateScalar().
      * @param[in] H: derivative matrix
      * @param[in] measured: array of measured values
      * @param[in] expected: array of expected values
      * @param[in] R: measurement noise covariance values
      */
     virtual void Update(dspm::Mat &H, float *measured, float *expected, float *R);
+    /**
+     * Update of current state by one measured value (sequential update).
+     * Calculate Kalman gain and update matrix P and vector X without any
+     * matrix inverse, in O(NUMX^2). P is updated with the Joseph form
+     * P = (I - K*H)*P*(I - K*H)' + K*R*K', that keeps it symmetric and
+     * positive definite with the float rounding errors.
+     * @param[in] h: derivative row, NUMX values (zero values are skipped)
+     * @param[in] measured: measured value
+     * @param[in] expected: expected value for the current state
+     * @param[in] R: measurement noise variance
+     */
+    virtual void UpdateScalar(const float *h, float measured, float expected, float R);
     /**
      * Update of current state by measured values.
      * This method just as a reference for research purpose.
@@ -150,6 +164,16 @@ public:
      */
     virtual void UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R);
 
+    /**
+     * Method used by Update().
+     * false (default): every row of H uses the expected value of the state
+     * before the update, and P = P - K*H*P.
+     * true: sequential scalar updates with UpdateScalar(), the expected values
+     * are corrected by the state changes of the previous rows, so the result
+     * is the one of UpdateRef() (diagonal R) without the matrix inverse.
+    */
+    bool sequential_update;
+
     /**
      * Matrix for intermidieve calculations
     */
@@ -159,6 +183,14 @@ public:
     */
     float *Km;
 
+    /**
+     * Arena for the temporary matrices of Process(), Update() and UpdateRef().
+     * The methods of derived classes that create matrices on every step should
+     * also open a dspm::Mat::ArenaScope on it. With it the filter does not use
+     * the heap after the constructor.
+    */
+    dspm::Mat::Arena arena;
+
 public:
     // Additional universal helper methods
     /**
@@ -170,6 +202,13 @@ public:
      */
     static dspm::Mat quat2rotm(float q[4]);
 
+    /**
+     * Convert quaternion to rotation matrix (fixed size).
+     * @param[in] q: quaternion
+     * @param[out] Rm: rotation matrix 3x3
+     */
+    static void quat2rotm(const float q[4], dspm::SMat<3, 3> &Rm);
+
     /**
      * Convert rotation matrix to quaternion.
      * @param[in] R: rotation matrix
@@ -215,6 +254,16 @@ public:
      */
     static dspm::Mat dFdq(dspm::Mat &vector, dspm::Mat &quat);
 
+    /**
+     * Df/dq:  Derivative of vector by quaternion (fixed size).
+     * @param[in] vector: input vector
+     * @param[in] quat: quaternion
+     *
+     * @return
+     *      - Derivative matrix 3x4
+     */
+    static dspm::SMat<3, 4> dFdq(const dspm::SMat<3, 1> &vector, const dspm::SMat<4, 1> &quat);
+
     /**
      * Df/dq: Derivative of vector by inverted quaternion.
      * @param[in] vector: input vector
@@ -225,6 +274,16 @@ public:
      */
     static dspm::Mat dFdq_inv(dspm::Mat &vector, dspm::Mat &quat);
 
+    /**
+     * Df/dq: Derivative of vector by inverted quaternion (fixed size).
+     * @param[in] vector: input vector
+     * @param[in] quat: quaternion
+     *
+     * @return
+     *      - Derivative matrix 3x4
+     */
+    static dspm::SMat<3, 4> dFdq_inv(const dspm::SMat<3, 1> &vector, const dspm::SMat<4, 1> &quat);
+
     /**
      * Make skew-symmetric matrix of vector.
      * @param[in] w: source vector
@@ -234,6 +293,13 @@ public:
      */
     static dspm::Mat SkewSym4x4(float *w);
 
+    /**
+     * Make skew-symmetric matrix of vector (fixed size).
+     * @param[in] w: source vector
+     * @param[out] result: skew-symmetric matrix 4x4
+     */
+    static void SkewSym4x4(const float *w, dspm::SMat<4, 4> &result);
+
     // q product
     // Rl = [q(1) - q(2) - q(3) - q(4); ...
     //      q(2)  q(1) - q(4)  q(3); ...
@@ -249,6 +315,13 @@ public:
      */
     static dspm::Mat qProduct(float *q);
 
+    /**
+     * Make right quaternion-product matrices (fixed size).
+     * @param[in] q: source quaternion
+     * @param[out] result: right quaternion-product matrix 4x4
+     */
+    static void qProduct(const float *q, dspm::SMat<4, 4> &result);
+
 };
 
 #endif // _ekf_h_
@@ -57,14 +57,16 @@ dspm::Mat ekf_imu13states::StateXdot(dspm::Mat &x, float *u)
     float wz = u[2] - x(6, 0);
 
     float w[] = {wx, wy, wz};
-    dspm::Mat q = dspm::Mat(x.data, 4, 1);
+    dspm::SMat<4, 1> q(x.data);
 
     // qdot = Q * w
-    dspm::Mat Omega = 0.5 * SkewSym4x4(w);
-    dspm::Mat qdot = Omega * q;
+    dspm::SMat<4, 4> Omega;
+    SkewSym4x4(w, Omega);
+    Omega *= 0.5f;
+    dspm::SMat<4, 1> qdot = Omega * q;
     dspm::Mat Xdot(this->NUMX, 1);
     Xdot *= 0;
-    Xdot.Copy(qdot, 0, 0);
+    Xdot.Copy(qdot.view(), 0, 0);
     // dwbias = 0
     // dMang_Ampl = 0
     // dMang_offset = 0
@@ -80,24 +82,32 @@ void ekf_imu13states::LinearizeFG(dspm::Mat &x, float *u)
     this->G *= 0;
 
     // dqdot / dq - skey matrix
-    F.Copy(0.5 * ekf::SkewSym4x4(w), 0, 0);
+    dspm::SMat<4, 4> skew;
+    ekf::SkewSym4x4(w, skew);
+    skew *= 0.5f;
+    F.Copy(skew.view(), 0, 0);
 
     // dqdot/dvector
-    dspm::Mat dq = -0.5 * qProduct(x.data);
-    dspm::Mat dq_q = dq.Get(0, 4, 1, 3);
+    dspm::SMat<4, 4> dq;
+    qProduct(x.data, dq);
+    dq *= -0.5f;
+    dspm::SMat<4, 3> dq_q = dq.block<4, 3>(0, 1);
 
     // dqdot / dnw
-    G.Copy(dq_q, 0, 0);
+    G.Copy(dq_q.view(), 0, 0);
     // dqdot / dwbias
-    F.Copy(dq_q, 0, 4);
-
-    dspm::Mat rotm = -1 * this->quat2rotm(x.data); // Convert quat to rotation matrix
-
-    G.Copy(rotm, 7, 6);
-    G.Copy(dspm::Mat::eye(3), 4, 3);   // random noise wbias
-    G.Copy(dspm::Mat::eye(3), 7, 12);  // random noise magnetometer amplitude
-    G.Copy(dspm::Mat::eye(3), 10, 9);  // magnetometer offset constant
-    G.Copy(dspm::Mat::eye(3), 10, 15); // random noise offset constant
+    F.Copy(dq_q.view(), 0, 4);
+
+    dspm::SMat<3, 3> rotm;
+    this->quat2rotm(x.data, rotm); // Convert quat to rotation matrix
+    rotm *= -1;
+
+    dspm::SMat<3, 3> eye = dspm::SMat<3, 3>::eye();
+    G.Copy(rotm.view(), 7, 6);
+    G.Copy(eye.view(), 4, 3);   // random noise wbias
+    G.Copy(eye.view(), 7, 12);  // random noise magnetometer amplitude
+    G.Copy(eye.view(), 10, 9);  // magnetometer offset constant
+    G.Copy(eye.view(), 10, 15); // random noise offset constant
 }
 
 void ekf_imu13states::Test()
@@ -186,22 +196,28 @@ void ekf_imu13states::TestFull(bool enable_att)
 
 void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6])
 {
+    dspm::Mat::ArenaScope scope(this->arena);
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
+    dspm::SMat<4, 1> q(this->X.data);
+    dspm::SMat<6, 13> H_data;
+    dspm::Mat H = H_data.view();
+    dspm::SMat<3, 3> Rm;
+    this->quat2rotm(q.data, Rm);
+    dspm::SMat<3, 3> Re = Rm.t();
+    dspm::SMat<3, 1> accel(this->accel0);
 
     // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
+    dspm::SMat<3, 4> dAccel_dq = ekf::dFdq_inv(accel, q);
+    H.Copy(dAccel_dq.view(), 3, 0);
 
     // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
+    dspm::SMat<3, 1> magn(&this->X.data[7]);
+    dspm::SMat<3, 1> magn_offset(&this->X.data[10]);
+    dspm::SMat<3, 4> dMagn_dq = ekf::dFdq_inv(magn, q);
+    H.Copy(dMagn_dq.view(), 0, 0);
 
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+    dspm::SMat<3, 1> expected_magn = Re * magn + magn_offset;
+    dspm::SMat<3, 1> expected_accel = Re * accel;
 
     float measured_data[6];
     float expected_data[6];
@@ -218,26 +234,33 @@ void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data,
 
 void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_data, float R[6])
 {
+    dspm::Mat::ArenaScope scope(this->arena);
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
+    dspm::SMat<4, 1> q(this->X.data);
+    dspm::SMat<6, 13> H_data;
+    dspm::Mat H = H_data.view();
+    dspm::SMat<3, 3> Rm;
+    this->quat2rotm(q.data, Rm);
+    dspm::SMat<3, 3> Re = Rm.t();
+    dspm::SMat<3, 3> eye = dspm::SMat<3, 3>::eye();
+    dspm::SMat<3, 1> accel(this->accel0);
 
     // We include these two line to update magnetometer initial state
-    H.Copy(Re, 0, 7);
-    H.Copy(dspm::Mat::eye(3), 0, 10);
+    H.Copy(Re.view(), 0, 7);
+    H.Copy(eye.view(), 0, 10);
 
     // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
+    dspm::SMat<3, 4> dAccel_dq = ekf::dFdq_inv(accel, q);
+    H.Copy(dAccel_dq.view(), 3, 0);
 
     // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
+    dspm::SMat<3, 1> magn(&this->X.data[7]);
+    dspm::SMat<3, 1> magn_offset(&this->X.data[10]);
+    dspm::SMat<3, 4> dMagn_dq = ekf::dFdq_inv(magn, q);
+    H.Copy(dMagn_dq.view(), 0, 0);
 
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+    dspm::SMat<3, 1> expected_magn = Re * magn + magn_offset;
+    dspm::SMat<3, 1> expected_accel = Re * accel;
 
     float measured_data[6];
     float expected_data[6];
@@ -254,26 +277,34 @@ void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_da
 
 void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10])
 {
+    dspm::Mat::ArenaScope scope(this->arena);
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(10, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
-
-    H.Copy(Re, 0, 7);
-    H.Copy(dspm::Mat::eye(3), 0, 10);
+    dspm::SMat<4, 1> q(this->X.data);
+    dspm::SMat<10, 13> H_data;
+    dspm::Mat H = H_data.view();
+    dspm::SMat<3, 3> Rm;
+    this->quat2rotm(q.data, Rm);
+    dspm::SMat<3, 3> Re = Rm.t();
+    dspm::SMat<3, 3> eye = dspm::SMat<3, 3>::eye();
+    dspm::SMat<4, 4> eye4 = dspm::SMat<4, 4>::eye();
+    dspm::SMat<3, 1> accel(this->accel0);
+
+    H.Copy(Re.view(), 0, 7);
+    H.Copy(eye.view(), 0, 10);
     // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
+    dspm::SMat<3, 4> dAccel_dq = ekf::dFdq_inv(accel, q);
+    H.Copy(dAccel_dq.view(), 3, 0);
     // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
+    dspm::SMat<3, 1> magn(&this->X.data[7]);
+    dspm::SMat<3, 1> magn_offset(&this->X.data[10]);
+    dspm::SMat<3, 4> dMagn_dq = ekf::dFdq_inv(magn, q);
+    H.Copy(dMagn_dq.view(), 0, 0);
 
     // dq/dq
-    H.Copy(dspm::Mat::eye(4), 6, 1);
+    H.Copy(eye4.view(), 6, 1);
 
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+    dspm::SMat<3, 1> expected_magn = Re * magn + magn_offset;
+    dspm::SMat<3, 1> expected_accel = Re * accel;
 
     float measured_data[10];
     float expected_data[10];
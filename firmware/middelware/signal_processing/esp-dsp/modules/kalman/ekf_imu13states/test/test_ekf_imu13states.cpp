@@ -58,3 +58,23 @@ TEST_CASE("ekf_imu13states functionality gyro and magn", "[dspm]")
     printf("Expected result = %i, calculated result = %i\n", 200, (int)(1000 * ekf13->X.data[5] + 0.5));
     printf("Expected result = %i, calculated result = %i\n", 300, (int)(1000 * ekf13->X.data[6] + 0.5));
 }
+
+TEST_CASE("ekf_imu13states functionality sequential update", "[dspm]")
+{
+    ekf_imu13states *ekf13 = new  ekf_imu13states();
+    ekf13->Init();
+    ekf13->sequential_update = true;
+    unsigned int start_b = xthal_get_ccount();
+    ekf13->TestFull(true);
+    unsigned int end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "Total time %i (K cycles)", (end_b - start_b) / 1000);
+
+    TEST_ASSERT_LESS_THAN(300, (int)(1000 * abs(ekf13->X.data[4] - 0.1)));
+    TEST_ASSERT_LESS_THAN(300, (int)(1000 * abs(ekf13->X.data[5] - 0.2)));
+    TEST_ASSERT_LESS_THAN(300, (int)(1000 * abs(ekf13->X.data[6] - 0.3)));
+    for (int i = 0; i < ekf13->NUMX; i++) {
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_EQUAL_FLOAT(ekf13->P(i, j), ekf13->P(j, i));
+        }
+    }
+}
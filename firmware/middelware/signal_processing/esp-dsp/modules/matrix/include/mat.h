@@ -40,6 +40,82 @@ public:
     bool ext_buff;          /*!< Flag indicates that matrix use external buffer*/
     bool sub_matrix;        /*!< Flag indicates that matrix is a subset of another matrix*/
 
+    /**
+     * @brief Memory arena for temporary matrices
+     *
+     * While an ArenaScope is open, the matrices that allocate their own buffer
+     * (results of the operators, t(), Get(), block(), copies, ...) take it from
+     * the arena instead of the heap. A buffer is returned to the arena when it is
+     * the last one, the rest are returned at the end of the scope. If the arena
+     * is full, the heap is used.
+     * Every matrix uses ARENA_HEADER floats of the arena besides its data.
+     */
+    struct Arena {
+        float *buffer;      /*!< Arena memory*/
+        int size;           /*!< Size of the buffer (amount of floats)*/
+        int used;           /*!< Amount of floats in use*/
+        int top;            /*!< Position of the last block (-1 if the arena is empty)*/
+        int peak;           /*!< Maximum amount of floats used*/
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] buffer: arena memory, owned by the caller
+         * @param[in] size: size of the buffer (amount of floats)
+         */
+        Arena(float *buffer, int size);
+
+        /**
+         * @brief Take a buffer from the arena
+         *
+         * @param[in] length: amount of floats
+         *
+         * @return
+         *      - pointer to the buffer
+         *      - NULL if the arena is full
+         */
+        float *alloc(int length);
+
+        /**
+         * @brief Return a buffer to the arena
+         *
+         * @param[in] data: buffer returned by alloc()
+         */
+        void release(float *data);
+    };
+    static const int ARENA_HEADER = 2;  /*!< Arena floats used by every matrix besides its data*/
+    Arena *arena;           /*!< Arena that holds the data (NULL if the matrix is not in an arena)*/
+
+    /**
+     * @brief Scope that takes the new matrices from an arena
+     *
+     * Matrices created inside the scope must not be used after it ends. Matrices
+     * created before it (for example class members) can be assigned inside it:
+     * the data is copied to their own buffers, and if the size changes the new
+     * buffer is taken from the heap.
+     * Scopes can be nested. The active arena is shared by all the tasks, so the
+     * scopes must be used from one task only.
+     */
+    class ArenaScope {
+    public:
+        /**
+         * @brief Start using the arena
+         *
+         * @param[in] arena: arena for the new matrices
+         */
+        ArenaScope(Arena &arena);
+        /**
+         * @brief Stop using the arena and release the matrices taken from it
+         */
+        ~ArenaScope();
+    private:
+        Arena *arena;       /*!< Arena of this scope*/
+        Arena *prev;        /*!< Active arena before this scope*/
+        int prev_start;     /*!< Start of the active scope before this scope*/
+        int used;           /*!< Arena use at the start of the scope*/
+        int top;            /*!< Arena last block at the start of the scope*/
+    };
+
     /**
      * @brief Rectangular area
      *
@@ -411,13 +487,15 @@ public:
     /**
      * @brief   Solve the matrix
      *
-     * Solve matrix. Find roots for the matrix A*x = b
+     * Solve matrix. Find roots for the matrix A*x = b, using the LU
+     * decomposition with partial pivoting
      *
      * @param[in] A: matrix [N]x[N] with input coefficients
      * @param[in] b: vector [N]x[1] with result values
      *
      * @return
      *      - matrix [N]x[1] with roots
+     *      - matrix [0]x[0] if A is singular
      */
     static Mat solve(Mat A, Mat b);
     /**
@@ -489,14 +567,100 @@ public:
      */
     Mat rowReduceFromGaussian();
 
+    /**
+     * @brief   LU decomposition
+     *
+     * In place LU decomposition with partial pivoting, P*A = L*U, of a square
+     * matrix. On return the strictly lower part holds L (its unit diagonal is
+     * not stored) and the upper part holds U.
+     *
+     * @param[out] perm: array of [N] elements, row i of P*A is row perm[i] of A
+     * @param[out] sign: determinant of P (1 or -1), can be NULL
+     *
+     * @return
+     *      - true on success
+     *      - false if the matrix is singular (pivot below abs_tol)
+     */
+    bool luDecompose(int *perm, int *sign = NULL);
+
+    /**
+     * @brief   Solve with a LU decomposition
+     *
+     * Find X for A*X = B, with A decomposed by luDecompose()
+     *
+     * @param[in] LU: matrix [N]x[N] returned by luDecompose()
+     * @param[in] perm: permutation returned by luDecompose()
+     * @param[in] B: matrix [N]x[M] with result values
+     *
+     * @return
+     *      - matrix [N]x[M] with roots
+     */
+    static Mat luSolve(const Mat &LU, const int *perm, const Mat &B);
+
+    /**
+     * @brief   LDL' decomposition
+     *
+     * In place Cholesky (LDL') decomposition, A = L*D*L', of a symmetric
+     * positive definite matrix. Only the lower part of A is used. On return the
+     * strictly lower part holds L (unit diagonal not stored) and the diagonal
+     * holds D. The upper part is not modified.
+     *
+     * @return
+     *      - true on success
+     *      - false if the matrix is not positive definite
+     */
+    bool ldltDecompose();
+
+    /**
+     * @brief   Solve with a LDL' decomposition
+     *
+     * Find X for A*X = B, with A decomposed by ldltDecompose()
+     *
+     * @param[in] LDL: matrix [N]x[N] returned by ldltDecompose()
+     * @param[in] B: matrix [N]x[M] with result values
+     *
+     * @return
+     *      - matrix [N]x[M] with roots
+     */
+    static Mat ldltSolve(const Mat &LDL, const Mat &B);
+
+    /**
+     * @brief   Solve a symmetric positive definite matrix
+     *
+     * Find X for A*X = B using the LDL' decomposition. If A is not positive
+     * definite, solve() is used instead.
+     *
+     * @param[in] A: symmetric matrix [N]x[N] with input coefficients
+     * @param[in] B: matrix [N]x[M] with result values
+     *
+     * @return
+     *      - matrix [N]x[M] with roots
+     */
+    static Mat solveSPD(const Mat &A, const Mat &B);
+
     /**
      * Find the inverse matrix
      *
+     * Closed form up to 3x3, LU decomposition for bigger matrices.
+     *
      * @return
      *      - inverse matrix
+     *      - zero matrix if the matrix is singular
      */
     Mat inverse();
 
+    /**
+     * Find the inverse of a symmetric positive definite matrix
+     *
+     * Uses the LDL' decomposition and returns an exactly symmetric matrix,
+     * as needed by covariance updates. If the matrix is not positive
+     * definite, inverse() is used instead.
+     *
+     * @return
+     *      - inverse matrix
+     */
+    Mat inverseSPD();
+
     /**
      * Find pseudo inverse matrix
      *
@@ -507,17 +671,23 @@ public:
 
     /**
      * Find determinant
-     * @param[in] n: element number in first row
+     *
+     * Closed form up to 3x3, LU decomposition for bigger matrices.
+     *
+     * @param[in] n: size of the upper left [n]x[n] block to use
      *
      * @return
      *      - determinant value
      */
     float det(int n);
 private:
-    Mat cofactor(int row, int col, int n);
-    Mat adjoint();
+    static Arena *active_arena; // Arena of the innermost ArenaScope (NULL: heap)
+    static int active_start; // Arena use at the start of the innermost ArenaScope
 
     void allocate(); // Allocate buffer
+    void allocate_heap(); // Allocate buffer from the heap, even inside an ArenaScope
+    bool in_active_scope(); // The buffer was taken from the arena inside the innermost ArenaScope
+    void release(); // Free the buffer (heap or arena)
     Mat expHelper(const Mat &m, int num);
 };
 /**
@@ -0,0 +1,354 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dspm_smat_h_
+#define _dspm_smat_h_
+#include <string.h>
+#include <math.h>
+#include "mat.h"
+#include "esp_log.h"
+
+namespace dspm {
+/**
+ * @brief   Fixed size matrix
+ *
+ * The SMat class provides matrix operations on single-precision floating point
+ * values for matrices whose size is known at compile time. The data is stored
+ * in the object (stack for local variables), so no buffer is allocated, and the
+ * loops of every operation have constant bounds and are fully unrolled.
+ * The view() method gives a dspm::Mat that uses the same data.
+ *
+ * @tparam R: amount of rows
+ * @tparam C: amount of columns
+ */
+template <int R, int C>
+class SMat {
+public:
+    static constexpr int rows = R;      /*!< Amount of rows*/
+    static constexpr int cols = C;      /*!< Amount of columns*/
+    float data[R * C];                  /*!< Row-major matrix data*/
+
+    /**
+     * Constructor, all the elements are 0.
+     */
+    SMat() : data() {}
+
+    /**
+     * Constructor that copies the data.
+     * @param[in] src: row-major matrix data, R*C elements
+     */
+    explicit SMat(const float *src)
+    {
+        memcpy(this->data, src, sizeof(this->data));
+    }
+
+    /**
+     * Constructor that copies a dspm::Mat with the same size.
+     * If the size of src is not [R]x[C] an error is logged and the matrix is
+     * zero filled.
+     * @param[in] src: source matrix [R]x[C]
+     */
+    explicit SMat(const Mat &src)
+    {
+        if (src.rows != R || src.cols != C) {
+            ESP_LOGE("SMat", "Constructor Error: source matrix dimensions %dx%d do not match %dx%d", src.rows, src.cols, R, C);
+            memset(this->data, 0, sizeof(this->data));
+            return;
+        }
+#pragma GCC unroll 16
+        for (int i = 0; i < R; i++) {
+#pragma GCC unroll 16
+            for (int j = 0; j < C; j++) {
+                (*this)(i, j) = src(i, j);
+            }
+        }
+    }
+
+    /**
+     * Access to the matrix elements.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of matrix M[row][col]
+     */
+    inline float &operator()(int row, int col)
+    {
+        return data[row * C + col];
+    }
+
+    /**
+     * Access to the matrix elements.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of matrix M[row][col]
+     */
+    inline const float &operator()(int row, int col) const
+    {
+        return data[row * C + col];
+    }
+
+    /**
+     * dspm::Mat that uses the data of this matrix (no copy).
+     * It can be used with every dspm::Mat method and operator, and as source of
+     * dspm::Mat::Copy(). It must not be used after this matrix is destroyed.
+     *
+     * @return
+     *      - matrix [R]x[C] with external buffer
+     */
+    Mat view()
+    {
+        return Mat(this->data, R, C);
+    }
+
+    /**
+     * Copy to a dspm::Mat, which allocates its buffer.
+     *
+     * @return
+     *      - matrix [R]x[C]
+     */
+    Mat toMat() const
+    {
+        Mat result(R, C);
+        memcpy(result.data, this->data, sizeof(this->data));
+        return result;
+    }
+
+    /**
+     * Identity matrix.
+     *
+     * @return
+     *      - matrix [R]x[C] with ones in the diagonal
+     */
+    static SMat eye()
+    {
+        SMat result;
+#pragma GCC unroll 16
+        for (int i = 0; i < ((R < C) ? R : C); i++) {
+            result(i, i) = 1;
+        }
+        return result;
+    }
+
+    /**
+     * Transposed matrix.
+     *
+     * @return
+     *      - matrix [C]x[R]
+     */
+    SMat<C, R> t() const
+    {
+        SMat<C, R> result;
+#pragma GCC unroll 16
+        for (int i = 0; i < R; i++) {
+#pragma GCC unroll 16
+            for (int j = 0; j < C; j++) {
+                result(j, i) = (*this)(i, j);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Copy of a block of the matrix.
+     * @tparam BR: amount of rows of the block
+     * @tparam BC: amount of columns of the block
+     * @param[in] row: start row position
+     * @param[in] col: start column position
+     *
+     * @return
+     *      - matrix [BR]x[BC]
+     */
+    template <int BR, int BC>
+    SMat<BR, BC> block(int row, int col) const
+    {
+        SMat<BR, BC> result;
+#pragma GCC unroll 16
+        for (int i = 0; i < BR; i++) {
+#pragma GCC unroll 16
+            for (int j = 0; j < BC; j++) {
+                result(i, j) = (*this)(row + i, col + j);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Euclidean norm of the matrix.
+     *
+     * @return
+     *      - matrix norm
+     */
+    float norm() const
+    {
+        float sqr_norm = 0;
+#pragma GCC unroll 16
+        for (int i = 0; i < R * C; i++) {
+            sqr_norm += data[i] * data[i];
+        }
+        return sqrtf(sqr_norm);
+    }
+
+    /**
+     * += operator
+     * @param[in] A: source matrix
+     *
+     * @return
+     *      - result matrix: result += A
+     */
+    SMat &operator+=(const SMat &A)
+    {
+#pragma GCC unroll 16
+        for (int i = 0; i < R * C; i++) {
+            data[i] += A.data[i];
+        }
+        return *this;
+    }
+
+    /**
+     * -= operator
+     * @param[in] A: source matrix
+     *
+     * @return
+     *      - result matrix: result -= A
+     */
+    SMat &operator-=(const SMat &A)
+    {
+#pragma GCC unroll 16
+        for (int i = 0; i < R * C; i++) {
+            data[i] -= A.data[i];
+        }
+        return *this;
+    }
+
+    /**
+     * *= operator
+     * @param[in] num: constant
+     *
+     * @return
+     *      - result matrix: result *= num
+     */
+    SMat &operator*=(float num)
+    {
+#pragma GCC unroll 16
+        for (int i = 0; i < R * C; i++) {
+            data[i] *= num;
+        }
+        return *this;
+    }
+
+    /**
+     * /= operator
+     * @param[in] num: constant
+     *
+     * @return
+     *      - result matrix: result /= num
+     */
+    SMat &operator/=(float num)
+    {
+        return (*this *= 1 / num);
+    }
+};
+
+/**
+ * + operator, sum of two matrices
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix A+B
+ */
+template <int R, int C>
+SMat<R, C> operator+(const SMat<R, C> &A, const SMat<R, C> &B)
+{
+    SMat<R, C> result(A);
+    return (result += B);
+}
+
+/**
+ * - operator, subtraction of two matrices
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix A-B
+ */
+template <int R, int C>
+SMat<R, C> operator-(const SMat<R, C> &A, const SMat<R, C> &B)
+{
+    SMat<R, C> result(A);
+    return (result -= B);
+}
+
+/**
+ * * operator, multiplication of two matrices
+ * @param[in] A: Input matrix A [R]x[K]
+ * @param[in] B: Input matrix B [K]x[C]
+ *
+ * @return
+ *     - result matrix A*B [R]x[C]
+ */
+template <int R, int K, int C>
+SMat<R, C> operator*(const SMat<R, K> &A, const SMat<K, C> &B)
+{
+    SMat<R, C> result;
+#pragma GCC unroll 16
+    for (int i = 0; i < R; i++) {
+#pragma GCC unroll 16
+        for (int j = 0; j < C; j++) {
+            float sum = 0;
+#pragma GCC unroll 16
+            for (int k = 0; k < K; k++) {
+                sum += A(i, k) * B(k, j);
+            }
+            result(i, j) = sum;
+        }
+    }
+    return result;
+}
+
+/**
+ * * operator, multiplication of matrix with constant
+ * @param[in] A: Input matrix A
+ * @param[in] num: floating point value
+ *
+ * @return
+ *     - result matrix A*num
+ */
+template <int R, int C>
+SMat<R, C> operator*(const SMat<R, C> &A, float num)
+{
+    SMat<R, C> result(A);
+    return (result *= num);
+}
+
+/**
+ * * operator, multiplication of matrix with constant
+ * @param[in] num: floating point value
+ * @param[in] A: Input matrix A
+ *
+ * @return
+ *     - result matrix num*A
+ */
+template <int R, int C>
+SMat<R, C> operator*(float num, const SMat<R, C> &A)
+{
+    SMat<R, C> result(A);
+    return (result *= num);
+}
+
+}
+#endif //_dspm_smat_h_
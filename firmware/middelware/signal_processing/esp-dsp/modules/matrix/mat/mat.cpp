@@ -32,6 +32,77 @@ using std::endl;
 namespace dspm {
 
 float Mat::abs_tol = 1e-10;
+Mat::Arena *Mat::active_arena = NULL;
+int Mat::active_start = 0;
+
+Mat::Arena::Arena(float *buffer, int size)
+{
+    this->buffer = buffer;
+    this->size = size;
+    this->used = 0;
+    this->top = -1;
+    this->peak = 0;
+}
+
+// Every block starts with a header of ARENA_HEADER floats: position of the
+// previous block and a flag that indicates that the block was released
+float *Mat::Arena::alloc(int length)
+{
+    int32_t header[ARENA_HEADER] = {this->top, 0};
+    if (this->used + ARENA_HEADER + length > this->size) {
+        return NULL;
+    }
+    memcpy(&this->buffer[this->used], header, sizeof(header));
+    this->top = this->used;
+    this->used += ARENA_HEADER + length;
+    if (this->used > this->peak) {
+        this->peak = this->used;
+    }
+    return &this->buffer[this->top + ARENA_HEADER];
+}
+
+void Mat::Arena::release(float *data)
+{
+    int32_t header[ARENA_HEADER];
+    int pos = data - this->buffer - ARENA_HEADER;
+    if ((pos < 0) || (pos >= this->used)) {
+        // Already released by the end of its scope
+        return;
+    }
+    memcpy(header, &this->buffer[pos], sizeof(header));
+    header[1] = 1;
+    memcpy(&this->buffer[pos], header, sizeof(header));
+    // Return the released blocks at the end of the arena
+    while (this->top >= 0) {
+        memcpy(header, &this->buffer[this->top], sizeof(header));
+        if (header[1] == 0) {
+            break;
+        }
+        this->used = this->top;
+        this->top = header[0];
+    }
+}
+
+Mat::ArenaScope::ArenaScope(Arena &arena)
+{
+    this->arena = &arena;
+    this->prev = Mat::active_arena;
+    this->prev_start = Mat::active_start;
+    this->used = arena.used;
+    this->top = arena.top;
+    Mat::active_arena = &arena;
+    Mat::active_start = arena.used;
+}
+
+Mat::ArenaScope::~ArenaScope()
+{
+    if (this->arena->used > this->used) {
+        this->arena->used = this->used;
+        this->arena->top = this->top;
+    }
+    Mat::active_arena = this->prev;
+    Mat::active_start = this->prev_start;
+}
 
 Mat::Rect::Rect(int x, int y, int width, int height)
 {
@@ -64,6 +135,7 @@ Mat::Mat(float *data, int roi_rows, int roi_cols, int stride)
     this->length = this->rows * this->cols;
     this->ext_buff = true;
     this->sub_matrix = true;
+    this->arena = NULL;
 }
 
 Mat::Mat(int rows, int cols)
@@ -82,6 +154,7 @@ Mat::Mat(float *data, int rows, int cols)
 {
     ESP_LOGD("Mat", "Mat(data, %i, %i)", rows, cols);
     this->ext_buff = true;
+    this->arena = NULL;
     this->rows = rows;
     this->cols = cols;
     this->data = data;
@@ -109,9 +182,7 @@ Mat::Mat()
 Mat::~Mat()
 {
     ESP_LOGD("Mat", "~Mat(%i, %i), ext_buff=%i, data = %p", this->rows, this->cols, this->ext_buff, this->data);
-    if (false == this->ext_buff) {
-        delete[] data;
-    }
+    release();
 }
 
 Mat::Mat(const Mat &m)
@@ -127,6 +198,7 @@ Mat::Mat(const Mat &m)
         this->length = m.length;
         this->data = m.data;
         this->ext_buff = true;
+        this->arena = NULL;
     } else {
         allocate();
         memcpy(this->data, m.data, this->length * sizeof(float));
@@ -179,9 +251,7 @@ void Mat::Copy(const Mat &src, int row_pos, int col_pos)
 
 void Mat::CopyHead(const Mat &src)
 {
-    if (!this->ext_buff) {
-        delete[] this->data;
-    }
+    release();
     this->rows = src.rows;
     this->cols = src.cols;
     this->length = src.length;
@@ -190,6 +260,11 @@ void Mat::CopyHead(const Mat &src)
     this->data = src.data;
     this->ext_buff = src.ext_buff;
     this->sub_matrix = src.sub_matrix;
+    // Only the source returns its buffer to the arena
+    if (src.arena != NULL) {
+        this->ext_buff = true;
+    }
+    this->arena = NULL;
 }
 
 void Mat::PrintHead(void)
@@ -239,16 +314,19 @@ Mat &Mat::operator=(const Mat &m)
             ESP_LOGE("Mat", "operator = Error for sub-matrices: operands matrices dimensions %dx%d and %dx%d do not match", this->rows, this->cols, m.rows, m.cols);
             return *this;
         }
-        if (!this->ext_buff) {
-            delete[] this->data;
-        }
-        this->ext_buff = false;
+        // A matrix created before the scope must outlive it: its new buffer can not be in the arena
+        bool scoped = in_active_scope();
+        release();
         this->rows = m.rows;
         this->cols = m.cols;
         this->stride = this->cols;
         this->padding = 0;
         this->sub_matrix = false;
-        allocate();
+        if (scoped) {
+            allocate();
+        } else {
+            allocate_heap();
+        }
     }
 
     for (int row = 0; row < this->rows; row++) {
@@ -465,48 +543,191 @@ float Mat::norm(void)
 
 Mat Mat::solve(Mat A, Mat b)
 {
-    // Gaussian elimination
-    for (int i = 0; i < A.rows; ++i) {
-        if (A(i, i) == 0) {
-            // pivot 0 - error
-            ESP_LOGW("Mat", "Error: the coefficient matrix has 0 as a pivot. Please fix the input and try again.");
-            Mat err_result(0, 0);
-            return err_result;
+    Mat LU = A.block(0, 0, A.rows, A.cols);
+    int *perm = new int[A.rows];
+    if (!LU.luDecompose(perm)) {
+        ESP_LOGW("Mat", "Error: the coefficient matrix is singular. Please fix the input and try again.");
+        delete[] perm;
+        Mat err_result(0, 0);
+        return err_result;
+    }
+    Mat x = luSolve(LU, perm, b);
+    delete[] perm;
+    return x;
+}
+
+bool Mat::luDecompose(int *perm, int *sign)
+{
+    int n = this->rows;
+    int s = 1;
+    if (this->rows != this->cols) {
+        ESP_LOGW("Mat", "luDecompose Error: matrix %dx%d is not square", this->rows, this->cols);
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        perm[i] = i;
+    }
+    for (int k = 0; k < n; k++) {
+        // Partial pivoting: largest element of the column
+        int p = k;
+        float max_val = fabsf(this->data[k * this->stride + k]);
+        for (int i = k + 1; i < n; i++) {
+            float cur_abs = fabsf(this->data[i * this->stride + k]);
+            if (cur_abs > max_val) {
+                max_val = cur_abs;
+                p = i;
+            }
         }
-        float a_ii = 1 / A(i, i);
-        for (int j = i + 1; j < A.rows; ++j) {
-            float a_ji = A(j, i) * a_ii;
-            for (int k = i + 1; k < A.cols; ++k) {
-                A(j, k) -= A(i, k) * a_ji;
-                if ((A(j, k) < abs_tol) && (A(j, k) > -1 * abs_tol)) {
-                    A(j, k) = 0;
-                }
+        if (max_val <= abs_tol) {
+            return false;
+        }
+        if (p != k) {
+            this->swapRows(p, k);
+            int temp = perm[p];
+            perm[p] = perm[k];
+            perm[k] = temp;
+            s = -s;
+        }
+        const float *row_k = &this->data[k * this->stride];
+        for (int i = k + 1; i < n; i++) {
+            float *row_i = &this->data[i * this->stride];
+            // Division (not a product by 1/pivot): a row equal to the pivot row becomes exactly 0
+            float l = row_i[k] / row_k[k];
+            row_i[k] = l;
+            for (int j = k + 1; j < n; j++) {
+                row_i[j] -= l * row_k[j];
+            }
+        }
+    }
+    if (sign != NULL) {
+        *sign = s;
+    }
+    return true;
+}
+
+Mat Mat::luSolve(const Mat &LU, const int *perm, const Mat &B)
+{
+    int n = LU.rows;
+    Mat X(n, B.cols);
+    // Forward substitution, L*Y = P*B (unit diagonal)
+    for (int i = 0; i < n; i++) {
+        float *x_i = &X.data[i * X.stride];
+        for (int c = 0; c < B.cols; c++) {
+            x_i[c] = B(perm[i], c);
+        }
+        for (int k = 0; k < i; k++) {
+            float l = LU(i, k);
+            const float *x_k = &X.data[k * X.stride];
+            for (int c = 0; c < B.cols; c++) {
+                x_i[c] -= l * x_k[c];
             }
-            b(j, 0) -= b(i, 0) * a_ji;
-            if (A(j, 0) < abs_tol && A(j, 0) > -1 * abs_tol) {
-                A(j, 0) = 0;
+        }
+    }
+    // Back substitution, U*X = Y
+    for (int i = n - 1; i >= 0; i--) {
+        float *x_i = &X.data[i * X.stride];
+        for (int k = i + 1; k < n; k++) {
+            float u = LU(i, k);
+            const float *x_k = &X.data[k * X.stride];
+            for (int c = 0; c < B.cols; c++) {
+                x_i[c] -= u * x_k[c];
             }
-            A(j, i) = 0;
+        }
+        float inv_u = 1 / LU(i, i);
+        for (int c = 0; c < B.cols; c++) {
+            x_i[c] *= inv_u;
         }
     }
+    return X;
+}
 
-    // Back substitution
-    Mat x(b.rows, 1);
-    x((x.rows - 1), 0) = b((x.rows - 1), 0) / A((x.rows - 1), (x.rows - 1));
-    if (x((x.rows - 1), 0) < abs_tol && x((x.rows - 1), 0) > -1 * abs_tol) {
-        x((x.rows - 1), 0) = 0;
+bool Mat::ldltDecompose()
+{
+    int n = this->rows;
+    if (this->rows != this->cols) {
+        ESP_LOGW("Mat", "ldltDecompose Error: matrix %dx%d is not square", this->rows, this->cols);
+        return false;
     }
-    for (int i = x.rows - 2; i >= 0; --i) {
-        float sum = 0;
-        for (int j = i + 1; j < x.rows; ++j) {
-            sum += A(i, j) * x(j, 0);
+    for (int i = 0; i < n; i++) {
+        float *row_i = &this->data[i * this->stride];
+        // row_i[j] = L(i, j) * D(j), computed with the rows above
+        for (int j = 0; j < i; j++) {
+            const float *row_j = &this->data[j * this->stride];
+            float sum = row_i[j];
+            for (int k = 0; k < j; k++) {
+                sum -= row_i[k] * row_j[k];
+            }
+            row_i[j] = sum;
         }
-        x(i, 0) = (b(i, 0) - sum) / A(i, i);
-        if (x(i, 0) < abs_tol && x(i, 0) > -1 * abs_tol) {
-            x(i, 0) = 0;
+        // Scale the row by D and find D(i)
+        float d = row_i[i];
+        for (int k = 0; k < i; k++) {
+            float l = row_i[k] / this->data[k * this->stride + k];
+            d -= row_i[k] * l;
+            row_i[k] = l;
+        }
+        if (!(d > abs_tol)) {
+            return false;
         }
+        row_i[i] = d;
     }
-    return x;
+    return true;
+}
+
+Mat Mat::ldltSolve(const Mat &LDL, const Mat &B)
+{
+    int n = LDL.rows;
+    Mat X(B.rows, B.cols);
+    X = B;
+    // Forward substitution, L*Y = B
+    for (int i = 0; i < n; i++) {
+        float *x_i = &X.data[i * X.stride];
+        for (int k = 0; k < i; k++) {
+            float l = LDL(i, k);
+            const float *x_k = &X.data[k * X.stride];
+            for (int c = 0; c < X.cols; c++) {
+                x_i[c] -= l * x_k[c];
+            }
+        }
+    }
+    // D*Z = Y
+    for (int i = 0; i < n; i++) {
+        float inv_d = 1 / LDL(i, i);
+        for (int c = 0; c < X.cols; c++) {
+            X(i, c) *= inv_d;
+        }
+    }
+    // Back substitution, L'*X = Z
+    for (int i = n - 1; i >= 0; i--) {
+        float *x_i = &X.data[i * X.stride];
+        for (int k = i + 1; k < n; k++) {
+            float l = LDL(k, i);
+            const float *x_k = &X.data[k * X.stride];
+            for (int c = 0; c < X.cols; c++) {
+                x_i[c] -= l * x_k[c];
+            }
+        }
+    }
+    return X;
+}
+
+Mat Mat::solveSPD(const Mat &A, const Mat &B)
+{
+    Mat LDL(A.rows, A.cols);
+    LDL = A;
+    if (!LDL.ldltDecompose()) {
+        ESP_LOGD("Mat", "solveSPD: matrix is not positive definite, using LU");
+        Mat LU(A.rows, A.cols);
+        LU = A;
+        int *perm = new int[A.rows];
+        Mat X(A.rows, B.cols);
+        if (LU.luDecompose(perm)) {
+            X = luSolve(LU, perm, B);
+        }
+        delete[] perm;
+        return X;
+    }
+    return ldltSolve(LDL, B);
 }
 
 Mat Mat::bandSolve(Mat A, Mat b, int k)
@@ -717,115 +938,162 @@ Mat Mat::pinv()
     return AInverse;
 }
 
-Mat Mat::cofactor(int row, int col, int n)
+float Mat::det(int n)
 {
-    int i = 0, j = 0;
-    Mat result(n, n);
-    // Looping for each element of the matrix
-    for (int r = 0; r < n; r++) {
-        for (int c = 0; c < n; c++) {
-            //  Copying into temporary matrix only those element
-            //  which are not in given row and column
-            if (r != row && c != col) {
-                result(i, j++) = (*this)(r, c);
-
-                // Row is filled, so increase row index and
-                // reset col index
-                if (j == this->rows - 1) {
-                    j = 0;
-                    i++;
-                }
-            }
+    const Mat &A = *this;
+    // Closed form for small matrices
+    if (n == 1) {
+        return A(0, 0);
+    }
+    if (n == 2) {
+        return A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+    }
+    if (n == 3) {
+        return A(0, 0) * (A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1))
+               - A(0, 1) * (A(1, 0) * A(2, 2) - A(1, 2) * A(2, 0))
+               + A(0, 2) * (A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0));
+    }
+
+    // Product of the LU pivots
+    Mat LU = this->block(0, 0, n, n);
+    int *perm = new int[n];
+    int sign;
+    float D = 0;
+    if (LU.luDecompose(perm, &sign)) {
+        D = sign;
+        for (int i = 0; i < n; i++) {
+            D *= LU(i, i);
         }
     }
-    return result;
+    delete[] perm;
+    return D;
 }
 
-float Mat::det(int n)
+Mat Mat::inverse()
 {
-    float D = 0; // Initialize result
-
-    //  Base case : if matrix contains single element
-    if (n == 1) {
-        return (*this)(0, 0);
+    Mat result(this->rows, this->cols);
+    const Mat &A = *this;
+    int n = this->rows;
+    if (this->rows != this->cols) {
+        ESP_LOGW("Mat", "inverse Error: matrix %dx%d is not square", this->rows, this->cols);
+        return result;
     }
 
-    Mat temp(this->rows, this->rows); // To store cofactors
-
-    int sign = 1;  // To store sign multiplier
-
-    // Iterate for each element of first row
-    for (int f = 0; f < n; f++) {
-        // Getting Cofactor of A[0][f]
-        Mat temp = this->cofactor(0, f, n);
-        D += (*this)(0, f) * temp.det(n - 1) * sign;
-
-        // terms are to be added with alternate sign
-        sign = -sign;
+    if (n <= 3) {
+        // Closed form: inverse(A) = adj(A)/det(A)
+        float det = this->det(n);
+        if (det == 0) {
+            return result;
+        }
+        if (n == 1) {
+            result(0, 0) = 1 / det;
+        } else if (n == 2) {
+            result(0, 0) = A(1, 1) / det;
+            result(0, 1) = -A(0, 1) / det;
+            result(1, 0) = -A(1, 0) / det;
+            result(1, 1) = A(0, 0) / det;
+        } else {
+            result(0, 0) = (A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1)) / det;
+            result(0, 1) = (A(0, 2) * A(2, 1) - A(0, 1) * A(2, 2)) / det;
+            result(0, 2) = (A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1)) / det;
+            result(1, 0) = (A(1, 2) * A(2, 0) - A(1, 0) * A(2, 2)) / det;
+            result(1, 1) = (A(0, 0) * A(2, 2) - A(0, 2) * A(2, 0)) / det;
+            result(1, 2) = (A(0, 2) * A(1, 0) - A(0, 0) * A(1, 2)) / det;
+            result(2, 0) = (A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0)) / det;
+            result(2, 1) = (A(0, 1) * A(2, 0) - A(0, 0) * A(2, 1)) / det;
+            result(2, 2) = (A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0)) / det;
+        }
+        return result;
     }
 
-    return D;
+    Mat LU = this->block(0, 0, n, n);
+    int *perm = new int[n];
+    if (LU.luDecompose(perm)) {
+        result = luSolve(LU, perm, Mat::eye(n));
+    }
+    delete[] perm;
+    return result;
 }
 
-Mat Mat::adjoint()
+Mat Mat::inverseSPD()
 {
-    Mat adj(this->rows, this->cols);
-    if (this->rows == 1) {
-        adj(0, 0) = 1;
-        return adj;
+    int n = this->rows;
+    Mat W = this->block(0, 0, n, n);
+    if (!W.ldltDecompose()) {
+        ESP_LOGD("Mat", "inverseSPD: matrix is not positive definite, using inverse()");
+        return this->inverse();
+    }
+    // W = inverse(L), in place (unit lower triangular)
+    for (int j = 0; j < n; j++) {
+        for (int i = j + 1; i < n; i++) {
+            float sum = W(i, j);
+            for (int k = j + 1; k < i; k++) {
+                sum += W(i, k) * W(k, j);
+            }
+            W(i, j) = -sum;
+        }
     }
-
-    // temp is used to store cofactors of A(,)
-    int sign = 1;
-    Mat temp(this->rows, this->cols);
-
-    for (int i = 0; i < this->rows; i++) {
-        for (int j = 0; j < this->cols; j++) {
-            // Get cofactor of A(i,j)
-            temp = this->cofactor( i, j, this->rows);
-
-            // sign of adj(j,i) positive if sum of row
-            // and column indexes is even.
-            sign = ((i + j) % 2 == 0) ? 1 : -1;
-
-            // Interchanging rows and columns to get the
-            // transpose of the cofactor matrix
-            adj(j, i) = (sign) * (temp.det(this->rows - 1));
+    // inverse(A) = W'*inverse(D)*W, only the lower part is calculated
+    Mat result(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            // The diagonal of W holds D, the unit diagonal of inverse(L) is implicit
+            float sum = ((i == j) ? 1 : W(i, j)) / W(i, i);
+            for (int k = i + 1; k < n; k++) {
+                sum += W(k, i) * W(k, j) / W(k, k);
+            }
+            result(i, j) = result(j, i) = sum;
         }
     }
-    return adj;
+    return result;
 }
 
-Mat Mat::inverse()
+void Mat::allocate()
 {
-    Mat result(this->rows, this->cols);
-    // Find determinant of matrix
-    float det = this->det(this->rows);
-    if (det == 0) {
-        //std::cout << "Singular matrix, can't find its inverse";
-        return result;
-    }
-
-    // Find adjoint
-    Mat adj = this->adjoint();
-
-    // Find Inverse using formula "inverse(A) = adj(A)/det(A)"
-    for (int i = 0; i < this->rows; i++)
-        for (int j = 0; j < this->cols; j++) {
-            result(i, j) = adj(i, j) / float(det);
+    this->ext_buff = false;
+    this->arena = NULL;
+    this->length = this->rows * this->cols;
+    if (active_arena != NULL) {
+        data = active_arena->alloc(this->length);
+        if (data != NULL) {
+            // The arena buffer is external: it is never deleted
+            this->ext_buff = true;
+            this->arena = active_arena;
+            ESP_LOGD("Mat", "allocate(%i) = %p (arena)", this->length, this->data);
+            return;
         }
-
-    return result;
+        ESP_LOGD("Mat", "allocate(%i): arena full, using the heap", this->length);
+    }
+    allocate_heap();
 }
 
-void Mat::allocate()
+void Mat::allocate_heap()
 {
     this->ext_buff = false;
+    this->arena = NULL;
     this->length = this->rows * this->cols;
     data = new float[this->length];
     ESP_LOGD("Mat", "allocate(%i) = %p", this->length, this->data);
 }
 
+bool Mat::in_active_scope()
+{
+    if ((this->arena == NULL) || (this->arena != active_arena)) {
+        return false;
+    }
+    return (this->data - this->arena->buffer - ARENA_HEADER) >= active_start;
+}
+
+void Mat::release()
+{
+    if (this->arena != NULL) {
+        this->arena->release(this->data);
+        this->arena = NULL;
+    } else if (!this->ext_buff) {
+        delete[] this->data;
+    }
+}
+
 Mat Mat::expHelper(const Mat &m, int num)
 {
     if (num == 0) {
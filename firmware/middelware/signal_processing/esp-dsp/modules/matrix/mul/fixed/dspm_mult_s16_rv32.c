@@ -0,0 +1,52 @@
+// Copyright 2026 Albano Peñalva (albano.penalva@uner.edu.ar)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dspm_mult.h"
+#include "dsp_rv32_common.h"
+
+#if (dspm_mult_s16_rv32_enabled == 1)
+
+// Matrinx A(m,n), m - amount or rows, n - amount of columns
+// C(m,k) = A(m,n)*B(n,k)
+// c(i,j) = sum(a(i,s)*b(s,j)) , s=1..n
+esp_err_t dspm_mult_s16_rv32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift)
+{
+    int final_shift = shift - 15;
+    for (int i = 0 ; i < m ; i++) {
+        const int16_t *a = &A[i * n];
+        for (int j = 0 ; j < k ; j++) {
+            // Same rounding and result as dspm_mult_s16_ansi()
+            long long acc = 0x7fff >> shift;
+            const int16_t *b = &B[j];
+            int s = 0;
+            for (; s < n - 3; s += 4) {
+                acc -= dsp_rv32_pair_neg(a[s], b[0], a[s + 1], b[k]);
+                acc -= dsp_rv32_pair_neg(a[s + 2], b[2 * k], a[s + 3], b[3 * k]);
+                b += 4 * k;
+            }
+            for (; s < n; s++) {
+                acc += (int32_t)a[s] * (int32_t)b[0];
+                b += k;
+            }
+            if (final_shift > 0) {
+                C[i * k + j] = (acc << final_shift);
+            } else {
+                C[i * k + j] = (acc >> (-final_shift));
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+#endif // dspm_mult_s16_rv32_enabled
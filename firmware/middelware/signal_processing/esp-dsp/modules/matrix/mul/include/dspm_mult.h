@@ -115,6 +115,7 @@ esp_err_t dspm_mult_4x4x4_f32_ae32(const float *A, const float *B, float *C);
  * Matrix multiplication for two signed 16 bit fixed point matrices: C[m][k] = (A[m][n] * B[n][k]) >> (15- shift)
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_rv32) is optimized for RISC-V chips (ESP32-C6), with the same results as _ansi.
  *
  * @param[in] A  input matrix A[m][n]
  * @param[in] B  input matrix B[n][k]
@@ -130,6 +131,7 @@ esp_err_t dspm_mult_4x4x4_f32_ae32(const float *A, const float *B, float *C);
 esp_err_t dspm_mult_s16_ansi(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 esp_err_t dspm_mult_s16_ae32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 esp_err_t dspm_mult_s16_aes3(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
+esp_err_t dspm_mult_s16_rv32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 /**@}*/
 
 /**@{*/
@@ -169,6 +171,8 @@ esp_err_t dspm_mult_ex_f32_aes3(const float *A, const float *B, float *C, int m,
 #define dspm_mult_s16 dspm_mult_s16_aes3
 #elif (dspm_mult_s16_ae32_enabled == 1)
 #define dspm_mult_s16 dspm_mult_s16_ae32
+#elif (dspm_mult_s16_rv32_enabled == 1)
+#define dspm_mult_s16 dspm_mult_s16_rv32
 #else
 #define dspm_mult_s16 dspm_mult_s16_ansi
 #endif
@@ -208,8 +212,13 @@ esp_err_t dspm_mult_ex_f32_aes3(const float *A, const float *B, float *C, int m,
 #define dspm_mult_4x4x4_f32(A,B,C) dspm_mult_f32_ansi(A,B,C, 4, 4, 4)
 #endif
 
+#else
+// The RISC-V kernels give the same results as the ANSI ones
+#if (dspm_mult_s16_rv32_enabled == 1)
+#define dspm_mult_s16 dspm_mult_s16_rv32
 #else
 #define dspm_mult_s16 dspm_mult_s16_ansi
+#endif
 #define dspm_mult_f32 dspm_mult_f32_ansi
 #define dspm_mult_3x3x1_f32(A,B,C) dspm_mult_f32_ansi(A,B,C, 3, 3, 1)
 #define dsps_sub_f32 dsps_sub_f32_ansi
@@ -22,6 +22,7 @@
 #include "esp_attr.h"
 #include "dsp_tests.h"
 #include "mat.h"
+#include "smat.h"
 
 static const char *TAG = "dspm_Mat";
 
@@ -257,3 +258,67 @@ TEST_CASE("Mat class operators", "[dspm]")
 
     delete[] check_array;
 }
+
+TEST_CASE("Mat class arena", "[dspm]")
+{
+    float buffer[128];
+    dspm::Mat::Arena arena(buffer, 128);
+    dspm::Mat result(3, 3);
+    float *result_data = result.data;
+    {
+        dspm::Mat::ArenaScope scope(arena);
+        dspm::Mat A = dspm::Mat::eye(3);
+        TEST_ASSERT_EQUAL_PTR(&arena, A.arena);
+        int used = arena.used;
+        result = (A * 2 + A) * A.t();
+        // Temporaries of the expression are returned to the arena
+        TEST_ASSERT_EQUAL(used, arena.used);
+        // Arena full: heap
+        dspm::Mat B(16, 16);
+        TEST_ASSERT_NULL(B.arena);
+    }
+    TEST_ASSERT_EQUAL(0, arena.used);
+    TEST_ASSERT_EQUAL_PTR(result_data, result.data);
+    TEST_ASSERT_EQUAL_FLOAT(3, result(1, 1));
+    TEST_ASSERT_EQUAL_FLOAT(0, result(1, 0));
+    ESP_LOGI(TAG, "Arena peak: %i floats", arena.peak);
+
+    // A matrix created before the scope that changes its size gets a heap buffer
+    dspm::Mat outer;
+    {
+        dspm::Mat::ArenaScope scope(arena);
+        outer = dspm::Mat::eye(2) * 2;
+        TEST_ASSERT_NULL(outer.arena);
+    }
+    {
+        dspm::Mat::ArenaScope scope(arena);
+        dspm::Mat C(2, 2);
+        C += 9;
+        TEST_ASSERT_EQUAL_FLOAT(2, outer(0, 0));
+        TEST_ASSERT_EQUAL_FLOAT(0, outer(0, 1));
+    }
+}
+
+TEST_CASE("SMat class", "[dspm]")
+{
+    float a_data[] = {1, 2, 3, 4, 5, 6};
+    float b_data[] = {1, -1, 2, 0, 3, 1};
+    dspm::SMat<2, 3> A(a_data);
+    dspm::SMat<3, 2> B(b_data);
+    dspm::Mat Am(a_data, 2, 3);
+    dspm::Mat Bm(b_data, 3, 2);
+    // Same results as dspm::Mat
+    dspm::SMat<2, 2> C = A * B;
+    dspm::Mat Cm = Am * Bm;
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(Cm.data, C.data, 4);
+    dspm::SMat<3, 2> D = A.t() + 2 * B - B;
+    dspm::Mat Dm = Am.t() + Bm;
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(Dm.data, D.data, 6);
+    // The view uses the same data
+    dspm::Mat view = A.view();
+    view(1, 2) = 10;
+    TEST_ASSERT_EQUAL_FLOAT(10, A(1, 2));
+    dspm::SMat<2, 2> block = A.block<2, 2>(0, 1);
+    TEST_ASSERT_EQUAL_FLOAT(2, block(0, 0));
+    TEST_ASSERT_EQUAL_FLOAT(10, block(1, 1));
+}
@@ -8,6 +8,25 @@
  */
 
 /** \brief Functionalities to calculate FFT
+ *
+ * FFTMagnitude() works with float values. The ESP32-C6 has no FPU, so every
+ * float operation is emulated in software: FFTMagnitudeQ15() computes the
+ * same spectrum with 16 bit integers (Q15 format: 32768 = 1.0) using an
+ * integer Hann window, the esp-dsp fixed point FFT and an integer square
+ * root.
+ *
+ * The fixed point FFT halves the data in every stage so that it can not
+ * overflow. To keep the resolution of small signals, the windowed block is
+ * first scaled up to use the whole 16 bit range (block floating point), and
+ * the shift is returned as a block exponent:
+ *
+ *     FFTMagnitude(x / 32768.0)[k]  ~=  fft[k] * 2^exponent / 32768
+ *
+ * where fft[k] and exponent are the output of FFTMagnitudeQ15(x).
+ *
+ * Both functions use a real input FFT: the N real samples are packed as N/2
+ * complex values, transformed with a N/2 points FFT and split into the N/2
+ * bins of the spectrum, which halves the work of the N points complex FFT.
  * 
  * @author Peñalva Albano
  *
@@ -16,6 +35,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 18/10/2026 | Q15 fixed point spectrum (FFTMagnitudeQ15)								|
+ * | 18/10/2026 | Real input FFT (N real samples in a N/2 points complex FFT)			|
  * 
  **/
 
@@ -48,6 +69,26 @@ bool FFTInit(void);
  */
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
 
+/**
+ * @brief Initialize the Q15 FFT calculation
+ *
+ * @return true     FFT initialized
+ * @return false    Not possible to initialize FFT
+ */
+bool FFTInitQ15(void);
+
+/**
+ * @brief Calculates the magnitude of the Fast Fourier Transform of a Q15 signal
+ *
+ * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ *
+ * @param signal            Array with signal values in Q15 format (of lenght = signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal arrays
+ * @return int8_t           Block exponent: magnitude k (Q15) is fft[k] * 2^exponent
+ */
+int8_t FFTMagnitudeQ15(const int16_t * signal, uint16_t * fft, uint16_t signal_lenght);
+
 /**
  * @brief Return the FFT frequency axis vector
  * 
@@ -8,6 +8,24 @@
  */
 
 /** \brief Functionalities to design and use filters
+ *
+ * LowPassFilter() and HiPassFilter() filter float signals. The ESP32-C6
+ * has no FPU, so every float operation is emulated in software:
+ * LowPassFilterQ15() and HiPassFilterQ15() apply the same filters to 16 bit
+ * signals (e.g. ADC samples) using only integer operations.
+ *
+ * The fixed point filters use the coefficients designed by LowPassInit() and
+ * HiPassInit(), quantized to Q2.30. Each 2nd order section is computed in
+ * Direct Form I with a 64 bit accumulator, and the signal between sections
+ * is kept with 32 bits (2 bits of headroom for the gain of the sections and
+ * 14 bits below the input LSB). The bits dropped after each section can be
+ * fed back into the next sample (noise shaping, see FilterNoiseShaping()):
+ * this removes the offset and the limit cycles that rounding produces in
+ * filters with a low cut-off frequency.
+ *
+ * The float and the fixed point filters keep separate states: the same
+ * filter can be applied to a float and to a Q15 signal. LowPassInit() and
+ * HiPassInit() clear both states.
  * 
  * @author Peñalva Albano
  *
@@ -16,11 +34,13 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 18/10/2026 | Fixed point filters (Q15 signals, Q2.30 coefficients)					|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 /*==================[macros]=================================================*/
 
 /*==================[typedef]================================================*/
@@ -69,6 +89,31 @@ void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_l
  */
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
 
+/**
+ * @brief Apply a low pass filter to a Q15 signal array, with integer operations
+ *
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the input array)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void LowPassFilterQ15(const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Apply a hi pass filter to a Q15 signal array, with integer operations
+ *
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the input array)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void HiPassFilterQ15(const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Enable or disable the noise shaping of the Q15 filters (enabled by default)
+ *
+ * @param enable            true: truncation error feedback, false: rounding
+ */
+void FilterNoiseShaping(bool enable);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,278 @@
+#ifndef MULTIRATE_H_
+#define MULTIRATE_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Multirate Multirate
+ */
+
+/** \brief Functionalities to change the sample rate of a signal
+ *
+ * Sampling with a fast timer and then keeping one of every M samples (or the
+ * average of M samples) lets the noise above the new Nyquist frequency alias
+ * into the signal, and filtering at the fast rate wastes the operations of
+ * the samples that are thrown away. The functions of this module filter and
+ * change the rate in one step, computing only the samples that are kept:
+ *
+ * - Decimator (decimate by M): FIR low pass filter computed once every M
+ *   input samples (polyphase decimation) with the esp-dsp dsps_fird_f32()
+ *   and dsps_fird_s16() functions. A filter of N taps takes N MACs per
+ *   output sample instead of N MACs per input sample (M times less).
+ * - Resampler (interpolate by L, change the rate by L/M): the FIR filter is
+ *   split in L sub-filters (polyphases) of N/L taps. Each output sample is
+ *   computed with one of them, without the zeros inserted between the input
+ *   samples.
+ * - CIC decimator (Cascaded Integrator-Comb): decimation by large factors
+ *   without multiplications, only integer additions. Its response falls
+ *   inside the pass band (sinc^N), so it is used as a first stage followed
+ *   by a FIR decimator by a small factor that defines the pass band.
+ *
+ * Every filter keeps its state in its own structure: signals can be
+ * processed in blocks of any length (e.g. each block read from the ADC) and
+ * the output is the same as if the whole signal was processed at once. The
+ * number of output samples of each call depends on the samples left from
+ * the previous calls, and is returned by the process functions.
+ *
+ * E.g. an ECG sampled at 8 kHz and decimated to 250 Hz: a CIC decimator by
+ * 8 (4 stages) and a Q15 decimator by 4 with MultirateLowPass(coeffs, 64,
+ * 100.0 / 1000.0, 1) take 64 MACs per output sample, instead of the 64 * 32
+ * MACs of filtering the 8 kHz signal and keeping one of every 32 samples.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 18/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsps_fir.h"
+/*==================[macros]=================================================*/
+#define CIC_MAX_STAGES      6
+/*==================[typedef]================================================*/
+/**
+ * @brief Polyphase FIR decimator (float signals)
+ */
+typedef struct {
+    fir_f32_t fir;          /*!< esp-dsp decimation FIR filter */
+    float * coeffs;         /*!< Coefficients (coeffs[0] multiplies the oldest sample) */
+    float * delay;          /*!< Delay line */
+    uint16_t factor;        /*!< Decimation factor */
+    uint16_t pending;       /*!< Input samples in the delay line for the next output */
+} decimator_t;
+
+/**
+ * @brief Polyphase FIR decimator (Q15 signals)
+ */
+typedef struct {
+    fir_s16_t fir;          /*!< esp-dsp decimation FIR filter */
+    int16_t * coeffs;       /*!< Coefficients in Q15 format */
+    int16_t * delay;        /*!< Delay line */
+    uint16_t factor;        /*!< Decimation factor */
+    int16_t max_input;      /*!< Largest input amplitude that can not overflow the output */
+} decimator_q15_t;
+
+/**
+ * @brief Polyphase rational resampler (float signals), also used to interpolate
+ */
+typedef struct {
+    float * coeffs;         /*!< Sub-filters (up arrays of taps coefficients, reversed) */
+    float * delay;          /*!< Delay line, stored twice to read it without wrapping */
+    uint16_t taps;          /*!< Taps of each sub-filter */
+    uint16_t up;            /*!< Interpolation factor (L) */
+    uint16_t down;          /*!< Decimation factor (M) */
+    uint16_t pos;           /*!< Position of the oldest sample in the delay line */
+    uint16_t phase;         /*!< Sub-filter of the next output sample (up: wait next input) */
+} resampler_t;
+
+/**
+ * @brief CIC decimator (Q15 signals, integer operations)
+ */
+typedef struct {
+    uint32_t integrator[CIC_MAX_STAGES];    /*!< Integrators (modulo 2^32) */
+    uint32_t comb[CIC_MAX_STAGES];          /*!< Previous input of each comb */
+    int32_t gain;                           /*!< Normalization: 2^shift / factor^stages */
+    uint8_t shift;                          /*!< Normalization shift */
+    uint8_t stages;                         /*!< Number of integrator-comb pairs (N) */
+    uint16_t factor;                        /*!< Decimation factor (R) */
+    uint16_t count;                         /*!< Input samples since the last output */
+} cic_decimator_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Design a FIR low pass filter (windowed sinc, Blackman window)
+ *
+ * For a decimator by M the cut-off frequency must be below 0.5 / M and for
+ * an interpolator by L below 0.5 / L, with gain = L. The transition band is
+ * about 5.5 / taps wide (stop band attenuation > 70 dB).
+ *
+ * @param coeffs            Array to store the coefficients (of lenght = taps)
+ * @param taps              Number of coefficients
+ * @param cut_frec          Cut-off frequency (-6 dB), relative to the sample frequency (0 to 0.5)
+ * @param gain              Gain at DC
+ */
+void MultirateLowPass(float * coeffs, uint16_t taps, float cut_frec, float gain);
+
+/**
+ * @brief Initialize a FIR decimator
+ *
+ * @param dec               Decimator structure
+ * @param coeffs            Filter coefficients (coeffs[0] multiplies the newest sample), copied
+ * @param taps              Number of coefficients
+ * @param factor            Decimation factor (M)
+ * @return true             Decimator initialized
+ * @return false            Not enough memory or wrong parameters
+ */
+bool DecimatorInit(decimator_t * dec, const float * coeffs, uint16_t taps, uint16_t factor);
+
+/**
+ * @brief Filter and decimate a block of a signal
+ *
+ * @param dec               Decimator structure
+ * @param input             Input signal array
+ * @param output            Output signal array (of lenght = input_lenght / factor + 1)
+ * @param input_lenght      Number of input samples
+ * @return uint16_t         Number of output samples
+ */
+uint16_t DecimatorProcess(decimator_t * dec, const float * input, float * output, uint16_t input_lenght);
+
+/**
+ * @brief Free the memory of a FIR decimator
+ *
+ * @param dec               Decimator structure
+ */
+void DecimatorDeinit(decimator_t * dec);
+
+/**
+ * @brief Initialize a Q15 FIR decimator (integer operations)
+ *
+ * @note  dsps_fird_s16() does not saturate: an output beyond the Q15 range wraps
+ *        around and changes sign. The worst case output is the input amplitude
+ *        times the sum of the absolute values of the coefficients (L1 gain), which
+ *        is above 1 for any filter with negative coefficients, e.g. MultirateLowPass()
+ *        with gain 1 (a full scale step overshoots). DecimatorInitQ15() stores in
+ *        dec->max_input the largest input amplitude that is safe for any signal:
+ *        the caller must keep |input| <= dec->max_input, or design the filter with
+ *        gain 1 / L1.
+ *
+ * @param dec               Decimator structure
+ * @param coeffs            Filter coefficients (coeffs[0] multiplies the newest sample), quantized to Q15
+ * @param taps              Number of coefficients
+ * @param factor            Decimation factor (M)
+ * @return true             Decimator initialized
+ * @return false            Not enough memory or wrong parameters
+ */
+bool DecimatorInitQ15(decimator_q15_t * dec, const float * coeffs, uint16_t taps, uint16_t factor);
+
+/**
+ * @brief Filter and decimate a block of a Q15 signal
+ *
+ * @note  The input must stay within +/- dec->max_input (see DecimatorInitQ15()).
+ *
+ * @param dec               Decimator structure
+ * @param input             Input signal array
+ * @param output            Output signal array (of lenght = input_lenght / factor + 1)
+ * @param input_lenght      Number of input samples
+ * @return uint16_t         Number of output samples
+ */
+uint16_t DecimatorProcessQ15(decimator_q15_t * dec, const int16_t * input, int16_t * output, uint16_t input_lenght);
+
+/**
+ * @brief Free the memory of a Q15 FIR decimator
+ *
+ * @param dec               Decimator structure
+ */
+void DecimatorDeinitQ15(decimator_q15_t * dec);
+
+/**
+ * @brief Initialize a rational resampler (output rate = input rate * up / down)
+ *
+ * @param rs                Resampler structure
+ * @param coeffs            Filter coefficients at up times the input rate (gain = up), copied
+ * @param taps              Number of coefficients
+ * @param up                Interpolation factor (L)
+ * @param down              Decimation factor (M)
+ * @return true             Resampler initialized
+ * @return false            Not enough memory or wrong parameters
+ */
+bool ResamplerInit(resampler_t * rs, const float * coeffs, uint16_t taps, uint16_t up, uint16_t down);
+
+/**
+ * @brief Resample a block of a signal
+ *
+ * @param rs                Resampler structure
+ * @param input             Input signal array
+ * @param output            Output signal array (of lenght = input_lenght * up / down + 1)
+ * @param input_lenght      Number of input samples
+ * @return uint16_t         Number of output samples
+ */
+uint16_t ResamplerProcess(resampler_t * rs, const float * input, float * output, uint16_t input_lenght);
+
+/**
+ * @brief Free the memory of a resampler
+ *
+ * @param rs                Resampler structure
+ */
+void ResamplerDeinit(resampler_t * rs);
+
+/**
+ * @brief Initialize an interpolator (a resampler with down = 1)
+ *
+ * @param rs                Resampler structure
+ * @param coeffs            Filter coefficients at factor times the input rate (gain = factor), copied
+ * @param taps              Number of coefficients
+ * @param factor            Interpolation factor (L)
+ * @return true             Interpolator initialized
+ * @return false            Not enough memory or wrong parameters
+ */
+bool InterpolatorInit(resampler_t * rs, const float * coeffs, uint16_t taps, uint16_t factor);
+
+/**
+ * @brief Interpolate a block of a signal
+ *
+ * @param rs                Resampler structure
+ * @param input             Input signal array
+ * @param output            Output signal array (of lenght = input_lenght * factor)
+ * @param input_lenght      Number of input samples
+ * @return uint16_t         Number of output samples
+ */
+uint16_t InterpolatorProcess(resampler_t * rs, const float * input, float * output, uint16_t input_lenght);
+
+/**
+ * @brief Initialize a CIC decimator (differential delay = 1, gain = 1 at DC)
+ *
+ * @note  stages * log2(factor) must be 16 or less (e.g. factor 16 with 4
+ *        stages, factor 8 with 5 stages).
+ *
+ * @param cic               CIC decimator structure
+ * @param factor            Decimation factor (R)
+ * @param stages            Number of integrator-comb pairs (N, 1 to CIC_MAX_STAGES)
+ * @return true             CIC decimator initialized
+ * @return false            Wrong parameters
+ */
+bool CicDecimatorInit(cic_decimator_t * cic, uint16_t factor, uint8_t stages);
+
+/**
+ * @brief Decimate a block of a Q15 signal
+ *
+ * @param cic               CIC decimator structure
+ * @param input             Input signal array
+ * @param output            Output signal array (of lenght = input_lenght / factor + 1)
+ * @param input_lenght      Number of input samples
+ * @return uint16_t         Number of output samples
+ */
+uint16_t CicDecimatorProcess(cic_decimator_t * cic, const int16_t * input, int16_t * output, uint16_t input_lenght);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* MULTIRATE_H_ */
+
+/*==================[end of file]============================================*/
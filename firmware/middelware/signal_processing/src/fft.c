@@ -17,9 +17,13 @@
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "FFT Module"
+#define Q15_MAX     0x7FFF
 /*==================[internal data declaration]==============================*/
-static float fft_complex[2 * MAX_SIGNAL_LENGHT];
+static float fft_complex[MAX_SIGNAL_LENGHT];       /* Real FFT: N real samples, N/2 complex bins */
 static float wind[MAX_SIGNAL_LENGHT];
+static int16_t fft_q15[MAX_SIGNAL_LENGHT];
+static int16_t wind_q15[MAX_SIGNAL_LENGHT];
+static uint16_t wind_q15_lenght = 0;    /* Lenght of the window in wind_q15 (0: not generated) */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -27,6 +31,30 @@ static float wind[MAX_SIGNAL_LENGHT];
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Integer square root (rounded to the nearest integer)
+ */
+static uint16_t isqrt32(uint32_t x){
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while(bit > x){
+        bit >>= 2;
+    }
+    while(bit != 0){
+        if(x >= root + bit){
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else{
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    /* x is now value - root^2 */
+    if(x > root){
+        root++;
+    }
+    return (uint16_t)root;
+}
 
 /*==================[external functions definition]==========================*/
 bool FFTInit(void){
@@ -40,23 +68,74 @@ bool FFTInit(void){
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
     // Generate Hann window
     dsps_wind_hann_f32(wind, signal_lenght);
-    // Clear fft array
-    memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
-    // Multiply input array with window and store as real part
-    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);    
-    // Calculate FFT  
-    dsps_fft2r_fc32(fft_complex, signal_lenght);
-    // Bit reverse
-    dsps_bit_rev_fc32(fft_complex, signal_lenght);
-    // Convert one complex vector to two complex vectors
-    dsps_cplx2reC_fc32(fft_complex, signal_lenght);
-    // Calculate FFT magnitude 
-    for (int j = 0; j < signal_lenght; j++){
-            fft_complex[j] = 2*(sqrt(fft_complex[j*2+0]*fft_complex[j*2+0] + fft_complex[j*2+1]*fft_complex[j*2+1])) / (signal_lenght/2);
+    // Multiply input array with window
+    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 1);
+    // Calculate FFT of the real signal (N real samples packed in a complex FFT of N/2 points)
+    dsps_fft2r_real_fc32(fft_complex, signal_lenght);
+    // Calculate FFT magnitude: 8 / signal_lenght for every bin but the first one
+    // (2 / signal_lenght), the same scale as the complex FFT and dsps_cplx2reC_fc32()
+    fft[0] = 2 * fabsf(fft_complex[0]) / signal_lenght;
+    for (int j = 1; j < (signal_lenght / 2); j++){
+        fft[j] = 8 * sqrtf(fft_complex[j*2+0]*fft_complex[j*2+0] + fft_complex[j*2+1]*fft_complex[j*2+1]) / signal_lenght;
+    }
+}
+
+bool FFTInitQ15(void){
+    esp_err_t ret = dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    if (ret != ESP_OK){
+        return false;
+    }
+    return true;
+}
+
+int8_t FFTMagnitudeQ15(const int16_t * signal, uint16_t * fft, uint16_t signal_lenght){
+    int32_t value;
+    int32_t peak = 0;
+    uint8_t shift = 0;
+    // Hann window in Q15, generated only when the lenght changes
+    if (signal_lenght != wind_q15_lenght){
+        dsps_wind_hann_f32(wind, signal_lenght);
+        for (int i = 0; i < signal_lenght; i++){
+            wind_q15[i] = (int16_t)(wind[i] * Q15_MAX + 0.5f);
+        }
+        wind_q15_lenght = signal_lenght;
+    }
+    // Peak of the windowed signal (Q30 products)
+    for (int i = 0; i < signal_lenght; i++){
+        value = (int32_t)signal[i] * wind_q15[i];
+        if (value < 0){
+            value = -value;
+        }
+        if (value > peak){
+            peak = value;
+        }
+    }
+    // Block floating point: the windowed block is scaled up to the full 16 bit
+    // range before rounding it to Q15, so small signals keep their resolution.
+    // The rounding is included: the peak must not round up to 32768
+    if (peak != 0){
+        while ((shift < 14) && (((peak + (1 << (13 - shift))) >> (14 - shift)) <= Q15_MAX)){
+            shift++;
+        }
+    }
+    // Multiply input array with window
+    for (int i = 0; i < signal_lenght; i++){
+        value = (int32_t)signal[i] * wind_q15[i];
+        fft_q15[i] = (int16_t)((value + (1 << (14 - shift))) >> (15 - shift));
+    }
+    // Calculate FFT of the real signal (the result is the DFT / signal_lenght).
+    // The complex FFT of N/2 points uses the RISC-V version on the ESP32-C6
+    dsps_fft2r_real_sc16(fft_q15, signal_lenght);
+    // Calculate FFT magnitude (the first element holds the real bins 0 and N/2)
+    fft[0] = (fft_q15[0] < 0) ? -fft_q15[0] : fft_q15[0];
+    for (int j = 1; j < (signal_lenght / 2); j++){
+        fft[j] = isqrt32((uint32_t)((int32_t)fft_q15[j * 2 + 0] * fft_q15[j * 2 + 0])
+                        + (uint32_t)((int32_t)fft_q15[j * 2 + 1] * fft_q15[j * 2 + 1]));
     }
-    fft_complex[0] = fft_complex[0] / 2;
-    // Copy result in fft array
-    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
+    // Same scale as FFTMagnitude(): 8 / signal_lenght for every bin but the
+    // first one (2 / signal_lenght), the 1 / signal_lenght is done by the FFT
+    fft[0] = (fft[0] + 2) >> 2;
+    return 3 - shift;
 }
 
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
@@ -10,6 +10,8 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
 #include "iir_filter.h"
 #include "esp_dsp.h"
 /*==================[macros and definitions]=================================*/
@@ -29,6 +31,19 @@
 #define ORDER8_Q2   (1 / 1.111)
 #define ORDER8_Q3   (1 / 1.663)
 #define ORDER8_Q4   (1 / 1.962)
+// Fixed point
+#define N_SECTIONS  (ORDER_8 / 2)   // Maximum number of 2nd order sections
+#define COEFF_SHIFT 30              // Coefficients in Q2.30
+#define STATE_SHIFT 14              // Q15 samples are stored << 14: 1.0 = 2^29, range +-4
+#define INT32_LIMIT(x)  (((x) > INT32_MAX) ? INT32_MAX : (((x) < INT32_MIN) ? INT32_MIN : (int32_t)(x)))
+#define INT16_LIMIT(x)  (((x) > INT16_MAX) ? INT16_MAX : (((x) < INT16_MIN) ? INT16_MIN : (int16_t)(x)))
+
+typedef struct {
+    int32_t coeff[N_SECTIONS][N_SOS];       // b0, b1, b2, a1, a2 of each section (Q2.30)
+    int32_t delay[N_SECTIONS + 1][N_DELAY]; // Last 2 inputs of each section and outputs of the last one
+    int32_t error[N_SECTIONS];              // Truncation error of each section (noise shaping)
+    uint8_t sections;                       // Sections in use
+} fixed_filter_t;
 /*==================[internal data declaration]==============================*/
 static uint8_t lp_order, hp_order;
 float hp2_delay[N_DELAY] = {0, 0};  // delay
@@ -47,6 +62,8 @@ float hp2_sos_coeff[N_SOS];
 float hp4_sos_coeff[N_SOS]; 
 float hp6_sos_coeff[N_SOS]; 
 float hp8_sos_coeff[N_SOS]; 
+static fixed_filter_t lp_fixed, hp_fixed;
+static bool noise_shaping = true;
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -54,6 +71,64 @@ float hp8_sos_coeff[N_SOS];
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Quantize the float sections of a filter to Q2.30 and clear its state
+ */
+static void FixedFilterInit(fixed_filter_t * filter, float * sos[], uint8_t sections){
+    float value;
+    memset(filter, 0, sizeof(fixed_filter_t));
+    filter->sections = sections;
+    for(uint8_t i = 0; i < sections; i++){
+        for(uint8_t j = 0; j < N_SOS; j++){
+            value = roundf(sos[i][j] * (float)(1L << COEFF_SHIFT));
+            /* +2.0 can not be represented (only when the cut-off is close to sample_frec / 2) */
+            filter->coeff[i][j] = (value >= 2147483647.0f) ? INT32_MAX : (int32_t)value;
+        }
+    }
+}
+
+/**
+ * @brief Direct Form I cascade with 64 bit accumulators
+ */
+static void FixedFilter(fixed_filter_t * filter, const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght){
+    int64_t acc;
+    int32_t x, y;
+    int32_t * c;
+    int32_t * in;
+    int32_t * out;
+    for(int16_t n = 0; n < signal_lenght; n++){
+        x = (int32_t)input_signal[n] << STATE_SHIFT;
+        for(uint8_t i = 0; i < filter->sections; i++){
+            c = filter->coeff[i];
+            /* The outputs of a section are the inputs of the next one: they share the delay line */
+            in = filter->delay[i];
+            out = filter->delay[i + 1];
+            acc = (int64_t)c[0] * x + (int64_t)c[1] * in[0] + (int64_t)c[2] * in[1]
+                - (int64_t)c[3] * out[0] - (int64_t)c[4] * out[1];
+            if(noise_shaping){
+                /* First order error feedback: the bits dropped in the last
+                 * sample are added back, so the error has no DC component
+                 * and can not sustain limit cycles */
+                acc += filter->error[i];
+            } else{
+                acc += 1L << (COEFF_SHIFT - 1);
+            }
+            y = INT32_LIMIT(acc >> COEFF_SHIFT);
+            filter->error[i] = (int32_t)(acc - ((int64_t)y << COEFF_SHIFT));
+            if((filter->error[i] < 0) || (filter->error[i] >= (1L << COEFF_SHIFT))){
+                /* Saturated output: the error is not a rounding error */
+                filter->error[i] = 0;
+            }
+            in[1] = in[0];
+            in[0] = x;
+            x = y;
+        }
+        out = filter->delay[filter->sections];
+        out[1] = out[0];
+        out[0] = x;
+        output_signal[n] = INT16_LIMIT((x + (1L << (STATE_SHIFT - 1))) >> STATE_SHIFT);
+    }
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -80,6 +155,12 @@ void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
             dsps_biquad_gen_lpf_f32(lp8_sos_coeff, f, ORDER8_Q4);
         break;
     }
+    memset(lp2_delay, 0, sizeof(lp2_delay));
+    memset(lp4_delay, 0, sizeof(lp4_delay));
+    memset(lp6_delay, 0, sizeof(lp6_delay));
+    memset(lp8_delay, 0, sizeof(lp8_delay));
+    float * sos[N_SECTIONS] = {lp2_sos_coeff, lp4_sos_coeff, lp6_sos_coeff, lp8_sos_coeff};
+    FixedFilterInit(&lp_fixed, sos, lp_order / 2);
 }
 
 void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
@@ -105,6 +186,12 @@ void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
             dsps_biquad_gen_hpf_f32(hp8_sos_coeff, f, ORDER8_Q4);
         break;
     }
+    memset(hp2_delay, 0, sizeof(hp2_delay));
+    memset(hp4_delay, 0, sizeof(hp4_delay));
+    memset(hp6_delay, 0, sizeof(hp6_delay));
+    memset(hp8_delay, 0, sizeof(hp8_delay));
+    float * sos[N_SECTIONS] = {hp2_sos_coeff, hp4_sos_coeff, hp6_sos_coeff, hp8_sos_coeff};
+    FixedFilterInit(&hp_fixed, sos, hp_order / 2);
 }
 
 void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
@@ -153,4 +240,16 @@ void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_le
     }
 }
 
+void LowPassFilterQ15(const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght){
+    FixedFilter(&lp_fixed, input_signal, output_signal, signal_lenght);
+}
+
+void HiPassFilterQ15(const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght){
+    FixedFilter(&hp_fixed, input_signal, output_signal, signal_lenght);
+}
+
+void FilterNoiseShaping(bool enable){
+    noise_shaping = enable;
+}
+
 /*==================[end of file]============================================*/
\ No newline at end of file
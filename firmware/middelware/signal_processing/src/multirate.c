@@ -0,0 +1,283 @@
+/**
+ * @file multirate.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "multirate.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define Q15_SCALE       32768.0f
+#define Q15_ONE         32768UL
+#define CIC_MAX_GAIN    (1UL << 16)     // 16 bit input + 16 bit of growth in the 32 bit registers
+#define INT16_LIMIT(x)  (((x) > INT16_MAX) ? INT16_MAX : (((x) < INT16_MIN) ? INT16_MIN : (int16_t)(x)))
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void MultirateLowPass(float * coeffs, uint16_t taps, float cut_frec, float gain){
+    float center = (taps - 1) / 2.0f;
+    float sum = 0;
+    if(taps == 1){
+        coeffs[0] = gain;
+        return;
+    }
+    /* The window is computed over taps + 2 points so that the first and last coefficients are not zero */
+    for(uint16_t i = 0; i < taps; i++){
+        float t = i - center;
+        float w = 0.42f - 0.5f * cosf(2 * M_PI * (i + 1) / (taps + 1)) + 0.08f * cosf(4 * M_PI * (i + 1) / (taps + 1));
+        float sinc = (t == 0) ? 2 * cut_frec : sinf(2 * M_PI * cut_frec * t) / (M_PI * t);
+        coeffs[i] = sinc * w;
+        sum += coeffs[i];
+    }
+    for(uint16_t i = 0; i < taps; i++){
+        coeffs[i] *= gain / sum;
+    }
+}
+
+bool DecimatorInit(decimator_t * dec, const float * coeffs, uint16_t taps, uint16_t factor){
+    memset(dec, 0, sizeof(decimator_t));
+    if((taps == 0) || (factor == 0)){
+        return false;
+    }
+    dec->coeffs = malloc(taps * sizeof(float));
+    dec->delay = malloc(taps * sizeof(float));
+    if((dec->coeffs == NULL) || (dec->delay == NULL)){
+        DecimatorDeinit(dec);
+        return false;
+    }
+    /* dsps_fird_f32() multiplies the oldest sample by coeffs[0] */
+    for(uint16_t i = 0; i < taps; i++){
+        dec->coeffs[i] = coeffs[taps - 1 - i];
+    }
+    dec->factor = factor;
+    if(dsps_fird_init_f32(&dec->fir, dec->coeffs, dec->delay, taps, factor) != ESP_OK){
+        DecimatorDeinit(dec);
+        return false;
+    }
+    return true;
+}
+
+uint16_t DecimatorProcess(decimator_t * dec, const float * input, float * output, uint16_t input_lenght){
+    uint16_t out = 0;
+    uint16_t blocks;
+    /* Output started in the previous call: dsps_fird_f32() adds the missing samples */
+    if(dec->pending && (dec->pending + input_lenght >= dec->factor)){
+        uint16_t missing = dec->factor - dec->pending;
+        dec->fir.decim = missing;
+        out = dsps_fird_f32(&dec->fir, input, output, 1);
+        dec->fir.decim = dec->factor;
+        dec->pending = 0;
+        input += missing;
+        input_lenght -= missing;
+    }
+    if(dec->pending == 0){
+        blocks = input_lenght / dec->factor;
+        out += dsps_fird_f32(&dec->fir, input, &output[out], blocks);
+        input += blocks * dec->factor;
+        input_lenght -= blocks * dec->factor;
+    }
+    /* The remaining samples wait in the delay line for the next call */
+    for(uint16_t i = 0; i < input_lenght; i++){
+        dec->fir.delay[dec->fir.pos++] = input[i];
+        if(dec->fir.pos >= dec->fir.N){
+            dec->fir.pos = 0;
+        }
+    }
+    dec->pending += input_lenght;
+    return out;
+}
+
+void DecimatorDeinit(decimator_t * dec){
+    free(dec->coeffs);
+    free(dec->delay);
+    dec->coeffs = NULL;
+    dec->delay = NULL;
+}
+
+bool DecimatorInitQ15(decimator_q15_t * dec, const float * coeffs, uint16_t taps, uint16_t factor){
+    memset(dec, 0, sizeof(decimator_q15_t));
+    if((taps < 2) || (taps > INT16_MAX) || (factor == 0) || (factor > INT16_MAX)){
+        return false;
+    }
+    dec->coeffs = malloc(taps * sizeof(int16_t));
+    dec->delay = malloc(taps * sizeof(int16_t));
+    if((dec->coeffs == NULL) || (dec->delay == NULL)){
+        DecimatorDeinitQ15(dec);
+        return false;
+    }
+    uint32_t l1 = 0;
+    for(uint16_t i = 0; i < taps; i++){
+        dec->coeffs[i] = INT16_LIMIT(lroundf(coeffs[i] * Q15_SCALE));
+        l1 += abs(dec->coeffs[i]);
+    }
+    /* |sum(coeffs * input)| <= max_input * l1 <= INT16_MAX * 2^15: with the rounding (< 2^15) the output stays in range */
+    dec->max_input = (l1 <= Q15_ONE) ? INT16_MAX : (int16_t)((uint32_t)INT16_MAX * Q15_ONE / l1);
+    dec->factor = factor;
+    /* Q15 coefficients and shift 0: Q15 output */
+    if(dsps_fird_init_s16(&dec->fir, dec->coeffs, dec->delay, taps, factor, 0, 0) != ESP_OK){
+        DecimatorDeinitQ15(dec);
+        return false;
+    }
+#if (dsps_fird_s16_aes3_enabled == 1)
+    dsps_16_array_rev(dec->fir.coeffs, dec->fir.coeffs_len);
+#endif
+    return true;
+}
+
+uint16_t DecimatorProcessQ15(decimator_q15_t * dec, const int16_t * input, int16_t * output, uint16_t input_lenght){
+    /* d_pos: input samples of the next output already in the delay line */
+    uint16_t missing = dec->factor - dec->fir.d_pos;
+    uint16_t out = 0;
+    uint16_t remaining;
+    if(input_lenght >= missing){
+        out = (input_lenght - missing) / dec->factor + 1;
+        out = dsps_fird_s16(&dec->fir, input, output, out);
+        remaining = input_lenght - missing - (out - 1) * dec->factor;
+    } else {
+        remaining = input_lenght;
+    }
+    input += input_lenght - remaining;
+    /* The remaining samples wait in the delay line for the next call */
+    for(uint16_t i = 0; i < remaining; i++){
+        if(dec->fir.pos >= dec->fir.coeffs_len){
+            dec->fir.pos = 0;
+        }
+        dec->fir.delay[dec->fir.pos++] = input[i];
+    }
+    dec->fir.d_pos += remaining;
+    return out;
+}
+
+void DecimatorDeinitQ15(decimator_q15_t * dec){
+    dsps_fird_s16_aexx_free(&dec->fir);
+    free(dec->coeffs);
+    free(dec->delay);
+    dec->coeffs = NULL;
+    dec->delay = NULL;
+}
+
+bool ResamplerInit(resampler_t * rs, const float * coeffs, uint16_t taps, uint16_t up, uint16_t down){
+    memset(rs, 0, sizeof(resampler_t));
+    if((taps == 0) || (up == 0) || (down == 0)){
+        return false;
+    }
+    rs->taps = (taps + up - 1) / up;
+    rs->up = up;
+    rs->down = down;
+    rs->coeffs = malloc(up * rs->taps * sizeof(float));
+    rs->delay = calloc(2 * rs->taps, sizeof(float));
+    if((rs->coeffs == NULL) || (rs->delay == NULL)){
+        ResamplerDeinit(rs);
+        return false;
+    }
+    /* Sub-filter p: coeffs[p], coeffs[p + up], ..., reversed to multiply the delay line from the oldest sample */
+    for(uint16_t p = 0; p < up; p++){
+        for(uint16_t k = 0; k < rs->taps; k++){
+            uint32_t i = (uint32_t)k * up + p;
+            rs->coeffs[p * rs->taps + rs->taps - 1 - k] = (i < taps) ? coeffs[i] : 0;
+        }
+    }
+    return true;
+}
+
+uint16_t ResamplerProcess(resampler_t * rs, const float * input, float * output, uint16_t input_lenght){
+    uint16_t out = 0;
+    for(uint16_t i = 0; i < input_lenght; i++){
+        /* Each sample is stored twice: the last taps samples are always in delay[pos .. pos + taps - 1] */
+        rs->delay[rs->pos] = input[i];
+        rs->delay[rs->pos + rs->taps] = input[i];
+        if(++rs->pos >= rs->taps){
+            rs->pos = 0;
+        }
+        while(rs->phase < rs->up){
+            dsps_dotprod_f32(&rs->coeffs[rs->phase * rs->taps], &rs->delay[rs->pos], &output[out++], rs->taps);
+            rs->phase += rs->down;
+        }
+        rs->phase -= rs->up;
+    }
+    return out;
+}
+
+void ResamplerDeinit(resampler_t * rs){
+    free(rs->coeffs);
+    free(rs->delay);
+    rs->coeffs = NULL;
+    rs->delay = NULL;
+}
+
+bool InterpolatorInit(resampler_t * rs, const float * coeffs, uint16_t taps, uint16_t factor){
+    return ResamplerInit(rs, coeffs, taps, factor, 1);
+}
+
+uint16_t InterpolatorProcess(resampler_t * rs, const float * input, float * output, uint16_t input_lenght){
+    return ResamplerProcess(rs, input, output, input_lenght);
+}
+
+bool CicDecimatorInit(cic_decimator_t * cic, uint16_t factor, uint8_t stages){
+    uint32_t gain = 1;
+    uint8_t bits = 0;
+    memset(cic, 0, sizeof(cic_decimator_t));
+    if((factor == 0) || (stages == 0) || (stages > CIC_MAX_STAGES)){
+        return false;
+    }
+    for(uint8_t s = 0; s < stages; s++){
+        gain *= factor;
+        if(gain > CIC_MAX_GAIN){
+            return false;
+        }
+    }
+    while((1UL << bits) < gain){
+        bits++;
+    }
+    /* output = sum * 2^shift / factor^stages / 2^shift, with 2^29 < cic->gain <= 2^30 */
+    cic->shift = 30 + bits;
+    cic->gain = (int32_t)(((1ULL << cic->shift) + gain / 2) / gain);
+    cic->stages = stages;
+    cic->factor = factor;
+    return true;
+}
+
+uint16_t CicDecimatorProcess(cic_decimator_t * cic, const int16_t * input, int16_t * output, uint16_t input_lenght){
+    uint16_t out = 0;
+    for(uint16_t i = 0; i < input_lenght; i++){
+        /* Integrators at the input rate: the overflows cancel in the combs (modulo 2^32) */
+        uint32_t acc = (uint32_t)(int32_t)input[i];
+        for(uint8_t s = 0; s < cic->stages; s++){
+            cic->integrator[s] += acc;
+            acc = cic->integrator[s];
+        }
+        if(++cic->count < cic->factor){
+            continue;
+        }
+        cic->count = 0;
+        /* Combs at the output rate */
+        for(uint8_t s = 0; s < cic->stages; s++){
+            uint32_t prev = cic->comb[s];
+            cic->comb[s] = acc;
+            acc -= prev;
+        }
+        int64_t value = (int64_t)(int32_t)acc * cic->gain + (1LL << (cic->shift - 1));
+        value >>= cic->shift;
+        output[out++] = INT16_LIMIT(value);
+    }
+    return out;
+}
+
+/*==================[end of file]============================================*/
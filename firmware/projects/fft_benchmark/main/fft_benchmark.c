@@ -0,0 +1,97 @@
+/*! @mainpage FFT Benchmark
+ *
+ * @section genDesc General Description
+ *
+ * Measures the CPU cycles used by FFTMagnitude() (float) and
+ * FFTMagnitudeQ15() (fixed point) for several signal lenghts, and the
+ * largest difference between both spectra. The results are printed through
+ * the serial monitor.
+ *
+ * The ESP32-C6 has no FPU: every float operation of FFTMagnitude() is done
+ * in software.
+ *
+ * @section hardConn Hardware Connection
+ *
+ * No external hardware is needed.
+ *
+ * @section changelog Changelog
+ *
+ * |   Date	    | Description                                    |
+ * |:----------:|:-----------------------------------------------|
+ * | 18/10/2026 | Document creation		                         |
+ *
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include "esp_cpu.h"
+#include "fft.h"
+/*==================[macros and definitions]=================================*/
+#define RUNS		10		/* Calls averaged for each measurement */
+#define MAX_LENGHT	1024
+/*==================[internal data definition]===============================*/
+static float signal_f[MAX_LENGHT];
+static int16_t signal_q15[MAX_LENGHT];
+static float fft_f[MAX_LENGHT / 2];
+static uint16_t fft_q15[MAX_LENGHT / 2];
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Test signal: two sines of amplitude 0.5 and 0.01
+ */
+static void generateSignal(uint16_t lenght){
+	for(uint16_t i = 0; i < lenght; i++){
+		float t = (float)i / lenght;
+		signal_q15[i] = (int16_t)(32767 * (0.5f * sinf(2 * M_PI * 20.5f * t) + 0.01f * sinf(2 * M_PI * 70 * t)));
+		signal_f[i] = signal_q15[i] / 32768.0f;
+	}
+}
+/*==================[external functions definition]==========================*/
+void app_main(void){
+	const uint16_t lenghts[] = {256, 512, 1024};
+	uint32_t start, cycles_f, cycles_q15;
+	int8_t exponent = 0;
+	float error, peak;
+
+	FFTInit();
+	FFTInitQ15();
+	printf("lenght\tfloat (cycles)\tQ15 (cycles)\tspeedup\terror (dB)\n");
+	for(uint8_t l = 0; l < sizeof(lenghts) / sizeof(lenghts[0]); l++){
+		uint16_t n = lenghts[l];
+		generateSignal(n);
+		/* First call of each lenght generates the windows */
+		FFTMagnitude(signal_f, fft_f, n);
+		FFTMagnitudeQ15(signal_q15, fft_q15, n);
+
+		start = esp_cpu_get_cycle_count();
+		for(uint8_t r = 0; r < RUNS; r++){
+			FFTMagnitude(signal_f, fft_f, n);
+		}
+		cycles_f = (esp_cpu_get_cycle_count() - start) / RUNS;
+
+		start = esp_cpu_get_cycle_count();
+		for(uint8_t r = 0; r < RUNS; r++){
+			exponent = FFTMagnitudeQ15(signal_q15, fft_q15, n);
+		}
+		cycles_q15 = (esp_cpu_get_cycle_count() - start) / RUNS;
+
+		error = 0;
+		peak = 0;
+		for(uint16_t k = 0; k < n / 2; k++){
+			float diff = fabsf(ldexpf(fft_q15[k], exponent) / 32768 - fft_f[k]);
+			if(diff > error){
+				error = diff;
+			}
+			if(fft_f[k] > peak){
+				peak = fft_f[k];
+			}
+		}
+		printf("%u\t%" PRIu32 "\t\t%" PRIu32 "\t\t%.1f\t%.1f\n", n, cycles_f, cycles_q15,
+			(float)cycles_f / cycles_q15, 20 * log10f(error / peak));
+	}
+}
+/*==================[end of file]============================================*/
@@ -126,18 +126,17 @@ void configureGpio(gpioConf_t *gpioConfig)
  */
 void setGpioFromBcd(uint8_t bcd_digit, gpioConf_t *gpioConfig)
 {
+	uint32_t mask = 0;
+	uint32_t values = 0;
 	for (int i = 0; i < NUM_PINS; i++)
 	{
-		uint8_t bitState = (bcd_digit >> i) & 1; // Obtener el estado del bit correspondiente
-		if (bitState)
+		mask |= GPIO_BIT(gpioConfig[i].pin);
+		if ((bcd_digit >> i) & 1) // Obtener el estado del bit correspondiente
 		{
-			GPIOOn(gpioConfig[i].pin); // Encender el GPIO si el bit es 1
-		}
-		else
-		{
-			GPIOOff(gpioConfig[i].pin); // Apagar el GPIO si el bit es 0
+			values |= GPIO_BIT(gpioConfig[i].pin); // Encender el GPIO si el bit es 1
 		}
 	}
+	GPIOWriteMask(mask, values); // Todos los GPIOs cambian a la vez, sin estados intermedios
 }
 
 /**
@@ -0,0 +1,93 @@
+/*! @mainpage IIR Benchmark
+ *
+ * @section genDesc General Description
+ *
+ * Measures the CPU cycles per sample used by LowPassFilter() (float) and
+ * LowPassFilterQ15() (fixed point) for every filter order, and the largest
+ * difference between both outputs. The results are printed through the
+ * serial monitor.
+ *
+ * The ESP32-C6 has no FPU: every float operation of LowPassFilter() is done
+ * in software.
+ *
+ * @section hardConn Hardware Connection
+ *
+ * No external hardware is needed.
+ *
+ * @section changelog Changelog
+ *
+ * |   Date	    | Description                                    |
+ * |:----------:|:-----------------------------------------------|
+ * | 18/10/2026 | Document creation		                         |
+ *
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <math.h>
+#include "esp_cpu.h"
+#include "iir_filter.h"
+/*==================[macros and definitions]=================================*/
+#define RUNS		10		/* Calls averaged for each measurement */
+#define LENGHT		256
+#define SAMPLE_FREQ	1000
+#define CUT_FREQ	50
+/*==================[internal data definition]===============================*/
+static float signal_f[LENGHT];
+static float filtered_f[LENGHT];
+static int16_t signal_q15[LENGHT];
+static int16_t filtered_q15[LENGHT];
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Test signal: sines of amplitude 0.3 below and above the cut-off frequency
+ */
+static void generateSignal(void){
+	for(uint16_t i = 0; i < LENGHT; i++){
+		float t = (float)i / SAMPLE_FREQ;
+		signal_q15[i] = (int16_t)(32767 * (0.3f * sinf(2 * M_PI * 10 * t) + 0.3f * sinf(2 * M_PI * 200 * t)));
+		signal_f[i] = signal_q15[i] / 32768.0f;
+	}
+}
+/*==================[external functions definition]==========================*/
+void app_main(void){
+	const filter_order_t orders[] = {ORDER_2, ORDER_4, ORDER_6, ORDER_8};
+	uint32_t start, cycles_f, cycles_q15;
+	int32_t error;
+
+	generateSignal();
+	printf("order\tfloat (cycles/sample)\tQ15 (cycles/sample)\tspeedup\terror (LSB)\n");
+	for(uint8_t o = 0; o < sizeof(orders) / sizeof(orders[0]); o++){
+		LowPassInit(SAMPLE_FREQ, CUT_FREQ, orders[o]);
+		start = esp_cpu_get_cycle_count();
+		for(uint8_t r = 0; r < RUNS; r++){
+			LowPassFilter(signal_f, filtered_f, LENGHT);
+		}
+		cycles_f = (esp_cpu_get_cycle_count() - start) / (RUNS * LENGHT);
+
+		start = esp_cpu_get_cycle_count();
+		for(uint8_t r = 0; r < RUNS; r++){
+			LowPassFilterQ15(signal_q15, filtered_q15, LENGHT);
+		}
+		cycles_q15 = (esp_cpu_get_cycle_count() - start) / (RUNS * LENGHT);
+
+		/* Both filters start from zero (LowPassInit() clears their states) */
+		LowPassInit(SAMPLE_FREQ, CUT_FREQ, orders[o]);
+		LowPassFilter(signal_f, filtered_f, LENGHT);
+		LowPassFilterQ15(signal_q15, filtered_q15, LENGHT);
+		error = 0;
+		for(uint16_t i = 0; i < LENGHT; i++){
+			int32_t diff = abs(filtered_q15[i] - (int32_t)lrintf(filtered_f[i] * 32768));
+			if(diff > error){
+				error = diff;
+			}
+		}
+		printf("%u\t%" PRIu32 "\t\t\t%" PRIu32 "\t\t\t%.1f\t%" PRIi32 "\n", orders[o], cycles_f, cycles_q15,
+			(float)cycles_f / cycles_q15, error);
+	}
+}
+/*==================[end of file]============================================*/
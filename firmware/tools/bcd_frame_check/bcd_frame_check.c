@@ -0,0 +1,115 @@
+/**
+ * @file bcd_frame_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the BCD display encoding table (bcd_frame module).
+ *
+ * Build (from this folder):
+ *
+ *     gcc -O2 -I../../drivers/utils/inc bcd_frame_check.c ../../drivers/utils/src/bcd_frame.c -o bcd_frame_check
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include "bcd_frame.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define DIGITS		3
+/*==================[internal data definition]===============================*/
+static int failures;
+
+/* ITS-E0803 data pins: BCD1 to BCD4 on GPIO_20 to GPIO_23 */
+static const uint8_t lcd_pins[BCD_FRAME_BITS] = {20, 21, 22, 23};
+
+/* Port values written by hand: code << 20 */
+static const uint32_t lcd_patterns[BCD_FRAME_CODES] = {
+	0x000000, 0x100000, 0x200000, 0x300000, 0x400000, 0x500000, 0x600000, 0x700000,
+	0x800000, 0x900000, 0xA00000, 0xB00000, 0xC00000, 0xD00000, 0xE00000, 0xF00000
+};
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Previous LcdItsE0803BCDtoPin() bit by bit conversion, used as reference
+ */
+static uint32_t legacy_bcd_to_pins(const uint8_t *pins, uint8_t value){
+	uint32_t values = 0;
+	if(value & (1<<0)) values |= 1UL << pins[0];
+	if(value & (1<<1)) values |= 1UL << pins[1];
+	if(value & (1<<2)) values |= 1UL << pins[2];
+	if(value & (1<<3)) values |= 1UL << pins[3];
+	return values;
+}
+
+/**
+ * @brief Code of a port value, -1 if it is not in the table
+ */
+static int decode(const bcd_frame_table_t *table, uint32_t port){
+	for(int code = 0; code < BCD_FRAME_CODES; code++){
+		if(table->pattern[code] == (port & table->mask)){
+			return code;
+		}
+	}
+	return -1;
+}
+
+static void test_table(void){
+	/* Scattered pins, in any order */
+	const uint8_t other_pins[BCD_FRAME_BITS] = {9, 0, 18, 3};
+	bcd_frame_table_t table;
+	BcdFrameTableInit(&table, lcd_pins);
+	CHECK(table.mask == 0xF00000);
+	for(int code = 0; code < BCD_FRAME_CODES; code++){
+		CHECK(table.pattern[code] == lcd_patterns[code]);
+	}
+	BcdFrameTableInit(&table, other_pins);
+	CHECK(table.mask == ((1UL << 9) | (1UL << 0) | (1UL << 18) | (1UL << 3)));
+	for(int code = 0; code < BCD_FRAME_CODES; code++){
+		CHECK(table.pattern[code] == legacy_bcd_to_pins(other_pins, code));
+		CHECK((table.pattern[code] & ~table.mask) == 0);
+	}
+}
+
+static void test_encode(void){
+	bcd_frame_table_t table;
+	uint32_t frame[DIGITS], big[10];
+	uint32_t value, errors = 0;
+	BcdFrameTableInit(&table, lcd_pins);
+	for(value = 0; value <= 999; value++){
+		CHECK(BcdFrameEncode(&table, value, frame, DIGITS));
+		if((decode(&table, frame[0]) != (int)(value / 100)) || (decode(&table, frame[1]) != (int)(value / 10 % 10))
+			|| (decode(&table, frame[2]) != (int)(value % 10))){
+			errors++;
+		}
+	}
+	CHECK(errors == 0);
+	printf("0 to 999 encoded, %u errors\n", errors);
+	/* Values that do not fit leave the frame unchanged */
+	BcdFrameEncode(&table, 42, frame, DIGITS);
+	CHECK(!BcdFrameEncode(&table, 1000, frame, DIGITS));
+	CHECK((frame[0] == lcd_patterns[0]) && (frame[1] == lcd_patterns[4]) && (frame[2] == lcd_patterns[2]));
+	CHECK(!BcdFrameEncode(&table, 5, frame, 0));
+	/* Largest value */
+	CHECK(BcdFrameEncode(&table, 4294967295UL, big, 10));
+	CHECK((decode(&table, big[0]) == 4) && (decode(&table, big[9]) == 5));
+	BcdFrameBlank(&table, frame, DIGITS);
+	for(int i = 0; i < DIGITS; i++){
+		CHECK(frame[i] == lcd_patterns[BCD_FRAME_BLANK]);
+	}
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	test_table();
+	test_encode();
+	if(failures){
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("OK\n");
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,226 @@
+/**
+ * @file conv_fft_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the esp-dsp FFT convolution and correlation.
+ *
+ * Compares dsps_conv_fft_f32(), dsps_corr_fft_f32(), dsps_ccorr_fft_f32() and the
+ * streaming dsps_conv_fft_stream_f32() with the direct ANSI implementations, and
+ * measures the crossover between the direct and the FFT paths.
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdbool.h>
+#include "dsps_conv.h"
+#include "dsps_corr.h"
+#include "dsps_ccorr.h"
+#include "dsps_conv_fft.h"
+#include "dsps_fft2r.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define MAX_LEN		5000
+#define STREAM_LEN	5000
+#define WINDOW		2048		/* ECG window for the benchmark */
+#define MAX_ERROR	1e-5f		/* Relative to the largest output value */
+/*==================[internal data definition]===============================*/
+static int failures;
+static float signal[MAX_LEN];
+static float kernel[MAX_LEN];
+static float out_ref[2 * MAX_LEN];
+static float out_fft[2 * MAX_LEN];
+/*==================[internal functions definition]==========================*/
+static void random_fill(float *data, int len){
+	for(int i = 0; i < len; i++){
+		data[i] = (float)rand() / RAND_MAX - 0.5f;
+	}
+}
+
+/**
+ * @brief Largest difference relative to the largest value of the reference
+ */
+static float rel_error(const float *ref, const float *test, int len){
+	float max_ref = 1e-30f, max_diff = 0;
+	for(int i = 0; i < len; i++){
+		max_ref = fmaxf(max_ref, fabsf(ref[i]));
+		max_diff = fmaxf(max_diff, fabsf(ref[i] - test[i]));
+	}
+	return max_diff / max_ref;
+}
+
+static double now_us(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+static void check_one_shot(void){
+	const int kern_lens[] = {1, 2, 3, 7, 16, 31, 64, 100, 257, 1000};
+	const int sig_lens[] = {1, 5, 100, 2048, 3000};
+	float worst = 0;
+	for(unsigned k = 0; k < sizeof(kern_lens) / sizeof(int); k++){
+		for(unsigned s = 0; s < sizeof(sig_lens) / sizeof(int); s++){
+			int lk = kern_lens[k];
+			int ls = sig_lens[s];
+			float err;
+			random_fill(signal, ls);
+			random_fill(kernel, lk);
+
+			dsps_conv_f32_ansi(signal, ls, kernel, lk, out_ref);
+			CHECK(dsps_conv_fft_f32(signal, ls, kernel, lk, out_fft) == ESP_OK);
+			err = rel_error(out_ref, out_fft, ls + lk - 1);
+			worst = fmaxf(worst, err);
+			CHECK(err < MAX_ERROR);
+
+			dsps_ccorr_f32_ansi(signal, ls, kernel, lk, out_ref);
+			CHECK(dsps_ccorr_fft_f32(signal, ls, kernel, lk, out_fft) == ESP_OK);
+			err = rel_error(out_ref, out_fft, ls + lk - 1);
+			worst = fmaxf(worst, err);
+			CHECK(err < MAX_ERROR);
+
+			if(ls >= lk){
+				dsps_corr_f32_ansi(signal, ls, kernel, lk, out_ref);
+				/* Guard value after the output */
+				out_fft[ls - lk + 1] = 1234;
+				CHECK(dsps_corr_fft_f32(signal, ls, kernel, lk, out_fft) == ESP_OK);
+				err = rel_error(out_ref, out_fft, ls - lk + 1);
+				worst = fmaxf(worst, err);
+				CHECK(err < MAX_ERROR);
+				CHECK(out_fft[ls - lk + 1] == 1234);
+			} else {
+				CHECK(dsps_corr_fft_f32(signal, ls, kernel, lk, out_fft) == ESP_ERR_DSP_PARAM_OUTOFRANGE);
+			}
+		}
+	}
+	printf("One shot conv/corr/ccorr against the direct functions: max relative error %.2e\n", worst);
+}
+
+/**
+ * @brief Streaming convolution or correlation in blocks of random length
+ *
+ * @param fft_size: 0 for the automatic selection
+ * @param in_place: output in the input array
+ */
+static float check_stream(int lk, int fft_size, bool corr, bool in_place){
+	static float stream_out[STREAM_LEN];
+	conv_fft_f32_t conv;
+	random_fill(signal, STREAM_LEN);
+	random_fill(kernel, lk);
+	if(corr){
+		CHECK(dsps_corr_fft_init_f32(&conv, kernel, lk, fft_size) == ESP_OK);
+	} else {
+		CHECK(dsps_conv_fft_init_f32(&conv, kernel, lk, fft_size) == ESP_OK);
+	}
+	for(int pos = 0; pos < STREAM_LEN; ){
+		int len = 1 + rand() % 300;
+		if(len > STREAM_LEN - pos){
+			len = STREAM_LEN - pos;
+		}
+		if(in_place){
+			memcpy(&stream_out[pos], &signal[pos], len * sizeof(float));
+			CHECK(dsps_conv_fft_stream_f32(&conv, &stream_out[pos], &stream_out[pos], len) == ESP_OK);
+		} else {
+			CHECK(dsps_conv_fft_stream_f32(&conv, &signal[pos], &stream_out[pos], len) == ESP_OK);
+		}
+		pos += len;
+	}
+	dsps_conv_fft_free_f32(&conv);
+
+	if(corr){
+		/* output[n] is the correlation with the window that ends at n */
+		dsps_corr_f32_ansi(signal, STREAM_LEN, kernel, lk, out_ref);
+		return rel_error(out_ref, &stream_out[lk - 1], STREAM_LEN - lk + 1);
+	}
+	dsps_conv_f32_ansi(signal, STREAM_LEN, kernel, lk, out_ref);
+	return rel_error(out_ref, stream_out, STREAM_LEN);
+}
+
+static void check_streaming(void){
+	const int kern_lens[] = {1, 5, 16, 33, 100, 257};
+	const int fft_sizes[] = {0, 64, 512, 4096};
+	float worst = 0;
+	for(unsigned k = 0; k < sizeof(kern_lens) / sizeof(int); k++){
+		for(unsigned f = 0; f < sizeof(fft_sizes) / sizeof(int); f++){
+			int lk = kern_lens[k];
+			int fft_size = fft_sizes[f];
+			if(fft_size && (fft_size < lk)){
+				conv_fft_f32_t conv;
+				CHECK(dsps_conv_fft_init_f32(&conv, kernel, lk, fft_size) == ESP_ERR_DSP_INVALID_LENGTH);
+				continue;
+			}
+			for(int mode = 0; mode < 4; mode++){
+				float err = check_stream(lk, fft_size, mode & 1, mode & 2);
+				worst = fmaxf(worst, err);
+				CHECK(err < MAX_ERROR);
+			}
+		}
+	}
+	printf("Streaming conv/corr (overlap-save, random blocks): max relative error %.2e\n", worst);
+	conv_fft_f32_t conv;
+	CHECK(dsps_conv_fft_init_f32(&conv, kernel, 4, 100) == ESP_ERR_DSP_INVALID_LENGTH);
+}
+
+/**
+ * @brief Direct and FFT correlation of a 2048 samples window with templates of
+ * increasing length, and the path selected by dsps_conv_fft_size()
+ */
+static void benchmark(void){
+	const int kern_lens[] = {4, 8, 16, 24, 32, 48, 64, 128, 256, 512, 1024};
+	random_fill(signal, WINDOW);
+	printf("Correlation of a %d samples window with a template (FFT: init, overlap-save and free):\n", WINDOW);
+	printf("  template   direct (us)   FFT (us)   speedup   auto FFT size\n");
+	for(unsigned k = 0; k < sizeof(kern_lens) / sizeof(int); k++){
+		int lk = kern_lens[k];
+		int fft_size = dsps_conv_fft_size(lk, WINDOW);
+		int runs = 20000 / lk + 5;
+		random_fill(kernel, lk);
+		double start = now_us();
+		for(int r = 0; r < runs; r++){
+			dsps_corr_f32_ansi(signal, WINDOW, kernel, lk, out_ref);
+		}
+		double direct = (now_us() - start) / runs;
+		/* FFT path even when the automatic selection is the direct one */
+		conv_fft_f32_t conv;
+		int size = 2;
+		while(size < 2 * lk){
+			size <<= 1;
+		}
+		int best = fft_size ? fft_size : size;
+		start = now_us();
+		for(int r = 0; r < runs; r++){
+			dsps_corr_fft_init_f32(&conv, kernel, lk, best);
+			dsps_conv_fft_stream_f32(&conv, signal, out_fft, WINDOW);
+			dsps_conv_fft_free_f32(&conv);
+		}
+		double fft = (now_us() - start) / runs;
+		/* Only reported: host wall-clock times are too noisy to check */
+		printf("  %8d   %11.1f   %8.1f   %7.2f   %13d\n", lk, direct, fft, direct / fft, fft_size);
+	}
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	CHECK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE) == ESP_OK);
+	check_one_shot();
+	check_streaming();
+	benchmark();
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
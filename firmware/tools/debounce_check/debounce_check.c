@@ -0,0 +1,224 @@
+/**
+ * @file debounce_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the switch debouncer (debounce module) with synthetic
+ * bounce traces: bouncy clicks, glitches, double/triple clicks and long presses.
+ *
+ * Build (from this folder): make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "debounce.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+#define MAX_TICKS		200000
+#define MAX_EVENTS		4096
+#define BOUNCE_TICKS	8		/* Length of the bounces at each edge */
+#define RELEASE			0
+#define PRESS			1
+/*==================[internal data definition]===============================*/
+/* 5 ms ticks: 20 ms integrator, 1 s long press, 300 ms double click (switch service) */
+static const debounce_config_t config = {.integrator_max = 4, .long_ticks = 200, .double_ticks = 60};
+static int failures;
+static uint8_t trace[MAX_TICKS];
+static uint32_t trace_len;
+static uint8_t events[MAX_EVENTS];		/* Events of the ticks with events, in order */
+static uint32_t event_tick[MAX_EVENTS];
+static uint32_t n_events;
+/*==================[internal functions definition]==========================*/
+static void trace_clear(void){
+	trace_len = 0;
+}
+
+/**
+ * @brief Stable level during ticks
+ */
+static void trace_level(uint8_t level, uint32_t ticks){
+	while(ticks-- && (trace_len < MAX_TICKS)){
+		trace[trace_len++] = level;
+	}
+}
+
+/**
+ * @brief Edge to level with contact bounce for BOUNCE_TICKS: 1 or 2 ticks at the
+ * new level and 1 tick back to the old one (bounces shorter than the debounce time)
+ */
+static void trace_edge(uint8_t level){
+	uint32_t end = trace_len + BOUNCE_TICKS;
+	while(trace_len < end){
+		trace_level(level, 1 + rand() % 2);
+		trace_level(!level, 1);
+	}
+	trace_level(level, 1);
+}
+
+/**
+ * @brief Bouncy press held for hold ticks, then bouncy release
+ */
+static void trace_click(uint32_t hold){
+	trace_edge(PRESS);
+	trace_level(PRESS, hold);
+	trace_edge(RELEASE);
+}
+
+static void run(void){
+	debounce_t sw;
+	DebounceInit(&sw);
+	n_events = 0;
+	for(uint32_t t = 0; t < trace_len; t++){
+		uint8_t evt = DebounceUpdate(&sw, &config, trace[t]);
+		if(evt && (n_events < MAX_EVENTS)){
+			event_tick[n_events] = t;
+			events[n_events++] = evt;
+		}
+	}
+}
+
+static uint32_t count(uint8_t evt){
+	uint32_t n = 0;
+	for(uint32_t i = 0; i < n_events; i++){
+		n += (events[i] & evt) != 0;
+	}
+	return n;
+}
+
+/**
+ * @brief Events in this order, one per tick with events
+ */
+static bool sequence(const uint8_t *expected, uint32_t n){
+	return (n_events == n) && (memcmp(events, expected, n) == 0);
+}
+
+static void test_bouncy_click(void){
+	trace_clear();
+	trace_level(RELEASE, 50);
+	trace_click(40);
+	trace_level(RELEASE, 200);
+	run();
+	const uint8_t expected[] = {DEBOUNCE_EVT_PRESS, DEBOUNCE_EVT_RELEASE};
+	CHECK(sequence(expected, 2));
+	/* Press reported at most integrator_max ticks after the bounces end */
+	CHECK((n_events > 0) && (event_tick[0] < 50 + BOUNCE_TICKS + config.integrator_max));
+}
+
+static void test_glitches(void){
+	trace_clear();
+	/* Pulses shorter than the integrator while released... */
+	for(int i = 0; i < 50; i++){
+		trace_level(RELEASE, 10 + rand() % 20);
+		trace_level(PRESS, 1 + rand() % (config.integrator_max - 1));
+	}
+	trace_level(RELEASE, 20);
+	run();
+	CHECK(n_events == 0);
+	/* ...and drops while pressed */
+	trace_clear();
+	trace_level(PRESS, 20);
+	for(int i = 0; i < 50; i++){
+		trace_level(RELEASE, 1 + rand() % (config.integrator_max - 1));
+		trace_level(PRESS, 10);
+	}
+	run();
+	CHECK((count(DEBOUNCE_EVT_PRESS) == 1) && (count(DEBOUNCE_EVT_RELEASE) == 0));
+}
+
+static void test_double_click(void){
+	const uint8_t expected[] = {DEBOUNCE_EVT_PRESS, DEBOUNCE_EVT_RELEASE,
+								DEBOUNCE_EVT_PRESS | DEBOUNCE_EVT_DOUBLE, DEBOUNCE_EVT_RELEASE};
+	trace_clear();
+	trace_click(20);
+	trace_level(RELEASE, 30);
+	trace_click(20);
+	trace_level(RELEASE, 100);
+	run();
+	CHECK(sequence(expected, 4));
+
+	/* Second press too late: two single clicks */
+	trace_clear();
+	trace_click(20);
+	trace_level(RELEASE, config.double_ticks + 20);
+	trace_click(20);
+	trace_level(RELEASE, 100);
+	run();
+	CHECK((count(DEBOUNCE_EVT_PRESS) == 2) && (count(DEBOUNCE_EVT_DOUBLE) == 0));
+
+	/* Triple click: one double click, the third press starts a new click */
+	trace_clear();
+	for(int i = 0; i < 3; i++){
+		trace_click(20);
+		trace_level(RELEASE, 30);
+	}
+	run();
+	CHECK((count(DEBOUNCE_EVT_PRESS) == 3) && (count(DEBOUNCE_EVT_DOUBLE) == 1));
+	CHECK((n_events == 6) && (events[2] & DEBOUNCE_EVT_DOUBLE));
+}
+
+static void test_long_press(void){
+	trace_clear();
+	trace_click(config.long_ticks * 3);
+	trace_level(RELEASE, 30);
+	/* A click right after a long press is not a double click */
+	trace_click(20);
+	trace_level(RELEASE, 100);
+	run();
+	const uint8_t expected[] = {DEBOUNCE_EVT_PRESS, DEBOUNCE_EVT_LONG, DEBOUNCE_EVT_RELEASE,
+								DEBOUNCE_EVT_PRESS, DEBOUNCE_EVT_RELEASE};
+	CHECK(sequence(expected, 5));
+	/* Long press reported long_ticks after the press */
+	CHECK((n_events > 1) && (event_tick[1] - event_tick[0] == config.long_ticks));
+}
+
+/**
+ * @brief Random bouncy clicks: one press and one release per click, alternating
+ */
+static void test_random(void){
+	uint32_t clicks = 0;
+	trace_clear();
+	while(trace_len < MAX_TICKS - 1000){
+		trace_level(RELEASE, 2 * config.integrator_max + rand() % 100);
+		trace_click(2 * config.integrator_max + rand() % 400);
+		clicks++;
+	}
+	trace_level(RELEASE, 20);
+	run();
+	bool alternate = true;
+	for(uint32_t i = 0, pressed = 0; i < n_events; i++){
+		if(events[i] & DEBOUNCE_EVT_PRESS){
+			alternate &= !pressed;
+			pressed = 1;
+		}
+		if(events[i] & DEBOUNCE_EVT_RELEASE){
+			alternate &= pressed;
+			pressed = 0;
+		}
+	}
+	printf("Random trace: %u bouncy clicks, %u presses, %u releases, %u long, %u double\n", (unsigned)clicks,
+		(unsigned)count(DEBOUNCE_EVT_PRESS), (unsigned)count(DEBOUNCE_EVT_RELEASE),
+		(unsigned)count(DEBOUNCE_EVT_LONG), (unsigned)count(DEBOUNCE_EVT_DOUBLE));
+	CHECK(count(DEBOUNCE_EVT_PRESS) == clicks);
+	CHECK(count(DEBOUNCE_EVT_RELEASE) == clicks);
+	CHECK(alternate);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	srand(1);
+	test_bouncy_click();
+	test_glitches();
+	test_double_click();
+	test_long_press();
+	test_random();
+	printf(failures ? "%d FAILURES\n" : "OK\n", failures);
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,189 @@
+/**
+ * @file dsp_rv32_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the RISC-V (_rv32) esp-dsp kernels against the ANSI references.
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dsps_dotprod.h"
+#include "dsps_fir.h"
+#include "dsps_fft2r.h"
+#include "dspm_mult.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define MAX_LEN		1024
+#define FIR_TAPS	67
+#define FFT_MAX		1024
+/*==================[internal data definition]===============================*/
+static int failures;
+static int16_t x[MAX_LEN], y[MAX_LEN];
+static int16_t out_ansi[MAX_LEN], out_rv32[MAX_LEN];
+static int16_t delay_ansi[FIR_TAPS], delay_rv32[FIR_TAPS];
+static int16_t fft_ansi[2 * FFT_MAX], fft_rv32[2 * FFT_MAX];
+/*==================[internal functions definition]==========================*/
+typedef enum {
+	RANDOM,			/* Uniform in the whole int16_t range */
+	SMALL,			/* Uniform in [-64, 63] */
+	MINIMUM,		/* Every sample -32768: largest products, worst case for the accumulators */
+	EXTREMES,		/* Random -32768 and 32767 */
+	FILLS
+} fill_t;
+
+static const char *fill_names[] = {"random", "small", "minimum", "extremes"};
+
+static void fill(int16_t *data, int len, fill_t type){
+	for(int i = 0; i < len; i++){
+		switch(type){
+		case RANDOM:
+			data[i] = (int16_t)(rand() & 0xFFFF);
+			break;
+		case SMALL:
+			data[i] = (int16_t)((rand() & 0x7F) - 64);
+			break;
+		case MINIMUM:
+			data[i] = INT16_MIN;
+			break;
+		case EXTREMES:
+		default:
+			data[i] = (rand() & 1) ? INT16_MAX : INT16_MIN;
+			break;
+		}
+	}
+}
+
+static int compare(const char *name, fill_t type, int len, int shift){
+	for(int i = 0; i < len; i++){
+		if(out_ansi[i] != out_rv32[i]){
+			printf("  %s (%s, len %d, shift %d): [%d] %d != %d\n", name, fill_names[type], len, shift,
+				i, out_rv32[i], out_ansi[i]);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static int check_dotprod(void){
+	int errors = 0;
+	for(fill_t type = 0; type < FILLS; type++){
+		for(int len = 1; len <= MAX_LEN; len += (len < 16) ? 1 : 61){
+			for(int shift = 0; shift <= 15; shift += 3){
+				fill(x, len, type);
+				fill(y, len, type);
+				dsps_dotprod_s16_ansi(x, y, out_ansi, len, shift);
+				dsps_dotprod_s16_rv32(x, y, out_rv32, len, shift);
+				errors += compare("dotprod", type, 1, shift);
+			}
+		}
+	}
+	return errors;
+}
+
+static int check_fird(void){
+	const int16_t decims[] = {1, 2, 3, 5};
+	const int16_t shifts[] = {-3, 0, 2, 15, 20};
+	int16_t coeffs[FIR_TAPS];
+	fir_s16_t fir_ansi, fir_rv32;
+	int errors = 0;
+	for(fill_t type = 0; type < FILLS; type++){
+		for(int taps = 2; taps <= FIR_TAPS; taps += 5){
+			for(uint8_t d = 0; d < sizeof(decims) / sizeof(decims[0]); d++){
+				for(uint8_t s = 0; s < sizeof(shifts) / sizeof(shifts[0]); s++){
+					fill(coeffs, taps, type);
+					dsps_fird_init_s16(&fir_ansi, coeffs, delay_ansi, taps, decims[d], 0, shifts[s]);
+					dsps_fird_init_s16(&fir_rv32, coeffs, delay_rv32, taps, decims[d], 0, shifts[s]);
+					/* Several blocks: the delay line position goes through every value */
+					for(int block = 0; block < 3; block++){
+						int len = 97 + 31 * block;
+						fill(x, len * decims[d], type);
+						int32_t n_ansi = dsps_fird_s16_ansi(&fir_ansi, x, out_ansi, len);
+						int32_t n_rv32 = dsps_fird_s16_rv32(&fir_rv32, x, out_rv32, len);
+						CHECK(n_ansi == n_rv32);
+						errors += compare("fird", type, n_ansi, shifts[s]);
+					}
+				}
+			}
+		}
+	}
+	return errors;
+}
+
+static int check_fft(void){
+	int errors = 0;
+	CHECK(dsps_fft2r_init_sc16(NULL, FFT_MAX * 2) == ESP_OK);
+	for(fill_t type = 0; type < FILLS; type++){
+		for(int n = 2; n <= FFT_MAX; n *= 2){
+			fill(fft_ansi, 2 * n, type);
+			memcpy(fft_rv32, fft_ansi, 2 * n * sizeof(int16_t));
+			CHECK(dsps_fft2r_sc16_ansi(fft_ansi, n) == ESP_OK);
+			CHECK(dsps_fft2r_sc16_rv32(fft_rv32, n) == ESP_OK);
+			memcpy(out_ansi, fft_ansi, sizeof(out_ansi));
+			memcpy(out_rv32, fft_rv32, sizeof(out_rv32));
+			errors += compare("fft2r", type, (2 * n < MAX_LEN) ? 2 * n : MAX_LEN, 0);
+			CHECK(memcmp(fft_ansi, fft_rv32, 2 * n * sizeof(int16_t)) == 0);
+		}
+	}
+	CHECK(dsps_fft2r_sc16_rv32(fft_rv32, 12) == ESP_ERR_DSP_INVALID_LENGTH);
+	dsps_fft2r_deinit_sc16();
+	return errors;
+}
+
+static int check_mult(void){
+	int errors = 0;
+	for(fill_t type = 0; type < FILLS; type++){
+		for(int m = 1; m <= 8; m++){
+			for(int n = 1; n <= 17; n++){
+				for(int k = 1; k <= 9; k += 2){
+					for(int shift = -4; shift < 4; shift += 2){
+						fill(x, m * n, type);
+						fill(y, n * k, type);
+						dspm_mult_s16_ansi(x, y, out_ansi, m, n, k, shift);
+						dspm_mult_s16_rv32(x, y, out_rv32, m, n, k, shift);
+						errors += compare("mult", type, m * k, shift);
+					}
+				}
+			}
+		}
+	}
+	return errors;
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	int errors;
+	srand(1);
+
+	errors = check_dotprod();
+	printf("dsps_dotprod_s16_rv32: %d mismatches\n", errors);
+	CHECK(errors == 0);
+
+	errors = check_fird();
+	printf("dsps_fird_s16_rv32: %d mismatches\n", errors);
+	CHECK(errors == 0);
+
+	errors = check_fft();
+	printf("dsps_fft2r_sc16_rv32: %d mismatches\n", errors);
+	CHECK(errors == 0);
+
+	errors = check_mult();
+	printf("dspm_mult_s16_rv32: %d mismatches\n", errors);
+	CHECK(errors == 0);
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
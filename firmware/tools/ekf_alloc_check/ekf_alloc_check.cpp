@@ -0,0 +1,185 @@
+/**
+ * @file ekf_alloc_check.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the dspm::Mat arena: heap allocations per ekf_imu13states iteration.
+ *
+ * The global new/delete operators are replaced to count the heap allocations.
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <new>
+#include "mat.h"
+#include "ekf_imu13states.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define ITERATIONS	500
+#define DT			0.01f
+
+using dspm::Mat;
+/*==================[internal data definition]===============================*/
+static int failures;
+static long allocations;
+/*==================[external functions definition]==========================*/
+void *operator new(size_t size){
+	allocations++;
+	void *ptr = malloc(size ? size : 1);
+	if(ptr == NULL){
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void *operator new[](size_t size){
+	return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept{
+	free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept{
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t size) noexcept{
+	free(ptr);
+}
+
+void operator delete[](void *ptr, size_t size) noexcept{
+	free(ptr);
+}
+/*==================[internal functions definition]==========================*/
+static void check_arena(void){
+	float buffer[256];
+	Mat::Arena arena(buffer, 256);
+	Mat outer(3, 3);
+	float *outer_data = outer.data;
+	{
+		Mat::ArenaScope scope(arena);
+		long before = allocations;
+		Mat A = Mat::eye(3);
+		CHECK(A.arena == &arena);
+		CHECK((A.data >= buffer) && (A.data < buffer + 256));
+		int used = arena.used;
+		{
+			/* Temporaries of an expression: all of them are returned */
+			Mat B = (A * 2 + A) * A.t();
+			CHECK(B(1, 1) == 3);
+			outer = B;
+		}
+		CHECK(arena.used == used);
+		/* Release out of order: returned when the last one is released */
+		Mat *C = new Mat(4, 4);
+		Mat *D = new Mat(4, 4);
+		delete C;
+		CHECK(arena.used > used);
+		delete D;
+		CHECK(arena.used == used);
+		/* Arena full: the heap is used */
+		Mat E(20, 20);
+		CHECK(E.arena == NULL);
+		CHECK(allocations - before == 3);	/* C, D and E's buffer */
+		/* Nested scope */
+		{
+			Mat::ArenaScope inner(arena);
+			Mat F(2, 2);
+			CHECK(F.arena == &arena);
+		}
+		CHECK(arena.used == used);
+	}
+	CHECK(arena.used == 0);
+	CHECK(arena.top == -1);
+	/* The assignment copies into the matrix created before the scope */
+	CHECK(outer.data == outer_data);
+	CHECK(outer(0, 0) == 3 && outer(0, 1) == 0);
+	/* Without a scope the heap is used */
+	Mat G(2, 2);
+	CHECK(G.arena == NULL);
+}
+
+/**
+ * @brief Runs the filter with the sensors of a body that rotates with a constant rate
+ *
+ * @return allocations per iteration (Process() and UpdateRefMeasurement())
+ */
+static double run_filter(bool use_arena, float *state, int *peak){
+	ekf_imu13states imu;
+	float R[6] = {0.01f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f};
+	float gyro[3] = {0.3f, -0.2f, 0.1f};
+	float gyro_bias[3] = {0.01f, 0.02f, -0.01f};
+	float accel[3], magn[3], u[3];
+	long count = 0;
+	imu.Init();
+	if(!use_arena){
+		/* Empty arena: every matrix falls back to the heap */
+		imu.arena.size = 0;
+	}
+	for(int n = 0; n < ITERATIONS; n++){
+		/* Sensors in the body frame (rotation about z plus a small tilt) */
+		float angle = gyro[2] * DT * n;
+		float tilt = 0.2f * sinf(0.01f * n);
+		accel[0] = -sinf(tilt);
+		accel[1] = 0;
+		accel[2] = cosf(tilt);
+		magn[0] = cosf(angle);
+		magn[1] = -sinf(angle);
+		magn[2] = 0;
+		for(int i = 0; i < 3; i++){
+			u[i] = gyro[i] + gyro_bias[i];
+		}
+
+		long before = allocations;
+		imu.Process(u, DT);
+		Mat q(imu.X.data, 4, 1);
+		q /= q.norm();
+		imu.UpdateRefMeasurement(accel, magn, R);
+		count += allocations - before;
+	}
+	memcpy(state, imu.X.data, imu.NUMX * sizeof(float));
+	*peak = imu.arena.peak;
+	return (double)count / ITERATIONS;
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	float state_heap[13], state_arena[13];
+	int peak, size;
+
+	check_arena();
+
+	double heap = run_filter(false, state_heap, &peak);
+	double with_arena = run_filter(true, state_arena, &peak);
+	ekf_imu13states imu;
+	size = imu.arena.size;
+	printf("ekf_imu13states, heap allocations per iteration:\n");
+	printf("  without arena: %.1f\n", heap);
+	printf("  with arena:    %.1f (arena peak %d of %d floats)\n", with_arena, peak, size);
+	CHECK(heap > 0);
+	CHECK(with_arena == 0);
+	CHECK(peak <= size);
+	/* The arena does not change the arithmetic */
+	CHECK(memcmp(state_heap, state_arena, sizeof(state_heap)) == 0);
+	for(int i = 0; i < 13; i++){
+		CHECK(!isnan(state_arena[i]));
+	}
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
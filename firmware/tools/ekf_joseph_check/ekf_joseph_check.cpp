@@ -0,0 +1,306 @@
+/**
+ * @file ekf_joseph_check.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the sequential (scalar) and Joseph form EKF updates.
+ *
+ * Compares ekf::Update() (sequential scalar updates, with and without the Joseph
+ * form) with the previous Update() and with the matrix update ekf::UpdateRef(),
+ * and measures the time of each one.
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "mat.h"
+#include "ekf_imu13states.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define NUMX		13
+#define NUMM		6
+#define ITERATIONS	2000
+#define RUNS		20000
+#define DT			0.01f
+
+using dspm::Mat;
+
+typedef enum {
+	UPDATE_PREV,		/* Previous ekf::Update() */
+	UPDATE,				/* ekf::Update() */
+	UPDATE_SEQUENTIAL,	/* ekf::Update() with sequential_update */
+	UPDATE_REF,			/* ekf::UpdateRef() */
+	UPDATE_TYPES
+} update_t;
+
+static const char *update_names[] = {
+	"previous Update()", "Update()", "Update(), sequential", "UpdateRef()"
+};
+
+/**
+ * @brief ekf_imu13states with the matrix update (UpdateRef()) as reference
+ */
+class ekf_imu13states_ref: public ekf_imu13states {
+public:
+	virtual void Update(dspm::Mat &H, float *measured, float *expected, float *R){
+		this->UpdateRef(H, measured, expected, R);
+	}
+};
+/*==================[internal data definition]===============================*/
+static int failures;
+static unsigned int seed = 1;
+/*==================[internal functions definition]==========================*/
+static float rand_float(void){
+	seed = seed * 1103515245u + 12345u;
+	return (float)((seed >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+}
+
+/**
+ * @brief Previous ekf::Update(), as reference
+ */
+static void update_prev(ekf &filter, Mat &H, float *measured, float *expected, float *R){
+	float HP[NUMX], Km[NUMX];
+	float HPHR, Error;
+	Mat &P = filter.P;
+	Mat &X = filter.X;
+	for(int m = 0; m < H.rows; m++){
+		for(int j = 0; j < NUMX; j++){
+			HP[j] = 0;
+		}
+		for(int k = 0; k < NUMX; k++){
+			for(int j = 0; j < NUMX; j++){
+				HP[j] += H(m, k) * P(k, j);
+			}
+		}
+		HPHR = R[m];
+		for(int k = 0; k < NUMX; k++){
+			HPHR += HP[k] * H(m, k);
+		}
+		float invHPHR = 1.0f / HPHR;
+		for(int k = 0; k < NUMX; k++){
+			Km[k] = HP[k] * invHPHR;
+		}
+		for(int i = 0; i < NUMX; i++){
+			for(int j = i; j < NUMX; j++){
+				P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j];
+			}
+		}
+		Error = measured[m] - expected[m];
+		for(int i = 0; i < NUMX; i++){
+			X(i, 0) = X(i, 0) + Km[i] * Error;
+		}
+	}
+}
+
+static void update(ekf &filter, update_t type, Mat &H, float *measured, float *expected, float *R){
+	filter.sequential_update = (type == UPDATE_SEQUENTIAL);
+	switch(type){
+	case UPDATE_PREV:
+		update_prev(filter, H, measured, expected, R);
+		break;
+	case UPDATE_REF:
+		filter.UpdateRef(H, measured, expected, R);
+		break;
+	default:
+		filter.Update(H, measured, expected, R);
+		break;
+	}
+}
+
+/**
+ * @brief Random test case: P = A*A' + 0.01*I, H with the non zero columns of
+ * ekf_imu13states::UpdateRefMeasurementMagn() (0..3 and 7..12)
+ */
+static void random_case(ekf &filter, Mat &H, float *measured, float *expected, float *R){
+	Mat A(NUMX, NUMX);
+	for(int i = 0; i < NUMX * NUMX; i++){
+		A.data[i] = rand_float();
+	}
+	filter.P = A * A.t() + 0.01f * Mat::eye(NUMX);
+	for(int i = 0; i < NUMX; i++){
+		filter.X(i, 0) = rand_float();
+	}
+	for(int m = 0; m < NUMM; m++){
+		for(int k = 0; k < NUMX; k++){
+			H(m, k) = ((k < 4) || (k >= 7)) ? rand_float() : 0;
+		}
+		measured[m] = rand_float();
+		expected[m] = rand_float();
+		R[m] = 0.01f + 0.1f * fabsf(rand_float());
+	}
+}
+
+static float max_diff(const Mat &A, const Mat &B){
+	float diff = 0;
+	for(int i = 0; i < A.rows; i++){
+		for(int j = 0; j < A.cols; j++){
+			diff = fmaxf(diff, fabsf(A(i, j) - B(i, j)));
+		}
+	}
+	return diff;
+}
+
+static float max_abs(const Mat &A){
+	Mat zero(A.rows, A.cols);
+	return max_diff(A, zero);
+}
+
+static bool symmetric(const Mat &A){
+	for(int i = 0; i < A.rows; i++){
+		for(int j = 0; j < i; j++){
+			if(A(i, j) != A(j, i)){
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool positive_definite(const Mat &A){
+	Mat LD = A;
+	return LD.ldltDecompose();
+}
+
+/**
+ * @brief Same random cases with every update: results against the reference
+ * (previous Update() or UpdateRef())
+ */
+static void check_updates(void){
+	ekf_imu13states filter[UPDATE_TYPES];
+	Mat H(NUMM, NUMX);
+	float measured[NUMM], expected[NUMM], R[NUMM];
+	float err_prev = 0, err_seq = 0;
+	for(int n = 0; n < 100; n++){
+		unsigned int case_seed = seed;
+		for(int u = 0; u < UPDATE_TYPES; u++){
+			seed = case_seed;
+			random_case(filter[u], H, measured, expected, R);
+			update(filter[u], (update_t)u, H, measured, expected, R);
+		}
+		/* The default Update() does the same operations as before */
+		CHECK(memcmp(filter[UPDATE].P.data, filter[UPDATE_PREV].P.data, NUMX * NUMX * sizeof(float)) == 0);
+		CHECK(memcmp(filter[UPDATE].X.data, filter[UPDATE_PREV].X.data, NUMX * sizeof(float)) == 0);
+		/* Sequential updates: symmetric P */
+		CHECK(symmetric(filter[UPDATE_SEQUENTIAL].P));
+		/* Against the matrix update, relative to the size of P and X */
+		float scale_p = max_abs(filter[UPDATE_REF].P);
+		float scale_x = max_abs(filter[UPDATE_REF].X);
+		err_prev = fmaxf(err_prev, max_diff(filter[UPDATE].X, filter[UPDATE_REF].X) / scale_x);
+		err_seq = fmaxf(err_seq, max_diff(filter[UPDATE_SEQUENTIAL].P, filter[UPDATE_REF].P) / scale_p);
+		err_seq = fmaxf(err_seq, max_diff(filter[UPDATE_SEQUENTIAL].X, filter[UPDATE_REF].X) / scale_x);
+	}
+	printf("Relative difference with UpdateRef() (100 random cases, %d measurements):\n", NUMM);
+	printf("  Update():             %.2e (X)\n", err_prev);
+	printf("  Update(), sequential: %.2e (X and P)\n", err_seq);
+	CHECK(err_seq < 1e-4f);
+}
+
+/**
+ * @brief Runs ekf_imu13states with the sensors of a rotating body
+ *
+ * @param R: measurement noise variance
+ * @return iterations where P is not positive definite
+ */
+static int run_filter(ekf_imu13states &imu, bool sequential, float R){
+	float R6[6] = {R, R, R, R, R, R};
+	float gyro[3] = {0.3f, -0.2f, 0.1f};
+	float accel[3], magn[3];
+	int lost = 0;
+	imu.Init();
+	imu.P = 0.01f * Mat::eye(NUMX);
+	imu.sequential_update = sequential;
+	for(int n = 0; n < ITERATIONS; n++){
+		float angle = gyro[2] * DT * n;
+		float tilt = 0.2f * sinf(0.01f * n);
+		accel[0] = -sinf(tilt);
+		accel[1] = 0;
+		accel[2] = cosf(tilt);
+		magn[0] = cosf(angle);
+		magn[1] = -sinf(angle);
+		magn[2] = 0;
+		imu.Process(gyro, DT);
+		Mat q(imu.X.data, 4, 1);
+		q /= q.norm();
+		imu.UpdateRefMeasurementMagn(accel, magn, R6);
+		if(!positive_definite(imu.P)){
+			lost++;
+		}
+	}
+	return lost;
+}
+
+static void check_filter(void){
+	ekf_imu13states imu, imu_seq;
+	ekf_imu13states_ref imu_ref;
+	float R[] = {0.01f, 1e-4f, 1e-6f};
+	printf("ekf_imu13states, %d steps:\n", ITERATIONS);
+	printf("                 steps with P not positive definite   state difference with UpdateRef()\n");
+	printf("  R              Update()  sequential  UpdateRef()    Update()  sequential\n");
+	for(int i = 0; i < 3; i++){
+		int lost = run_filter(imu, false, R[i]);
+		int lost_seq = run_filter(imu_seq, true, R[i]);
+		int lost_ref = run_filter(imu_ref, false, R[i]);
+		float diff = max_diff(imu.X, imu_ref.X);
+		float diff_seq = max_diff(imu_seq.X, imu_ref.X);
+		printf("  %-10.0e   %8d  %10d  %11d    %.2e    %.2e\n", R[i], lost, lost_seq, lost_ref, diff, diff_seq);
+		CHECK(lost_seq == 0);
+		if(i == 0){
+			CHECK(diff_seq < 1e-3f);
+		}
+	}
+}
+
+static double now_us(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+/**
+ * @brief Time of one update with the 6 measurements of UpdateRefMeasurementMagn()
+ */
+static void benchmark(void){
+	ekf_imu13states filter;
+	Mat H(NUMM, NUMX);
+	float measured[NUMM], expected[NUMM], R[NUMM];
+	random_case(filter, H, measured, expected, R);
+	Mat P0 = filter.P;
+	Mat X0 = filter.X;
+	printf("Update with %d measurements and %d states:\n", NUMM, NUMX);
+	printf("                        time (us)\n");
+	for(int u = 0; u < UPDATE_TYPES; u++){
+		double time = 0;
+		for(int run = 0; run < RUNS; run++){
+			filter.P = P0;
+			filter.X = X0;
+			double start = now_us();
+			update(filter, (update_t)u, H, measured, expected, R);
+			time += now_us() - start;
+		}
+		printf("  %-20s %9.2f\n", update_names[u], time / RUNS);
+	}
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	check_updates();
+	check_filter();
+	benchmark();
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
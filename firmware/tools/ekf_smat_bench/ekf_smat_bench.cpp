@@ -0,0 +1,254 @@
+/**
+ * @file ekf_smat_bench.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of ekf_imu13states with the fixed size (dspm::SMat) helpers.
+ *
+ * The previous version of the filter, which builds its small matrices as heap
+ * dspm::Mat objects, is kept here as a derived class to compare both: final
+ * state, time per step and heap allocations per step.
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <new>
+#include "mat.h"
+#include "smat.h"
+#include "ekf_imu13states.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define ITERATIONS	2000
+#define DT			0.01f
+
+using dspm::Mat;
+using dspm::SMat;
+
+/**
+ * @brief Previous ekf_imu13states: dspm::Mat helpers
+ */
+class ekf_imu13states_mat: public ekf_imu13states {
+public:
+	virtual dspm::Mat StateXdot(dspm::Mat &x, float *u){
+		float wx = u[0] - x(4, 0);
+		float wy = u[1] - x(5, 0);
+		float wz = u[2] - x(6, 0);
+		float w[] = {wx, wy, wz};
+		dspm::Mat q = dspm::Mat(x.data, 4, 1);
+		dspm::Mat Omega = 0.5 * SkewSym4x4(w);
+		dspm::Mat qdot = Omega * q;
+		dspm::Mat Xdot(this->NUMX, 1);
+		Xdot *= 0;
+		Xdot.Copy(qdot, 0, 0);
+		return Xdot;
+	}
+
+	virtual void LinearizeFG(dspm::Mat &x, float *u){
+		float w[3] = {(u[0] - x(4, 0)), (u[1] - x(5, 0)), (u[2] - x(6, 0))};
+		this->F *= 0;
+		this->G *= 0;
+		F.Copy(0.5 * ekf::SkewSym4x4(w), 0, 0);
+		dspm::Mat dq = -0.5 * qProduct(x.data);
+		dspm::Mat dq_q = dq.Get(0, 4, 1, 3);
+		G.Copy(dq_q, 0, 0);
+		F.Copy(dq_q, 0, 4);
+		dspm::Mat rotm = -1 * this->quat2rotm(x.data);
+		G.Copy(rotm, 7, 6);
+		G.Copy(dspm::Mat::eye(3), 4, 3);
+		G.Copy(dspm::Mat::eye(3), 7, 12);
+		G.Copy(dspm::Mat::eye(3), 10, 9);
+		G.Copy(dspm::Mat::eye(3), 10, 15);
+	}
+
+	void UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6]){
+		dspm::Mat::ArenaScope scope(this->arena);
+		dspm::Mat quat(this->X.data, 4, 1);
+		dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
+		dspm::Mat Re = this->quat2rotm(quat.data).t();
+		dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
+		H.Copy(dAccel_dq, 3, 0);
+		dspm::Mat magn(&this->X.data[7], 3, 1);
+		dspm::Mat magn_offset(&this->X.data[10], 3, 1);
+		dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
+		H.Copy(dMagn_dq, 0, 0);
+		dspm::Mat expected_magn = Re * magn + magn_offset;
+		dspm::Mat expected_accel = Re * this->accel0;
+		float measured_data[6];
+		float expected_data[6];
+		for(int i = 0; i < 3; i++){
+			measured_data[i] = magn_data[i];
+			expected_data[i] = expected_magn.data[i];
+			measured_data[i + 3] = accel_data[i];
+			expected_data[i + 3] = expected_accel.data[i];
+		}
+		this->Update(H, measured_data, expected_data, R);
+		quat /= quat.norm();
+	}
+};
+/*==================[internal data definition]===============================*/
+static int failures;
+static long allocations;
+/*==================[external functions definition]==========================*/
+void *operator new(size_t size){
+	allocations++;
+	void *ptr = malloc(size ? size : 1);
+	if(ptr == NULL){
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void *operator new[](size_t size){
+	return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept{
+	free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept{
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t size) noexcept{
+	free(ptr);
+}
+
+void operator delete[](void *ptr, size_t size) noexcept{
+	free(ptr);
+}
+/*==================[internal functions definition]==========================*/
+typedef struct {
+	double time_us;			/* Time per step */
+	double allocations;		/* Heap allocations per step */
+	float state[13];		/* Final state */
+} result_t;
+
+/**
+ * @brief Runs a filter with the sensors of a rotating body
+ *
+ * @tparam T: ekf_imu13states or ekf_imu13states_mat
+ * @param use_arena: false to leave the temporaries in the heap
+ */
+template <class T>
+static result_t run_filter(bool use_arena){
+	T imu;
+	float R[6] = {0.01f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f};
+	float gyro[3] = {0.3f, -0.2f, 0.1f};
+	float accel[3], magn[3];
+	result_t result;
+	long count = 0;
+	clock_t time = 0;
+	imu.Init();
+	if(!use_arena){
+		imu.arena.size = 0;
+	}
+	for(int n = 0; n < ITERATIONS; n++){
+		float angle = gyro[2] * DT * n;
+		float tilt = 0.2f * sinf(0.01f * n);
+		accel[0] = -sinf(tilt);
+		accel[1] = 0;
+		accel[2] = cosf(tilt);
+		magn[0] = cosf(angle);
+		magn[1] = -sinf(angle);
+		magn[2] = 0;
+
+		long before = allocations;
+		clock_t start = clock();
+		imu.Process(gyro, DT);
+		Mat q(imu.X.data, 4, 1);
+		q /= q.norm();
+		imu.UpdateRefMeasurement(accel, magn, R);
+		time += clock() - start;
+		count += allocations - before;
+	}
+	result.time_us = 1e6 * (double)time / CLOCKS_PER_SEC / ITERATIONS;
+	result.allocations = (double)count / ITERATIONS;
+	memcpy(result.state, imu.X.data, sizeof(result.state));
+	return result;
+}
+
+static void check_smat(void){
+	float a_data[] = {1, 2, 3, 4, 5, 6};
+	float b_data[] = {1, -1, 2, 0, 3, 1};
+	SMat<2, 3> A(a_data);
+	SMat<3, 2> B(b_data);
+	Mat Am(a_data, 2, 3);
+	Mat Bm(b_data, 3, 2);
+	/* Same results as dspm::Mat */
+	SMat<2, 2> C = A * B;
+	Mat Cm = Am * Bm;
+	CHECK(memcmp(C.data, Cm.data, sizeof(C.data)) == 0);
+	SMat<3, 2> At = A.t();
+	Mat Atm = Am.t();
+	CHECK(memcmp(At.data, Atm.data, sizeof(At.data)) == 0);
+	SMat<3, 2> D = At + 2.0f * B - B;
+	for(int i = 0; i < 6; i++){
+		CHECK(D.data[i] == At.data[i] + B.data[i]);
+	}
+	/* Views share the data */
+	Mat view = A.view();
+	view(1, 2) = 10;
+	CHECK(A(1, 2) == 10);
+	SMat<2, 3> copy(Am);
+	CHECK(copy(1, 2) == 6);
+	/* A Mat of another size is not read past its end */
+	SMat<3, 3> wrong(Am);
+	CHECK(wrong(0, 0) == 0 && wrong(2, 2) == 0);
+	SMat<2, 2> block = A.block<2, 2>(0, 1);
+	CHECK(block(0, 0) == 2 && block(1, 1) == 10);
+	SMat<3, 3> eye = SMat<3, 3>::eye();
+	CHECK(eye(2, 2) == 1 && eye(2, 1) == 0);
+	/* Helpers: same results as the dspm::Mat versions */
+	float q[4] = {0.9f, 0.1f, -0.3f, 0.2f};
+	float v[3] = {0.5f, -1, 2};
+	SMat<3, 3> Rm;
+	ekf::quat2rotm(q, Rm);
+	Mat Rmm = ekf::quat2rotm(q);
+	CHECK(memcmp(Rm.data, Rmm.data, sizeof(Rm.data)) == 0);
+	Mat qm(q, 4, 1);
+	Mat vm(v, 3, 1);
+	SMat<3, 4> J = ekf::dFdq_inv(SMat<3, 1>(v), SMat<4, 1>(q));
+	Mat Jm = ekf::dFdq_inv(vm, qm);
+	CHECK(memcmp(J.data, Jm.data, sizeof(J.data)) == 0);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	check_smat();
+
+	result_t mat_heap = run_filter<ekf_imu13states_mat>(false);
+	result_t smat_heap = run_filter<ekf_imu13states>(false);
+	result_t mat_arena = run_filter<ekf_imu13states_mat>(true);
+	result_t smat_arena = run_filter<ekf_imu13states>(true);
+
+	printf("ekf_imu13states step (Process() + UpdateRefMeasurement()):\n");
+	printf("                      time (us)   heap allocations\n");
+	printf("  Mat, heap           %9.2f   %16.1f\n", mat_heap.time_us, mat_heap.allocations);
+	printf("  SMat, heap          %9.2f   %16.1f\n", smat_heap.time_us, smat_heap.allocations);
+	printf("  Mat, arena          %9.2f   %16.1f\n", mat_arena.time_us, mat_arena.allocations);
+	printf("  SMat, arena         %9.2f   %16.1f\n", smat_arena.time_us, smat_arena.allocations);
+	CHECK(smat_heap.allocations < mat_heap.allocations);
+	CHECK(smat_arena.allocations == 0);
+	/* The fixed size helpers do the same operations */
+	CHECK(memcmp(mat_heap.state, smat_heap.state, sizeof(mat_heap.state)) == 0);
+	CHECK(memcmp(mat_heap.state, smat_arena.state, sizeof(mat_heap.state)) == 0);
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,148 @@
+/**
+ * @file fast_io_map_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the pin map of the dedicated GPIO bundles (fast_io_map
+ * module) used by gpio_fast_out_mcu.c.
+ *
+ * Build (from this folder): make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fast_io_map.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define RANDOM_MAPS	10000
+#define ALL_PINS	0xFFFFFFFFUL
+#define PORT_PINS	0x00FFBFFFUL	/* GPIO_PORT_MASK of gpio_mcu.h: GPIO_0 to GPIO_23, except GPIO_14 */
+/*==================[internal data definition]===============================*/
+static int failures;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Bundle value of a port value, bit by bit
+ */
+static uint8_t from_port_ref(const uint8_t *pins, uint8_t qty, uint32_t port){
+	uint8_t value = 0;
+	for(uint8_t i = 0; i < qty; i++){
+		value |= ((port >> pins[i]) & 1) << i;
+	}
+	return value;
+}
+
+/**
+ * @brief Invalid lists are rejected and leave the map unchanged
+ */
+static void test_reject(void){
+	fast_io_map_t map, copy;
+	const uint8_t valid[] = {4, 5};
+	const uint8_t nine[] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+	const uint8_t out_of_range[] = {3, FAST_IO_MAP_PINS};
+	const uint8_t repeated[] = {6, 7, 8, 6};
+	const uint8_t max[] = {255};
+	CHECK(FastIoMapInit(&map, valid, 2, ALL_PINS));
+	memcpy(&copy, &map, sizeof(map));
+	CHECK(!FastIoMapInit(&map, valid, 0, ALL_PINS));
+	CHECK(!FastIoMapInit(&map, nine, FAST_IO_MAP_MAX + 1, ALL_PINS));
+	CHECK(!FastIoMapInit(&map, out_of_range, 2, ALL_PINS));
+	CHECK(!FastIoMapInit(&map, repeated, 4, ALL_PINS));
+	CHECK(!FastIoMapInit(&map, max, 1, ALL_PINS));
+	/* Pins that are not in the port can not be mapped */
+	const uint8_t flash[] = {0, 14};
+	const uint8_t high[] = {24, 1};
+	CHECK(!FastIoMapInit(&map, flash, 2, PORT_PINS));
+	CHECK(!FastIoMapInit(&map, high, 2, PORT_PINS));
+	CHECK(!FastIoMapInit(&map, valid, 2, 0));
+	/* A rejected list does not change the number of pins, the masks or the conversions */
+	CHECK((map.qty == copy.qty) && (map.mask == copy.mask) && (map.port_mask == copy.port_mask));
+	CHECK(FastIoMapToPort(&map, 0x3) == ((1UL << 4) | (1UL << 5)));
+}
+
+/**
+ * @brief Known maps: bit order, pin 31, eight pins and bits outside the bundle
+ */
+static void test_known(void){
+	fast_io_map_t map;
+	const uint8_t reversed[] = {9, 3, 0};
+	const uint8_t edge[] = {31, 0};
+	const uint8_t eight[] = {23, 22, 21, 20, 19, 18, 15, 1};
+
+	CHECK(FastIoMapInit(&map, reversed, 3, ALL_PINS));
+	CHECK(map.mask == 0x07);
+	CHECK(map.port_mask == 0x209);
+	CHECK(FastIoMapToPort(&map, 0x1) == (1UL << 9));
+	CHECK(FastIoMapToPort(&map, 0x4) == (1UL << 0));
+	CHECK(FastIoMapToPort(&map, 0xF8) == 0);					/* Bits above qty are ignored */
+	CHECK(FastIoMapFromPort(&map, 0x008) == 0x2);
+	CHECK(FastIoMapFromPort(&map, ~0x209U) == 0);			/* Pins outside the bundle are ignored */
+
+	CHECK(FastIoMapInit(&map, edge, 2, ALL_PINS));
+	CHECK(map.port_mask == 0x80000001UL);
+	CHECK(FastIoMapToPort(&map, 0x1) == 0x80000000UL);
+	CHECK(FastIoMapFromPort(&map, 0x80000000UL) == 0x1);
+
+	CHECK(FastIoMapInit(&map, eight, FAST_IO_MAP_MAX, ALL_PINS));
+	CHECK(map.mask == 0xFF);
+	CHECK(FastIoMapToPort(&map, 0xFF) == map.port_mask);
+	CHECK(FastIoMapToPort(&map, 0x81) == ((1UL << 23) | (1UL << 1)));
+}
+
+/**
+ * @brief Random lists: accepted only with distinct pins of the port; then every
+ * bundle value goes to the port and back, and port values match the bit by bit
+ * conversion
+ */
+static void test_random(void){
+	fast_io_map_t map;
+	uint8_t pins[FAST_IO_MAP_MAX];
+	int errors = 0, rejected = 0;
+	srand(1);
+	for(int m = 0; m < RANDOM_MAPS; m++){
+		uint8_t qty = 1 + rand() % FAST_IO_MAP_MAX;
+		uint32_t used = 0;
+		bool valid = true;
+		for(uint8_t i = 0; i < qty; i++){
+			pins[i] = rand() % FAST_IO_MAP_PINS;
+			valid &= ((PORT_PINS >> pins[i]) & 1) && !((used >> pins[i]) & 1);
+			used |= 1UL << pins[i];
+		}
+		if(FastIoMapInit(&map, pins, qty, PORT_PINS) != valid){
+			errors++;
+			continue;
+		}
+		if(!valid){
+			rejected++;
+			continue;
+		}
+		if((map.port_mask != used) || (map.mask != (1U << qty) - 1)){
+			errors++;
+			continue;
+		}
+		for(uint32_t v = 0; v <= map.mask; v++){
+			uint32_t port = FastIoMapToPort(&map, v);
+			errors += ((port & ~used) != 0) || (__builtin_popcount(port) != __builtin_popcount(v));
+			errors += (FastIoMapFromPort(&map, port) != v);
+		}
+		uint32_t port = ((uint32_t)rand() << 16) ^ rand();
+		errors += (FastIoMapFromPort(&map, port) != from_port_ref(pins, qty, port));
+	}
+	printf("%d random lists (%d rejected): %d errors\n", RANDOM_MAPS, rejected, errors);
+	CHECK(errors == 0);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	test_reject();
+	test_known();
+	test_random();
+	printf(failures ? "%d FAILURES\n" : "OK\n", failures);
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,166 @@
+/**
+ * @file fft_q15_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host accuracy test of FFTMagnitudeQ15() against the float FFTMagnitude().
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fft.h"
+#include "dsps_wind_hann.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define PI			3.14159265358979f
+/*==================[internal data definition]===============================*/
+static int failures;
+static float signal_f[MAX_SIGNAL_LENGHT];
+static int16_t signal_q15[MAX_SIGNAL_LENGHT];
+static float fft_f[MAX_SIGNAL_LENGHT / 2];
+static uint16_t fft_q15[MAX_SIGNAL_LENGHT / 2];
+/*==================[internal functions definition]==========================*/
+typedef enum {
+	SINE_FULL,			/* Sine of amplitude 0.9 */
+	SINE_SMALL,			/* Sine of amplitude 0.001 (33 LSB) */
+	TWO_TONES,			/* 0.5 and 0.002 amplitude sines */
+	DC_SINE,			/* Offset of 0.5 and 0.4 amplitude sine */
+	NOISE,				/* Uniform noise in [-0.9, 0.9] */
+	SQUARE,				/* Full scale square wave */
+	SIGNALS
+} test_signal_t;
+
+static const char *signal_names[] = {"sine 0.9", "sine 0.001", "two tones", "dc + sine", "noise", "square"};
+
+static void generate(test_signal_t type, uint16_t n){
+	for(uint16_t i = 0; i < n; i++){
+		float t = (float)i / n;
+		float x;
+		switch(type){
+		case SINE_FULL:
+			x = 0.9f * sinf(2 * PI * 10.3f * t);
+			break;
+		case SINE_SMALL:
+			x = 0.001f * sinf(2 * PI * 10.3f * t);
+			break;
+		case TWO_TONES:
+			x = 0.5f * sinf(2 * PI * 7 * t) + 0.002f * sinf(2 * PI * (n / 4 + 0.5f) * t);
+			break;
+		case DC_SINE:
+			x = 0.5f + 0.4f * sinf(2 * PI * 3 * t);
+			break;
+		case NOISE:
+			x = 0.9f * (2.0f * rand() / RAND_MAX - 1.0f);
+			break;
+		case SQUARE:
+		default:
+			x = ((i / 8) % 2) ? 32767 / 32768.0f : -1.0f;
+			break;
+		}
+		signal_q15[i] = (int16_t)lrintf(x * 32768);
+		/* The float path gets exactly the same samples */
+		signal_f[i] = signal_q15[i] / 32768.0f;
+	}
+}
+
+/**
+ * @brief Largest error of the Q15 spectrum, in dB relative to the spectrum peak
+ */
+static float compare(uint16_t n, int8_t exponent){
+	float peak = 0, error = 0, scale = ldexpf(1.0f, exponent) / 32768;
+	for(uint16_t k = 0; k < n / 2; k++){
+		if(fft_f[k] > peak){
+			peak = fft_f[k];
+		}
+		if(fabsf(fft_q15[k] * scale - fft_f[k]) > error){
+			error = fabsf(fft_q15[k] * scale - fft_f[k]);
+		}
+	}
+	return 20 * log10f(error / peak);
+}
+/**
+ * @brief Windowed peak that rounds up to 32768 with the block scaling
+ *
+ * A small sine plus one sample x at the edge of the window, where the Q15
+ * window weight w makes x * w round up to 32768 when it is scaled to 16 bits
+ * (e.g. x = 25811, w = 325 with a shift of 7). The peak must not wrap to -32768.
+ */
+static void test_rounding_peak(uint16_t n){
+	static float wind[MAX_SIGNAL_LENGHT];
+	dsps_wind_hann_f32(wind, n);
+	for(uint16_t i = 1; i < n / 2; i++){
+		int32_t w = (int16_t)(wind[i] * 0x7FFF + 0.5f);
+		if(w == 0){
+			continue;
+		}
+		int32_t x = (8388480 + w - 1) / w;
+		if((x > 32767) || (x * w >= 8388608)){
+			continue;
+		}
+		for(uint16_t j = 0; j < n; j++){
+			signal_q15[j] = (int16_t)lrintf(0.001f * 32768 * sinf(2 * PI * 5 * j / n));
+		}
+		signal_q15[i] = (int16_t)x;
+		for(uint16_t j = 0; j < n; j++){
+			signal_f[j] = signal_q15[j] / 32768.0f;
+		}
+		FFTMagnitude(signal_f, fft_f, n);
+		int8_t exponent = FFTMagnitudeQ15(signal_q15, fft_q15, n);
+		float error = compare(n, exponent);
+		printf("rounding peak: N = %u, x = %d, w = %d, error %.1f dB\n", n, (int)x, (int)w, error);
+		/* Broadband like the noise (limit -48 dB), a wrapped peak gives -13 to -32 dB */
+		CHECK(error < -48);
+		return;
+	}
+	printf("rounding peak: no window weight for N = %u\n", n);
+	failures++;
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	const uint16_t lenghts[] = {64, 256, 1024, 2048};
+	/* Worst case allowed for each signal (dB below the spectrum peak). The
+	 * fixed point FFT rounds the data to 16 bits in every stage, so the error
+	 * grows with the lenght, and it is higher relative to the peak for
+	 * broadband signals */
+	const float limits[SIGNALS] = {-62, -60, -62, -62, -48, -66};
+	CHECK(FFTInit());
+	CHECK(FFTInitQ15());
+	printf("%-12s", "error (dB)");
+	for(unsigned l = 0; l < sizeof(lenghts) / sizeof(lenghts[0]); l++){
+		printf("%8u", lenghts[l]);
+	}
+	printf("\n");
+	for(int s = 0; s < SIGNALS; s++){
+		printf("%-12s", signal_names[s]);
+		for(unsigned l = 0; l < sizeof(lenghts) / sizeof(lenghts[0]); l++){
+			uint16_t n = lenghts[l];
+			generate(s, n);
+			FFTMagnitude(signal_f, fft_f, n);
+			int8_t exponent = FFTMagnitudeQ15(signal_q15, fft_q15, n);
+			float error = compare(n, exponent);
+			printf("%8.1f", error);
+			CHECK(error < limits[s]);
+		}
+		printf("\n");
+	}
+	test_rounding_peak(256);
+	test_rounding_peak(2048);
+	if(failures){
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("OK\n");
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,3 @@
+/* Host mock */
+#pragma once
+#define IRAM_ATTR
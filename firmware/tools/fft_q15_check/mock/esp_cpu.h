@@ -0,0 +1,7 @@
+/* Host mock of the CPU cycle counter */
+#pragma once
+#include <stdint.h>
+#include <time.h>
+static inline uint32_t esp_cpu_get_cycle_count(void){
+	return (uint32_t)clock();
+}
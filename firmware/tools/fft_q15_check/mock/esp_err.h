@@ -0,0 +1,8 @@
+/* Host mock of the ESP-IDF error codes */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+typedef int esp_err_t;
+#define ESP_OK		0
+#define ESP_FAIL	(-1)
@@ -0,0 +1,7 @@
+/* Host mock of the ESP-IDF log */
+#pragma once
+#define ESP_LOGE(tag, ...)
+#define ESP_LOGW(tag, ...)
+#define ESP_LOGI(tag, ...)
+#define ESP_LOGD(tag, ...)
+#define ESP_LOGV(tag, ...)
@@ -0,0 +1,2 @@
+/* Host mock */
+#pragma once
@@ -0,0 +1,2 @@
+/* Host mock: no target options */
+#pragma once
@@ -0,0 +1,330 @@
+/**
+ * @file fft_real_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the esp-dsp real FFT (dsps_fft2r_real_fc32/sc16).
+ *
+ * Compares the real FFT (N real samples packed in a complex FFT of N/2 points)
+ * with the complex FFT of N points with zero imaginary parts, in float and in
+ * Q15, checks FFTMagnitude() against its previous (complex FFT) version, and
+ * measures the time of both paths.
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "fft.h"
+#include "dsps_fft2r.h"
+#include "dsps_wind_hann.h"
+#include "dsps_mul.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define MAX_N		CONFIG_DSP_MAX_FFT_SIZE
+#define MAX_ERROR	1e-5f		/* Float: relative to the largest bin */
+#define RUNS		400
+#define REPEAT		7			/* Benchmark: best of 7 measurements */
+/*==================[internal data definition]===============================*/
+static int failures;
+static float x_f[MAX_N];
+static float real_f[MAX_N];
+static float cplx_f[2 * MAX_N];
+static int16_t x_q15[MAX_N];
+static int16_t real_q15[MAX_N];
+static int16_t cplx_q15[2 * MAX_N];
+static double dft_re[MAX_N / 2 + 1];
+static double dft_im[MAX_N / 2 + 1];
+/*==================[internal functions definition]==========================*/
+static double now_us(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+typedef enum {
+	NOISE,			/* Uniform noise, full scale */
+	TONE,			/* Sine of amplitude 0.9 */
+	SQUARE_N4,		/* Full scale square wave of period 4: the bin N/4 is the largest possible */
+	SQUARE,			/* Full scale square wave of period 16 */
+	DC,				/* Full scale negative constant */
+	SIGNALS
+} test_signal_t;
+
+static const char *signal_names[] = {"noise", "tone", "square N/4", "square", "dc"};
+
+static void generate(test_signal_t type, int n){
+	for(int i = 0; i < n; i++){
+		switch(type){
+		case NOISE:
+			x_q15[i] = rand() % 65536 - 32768;
+			break;
+		case TONE:
+			x_q15[i] = lround(29490 * sin(2 * M_PI * 10.3 * i / n));
+			break;
+		case SQUARE_N4:
+			x_q15[i] = (i & 2) ? INT16_MIN : INT16_MAX;
+			break;
+		case SQUARE:
+			x_q15[i] = (i & 8) ? INT16_MIN : INT16_MAX;
+			break;
+		default:
+			x_q15[i] = INT16_MIN;
+			break;
+		}
+		x_f[i] = x_q15[i] / 32768.0f;
+	}
+}
+
+/**
+ * @brief Exact DFT of x_q15 (bins 0 to n/2), divided by n
+ */
+static void dft(int n){
+	for(int k = 0; k <= n / 2; k++){
+		double re = 0, im = 0;
+		for(int i = 0; i < n; i++){
+			/* Angle reduced modulo n to keep the double precision */
+			double angle = 2 * M_PI * (double)(((long)k * i) % n) / n;
+			re += x_q15[i] * cos(angle);
+			im -= x_q15[i] * sin(angle);
+		}
+		dft_re[k] = re / n;
+		dft_im[k] = im / n;
+	}
+}
+
+/**
+ * @brief Bin k of a real FFT result (bins 0 and n/2 packed in the first element)
+ */
+static void real_bin(const float *data, int n, int k, float *re, float *im){
+	if(k == 0){
+		*re = data[0];
+		*im = 0;
+	} else if(k == n / 2){
+		*re = data[1];
+		*im = 0;
+	} else {
+		*re = data[2 * k];
+		*im = data[2 * k + 1];
+	}
+}
+
+static void check_float(void){
+	float worst = 0;
+	for(int n = 4; n <= MAX_N; n *= 2){
+		for(int s = 0; s < SIGNALS; s++){
+			generate(s, n);
+			memcpy(real_f, x_f, n * sizeof(float));
+			CHECK(dsps_fft2r_real_fc32(real_f, n) == ESP_OK);
+			for(int i = 0; i < n; i++){
+				cplx_f[2 * i] = x_f[i];
+				cplx_f[2 * i + 1] = 0;
+			}
+			dsps_fft2r_fc32(cplx_f, n);
+			dsps_bit_rev_fc32(cplx_f, n);
+			float peak = 1e-30f, diff = 0;
+			for(int k = 0; k <= n / 2; k++){
+				float re, im;
+				real_bin(real_f, n, k, &re, &im);
+				peak = fmaxf(peak, hypotf(cplx_f[2 * k], cplx_f[2 * k + 1]));
+				diff = fmaxf(diff, hypotf(re - cplx_f[2 * k], im - cplx_f[2 * k + 1]));
+			}
+			worst = fmaxf(worst, diff / peak);
+		}
+	}
+	printf("dsps_fft2r_real_fc32 against dsps_fft2r_fc32 (N = 4 to %d): max relative error %.1e\n", MAX_N, worst);
+	CHECK(worst < MAX_ERROR);
+	CHECK(dsps_fft2r_real_fc32(real_f, 2) == ESP_ERR_DSP_INVALID_LENGTH);
+	CHECK(dsps_fft2r_real_fc32(real_f, 100) == ESP_ERR_DSP_INVALID_LENGTH);
+	CHECK(dsps_cplx2real2r_fc32_ansi(real_f, MAX_N) == ESP_ERR_DSP_PARAM_OUTOFRANGE);
+}
+
+/**
+ * @brief Q15: error of the real and of the complex FFT against the exact DFT / N, in LSB
+ */
+static void check_q15(void){
+	const int lenghts[] = {16, 64, 256, 1024};
+	printf("Q15 FFT, max error against the exact DFT / N (LSB): real / complex\n");
+	printf("  %-12s", "signal");
+	for(unsigned l = 0; l < sizeof(lenghts) / sizeof(int); l++){
+		printf("%14d", lenghts[l]);
+	}
+	printf("\n");
+	for(int s = 0; s < SIGNALS; s++){
+		printf("  %-12s", signal_names[s]);
+		for(unsigned l = 0; l < sizeof(lenghts) / sizeof(int); l++){
+			int n = lenghts[l];
+			double err_real = 0, err_cplx = 0;
+			generate(s, n);
+			dft(n);
+			memcpy(real_q15, x_q15, n * sizeof(int16_t));
+			CHECK(dsps_fft2r_real_sc16(real_q15, n) == ESP_OK);
+			for(int i = 0; i < n; i++){
+				cplx_q15[2 * i] = x_q15[i];
+				cplx_q15[2 * i + 1] = 0;
+			}
+			dsps_fft2r_sc16(cplx_q15, n);
+			dsps_bit_rev_sc16_ansi(cplx_q15, n);
+			for(int k = 0; k <= n / 2; k++){
+				double re, im;
+				if(k == 0){
+					re = real_q15[0];
+					im = 0;
+				} else if(k == n / 2){
+					re = real_q15[1];
+					im = 0;
+				} else {
+					re = real_q15[2 * k];
+					im = real_q15[2 * k + 1];
+				}
+				err_real = fmax(err_real, hypot(re - dft_re[k], im - dft_im[k]));
+				err_cplx = fmax(err_cplx, hypot(cplx_q15[2 * k] - dft_re[k], cplx_q15[2 * k + 1] - dft_im[k]));
+			}
+			printf("%7.1f /%5.1f", err_real, err_cplx);
+			/* Rounding in log2(N) - 1 stages and in the post-processing */
+			CHECK(err_real <= err_cplx + 1);
+		}
+		printf("\n");
+	}
+	CHECK(dsps_fft2r_real_sc16(real_q15, 2) == ESP_ERR_DSP_INVALID_LENGTH);
+}
+
+/**
+ * @brief FFTMagnitude() before the real FFT, as reference
+ */
+static void fft_magnitude_prev(float *signal, float *fft, uint16_t n){
+	static float wind[MAX_SIGNAL_LENGHT];
+	dsps_wind_hann_f32(wind, n);
+	memset(cplx_f, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
+	dsps_mul_f32(signal, wind, cplx_f, n, 1, 1, 2);
+	dsps_fft2r_fc32(cplx_f, n);
+	dsps_bit_rev_fc32(cplx_f, n);
+	dsps_cplx2reC_fc32(cplx_f, n);
+	for(int j = 0; j < n; j++){
+		cplx_f[j] = 2 * (sqrt(cplx_f[j * 2 + 0] * cplx_f[j * 2 + 0] + cplx_f[j * 2 + 1] * cplx_f[j * 2 + 1])) / (n / 2);
+	}
+	cplx_f[0] = cplx_f[0] / 2;
+	memcpy(fft, cplx_f, (n / 2) * sizeof(float));
+}
+
+static void check_magnitude(void){
+	static float fft_prev[MAX_SIGNAL_LENGHT / 2], fft_new[MAX_SIGNAL_LENGHT / 2];
+	float worst = 0;
+	for(int n = 8; n <= MAX_SIGNAL_LENGHT; n *= 2){
+		for(int s = 0; s < SIGNALS; s++){
+			generate(s, n);
+			fft_magnitude_prev(x_f, fft_prev, n);
+			FFTMagnitude(x_f, fft_new, n);
+			float peak = 1e-30f, diff = 0;
+			for(int k = 0; k < n / 2; k++){
+				peak = fmaxf(peak, fft_prev[k]);
+				diff = fmaxf(diff, fabsf(fft_prev[k] - fft_new[k]));
+			}
+			worst = fmaxf(worst, diff / peak);
+		}
+	}
+	printf("FFTMagnitude() against the previous version (complex FFT): max relative error %.1e\n", worst);
+	CHECK(worst < MAX_ERROR);
+}
+
+static void complex_fc32(int n){
+	for(int i = 0; i < n; i++){
+		cplx_f[2 * i] = x_f[i];
+		cplx_f[2 * i + 1] = 0;
+	}
+	dsps_fft2r_fc32(cplx_f, n);
+	dsps_bit_rev_fc32(cplx_f, n);
+}
+
+static void real_fc32(int n){
+	memcpy(real_f, x_f, n * sizeof(float));
+	dsps_fft2r_real_fc32(real_f, n);
+}
+
+static void complex_sc16(int n){
+	for(int i = 0; i < n; i++){
+		cplx_q15[2 * i] = x_q15[i];
+		cplx_q15[2 * i + 1] = 0;
+	}
+	dsps_fft2r_sc16(cplx_q15, n);
+	dsps_bit_rev_sc16_ansi(cplx_q15, n);
+}
+
+static void real_sc16(int n){
+	memcpy(real_q15, x_q15, n * sizeof(int16_t));
+	dsps_fft2r_real_sc16(real_q15, n);
+}
+
+static void magnitude_prev(int n){
+	static float fft_out[MAX_SIGNAL_LENGHT / 2];
+	fft_magnitude_prev(x_f, fft_out, n);
+}
+
+static void magnitude(int n){
+	static float fft_out[MAX_SIGNAL_LENGHT / 2];
+	FFTMagnitude(x_f, fft_out, n);
+}
+
+/**
+ * @brief Time of one call (us): best of REPEAT averages, to filter the host noise
+ */
+static double time_us(void (*function)(int), int n){
+	const int runs = RUNS * 256 / n;
+	double best = 1e30;
+	for(int rep = 0; rep < REPEAT; rep++){
+		double start = now_us();
+		for(int r = 0; r < runs; r++){
+			function(n);
+		}
+		best = fmin(best, (now_us() - start) / runs);
+	}
+	return best;
+}
+
+static void benchmark(void){
+	printf("Time (us)    complex fc32  real fc32  speedup  complex sc16  real sc16  speedup  FFTMagnitude prev / new\n");
+	double total[4] = {0};
+	for(int n = 256; n <= MAX_SIGNAL_LENGHT; n *= 2){
+		generate(NOISE, n);
+		double t_cf = time_us(complex_fc32, n);
+		double t_rf = time_us(real_fc32, n);
+		double t_cs = time_us(complex_sc16, n);
+		double t_rs = time_us(real_sc16, n);
+		double t_mp = time_us(magnitude_prev, n);
+		double t_m = time_us(magnitude, n);
+		printf("  N = %-5d %12.1f %10.1f %8.2f %13.1f %10.1f %8.2f %14.1f / %.1f\n", n,
+			t_cf, t_rf, t_cf / t_rf, t_cs, t_rs, t_cs / t_rs, t_mp, t_m);
+		total[0] += t_cf;
+		total[1] += t_rf;
+		total[2] += t_cs;
+		total[3] += t_rs;
+	}
+	/* Only reported: host timings depend on the machine and its load */
+	printf("  Total speedup: fc32 %.2f, sc16 %.2f\n", total[0] / total[1], total[2] / total[3]);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	CHECK(FFTInit());
+	CHECK(FFTInitQ15());
+	check_float();
+	check_q15();
+	check_magnitude();
+	benchmark();
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,319 @@
+/**
+ * @file format_bench.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host checks and benchmark of the format module against UartItoa() and snprintf().
+ *
+ * Build (from this folder): make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "format.h"
+/*==================[macros and definitions]=================================*/
+#define N_VALUES	4096
+#define N_ROUNDS	2000
+#define N_FLOATS	200000
+#define EXPECT(cond, ...)	do{ if(!(cond)){ if(failures < 20){ fprintf(stderr, "FAIL: " __VA_ARGS__); } failures++; } }while(0)
+/*==================[internal data definition]===============================*/
+static uint32_t values[N_VALUES];
+static float fvalues[N_VALUES];
+static volatile uint32_t sink;
+static int failures;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Copy of UartItoa() from uart_mcu.c (one division per digit, static buffer)
+ */
+static uint8_t* uart_itoa(uint32_t val, uint8_t base){
+	static uint8_t buf[32] = {0};
+	uint32_t i = 30;
+	if(val == 0){
+		return (uint8_t*)"0";
+	}else{
+		for(; val && i ; --i, val /= base){
+			buf[i] = "0123456789abcdef"[val % base];
+		}
+		return &buf[i+1];
+	}
+}
+
+static double elapsed_ns(struct timespec *start, uint32_t ops){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((now.tv_sec - start->tv_sec) * 1e9 + (now.tv_nsec - start->tv_nsec)) / ops;
+}
+
+/**
+ * @brief Fixed-point reference: integer and fractional parts with 64 bit arithmetic
+ */
+static void fixed_ref(char *buf, int32_t val, uint8_t decimals){
+	long long mag = llabs((long long)val), scale = 1;
+	for(uint8_t i = 0; i < decimals; i++){
+		scale *= 10;
+	}
+	if(decimals){
+		sprintf(buf, "%s%lld.%0*lld", (val < 0) ? "-" : "", mag / scale, decimals, mag % scale);
+	} else{
+		sprintf(buf, "%s%lld", (val < 0) ? "-" : "", mag);
+	}
+}
+
+/**
+ * @brief Float reference with the documented rounding: half away from zero on the
+ * exact value of the float (a long double holds val * 10^9 without rounding)
+ */
+static void float_ref(char *buf, float val, uint8_t decimals){
+	long double x = floorl(fabsl((long double)val) * powl(10, decimals) + 0.5L);
+	unsigned long long q = (unsigned long long)x, scale = 1;
+	for(uint8_t i = 0; i < decimals; i++){
+		scale *= 10;
+	}
+	const char *sign = ((val < 0) && q) ? "-" : "";
+	if(decimals){
+		sprintf(buf, "%s%llu.%0*llu", sign, q / scale, decimals, q % scale);
+	} else{
+		sprintf(buf, "%s%llu", sign, q);
+	}
+}
+
+/**
+ * @brief Random float with several magnitudes, including exact binary fractions (ties)
+ */
+static float random_float(void){
+	switch(rand() % 3){
+		case 0:
+			return (rand() / (float)RAND_MAX - 0.5f) * 2000.0f;
+		case 1:
+			return (rand() / (float)RAND_MAX - 0.5f) * 2.0f;
+		default:
+			return ldexpf((float)(rand() % 100000 - 50000), -(rand() % 12));
+	}
+}
+
+static void check_integers(void){
+	const int32_t edges[] = {0, 1, -1, 9, -10, 99, -100, INT32_MAX, INT32_MIN, INT32_MIN + 1};
+	char a[32], b[32];
+	uint8_t n;
+	for(uint32_t i = 0; i < N_VALUES; i++){
+		FormatU32(a, values[i]);
+		EXPECT(strcmp(a, (char *)uart_itoa(values[i], 10)) == 0, "FormatU32(%u) = %s\n", values[i], a);
+		FormatHex(a, values[i], 0);
+		snprintf(b, sizeof(b), "%x", values[i]);
+		EXPECT(strcmp(a, b) == 0, "FormatHex(%u) = %s\n", values[i], a);
+		FormatHex(a, values[i], i % 10);
+		snprintf(b, sizeof(b), "%0*x", (i % 10 > 8) ? 8 : i % 10, values[i]);
+		EXPECT(strcmp(a, b) == 0, "FormatHex(%u, %u) = %s\n", values[i], i % 10, a);
+		int32_t v = (i & 1) ? -(int32_t)(values[i] >> 1) : (int32_t)values[i];
+		n = FormatI32(a, v);
+		snprintf(b, sizeof(b), "%d", v);
+		EXPECT((strcmp(a, b) == 0) && (n == strlen(b)), "FormatI32(%d) = %s\n", v, a);
+	}
+	for(unsigned i = 0; i < sizeof(edges) / sizeof(edges[0]); i++){
+		n = FormatI32(a, edges[i]);
+		snprintf(b, sizeof(b), "%d", edges[i]);
+		EXPECT((strcmp(a, b) == 0) && (n == strlen(b)) && (n < FORMAT_I32_LEN), "FormatI32(%d) = %s\n", edges[i], a);
+		for(uint8_t d = 0; d <= FORMAT_MAX_DECIMALS; d++){
+			n = FormatFixed(a, edges[i], d);
+			fixed_ref(b, edges[i], d);
+			EXPECT((strcmp(a, b) == 0) && (n == strlen(b)), "FormatFixed(%d, %u) = %s\n", edges[i], d, a);
+		}
+	}
+	for(uint32_t i = 0; i < N_VALUES; i++){
+		int32_t v = (int32_t)values[i];
+		uint8_t d = i % (FORMAT_MAX_DECIMALS + 1);
+		n = FormatFixed(a, v, d);
+		fixed_ref(b, v, d);
+		EXPECT((strcmp(a, b) == 0) && (n == strlen(b)), "FormatFixed(%d, %u) = %s\n", v, d, a);
+	}
+	FormatFixed(a, -12345, 2);
+	EXPECT(strcmp(a, "-123.45") == 0, "FormatFixed(-12345, 2) = %s\n", a);
+	FormatFixed(a, -5, 3);
+	EXPECT(strcmp(a, "-0.005") == 0, "FormatFixed(-5, 3) = %s\n", a);
+}
+
+static void check_floats(void){
+	/* Exact ties (snprintf() rounds them to even) and special values */
+	const struct {
+		float val;
+		uint8_t decimals;
+		const char *text;
+	} cases[] = {
+		{0.5f, 0, "1"}, {2.5f, 0, "3"}, {-2.5f, 0, "-3"}, {0.125f, 2, "0.13"}, {-0.125f, 2, "-0.13"},
+		{1.0625f, 3, "1.063"}, {0.375f, 2, "0.38"}, {9.146484375f, 9, "9.146484375"}, {9.146484375f, 8, "9.14648438"},
+		{0.999f, 2, "1.00"}, {-0.001f, 2, "0.00"}, {-0.0f, 1, "0.0"}, {4294967040.0f, 1, "4294967040.0"},
+		{4294967296.0f, 2, "ovf"}, {-1e20f, 2, "-ovf"}, {INFINITY, 2, "inf"}, {-INFINITY, 2, "-inf"}, {NAN, 2, "nan"},
+	};
+	char a[64], b[64];
+	int bad[FORMAT_MAX_DECIMALS + 1] = {0};
+	for(unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+		uint8_t n = FormatFloat(a, cases[i].val, cases[i].decimals);
+		EXPECT((strcmp(a, cases[i].text) == 0) && (n == strlen(a)), "FormatFloat(%.10g, %u) = %s, expected %s\n",
+			cases[i].val, cases[i].decimals, a, cases[i].text);
+	}
+	for(uint32_t i = 0; i < N_FLOATS; i++){
+		float v = random_float();
+		uint8_t d = i % (FORMAT_MAX_DECIMALS + 1);
+		FormatFloat(a, v, d);
+		float_ref(b, v, d);
+		EXPECT(strcmp(a, b) == 0, "FormatFloat(%.10g, %u) = %s, expected %s\n", v, d, a, b);
+		bad[d] += (strcmp(a, b) != 0);
+		/* Away from ties it matches snprintf() */
+		long double x = fabsl((long double)v) * powl(10, d);
+		if(x - floorl(x) != 0.5L){
+			snprintf(b, sizeof(b), "%.*f", d, v);
+			if(strcmp(b, "-0") == 0 || (b[0] == '-' && strspn(b, "-0.") == strlen(b))){
+				memmove(b, b + 1, strlen(b));		/* FormatFloat() does not write "-0" */
+			}
+			EXPECT(strcmp(a, b) == 0, "FormatFloat(%.10g, %u) = %s, snprintf %s\n", v, d, a, b);
+		}
+	}
+}
+
+/**
+ * @brief FormatPrint() against snprintf() (same output and truncation, returns
+ * the characters written instead of the full length)
+ */
+static void check_print(void){
+	char a[64], b[64];
+	uint32_t n;
+	int full;
+#define PRINT_CASE(size, ...)	do{ \
+		n = FormatPrint(a, size, __VA_ARGS__); \
+		full = snprintf(b, size, __VA_ARGS__); \
+		EXPECT((strcmp(a, b) == 0) && (n == (((uint32_t)full < (size)) ? (uint32_t)full : (size) - 1)), \
+			"FormatPrint(%u, \"%s\") = \"%s\" (%u), snprintf \"%s\"\n", (unsigned)(size), #__VA_ARGS__, a, n, b); \
+	}while(0)
+	PRINT_CASE(64, "Peso: %ukg\r\n", 1234u);
+	PRINT_CASE(64, "[%5d][%-5d][%05d][%05d][%-5d]", 42, 42, 42, -42, -42);
+	PRINT_CASE(64, "[%d][%i][%ld][%d]", INT32_MIN, INT32_MAX, -7L, 0);
+	PRINT_CASE(64, "[%u][%10u][%-10u][%010u]", 4294967295u, 7u, 7u, 7u);
+	PRINT_CASE(64, "[%x][%X][%08x][%-8X][%8x]", 0xBEEFu, 0xbeefu, 0xABCu, 0xABCu, 0u);
+	PRINT_CASE(64, "[%c][%3c][%-3c][%%]", 'a', 'b', 'c');
+	PRINT_CASE(64, "[%s][%8s][%-8s][%.3s][%8.2s][%-6.1s]", "abc", "abc", "abc", "abcdef", "abcdef", "xyz");
+	PRINT_CASE(64, "[%.2f][%.0f][%8.3f][%-8.1f][%08.2f][%08.2f]", 3.25, 2.75, -1.5, 0.3125, -3.75, 12.1251);
+	PRINT_CASE(64, "[%.4f][%10.4f][%.9f]", 123.0625, -0.5625, 0.000000125);
+	/* Truncation at the buffer size */
+	for(uint32_t size = 1; size <= 24; size++){
+		PRINT_CASE(size, "val=%05d %s|%-4x|", -123, "texto", 0xfu);
+	}
+	/* Ties are rounded half away from zero (snprintf() rounds them to even) */
+	n = FormatPrint(a, sizeof(a), "[%.1f][%08.2f][%.0f][%-6.2f]", 0.25, 12.125, -2.5, -0.125);
+	EXPECT((strcmp(a, "[0.3][00012.13][-3][-0.13 ]") == 0) && (n == strlen(a)), "FormatPrint(ties) = %s\n", a);
+	/* Default %f precision is 2 (not 6 as in snprintf()) and size 0 writes nothing */
+	n = FormatPrint(a, sizeof(a), "%f %5f", 1.5, -0.25);
+	EXPECT((strcmp(a, "1.50 -0.25") == 0) && (n == 10), "FormatPrint(\"%%f\") = %s\n", a);
+	a[0] = 'x';
+	n = FormatPrint(a, 0, "abc");
+	EXPECT((n == 0) && (a[0] == 'x'), "FormatPrint(size 0) wrote %u\n", n);
+#undef PRINT_CASE
+}
+
+static int check(void){
+	check_integers();
+	check_floats();
+	check_print();
+	printf("checks: %d failures\n", failures);
+	return failures != 0;
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	struct timespec start;
+	char buf[64];
+	uint32_t ops = N_VALUES * N_ROUNDS;
+
+	srand(1);
+	for(uint32_t i = 0; i < N_VALUES; i++){
+		/* Mix of magnitudes, as in ADC readings, counters and timestamps */
+		values[i] = ((uint32_t)rand() << 8 ^ rand()) >> (rand() % 32);
+		fvalues[i] = (rand() / (float)RAND_MAX - 0.5f) * 2000.0f;
+	}
+	if(check()){
+		return 1;
+	}
+
+	printf("%-34s %8s\n", "conversion", "ns/op");
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += uart_itoa(values[i], 10)[0];
+		}
+	}
+	printf("%-34s %8.1f\n", "UartItoa(val, 10)", elapsed_ns(&start, ops));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += snprintf(buf, sizeof(buf), "%u", values[i]);
+		}
+	}
+	printf("%-34s %8.1f\n", "snprintf(\"%u\")", elapsed_ns(&start, ops));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += FormatU32(buf, values[i]);
+		}
+	}
+	printf("%-34s %8.1f\n", "FormatU32()", elapsed_ns(&start, ops));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += uart_itoa(values[i], 16)[0];
+		}
+	}
+	printf("%-34s %8.1f\n", "UartItoa(val, 16)", elapsed_ns(&start, ops));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += FormatHex(buf, values[i], 0);
+		}
+	}
+	printf("%-34s %8.1f\n", "FormatHex()", elapsed_ns(&start, ops));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += snprintf(buf, sizeof(buf), "%.2f", fvalues[i]);
+		}
+	}
+	printf("%-34s %8.1f\n", "snprintf(\"%.2f\")", elapsed_ns(&start, ops));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += FormatFloat(buf, fvalues[i], 2);
+		}
+	}
+	printf("%-34s %8.1f\n", "FormatFloat(val, 2)", elapsed_ns(&start, ops));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += snprintf(buf, sizeof(buf), "Peso: %ukg\r\n", values[i]);
+		}
+	}
+	printf("%-34s %8.1f\n", "snprintf(\"Peso: %ukg\\r\\n\")", elapsed_ns(&start, ops));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t r = 0; r < N_ROUNDS; r++){
+		for(uint32_t i = 0; i < N_VALUES; i++){
+			sink += FormatPrint(buf, sizeof(buf), "Peso: %ukg\r\n", values[i]);
+		}
+	}
+	printf("%-34s %8.1f\n", "FormatPrint(\"Peso: %ukg\\r\\n\")", elapsed_ns(&start, ops));
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,190 @@
+/**
+ * @file gpio_port_mock.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host check of the port-wide accesses of gpio_mcu.c against mocked registers.
+ *
+ * Build (from this folder):
+ *
+ *     gcc -O2 -Imock -I../../drivers/microcontroller/inc gpio_port_mock.c ../../drivers/microcontroller/src/gpio_mcu.c -o gpio_port_mock
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "gpio_mcu.h"
+#include "driver/gpio.h"
+#include "driver/gpio_filter.h"
+#include "soc/gpio_reg.h"
+#include "freertos/FreeRTOS.h"
+/*==================[macros and definitions]=================================*/
+#define BCD_1		GPIO_20
+#define BCD_2		GPIO_21
+#define BCD_3		GPIO_22
+#define BCD_4		GPIO_23
+#define BCD_MASK	(GPIO_BIT(BCD_1) | GPIO_BIT(BCD_2) | GPIO_BIT(BCD_3) | GPIO_BIT(BCD_4))
+#define LOG_SIZE	64
+
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+/*==================[internal data definition]===============================*/
+static uint32_t out_reg;				/* Simulated GPIO_OUT_REG */
+static uint32_t in_reg;					/* Simulated GPIO_IN_REG */
+static uint32_t out_log[LOG_SIZE];		/* Every value the output register took */
+static uint32_t out_writes;
+static int critical;
+static int failures;
+/*==================[mock definitions]=======================================*/
+static void out_store(uint32_t value){
+	out_reg = value;
+	if(out_writes < LOG_SIZE){
+		out_log[out_writes] = value;
+	}
+	out_writes++;
+}
+
+uint32_t mock_reg_read(uint32_t reg){
+	if(reg == GPIO_OUT_REG){
+		return out_reg;
+	}
+	if(reg == GPIO_IN_REG){
+		return in_reg;
+	}
+	printf("FAIL: read of unknown register 0x%08X\n", (unsigned)reg);
+	failures++;
+	return 0;
+}
+
+void mock_reg_write(uint32_t reg, uint32_t value){
+	if(reg != GPIO_OUT_REG){
+		printf("FAIL: write to unknown register 0x%08X\n", (unsigned)reg);
+		failures++;
+		return;
+	}
+	if(!critical){
+		printf("FAIL: read-modify-write of GPIO_OUT_REG outside a critical section\n");
+		failures++;
+	}
+	out_store(value);
+}
+
+void mock_enter_critical(portMUX_TYPE *mux){
+	critical++;
+}
+
+void mock_exit_critical(portMUX_TYPE *mux){
+	critical--;
+}
+
+int gpio_set_level(gpio_num_t pin, uint32_t level){
+	out_store(level ? (out_reg | (1UL << pin)) : (out_reg & ~(1UL << pin)));
+	return 0;
+}
+
+int gpio_get_level(gpio_num_t pin){
+	return (in_reg >> pin) & 1;
+}
+
+int gpio_reset_pin(gpio_num_t pin){ return 0; }
+int gpio_set_direction(gpio_num_t pin, gpio_mode_t mode){ return 0; }
+int gpio_set_pull_mode(gpio_num_t pin, gpio_pull_mode_t pull){ return 0; }
+int gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type){ return 0; }
+int gpio_install_isr_service(int flags){ return 0; }
+int gpio_isr_handler_add(gpio_num_t pin, void *isr, void *args){ return 0; }
+int gpio_new_flex_glitch_filter(const gpio_flex_glitch_filter_config_t *config, gpio_glitch_filter_handle_t *filter){ return 0; }
+int gpio_glitch_filter_enable(gpio_glitch_filter_handle_t filter){ return 0; }
+/*==================[internal functions definition]==========================*/
+static uint32_t bcd_to_port(uint8_t value){
+	uint32_t port = 0;
+	if(value & 1) port |= GPIO_BIT(BCD_1);
+	if(value & 2) port |= GPIO_BIT(BCD_2);
+	if(value & 4) port |= GPIO_BIT(BCD_3);
+	if(value & 8) port |= GPIO_BIT(BCD_4);
+	return port;
+}
+
+/**
+ * @brief Output states seen between two BCD values that are neither the old nor the new one
+ */
+static uint32_t glitches(uint32_t from, uint32_t to){
+	uint32_t n = 0;
+	for(uint32_t i = 0; (i < out_writes) && (i < LOG_SIZE); i++){
+		uint32_t bcd = out_log[i] & BCD_MASK;
+		if((bcd != (from & BCD_MASK)) && (bcd != (to & BCD_MASK))){
+			n++;
+		}
+	}
+	return n;
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	uint32_t per_pin_glitches = 0, mask_glitches = 0;
+	const uint32_t others = GPIO_BIT(GPIO_5) | GPIO_BIT(GPIO_11);
+
+	GPIOInit(BCD_1, GPIO_OUTPUT);
+	GPIOInit(BCD_2, GPIO_OUTPUT);
+	GPIOInit(BCD_3, GPIO_OUTPUT);
+	GPIOInit(BCD_4, GPIO_OUTPUT);
+	GPIOInit(GPIO_5, GPIO_OUTPUT);
+	GPIOInit(GPIO_11, GPIO_OUTPUT);
+	GPIOInit(GPIO_4, GPIO_INPUT);
+	GPIOOn(GPIO_5);
+	GPIOOn(GPIO_11);
+
+	/* Every transition between two BCD digits */
+	for(uint8_t from = 0; from < 16; from++){
+		for(uint8_t to = 0; to < 16; to++){
+			uint32_t start;
+			/* Reference: one GPIOState() per line */
+			GPIOWriteMask(BCD_MASK, bcd_to_port(from));
+			start = out_reg;
+			out_writes = 0;
+			GPIOState(BCD_1, to & 1);
+			GPIOState(BCD_2, to & 2);
+			GPIOState(BCD_3, to & 4);
+			GPIOState(BCD_4, to & 8);
+			per_pin_glitches += glitches(start, bcd_to_port(to));
+
+			GPIOWriteMask(BCD_MASK, bcd_to_port(from));
+			start = out_reg;
+			out_writes = 0;
+			GPIOWriteMask(BCD_MASK, bcd_to_port(to));
+			CHECK(out_writes == 1);
+			CHECK((out_reg & BCD_MASK) == bcd_to_port(to));
+			CHECK((out_reg & ~BCD_MASK) == (start & ~BCD_MASK));
+			CHECK((out_reg & others) == others);
+			mask_glitches += glitches(start, bcd_to_port(to));
+		}
+	}
+	CHECK(mask_glitches == 0);
+	CHECK(critical == 0);
+
+	/* Shadow states: GPIOToggle() must start from the value written by GPIOWriteMask() */
+	GPIOWriteMask(BCD_MASK, GPIO_BIT(BCD_2) | GPIO_BIT(BCD_4));
+	GPIOToggle(BCD_1);
+	GPIOToggle(BCD_2);
+	CHECK((out_reg & BCD_MASK) == (GPIO_BIT(BCD_1) | GPIO_BIT(BCD_4)));
+
+	/* Pins not initialized as outputs are never written */
+	out_writes = 0;
+	GPIOWriteMask(GPIO_BIT(GPIO_4) | GPIO_BIT(GPIO_3), UINT32_MAX);
+	CHECK(out_writes == 0);
+	CHECK((out_reg & (GPIO_BIT(GPIO_4) | GPIO_BIT(GPIO_3))) == 0);
+
+	/* Port read: one register, unavailable pins masked */
+	in_reg = 0xFFFFFFFF;
+	CHECK(GPIOReadPort() == GPIO_PORT_MASK);
+	in_reg = GPIO_BIT(GPIO_4) | GPIO_BIT(GPIO_15);
+	CHECK(GPIOReadPort() == (GPIO_BIT(GPIO_4) | GPIO_BIT(GPIO_15)));
+
+	printf("Intermediate states over 256 BCD transitions: GPIOState() %u, GPIOWriteMask() %u\n",
+		(unsigned)per_pin_glitches, (unsigned)mask_glitches);
+	printf("%s\n", failures ? "FAILED" : "OK");
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,25 @@
+/* Host mock of the ESP-IDF GPIO driver (only what gpio_mcu.c uses) */
+#ifndef MOCK_DRIVER_GPIO_H
+#define MOCK_DRIVER_GPIO_H
+#include <stdint.h>
+#include "soc/soc.h"
+
+typedef enum {
+	GPIO_NUM_0, GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_3, GPIO_NUM_4, GPIO_NUM_5,
+	GPIO_NUM_6, GPIO_NUM_7, GPIO_NUM_8, GPIO_NUM_9, GPIO_NUM_10, GPIO_NUM_11,
+	GPIO_NUM_12, GPIO_NUM_13, GPIO_NUM_14, GPIO_NUM_15, GPIO_NUM_16, GPIO_NUM_17,
+	GPIO_NUM_18, GPIO_NUM_19, GPIO_NUM_20, GPIO_NUM_21, GPIO_NUM_22, GPIO_NUM_23,
+} gpio_num_t;
+typedef enum {GPIO_MODE_DISABLE, GPIO_MODE_INPUT, GPIO_MODE_OUTPUT} gpio_mode_t;
+typedef enum {GPIO_PULLUP_ONLY, GPIO_PULLDOWN_ONLY, GPIO_FLOATING} gpio_pull_mode_t;
+typedef enum {GPIO_INTR_POSEDGE = 1, GPIO_INTR_NEGEDGE} gpio_int_type_t;
+
+int gpio_reset_pin(gpio_num_t pin);
+int gpio_set_direction(gpio_num_t pin, gpio_mode_t mode);
+int gpio_set_pull_mode(gpio_num_t pin, gpio_pull_mode_t pull);
+int gpio_set_level(gpio_num_t pin, uint32_t level);
+int gpio_get_level(gpio_num_t pin);
+int gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type);
+int gpio_install_isr_service(int flags);
+int gpio_isr_handler_add(gpio_num_t pin, void *isr, void *args);
+#endif
@@ -0,0 +1,14 @@
+/* Host mock of the ESP-IDF GPIO glitch filter driver */
+#ifndef MOCK_DRIVER_GPIO_FILTER_H
+#define MOCK_DRIVER_GPIO_FILTER_H
+typedef enum {GLITCH_FILTER_CLK_SRC_DEFAULT} glitch_filter_clock_source_t;
+typedef struct {
+	glitch_filter_clock_source_t clk_src;
+	int gpio_num;
+	unsigned window_width_ns;
+	unsigned window_thres_ns;
+} gpio_flex_glitch_filter_config_t;
+typedef void *gpio_glitch_filter_handle_t;
+int gpio_new_flex_glitch_filter(const gpio_flex_glitch_filter_config_t *config, gpio_glitch_filter_handle_t *filter);
+int gpio_glitch_filter_enable(gpio_glitch_filter_handle_t filter);
+#endif
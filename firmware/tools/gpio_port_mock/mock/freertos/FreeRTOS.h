@@ -0,0 +1,10 @@
+/* Host mock of the FreeRTOS critical sections */
+#ifndef MOCK_FREERTOS_H
+#define MOCK_FREERTOS_H
+typedef struct {int locked;} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED	{0}
+void mock_enter_critical(portMUX_TYPE *mux);
+void mock_exit_critical(portMUX_TYPE *mux);
+#define portENTER_CRITICAL(mux)		mock_enter_critical(mux)
+#define portEXIT_CRITICAL(mux)		mock_exit_critical(mux)
+#endif
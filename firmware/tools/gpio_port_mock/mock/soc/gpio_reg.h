@@ -0,0 +1,6 @@
+/* Host mock of the ESP32-C6 GPIO registers */
+#ifndef MOCK_SOC_GPIO_REG_H
+#define MOCK_SOC_GPIO_REG_H
+#define GPIO_OUT_REG	0x60091004
+#define GPIO_IN_REG		0x6009103C
+#endif
@@ -0,0 +1,9 @@
+/* Host mock of the register access macros: every access goes through the mock */
+#ifndef MOCK_SOC_SOC_H
+#define MOCK_SOC_SOC_H
+#include <stdint.h>
+uint32_t mock_reg_read(uint32_t reg);
+void mock_reg_write(uint32_t reg, uint32_t value);
+#define REG_READ(reg)			mock_reg_read(reg)
+#define REG_WRITE(reg, value)	mock_reg_write((reg), (value))
+#endif
@@ -0,0 +1,218 @@
+/**
+ * @file hid_scheduler_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the HID report queue (hid_scheduler module) used by
+ * ble_hid_mcu.c: mouse coalescing, keyboard ordering and text typing.
+ *
+ * Build (from this folder): make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include "hid_scheduler.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define QUEUE_LEN	8
+#define TEXT_MAX	512
+/*==================[internal data definition]===============================*/
+static int failures;
+static hid_sched_report_t storage[QUEUE_LEN];
+static hid_sched_report_t big_storage[2 * TEXT_MAX];
+static hid_sched_report_t sent[2 * TEXT_MAX];
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Take the next report and check that it is a mouse report with these values
+ */
+static bool next_mouse(hid_scheduler_t *sched, uint8_t buttons, int8_t x, int8_t y, int8_t wheel){
+	hid_sched_report_t r;
+	return HidSchedulerNext(sched, &r) && (r.type == HID_SCHED_MOUSE) && (r.len == HID_SCHED_MOUSE_LEN)
+		&& (r.data[0] == buttons) && ((int8_t)r.data[1] == x) && ((int8_t)r.data[2] == y) && ((int8_t)r.data[3] == wheel);
+}
+
+/**
+ * @brief Take the next report and check that it is a keyboard report with these values
+ */
+static bool next_key(hid_scheduler_t *sched, uint8_t modifiers, uint8_t key){
+	hid_sched_report_t r;
+	const uint8_t expected[HID_SCHED_KEYBOARD_LEN] = {modifiers, 0, key};
+	return HidSchedulerNext(sched, &r) && (r.type == HID_SCHED_KEYBOARD) && (r.len == HID_SCHED_KEYBOARD_LEN)
+		&& (memcmp(r.data, expected, HID_SCHED_KEYBOARD_LEN) == 0);
+}
+
+/**
+ * @brief Deltas are added to the newest mouse report with the same buttons, within -127 to 127
+ */
+static void test_coalescing(void){
+	hid_scheduler_t sched;
+	HidSchedulerInit(&sched, storage, QUEUE_LEN);
+	CHECK(HidSchedulerMouse(&sched, 0, 10, 5, 0));
+	CHECK(HidSchedulerMouse(&sched, 0, -3, 2, 1));
+	CHECK(HidSchedulerMouse(&sched, 0, 20, -30, -2));
+	CHECK(HidSchedulerPending(&sched) == 1);
+	CHECK(sched.coalesced == 2);
+	CHECK(next_mouse(&sched, 0, 27, -23, -1));
+
+	/* Sums up to the limit are merged, beyond it start a new report */
+	CHECK(HidSchedulerMouse(&sched, 0, 100, -100, 0));
+	CHECK(HidSchedulerMouse(&sched, 0, 27, -27, 0));
+	CHECK(HidSchedulerMouse(&sched, 0, 1, 0, 0));
+	CHECK(HidSchedulerMouse(&sched, 0, 0, -1, 0));
+	CHECK(HidSchedulerMouse(&sched, 0, 0, 0, 127));
+	CHECK(HidSchedulerMouse(&sched, 0, 0, 0, 1));
+	CHECK(HidSchedulerPending(&sched) == 3);
+	CHECK(next_mouse(&sched, 0, 127, -127, 0));
+	CHECK(next_mouse(&sched, 0, 1, -1, 127));
+	CHECK(next_mouse(&sched, 0, 0, 0, 1));
+
+	/* -128 is outside the logical range of the report */
+	CHECK(HidSchedulerMouse(&sched, 0, -128, -128, -128));
+	CHECK(HidSchedulerMouse(&sched, 0, -128, 0, 0));
+	CHECK(next_mouse(&sched, 0, -127, -127, -127));
+	CHECK(next_mouse(&sched, 0, -127, 0, 0));
+	CHECK(HidSchedulerPending(&sched) == 0);
+}
+
+/**
+ * @brief No merge across a button change or a keyboard report: the order is kept
+ */
+static void test_no_merge(void){
+	hid_scheduler_t sched;
+	const uint8_t key = 0x04;
+	HidSchedulerInit(&sched, storage, QUEUE_LEN);
+	CHECK(HidSchedulerMouse(&sched, 0, 1, 1, 0));
+	CHECK(HidSchedulerMouse(&sched, HID_SCHED_BUTTON_LEFT, 0, 0, 0));		/* Press */
+	CHECK(HidSchedulerMouse(&sched, HID_SCHED_BUTTON_LEFT, 5, 0, 0));		/* Drag */
+	CHECK(HidSchedulerMouse(&sched, 0, 0, 0, 0));							/* Release */
+	CHECK(HidSchedulerKeyboard(&sched, 0, &key, 1));
+	CHECK(HidSchedulerMouse(&sched, 0, 2, 2, 0));
+	CHECK(HidSchedulerPending(&sched) == 6);
+	CHECK(next_mouse(&sched, 0, 1, 1, 0));
+	CHECK(next_mouse(&sched, HID_SCHED_BUTTON_LEFT, 5, 0, 0));
+	CHECK(next_mouse(&sched, 0, 0, 0, 0));
+	CHECK(next_key(&sched, 0, key));
+	CHECK(next_key(&sched, 0, 0));
+	CHECK(next_mouse(&sched, 0, 2, 2, 0));
+	CHECK(sched.coalesced == 1);
+}
+
+/**
+ * @brief Every press is followed by its release, keyboard reports are never merged
+ */
+static void test_keyboard(void){
+	hid_scheduler_t sched;
+	const uint8_t keys[] = {0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A};
+	hid_sched_report_t r;
+	HidSchedulerInit(&sched, storage, QUEUE_LEN);
+	CHECK(HidSchedulerKeyboard(&sched, 0x02, keys, 2));
+	CHECK(HidSchedulerKeyboard(&sched, 0x02, keys, 2));
+	CHECK(!HidSchedulerKeyboard(&sched, 0, keys, HID_SCHED_KEYS_MAX + 1));
+	CHECK(HidSchedulerPending(&sched) == 4);
+	for(int i = 0; i < 2; i++){
+		CHECK(HidSchedulerNext(&sched, &r));
+		CHECK((r.data[0] == 0x02) && (r.data[1] == 0) && (r.data[2] == 0x04) && (r.data[3] == 0x05) && (r.data[4] == 0));
+		CHECK(next_key(&sched, 0, 0));
+	}
+	CHECK(HidSchedulerKeyboard(&sched, 0, keys, HID_SCHED_KEYS_MAX));
+	CHECK(HidSchedulerNext(&sched, &r));
+	CHECK(memcmp(&r.data[2], keys, HID_SCHED_KEYS_MAX) == 0);
+	CHECK(next_key(&sched, 0, 0));
+	CHECK(!HidSchedulerNext(&sched, &r));
+}
+
+/**
+ * @brief Queue full: false and nothing queued, except mouse deltas that can still be merged
+ */
+static void test_full(void){
+	hid_scheduler_t sched;
+	const uint8_t key = 0x04;
+	hid_sched_report_t r;
+	HidSchedulerInit(&sched, storage, QUEUE_LEN);
+	/* Move the head so the queue wraps around */
+	for(int i = 0; i < 3; i++){
+		CHECK(HidSchedulerKeyboard(&sched, 0, &key, 1));
+		CHECK(HidSchedulerNext(&sched, &r) && HidSchedulerNext(&sched, &r));
+	}
+	for(int i = 0; i < QUEUE_LEN / 2 - 1; i++){
+		CHECK(HidSchedulerKeyboard(&sched, 0, &key, 1));
+	}
+	CHECK(HidSchedulerMouse(&sched, 0, 1, 0, 0));
+	CHECK(HidSchedulerPending(&sched) == QUEUE_LEN - 1);
+	CHECK(!HidSchedulerKeyboard(&sched, 0, &key, 1));			/* Needs two slots */
+	CHECK(HidSchedulerPending(&sched) == QUEUE_LEN - 1);
+	CHECK(HidSchedulerMouse(&sched, HID_SCHED_BUTTON_RIGHT, 0, 0, 0));
+	CHECK(HidSchedulerPending(&sched) == QUEUE_LEN);
+	CHECK(!HidSchedulerMouse(&sched, 0, 1, 0, 0));				/* Other buttons */
+	CHECK(HidSchedulerMouse(&sched, HID_SCHED_BUTTON_RIGHT, 3, 0, 0));	/* Merged */
+	CHECK(!HidSchedulerMouse(&sched, HID_SCHED_BUTTON_RIGHT, 127, 0, 0));	/* Out of range */
+	CHECK(HidSchedulerType(&sched, "abc") == 0);
+	CHECK(HidSchedulerPending(&sched) == QUEUE_LEN);
+	for(int i = 0; i < QUEUE_LEN / 2 - 1; i++){
+		CHECK(next_key(&sched, 0, key));
+		CHECK(next_key(&sched, 0, 0));
+	}
+	CHECK(next_mouse(&sched, 0, 1, 0, 0));
+	CHECK(next_mouse(&sched, HID_SCHED_BUTTON_RIGHT, 3, 0, 0));
+	CHECK(!HidSchedulerNext(&sched, &r));
+	HidSchedulerMouse(&sched, 0, 1, 0, 0);
+	HidSchedulerClear(&sched);
+	CHECK(HidSchedulerPending(&sched) == 0);
+}
+
+/**
+ * @brief Text: key codes and shift, skipped characters, and typing in chunks
+ * when the queue gets full gives the same reports as a queue big enough
+ */
+static void test_type(void){
+	hid_scheduler_t sched, big;
+	const char *text = "Hello, World!\n\tA1 [x]~\b\x01\x7f" "end";
+	uint32_t n, pos = 0, n_sent = 0;
+	hid_sched_report_t r;
+	HidSchedulerInit(&big, big_storage, 2 * TEXT_MAX);
+	CHECK(HidSchedulerType(&big, "Ha1\n!") == 5);
+	CHECK(next_key(&big, 0x02, 0x0B) && next_key(&big, 0, 0));		/* H */
+	CHECK(next_key(&big, 0, 0x04) && next_key(&big, 0, 0));			/* a */
+	CHECK(next_key(&big, 0, 0x1E) && next_key(&big, 0, 0));			/* 1 */
+	CHECK(next_key(&big, 0, 0x28) && next_key(&big, 0, 0));			/* Return */
+	CHECK(next_key(&big, 0x02, 0x1E) && next_key(&big, 0, 0));		/* ! */
+	/* Characters that can not be typed are consumed without reports */
+	CHECK(HidSchedulerType(&big, "\x01\x7f\xe9") == 3);
+	CHECK(HidSchedulerPending(&big) == 0);
+
+	CHECK(HidSchedulerType(&big, text) == strlen(text));
+	n = HidSchedulerPending(&big);
+	CHECK(n == 2 * (strlen(text) - 2));
+
+	HidSchedulerInit(&sched, storage, QUEUE_LEN);
+	while(text[pos] != '\0'){
+		uint32_t typed = HidSchedulerType(&sched, &text[pos]);
+		CHECK(typed <= QUEUE_LEN / 2 + 2);
+		pos += typed;
+		while(HidSchedulerNext(&sched, &r) && (n_sent < n)){
+			sent[n_sent++] = r;
+		}
+	}
+	CHECK(n_sent == n);
+	for(uint32_t i = 0; i < n_sent; i++){
+		CHECK(HidSchedulerNext(&big, &r));
+		CHECK((r.type == sent[i].type) && (r.len == sent[i].len) && (memcmp(r.data, sent[i].data, r.len) == 0));
+	}
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	test_coalescing();
+	test_no_merge();
+	test_keyboard();
+	test_full();
+	test_type();
+	printf(failures ? "%d FAILURES\n" : "OK\n", failures);
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,330 @@
+/**
+ * @file iir_q15_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of LowPassFilterQ15() and HiPassFilterQ15() against the float filters.
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "iir_filter.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define PI			3.14159265358979
+#define N_SOS		5
+#define LENGTH		4096
+#define FREQS		512
+#define BENCH_RUNS	500
+/*==================[internal data definition]===============================*/
+/* Float designs of iir_filter.c (the reference) */
+extern float lp2_sos_coeff[N_SOS], lp4_sos_coeff[N_SOS], lp6_sos_coeff[N_SOS], lp8_sos_coeff[N_SOS];
+extern float hp2_sos_coeff[N_SOS], hp4_sos_coeff[N_SOS], hp6_sos_coeff[N_SOS], hp8_sos_coeff[N_SOS];
+
+static int failures;
+static float signal_f[LENGTH];
+static float filtered_f[LENGTH];
+static int16_t signal_q15[LENGTH];
+static int16_t filtered_q15[LENGTH];
+static double filtered_exact[LENGTH];
+
+static const filter_order_t orders[] = {ORDER_2, ORDER_4, ORDER_6, ORDER_8};
+static const float cut_freqs[] = {0.001f, 0.01f, 0.1f, 0.4f};	/* Relative to the sample frequency */
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Magnitude (dB) of a cascade of sections at frequency f (relative to the sample frequency)
+ */
+static double response_db(float *sos[], uint8_t sections, bool quantized, double f){
+	double w = 2 * PI * f, gain = 1;
+	double c[N_SOS];
+	for(uint8_t i = 0; i < sections; i++){
+		for(uint8_t j = 0; j < N_SOS; j++){
+			/* Same rounding as the filter initialization */
+			c[j] = quantized ? roundf(sos[i][j] * (float)(1L << 30)) / (double)(1L << 30) : sos[i][j];
+		}
+		double num_re = c[0] + c[1] * cos(w) + c[2] * cos(2 * w);
+		double num_im = -c[1] * sin(w) - c[2] * sin(2 * w);
+		double den_re = 1 + c[3] * cos(w) + c[4] * cos(2 * w);
+		double den_im = -c[3] * sin(w) - c[4] * sin(2 * w);
+		gain *= sqrt((num_re * num_re + num_im * num_im) / (den_re * den_re + den_im * den_im));
+	}
+	return 20 * log10(gain + 1e-300);
+}
+
+/**
+ * @brief Largest change of the magnitude response due to the Q2.30 coefficients,
+ * where the response is above -100 dB
+ */
+static double quantization_db(float *sos[], uint8_t sections){
+	double error = 0, reference, f;
+	for(uint16_t k = 1; k < FREQS; k++){
+		f = 0.5 * k / FREQS;
+		reference = response_db(sos, sections, false, f);
+		if(reference > -100){
+			error = fmax(error, fabs(response_db(sos, sections, true, f) - reference));
+		}
+	}
+	return error;
+}
+
+/**
+ * @brief Largest coefficient quantization error (relative to 2^-30)
+ */
+static double quantization_lsb(float *sos[], uint8_t sections){
+	double error = 0;
+	for(uint8_t i = 0; i < sections; i++){
+		for(uint8_t j = 0; j < N_SOS; j++){
+			double q = roundf(sos[i][j] * (float)(1L << 30));
+			error = fmax(error, fabs(q - (double)sos[i][j] * (1L << 30)));
+		}
+	}
+	return error;
+}
+
+static void filter(bool low_pass){
+	if(low_pass){
+		LowPassFilter(signal_f, filtered_f, LENGTH);
+		LowPassFilterQ15(signal_q15, filtered_q15, LENGTH);
+	} else{
+		HiPassFilter(signal_f, filtered_f, LENGTH);
+		HiPassFilterQ15(signal_q15, filtered_q15, LENGTH);
+	}
+}
+
+static void init(bool low_pass, float fc, filter_order_t order){
+	if(low_pass){
+		LowPassInit(1.0f, fc, order);
+	} else{
+		HiPassInit(1.0f, fc, order);
+	}
+}
+
+/**
+ * @brief Exact output (double precision Direct Form I, same coefficients) of the
+ * signal given to both filters
+ */
+static void filter_exact(float *sos[], uint8_t sections){
+	double x[LENGTH + 2] = {0}, y[LENGTH + 2] = {0};
+	double *c;
+	float cf[N_SOS];
+	for(uint16_t i = 0; i < LENGTH; i++){
+		x[i + 2] = signal_f[i];
+	}
+	for(uint8_t s = 0; s < sections; s++){
+		memcpy(cf, sos[s], sizeof(cf));
+		double cd[N_SOS] = {cf[0], cf[1], cf[2], cf[3], cf[4]};
+		c = cd;
+		for(uint16_t i = 2; i < LENGTH + 2; i++){
+			y[i] = c[0] * x[i] + c[1] * x[i - 1] + c[2] * x[i - 2] - c[3] * y[i - 1] - c[4] * y[i - 2];
+		}
+		memcpy(x, y, sizeof(x));
+	}
+	for(uint16_t i = 0; i < LENGTH; i++){
+		filtered_exact[i] = x[i + 2];
+	}
+}
+
+/**
+ * @brief Error of the float and the Q15 filters against the exact output, in dB relative to full scale
+ */
+static double float_error_db(void){
+	double error = 0;
+	for(uint16_t i = 0; i < LENGTH; i++){
+		double e = filtered_f[i] - filtered_exact[i];
+		error += e * e;
+	}
+	return 10 * log10(error / LENGTH + 1e-30);
+}
+
+static double q15_error_db(void){
+	double error = 0;
+	for(uint16_t i = 0; i < LENGTH; i++){
+		double e = filtered_q15[i] / 32768.0 - filtered_exact[i];
+		error += e * e;
+	}
+	return 10 * log10(error / LENGTH + 1e-30);
+}
+
+/**
+ * @brief DC gain of a cascade of sections
+ */
+static double dc_gain(float *sos[], uint8_t sections){
+	double gain = 1;
+	for(uint8_t i = 0; i < sections; i++){
+		gain *= ((double)sos[i][0] + sos[i][1] + sos[i][2]) / (1.0 + sos[i][3] + sos[i][4]);
+	}
+	return gain;
+}
+
+/**
+ * @brief Sines at 0.25 of full scale over the whole band plus uniform noise
+ */
+static void generate(void){
+	for(uint16_t i = 0; i < LENGTH; i++){
+		double x = 0.25 * sin(2 * PI * 0.0007 * i) + 0.25 * sin(2 * PI * 0.013 * i)
+			+ 0.25 * sin(2 * PI * 0.21 * i) + 0.1 * (2.0 * rand() / RAND_MAX - 1.0);
+		signal_q15[i] = (int16_t)lrint(x * 32768);
+		/* The float path gets exactly the same samples */
+		signal_f[i] = signal_q15[i] / 32768.0f;
+	}
+}
+
+/**
+ * @brief Samples until the output of a zero input stays at zero, after a burst of
+ * noise. Returns -1 if the output never settles (limit cycle).
+ */
+static int32_t settle(bool low_pass, int16_t *offset){
+	int32_t last = 0;
+	int16_t value = 0;
+	generate();
+	filter(low_pass);
+	memset(signal_q15, 0, sizeof(signal_q15));
+	for(uint8_t block = 0; block < 16; block++){
+		if(low_pass){
+			LowPassFilterQ15(signal_q15, filtered_q15, LENGTH);
+		} else{
+			HiPassFilterQ15(signal_q15, filtered_q15, LENGTH);
+		}
+		for(uint16_t i = 0; i < LENGTH; i++){
+			if(filtered_q15[i] != 0){
+				last = block * LENGTH + i + 1;
+				value = filtered_q15[i];
+			}
+		}
+	}
+	*offset = value;
+	/* Still moving in the last block */
+	return (last > 15 * LENGTH) ? -1 : last;
+}
+
+/**
+ * @brief Final value of the step response (DC gain of the low pass filters)
+ */
+static int16_t step(int16_t amplitude){
+	for(uint16_t i = 0; i < LENGTH; i++){
+		signal_q15[i] = amplitude;
+	}
+	for(uint8_t block = 0; block < 16; block++){
+		LowPassFilterQ15(signal_q15, filtered_q15, LENGTH);
+	}
+	return filtered_q15[LENGTH - 1];
+}
+
+static double seconds(clock_t start){
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	float *lp_sos[] = {lp2_sos_coeff, lp4_sos_coeff, lp6_sos_coeff, lp8_sos_coeff};
+	float *hp_sos[] = {hp2_sos_coeff, hp4_sos_coeff, hp6_sos_coeff, hp8_sos_coeff};
+
+	printf("Coefficient quantization (Q2.30): largest error (LSB) and response change (dB)\n");
+	for(uint8_t o = 0; o < 4; o++){
+		for(uint8_t f = 0; f < 4; f++){
+			LowPassInit(1.0f, cut_freqs[f], orders[o]);
+			HiPassInit(1.0f, cut_freqs[f], orders[o]);
+			double lp_lsb = quantization_lsb(lp_sos, orders[o] / 2);
+			double hp_lsb = quantization_lsb(hp_sos, orders[o] / 2);
+			double lp_db = quantization_db(lp_sos, orders[o] / 2);
+			double hp_db = quantization_db(hp_sos, orders[o] / 2);
+			printf("  order %u fc %.3f: LP %.2f LSB %.1e dB, HP %.2f LSB %.1e dB\n",
+				orders[o], cut_freqs[f], lp_lsb, lp_db, hp_lsb, hp_db);
+			CHECK(lp_lsb <= 0.5);
+			CHECK(hp_lsb <= 0.5);
+			CHECK(lp_db < 0.001);
+			CHECK(hp_db < 0.001);
+		}
+	}
+
+	printf("Output error against the exact output (dB full scale): float, Q15 noise shaping on / off\n");
+	for(uint8_t o = 0; o < 4; o++){
+		for(uint8_t f = 0; f < 4; f++){
+			double error[2][3];
+			for(uint8_t lp = 0; lp < 2; lp++){
+				for(uint8_t shaping = 0; shaping < 2; shaping++){
+					FilterNoiseShaping(shaping);
+					init(lp, cut_freqs[f], orders[o]);
+					srand(1);
+					generate();
+					filter(lp);
+					filter_exact(lp ? lp_sos : hp_sos, orders[o] / 2);
+					error[lp][shaping] = q15_error_db();
+					error[lp][2] = float_error_db();
+				}
+			}
+			printf("  order %u fc %.3f: LP %.1f, %.1f / %.1f, HP %.1f, %.1f / %.1f\n", orders[o], cut_freqs[f],
+				error[1][2], error[1][1], error[1][0], error[0][2], error[0][1], error[0][0]);
+			/* Output rounding alone is -101 dB */
+			CHECK(error[1][1] < -90);
+			CHECK(error[0][1] < -90);
+		}
+	}
+
+	printf("Zero input after noise: samples until the output settles, noise shaping on / off\n");
+	for(uint8_t o = 0; o < 4; o++){
+		for(uint8_t lp = 0; lp < 2; lp++){
+			int32_t samples[2];
+			int16_t offset[2];
+			/* Lowest cut-off: poles closest to the unit circle */
+			float fc = lp ? cut_freqs[0] : 0.45f;
+			for(uint8_t shaping = 0; shaping < 2; shaping++){
+				FilterNoiseShaping(shaping);
+				init(lp, fc, orders[o]);
+				srand(2);
+				samples[shaping] = settle(lp, &offset[shaping]);
+			}
+			printf("  %s order %u fc %.3f: %d (%d) / %d (%d)\n", lp ? "LP" : "HP", orders[o], fc,
+				samples[1], offset[1], samples[0], offset[0]);
+			CHECK(samples[1] >= 0);
+		}
+	}
+
+	printf("Step response of the low pass filters (fc %.3f), noise shaping on\n", cut_freqs[0]);
+	FilterNoiseShaping(true);
+	for(uint8_t o = 0; o < 4; o++){
+		const int16_t amplitudes[] = {1, 7, -3, 1000, -20000};
+		for(uint8_t a = 0; a < sizeof(amplitudes) / sizeof(amplitudes[0]); a++){
+			LowPassInit(1.0f, cut_freqs[0], orders[o]);
+			/* The float design has a DC gain slightly different from 1 */
+			double expected = amplitudes[a] * dc_gain(lp_sos, orders[o] / 2);
+			int16_t value = step(amplitudes[a]);
+			printf("  order %u: step %d settles at %d (exact %.2f)\n", orders[o], amplitudes[a], value, expected);
+			CHECK(fabs(value - expected) <= 1);
+		}
+	}
+
+	printf("Host throughput (Msamples/s), order 8 low pass: ");
+	LowPassInit(1.0f, 0.1f, ORDER_8);
+	srand(3);
+	generate();
+	clock_t start = clock();
+	for(uint16_t run = 0; run < BENCH_RUNS; run++){
+		LowPassFilter(signal_f, filtered_f, LENGTH);
+	}
+	double float_time = seconds(start);
+	start = clock();
+	for(uint16_t run = 0; run < BENCH_RUNS; run++){
+		LowPassFilterQ15(signal_q15, filtered_q15, LENGTH);
+	}
+	double q15_time = seconds(start);
+	printf("float %.1f, Q15 %.1f\n", BENCH_RUNS * LENGTH / float_time / 1e6, BENCH_RUNS * LENGTH / q15_time / 1e6);
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,365 @@
+/**
+ * @file mat_lu_check.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the LU and LDL' based dspm::Mat solve(), inverse() and det().
+ *
+ * The results are compared with the previous implementations: cofactor expansion
+ * for det() and inverse(), Gaussian elimination without pivoting for solve() and
+ * Gauss-Jordan elimination (pinv()).
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "mat.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define N_MIN		2
+#define N_MAX		16
+#define COFACTOR_MAX	8		/* Bigger sizes take too long with the cofactor expansion */
+#define TOL			1e-4f	/* Relative error tolerance */
+
+using dspm::Mat;
+/*==================[internal data definition]===============================*/
+static int failures;
+/*==================[internal functions definition]==========================*/
+static float frand(void){
+	return 2.0f * rand() / RAND_MAX - 1.0f;
+}
+
+/**
+ * @brief Random matrix, diagonally dominant so that it is well conditioned
+ */
+static Mat random_matrix(int n){
+	Mat A(n, n);
+	for(int i = 0; i < n; i++){
+		for(int j = 0; j < n; j++){
+			A(i, j) = frand();
+		}
+		A(i, i) += (A(i, i) < 0) ? -n : n;
+	}
+	return A;
+}
+
+/**
+ * @brief Random symmetric positive definite matrix, M*M' + I
+ */
+static Mat random_spd(int n){
+	Mat M(n, n);
+	for(int i = 0; i < n; i++){
+		for(int j = 0; j < n; j++){
+			M(i, j) = frand();
+		}
+	}
+	Mat A = M * M.t();
+	for(int i = 0; i < n; i++){
+		A(i, i) += 1;
+	}
+	return A;
+}
+
+/**
+ * @brief Largest element difference, relative to the largest element of B
+ */
+static float rel_error(Mat &A, Mat &B){
+	float err = 0, max = 0;
+	for(int i = 0; i < A.rows; i++){
+		for(int j = 0; j < A.cols; j++){
+			err = fmaxf(err, fabsf(A(i, j) - B(i, j)));
+			max = fmaxf(max, fabsf(B(i, j)));
+		}
+	}
+	return err / max;
+}
+
+/* Previous implementations, used as references */
+static Mat ref_cofactor(Mat &A, int row, int col, int n){
+	Mat result(n - 1, n - 1);
+	int i = 0, j = 0;
+	for(int r = 0; r < n; r++){
+		for(int c = 0; c < n; c++){
+			if(r != row && c != col){
+				result(i, j++) = A(r, c);
+				if(j == n - 1){
+					j = 0;
+					i++;
+				}
+			}
+		}
+	}
+	return result;
+}
+
+static float ref_det(Mat &A, int n){
+	float D = 0;
+	int sign = 1;
+	if(n == 1){
+		return A(0, 0);
+	}
+	for(int f = 0; f < n; f++){
+		Mat temp = ref_cofactor(A, 0, f, n);
+		D += A(0, f) * ref_det(temp, n - 1) * sign;
+		sign = -sign;
+	}
+	return D;
+}
+
+static Mat ref_inverse(Mat &A){
+	int n = A.rows;
+	Mat result(n, n);
+	float det = ref_det(A, n);
+	for(int i = 0; i < n; i++){
+		for(int j = 0; j < n; j++){
+			Mat temp = ref_cofactor(A, i, j, n);
+			result(j, i) = (((i + j) % 2 == 0) ? 1 : -1) * ref_det(temp, n - 1) / det;
+		}
+	}
+	return result;
+}
+
+static Mat ref_solve(Mat A, Mat b){
+	int n = A.rows;
+	Mat x(n, 1);
+	for(int i = 0; i < n; i++){
+		for(int j = i + 1; j < n; j++){
+			float a_ji = A(j, i) / A(i, i);
+			for(int k = i + 1; k < n; k++){
+				A(j, k) -= A(i, k) * a_ji;
+			}
+			b(j, 0) -= b(i, 0) * a_ji;
+		}
+	}
+	for(int i = n - 1; i >= 0; i--){
+		float sum = b(i, 0);
+		for(int j = i + 1; j < n; j++){
+			sum -= A(i, j) * x(j, 0);
+		}
+		x(i, 0) = sum / A(i, i);
+	}
+	return x;
+}
+
+static void check_general(void){
+	float worst_inv = 0, worst_solve = 0, worst_det = 0;
+	for(int n = N_MIN; n <= N_MAX; n++){
+		for(int trial = 0; trial < 20; trial++){
+			Mat A = random_matrix(n);
+			Mat b(n, 1);
+			for(int i = 0; i < n; i++){
+				b(i, 0) = frand();
+			}
+			/* inverse() against Gauss-Jordan (and the cofactor expansion for small sizes) */
+			Mat inv = A.inverse();
+			Mat gj = A.pinv();
+			worst_inv = fmaxf(worst_inv, rel_error(inv, gj));
+			if(n <= COFACTOR_MAX){
+				Mat cof = ref_inverse(A);
+				worst_inv = fmaxf(worst_inv, rel_error(inv, cof));
+			}
+			Mat I = A * inv;
+			Mat eye = Mat::eye(n);
+			worst_inv = fmaxf(worst_inv, rel_error(I, eye));
+			/* solve() against the elimination without pivoting */
+			Mat x = Mat::solve(A, b);
+			Mat x_ref = ref_solve(A, b);
+			CHECK(x.rows == n);
+			worst_solve = fmaxf(worst_solve, rel_error(x, x_ref));
+			/* det() against the cofactor expansion, det(inverse(A)) = 1 / det(A) for big sizes */
+			float det = A.det(n);
+			if(n <= COFACTOR_MAX){
+				worst_det = fmaxf(worst_det, fabsf(det - ref_det(A, n)) / fabsf(det));
+			} else{
+				worst_det = fmaxf(worst_det, fabsf(det * inv.det(n) - 1));
+			}
+		}
+	}
+	printf("inverse(): max relative error %.2e\n", worst_inv);
+	printf("solve():   max relative error %.2e\n", worst_solve);
+	printf("det():     max relative error %.2e\n", worst_det);
+	CHECK(worst_inv < TOL);
+	CHECK(worst_solve < TOL);
+	CHECK(worst_det < TOL);
+}
+
+static void check_pivoting(void){
+	/* Zero in the first pivot: the previous solve() failed */
+	Mat A(3, 3);
+	Mat b(3, 1);
+	float a[] = {0, 2, 1, 1, 1, 1, 2, 1, 3};
+	float x_expected[] = {1, -1, 2};
+	for(int i = 0; i < 9; i++){
+		A.data[i] = a[i];
+	}
+	for(int i = 0; i < 3; i++){
+		b(i, 0) = 0;
+		for(int j = 0; j < 3; j++){
+			b(i, 0) += A(i, j) * x_expected[j];
+		}
+	}
+	Mat x = Mat::solve(A, b);
+	CHECK(x.rows == 3);
+	for(int i = 0; (x.rows == 3) && (i < 3); i++){
+		CHECK(fabsf(x(i, 0) - x_expected[i]) < 1e-6f);
+	}
+	/* Same with a bigger matrix (LU inverse) */
+	Mat B = random_matrix(6);
+	B(0, 0) = 0;
+	Mat inv = B.inverse();
+	Mat I = B * inv;
+	Mat eye = Mat::eye(6);
+	CHECK(rel_error(I, eye) < TOL);
+}
+
+static void check_singular(void){
+	for(int n = N_MIN; n <= N_MAX; n++){
+		/* Integer elements and last row = first row: the zero pivot is exact */
+		Mat A(n, n);
+		for(int i = 0; i < n; i++){
+			for(int j = 0; j < n; j++){
+				A(i, j) = (i == n - 1) ? A(0, j) : (rand() % 19) - 9;
+			}
+		}
+		Mat b(n, 1);
+		Mat x = Mat::solve(A, b);
+		Mat inv = A.inverse();
+		float sum = 0;
+		for(int i = 0; i < n * n; i++){
+			sum += fabsf(inv.data[i]);
+		}
+		CHECK(A.det(n) == 0);
+		CHECK(x.rows == 0);
+		CHECK(sum == 0);
+	}
+}
+
+static void check_spd(void){
+	float worst_inv = 0, worst_solve = 0, worst_ldl = 0;
+	for(int n = N_MIN; n <= N_MAX; n++){
+		for(int trial = 0; trial < 20; trial++){
+			Mat A = random_spd(n);
+			Mat B(n, 3);
+			for(int i = 0; i < n; i++){
+				for(int j = 0; j < 3; j++){
+					B(i, j) = frand();
+				}
+			}
+			/* inverseSPD() against the LU inverse, the result must be exactly symmetric */
+			Mat inv = A.inverseSPD();
+			Mat lu = A.inverse();
+			worst_inv = fmaxf(worst_inv, rel_error(inv, lu));
+			for(int i = 0; i < n; i++){
+				for(int j = 0; j < i; j++){
+					CHECK(inv(i, j) == inv(j, i));
+				}
+			}
+			/* solveSPD() against solve(), several columns */
+			Mat X = Mat::solveSPD(A, B);
+			for(int j = 0; j < 3; j++){
+				Mat b(n, 1);
+				for(int i = 0; i < n; i++){
+					b(i, 0) = B(i, j);
+				}
+				Mat x = Mat::solve(A, b);
+				Mat x_spd(n, 1);
+				for(int i = 0; i < n; i++){
+					x_spd(i, 0) = X(i, j);
+				}
+				worst_solve = fmaxf(worst_solve, rel_error(x_spd, x));
+			}
+			/* L*D*L' = A */
+			Mat LDL(n, n);
+			LDL = A;
+			CHECK(LDL.ldltDecompose());
+			Mat L = Mat::eye(n);
+			Mat D(n, n);
+			for(int i = 0; i < n; i++){
+				for(int j = 0; j < i; j++){
+					L(i, j) = LDL(i, j);
+				}
+				D(i, i) = LDL(i, i);
+			}
+			Mat R = L * D * L.t();
+			worst_ldl = fmaxf(worst_ldl, rel_error(R, A));
+		}
+	}
+	printf("inverseSPD(): max relative error %.2e\n", worst_inv);
+	printf("solveSPD():   max relative error %.2e\n", worst_solve);
+	printf("L*D*L':       max relative error %.2e\n", worst_ldl);
+	CHECK(worst_inv < TOL);
+	CHECK(worst_solve < TOL);
+	CHECK(worst_ldl < TOL);
+
+	/* Not positive definite: LDL' fails, inverseSPD() falls back to inverse() */
+	Mat A = random_matrix(5);
+	for(int i = 0; i < 5; i++){
+		for(int j = 0; j < i; j++){
+			A(j, i) = A(i, j);
+		}
+	}
+	A(0, 0) = -fabsf(A(0, 0));
+	Mat LDL(5, 5);
+	LDL = A;
+	CHECK(!LDL.ldltDecompose());
+	Mat inv = A.inverseSPD();
+	Mat I = A * inv;
+	Mat eye = Mat::eye(5);
+	CHECK(rel_error(I, eye) < TOL);
+}
+
+/**
+ * @brief Time of one call, in microseconds
+ */
+#define BENCH(result, runs, expr)	do{ \
+		clock_t start = clock(); \
+		for(int run = 0; run < (runs); run++){ expr; } \
+		(result) = 1e6 * (double)(clock() - start) / CLOCKS_PER_SEC / (runs); \
+	}while(0)
+
+static void benchmark(void){
+	double t_cof, t_gj, t_lu, t_spd, t_det_cof, t_det_lu;
+	printf("\n n   cofactor inv   pinv (GJ)   LU inverse   LDL' inverse   cofactor det   LU det   (us)\n");
+	for(int n = N_MIN; n <= N_MAX; n++){
+		Mat A = random_spd(n);
+		int runs = 20000 / (n * n);
+		BENCH(t_gj, runs, Mat r = A.pinv());
+		BENCH(t_lu, runs, Mat r = A.inverse());
+		BENCH(t_spd, runs, Mat r = A.inverseSPD());
+		BENCH(t_det_lu, runs, volatile float d = A.det(n));
+		if(n <= COFACTOR_MAX){
+			BENCH(t_cof, 10, Mat r = ref_inverse(A));
+			BENCH(t_det_cof, 10, volatile float d = ref_det(A, n));
+			printf("%2d %12.2f %11.2f %12.2f %14.2f %14.2f %8.2f\n", n, t_cof, t_gj, t_lu, t_spd, t_det_cof, t_det_lu);
+		} else{
+			printf("%2d %12s %11.2f %12.2f %14.2f %14s %8.2f\n", n, "-", t_gj, t_lu, t_spd, "-", t_det_lu);
+		}
+	}
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	srand(1);
+
+	check_general();
+	check_pivoting();
+	check_singular();
+	check_spd();
+	benchmark();
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,203 @@
+/**
+ * @file motion_profile_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the motion profile generator (motion_profile module)
+ * against analytic trapezoid, triangle and S-curve trajectories.
+ *
+ * Build (from this folder): make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <math.h>
+#include "motion_profile.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+#define DT			1e-4		/* Reference integration step (s) */
+#define TOL			1e-3f		/* Relative tolerance of positions and limits */
+/*==================[internal data definition]===============================*/
+static int failures;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Largest error between the profile and a reference trajectory built by
+ * integrating a piecewise constant jerk (or acceleration) over the given segments
+ *
+ * @param dur Duration of the 7 segments: jerk +J, 0, -J, cruise, -J, 0, +J
+ * @param jerk Jerk (0: trapezoid, then acc is the acceleration of segments 1 and 5)
+ */
+static float compare(const motion_profile_t *prof, const double dur[7], double jerk, double acc, float dist){
+	static const int jerk_sign[7] = {1, 0, -1, 0, -1, 0, 1};
+	static const int acc_sign[7] = {0, 1, 0, 0, 0, -1, 0};
+	double p = 0, v = 0, a = 0, t = 0, err = 0;
+	for(int s = 0; s < 7; s++){
+		int steps = (int)ceil(dur[s] / DT);
+		double h = (steps > 0) ? dur[s] / steps : 0;
+		double j = jerk_sign[s] * jerk;
+		if(jerk == 0){
+			a = acc_sign[s] * acc;
+		}
+		for(int k = 0; k < steps; k++){
+			/* Exact for a constant jerk */
+			p += h * (v + h * (a / 2 + h * j / 6));
+			v += h * (a + h * j / 2);
+			a += h * j;
+			t += h;
+			float pos;
+			MotionProfileSample(prof, (float)t, &pos, NULL);
+			err = fmax(err, fabs(pos - prof->start - prof->sign * p));
+		}
+	}
+	return (float)(err / dist);
+}
+
+/**
+ * @brief Acceleration from the velocity of the profile (finite difference)
+ */
+static float acceleration(const motion_profile_t *prof, float t, float h){
+	float pos, v0, v1;
+	MotionProfileSample(prof, t, &pos, &v0);
+	MotionProfileSample(prof, t + h, &pos, &v1);
+	return (v1 - v0) / h;
+}
+
+/**
+ * @brief Velocity, acceleration and jerk of the sampled profile within the limits
+ */
+static bool within_limits(const motion_profile_t *prof, float vel, float acc, float jerk){
+	const float h = 1e-3f;
+	const float window = 1e-2f;		/* Jerk from accelerations 10 ms apart (float noise) */
+	float duration = MotionProfileDuration(prof);
+	bool ok = true;
+	for(float t = 0; t < duration + window; t += h){
+		float pos, v;
+		MotionProfileSample(prof, t, &pos, &v);
+		ok &= fabsf(v) <= vel * (1 + TOL);
+		float a = acceleration(prof, t, h);
+		ok &= fabsf(a) <= acc * (1 + TOL) + 1e-2f;
+		if(jerk > 0){
+			float da = acceleration(prof, t + window, h) - a;
+			ok &= fabsf(da) / window <= jerk * (1 + 0.05f);
+		}
+	}
+	return ok;
+}
+
+/**
+ * @brief Trapezoid and triangle velocity profiles (jerk limit 0)
+ */
+static void test_trapezoid(void){
+	motion_profile_t prof;
+	/* 100 units at 50 u/s and 100 u/s²: 0.5 s ramps, 1.5 s cruise */
+	CHECK(MotionProfilePlan(&prof, 10, 110, 50, 100, 0));
+	CHECK(fabsf(MotionProfileDuration(&prof) - 2.5f) < 1e-4f);
+	double trap[7] = {0, 0.5, 0, 1.5, 0, 0.5, 0};
+	float err = compare(&prof, trap, 0, 100, 100);
+	printf("Trapezoid: duration %.4f s, error %.1e\n", MotionProfileDuration(&prof), err);
+	CHECK(err < TOL);
+	CHECK(within_limits(&prof, 50, 100, 0));
+
+	/* 10 units: triangle with peak velocity sqrt(10 * 100) */
+	CHECK(MotionProfilePlan(&prof, 0, -10, 50, 100, 0));
+	double t_ramp = sqrt(10.0 * 100) / 100;
+	CHECK(fabsf(MotionProfileDuration(&prof) - 2 * t_ramp) < 1e-4f);
+	double tri[7] = {0, t_ramp, 0, 0, 0, t_ramp, 0};
+	err = compare(&prof, tri, 0, 100, 10);
+	printf("Triangle:  duration %.4f s, error %.1e\n", MotionProfileDuration(&prof), err);
+	CHECK(err < TOL);
+	CHECK(within_limits(&prof, 50, 100, 0));
+}
+
+/**
+ * @brief S-curves: full 7 segments, acceleration limit not reached, short moves
+ */
+static void test_scurve(void){
+	motion_profile_t prof;
+	float err;
+
+	/* v = 50, a = 100, J = 1000: 0.1 s jerk, 0.4 s constant acceleration, 1.4 s cruise */
+	CHECK(MotionProfilePlan(&prof, 0, 100, 50, 100, 1000));
+	double full[7] = {0.1, 0.4, 0.1, 1.4, 0.1, 0.4, 0.1};
+	CHECK(fabsf(MotionProfileDuration(&prof) - 2.6f) < 1e-4f);
+	err = compare(&prof, full, 1000, 0, 100);
+	printf("S-curve:   duration %.4f s, error %.1e\n", MotionProfileDuration(&prof), err);
+	CHECK(err < TOL);
+	CHECK(within_limits(&prof, 50, 100, 1000));
+
+	/* v * J < a²: the acceleration peaks at sqrt(v * J) = 70.7 */
+	CHECK(MotionProfilePlan(&prof, 0, 100, 50, 100, 100));
+	double tj = sqrt(50.0 / 100);
+	double cruise = (100 - 50 * 2 * tj) / 50;
+	double no_acc[7] = {tj, 0, tj, cruise, tj, 0, tj};
+	CHECK(fabsf(MotionProfileDuration(&prof) - (float)(4 * tj + cruise)) < 1e-4f);
+	err = compare(&prof, no_acc, 100, 0, 100);
+	printf("S-curve (acceleration limit not reached): duration %.4f s, error %.1e\n", MotionProfileDuration(&prof), err);
+	CHECK(err < TOL);
+	CHECK(within_limits(&prof, 50, 100, 100));
+
+	/* Short move, peak acceleration reached: no cruise, v² / a + v * a / J = d */
+	CHECK(MotionProfilePlan(&prof, 0, 20, 50, 100, 1000));
+	double a_j = 0.1;
+	double v = 0.5 * 100 * (sqrt(a_j * a_j + 4 * 20.0 / 100) - a_j);
+	double t_const = v / 100 - a_j;
+	double short_acc[7] = {a_j, t_const, a_j, 0, a_j, t_const, a_j};
+	err = compare(&prof, short_acc, 1000, 0, 20);
+	printf("S-curve (short, no cruise): duration %.4f s, error %.1e\n", MotionProfileDuration(&prof), err);
+	CHECK(err < TOL);
+	CHECK(within_limits(&prof, 50, 100, 1000));
+
+	/* Very short move: only jerk segments, d = 2 * J * tj³ */
+	CHECK(MotionProfilePlan(&prof, 5, 4, 50, 100, 1000));
+	tj = cbrt(1.0 / (2 * 1000));
+	double jerk_only[7] = {tj, 0, tj, 0, tj, 0, tj};
+	CHECK(fabsf(MotionProfileDuration(&prof) - (float)(4 * tj)) < 1e-4f);
+	err = compare(&prof, jerk_only, 1000, 0, 1);
+	printf("S-curve (very short, jerk only): duration %.4f s, error %.1e\n", MotionProfileDuration(&prof), err);
+	CHECK(err < TOL);
+	CHECK(within_limits(&prof, 50, 100, 1000));
+}
+
+/**
+ * @brief Stretched profiles, null moves and invalid limits
+ */
+static void test_stretch(void){
+	motion_profile_t prof;
+	float pos, vel;
+	CHECK(MotionProfilePlan(&prof, 0, 100, 50, 100, 1000));
+	CHECK(!MotionProfileStretch(&prof, 2.0f));		/* Faster than possible */
+	CHECK(MotionProfileStretch(&prof, 5.2f));
+	CHECK(fabsf(MotionProfileDuration(&prof) - 5.2f) < 1e-4f);
+	/* Same shape in half the speed: halfway at half the time */
+	MotionProfileSample(&prof, 2.6f, &pos, &vel);
+	CHECK(fabsf(pos - 50) < 1e-3f);
+	CHECK(fabsf(vel - 25) < 1e-3f);
+	CHECK(within_limits(&prof, 25, 25, 125));
+	MotionProfileSample(&prof, 6, &pos, &vel);
+	CHECK((pos == 100) && (vel == 0));
+
+	CHECK(MotionProfilePlan(&prof, 3, 3, 50, 100, 1000));
+	CHECK(MotionProfileDuration(&prof) == 0);
+	CHECK(MotionProfileStretch(&prof, 1));
+	MotionProfileSample(&prof, 0.5f, &pos, NULL);
+	CHECK(pos == 3);
+
+	CHECK(!MotionProfilePlan(&prof, 0, 1, 0, 100, 0));
+	CHECK(!MotionProfilePlan(&prof, 0, 1, 50, 0, 0));
+	CHECK(!MotionProfilePlan(&prof, 0, 1, 50, 100, -1));
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	test_trapezoid();
+	test_scurve();
+	test_stretch();
+	printf(failures ? "%d FAILURES\n" : "OK\n", failures);
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,578 @@
+/**
+ * @file multirate_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the multirate middleware (decimators, resampler and CIC).
+ *
+ * Measures the frequency response of the decimators, the interpolator, the
+ * rational resampler and the CIC decimator with tones, compares their outputs
+ * with a direct (filter at the high rate, then keep the samples) implementation,
+ * checks the processing in blocks of random length, and counts the MACs and the
+ * time of an 8 kHz to 250 Hz ECG decimation.
+ *
+ * Build (from this folder):
+ *
+ *     make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "multirate.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define SIG_LEN		16384
+#define MAX_TAPS	512
+#define SEGMENT		1024		/* Output samples used to measure a tone */
+#define Q15_AMP		16000		/* Amplitude of the Q15 tones */
+#define DB(x)		(20 * log10(x))
+/*==================[internal data definition]===============================*/
+static int failures;
+static float x[SIG_LEN];
+static float y[4 * SIG_LEN];
+static float y_ref[4 * SIG_LEN];
+static float h[MAX_TAPS];
+static int16_t x_q15[SIG_LEN];
+static int16_t y_q15[SIG_LEN];
+static int16_t y2_q15[SIG_LEN];
+/*==================[internal functions definition]==========================*/
+static double now_us(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+/**
+ * @brief Magnitude of the FIR filter response at frequency f (relative to its sample frequency)
+ */
+static double fir_response(const float *coeffs, int taps, double f){
+	double re = 0, im = 0;
+	for(int k = 0; k < taps; k++){
+		re += coeffs[k] * cos(2 * M_PI * f * k);
+		im -= coeffs[k] * sin(2 * M_PI * f * k);
+	}
+	return sqrt(re * re + im * im);
+}
+
+/**
+ * @brief Amplitude of the tone of frequency f in len samples (f * len must be an integer)
+ */
+static double tone_amplitude(const float *sig, int len, double f){
+	double re = 0, im = 0;
+	for(int n = 0; n < len; n++){
+		re += sig[n] * cos(2 * M_PI * f * n);
+		im += sig[n] * sin(2 * M_PI * f * n);
+	}
+	if((fabs(f - round(f)) < 1e-12) || (fabs(f - round(f) - 0.5) < 1e-12) || (fabs(f - round(f) + 0.5) < 1e-12)){
+		return fabs(re) / len;
+	}
+	return 2 * sqrt(re * re + im * im) / len;
+}
+
+/**
+ * @brief Ratio between the rms of the signal without the tone of frequency f and the amplitude of the tone
+ */
+static double tone_residual(const float *sig, int len, double f){
+	double re = 0, im = 0, res = 0;
+	for(int n = 0; n < len; n++){
+		re += sig[n] * cos(2 * M_PI * f * n);
+		im += sig[n] * sin(2 * M_PI * f * n);
+	}
+	re *= 2.0 / len;
+	im *= 2.0 / len;
+	for(int n = 0; n < len; n++){
+		double e = sig[n] - re * cos(2 * M_PI * f * n) - im * sin(2 * M_PI * f * n);
+		res += e * e;
+	}
+	return sqrt(res / len) / sqrt(re * re + im * im);
+}
+
+/**
+ * @brief Frequency of a tone after decimation, in [0, 0.5]
+ */
+static double alias(double f){
+	f -= floor(f);
+	return (f > 0.5) ? 1 - f : f;
+}
+
+static void tone(float *sig, int len, double f){
+	for(int n = 0; n < len; n++){
+		sig[n] = cos(2 * M_PI * f * n);
+	}
+}
+
+static void tone_q15(int16_t *sig, int len, double f, int amp){
+	for(int n = 0; n < len; n++){
+		sig[n] = lround(amp * cos(2 * M_PI * f * n));
+	}
+}
+
+static void q15_to_float(const int16_t *in, float *out, int len){
+	for(int n = 0; n < len; n++){
+		out[n] = in[n] / (float)Q15_AMP;
+	}
+}
+
+static int random_block(int pos, int len){
+	int block = 1 + rand() % 100;
+	return (block > len - pos) ? len - pos : block;
+}
+
+static float max_diff(const float *a, const float *b, int len){
+	float diff = 0;
+	for(int i = 0; i < len; i++){
+		diff = fmaxf(diff, fabsf(a[i] - b[i]));
+	}
+	return diff;
+}
+
+/**
+ * @brief Direct resampling: zeros between the input samples, FIR at up times the
+ * input rate and one of every down samples, computed only at the kept samples
+ */
+static int resample_ref(const float *in, int len, const float *coeffs, int taps, int up, int down, float *out){
+	int n_out = 0;
+	for(long t = 0; t < (long)len * up; t += down){
+		double acc = 0;
+		for(int k = 0; k < taps; k++){
+			if((t - k >= 0) && ((t - k) % up == 0)){
+				acc += coeffs[k] * in[(t - k) / up];
+			}
+		}
+		out[n_out++] = acc;
+	}
+	return n_out;
+}
+
+static void check_decimator(void){
+	const int factor = 4, taps = 96;
+	const double freqs[] = {0.01, 0.03, 0.06, 0.15, 0.2, 0.3, 0.45};
+	decimator_t dec;
+	float worst_pass = 0, worst_stop = -1000, worst_diff = 0;
+	MultirateLowPass(h, taps, 0.1f, 1);
+	printf("Decimator by %d, %d taps, cut-off 0.1 fs:\n", factor, taps);
+	printf("  f (fs in)   |H(f)| (dB)   measured (dB)\n");
+	for(unsigned i = 0; i < sizeof(freqs) / sizeof(double); i++){
+		/* Integer number of cycles in SEGMENT output samples */
+		double f = round(freqs[i] * factor * SEGMENT) / (factor * SEGMENT);
+		int len = (SEGMENT + taps) * factor;
+		int n_out = 0;
+		tone(x, len, f);
+		CHECK(DecimatorInit(&dec, h, taps, factor));
+		for(int pos = 0; pos < len; ){
+			int block = random_block(pos, len);
+			n_out += DecimatorProcess(&dec, &x[pos], &y[n_out], block);
+			pos += block;
+		}
+		DecimatorDeinit(&dec);
+		CHECK(n_out == len / factor);
+		/* Direct: FIR at the input rate, the output n uses inputs up to n * factor + factor - 1 */
+		for(int n = 0; n < n_out; n++){
+			double acc = 0;
+			for(int k = 0; k < taps; k++){
+				int j = n * factor + factor - 1 - k;
+				acc += (j >= 0) ? h[k] * x[j] : 0;
+			}
+			y_ref[n] = acc;
+		}
+		worst_diff = fmaxf(worst_diff, max_diff(y, y_ref, n_out));
+		double theory = fir_response(h, taps, f);
+		double measured = tone_amplitude(&y[n_out - SEGMENT], SEGMENT, alias(f * factor));
+		printf("  %9.4f   %11.2f   %13.2f\n", f, DB(theory), DB(measured));
+		if(f < 0.065){
+			worst_pass = fmaxf(worst_pass, fabs(DB(measured)));
+		}
+		if(f > 0.145){
+			worst_stop = fmaxf(worst_stop, DB(measured));
+		}
+		CHECK(fabs(measured - theory) < 1e-4);
+	}
+	printf("  pass band ripple %.4f dB, stop band %.1f dB, max difference with the direct FIR %.1e\n", worst_pass, worst_stop, worst_diff);
+	CHECK(worst_pass < 0.01f);
+	CHECK(worst_stop < -70);
+	CHECK(worst_diff < 1e-5f);
+	CHECK(!DecimatorInit(&dec, h, taps, 0));
+}
+
+static void check_decimator_q15(void){
+	const int factor = 4, taps = 96;
+	const double freqs[] = {0.01, 0.03, 0.06, 0.15, 0.2, 0.3, 0.45};
+	decimator_q15_t dec;
+	float worst_pass = 0, worst_stop = -1000;
+	MultirateLowPass(h, taps, 0.1f, 1);
+	for(unsigned i = 0; i < sizeof(freqs) / sizeof(double); i++){
+		double f = round(freqs[i] * factor * SEGMENT) / (factor * SEGMENT);
+		int len = (SEGMENT + taps) * factor;
+		int n_out = 0, n_one;
+		tone_q15(x_q15, len, f, Q15_AMP);
+		/* One call */
+		CHECK(DecimatorInitQ15(&dec, h, taps, factor));
+		n_one = DecimatorProcessQ15(&dec, x_q15, y2_q15, len);
+		DecimatorDeinitQ15(&dec);
+		/* Blocks of random length */
+		CHECK(DecimatorInitQ15(&dec, h, taps, factor));
+		for(int pos = 0; pos < len; ){
+			int block = random_block(pos, len);
+			n_out += DecimatorProcessQ15(&dec, &x_q15[pos], &y_q15[n_out], block);
+			pos += block;
+		}
+		DecimatorDeinitQ15(&dec);
+		CHECK(n_out == len / factor);
+		CHECK(n_one == n_out);
+		CHECK(memcmp(y_q15, y2_q15, n_out * sizeof(int16_t)) == 0);
+		q15_to_float(&y_q15[n_out - SEGMENT], y, SEGMENT);
+		double measured = tone_amplitude(y, SEGMENT, alias(f * factor));
+		if(f < 0.065){
+			worst_pass = fmaxf(worst_pass, fabs(DB(measured)));
+		}
+		if(f > 0.145){
+			worst_stop = fmaxf(worst_stop, DB(measured));
+		}
+	}
+	printf("Q15 decimator by %d, %d taps: pass band ripple %.4f dB, stop band %.1f dB\n", factor, taps, worst_pass, worst_stop);
+	CHECK(worst_pass < 0.01f);
+	CHECK(worst_stop < -70);
+}
+
+/**
+ * @brief Peak of the exact Q15 decimator output (64 bit sums, same rounding as
+ * dsps_fird_s16) for the step from -amp to amp, stored in y_ref as integers
+ */
+static long step_q15_ref(const int16_t *coeffs, int taps, int factor, int len, int amp){
+	long peak = 0;
+	for(int n = 0; n < len / factor; n++){
+		long long acc = 0x7fff;
+		for(int k = 0; k < taps; k++){
+			int j = n * factor + factor - 1 - k;
+			acc += (j >= 0) ? (long long)coeffs[k] * ((j < len / 2) ? -amp : amp) : 0;
+		}
+		acc >>= 15;
+		y_ref[n] = acc;
+		peak = (labs(acc) > peak) ? labs(acc) : peak;
+	}
+	return peak;
+}
+
+/**
+ * @brief Step from -amp to amp through the Q15 decimator, compared with the exact output
+ */
+static int step_q15_errors(decimator_q15_t *dec, int taps, int factor, int len, int amp, long *peak){
+	int errors = 0;
+	*peak = step_q15_ref(dec->coeffs, taps, factor, len, amp);
+	for(int n = 0; n < len; n++){
+		x_q15[n] = (n < len / 2) ? -amp : amp;
+	}
+	int n_out = DecimatorProcessQ15(dec, x_q15, y_q15, len);
+	CHECK(n_out == len / factor);
+	for(int n = 0; n < n_out; n++){
+		errors += (y_q15[n] != (long)y_ref[n]);
+	}
+	return errors;
+}
+
+/**
+ * @brief Near full scale steps (the overshoot of the filter is the worst case for
+ * common signals): within dec.max_input, or with the filter gain set to 1 / L1,
+ * the output must not wrap around
+ */
+static void check_decimator_q15_step(void){
+	const int factor = 4, taps = 96, len = 4096;
+	decimator_q15_t dec;
+	long peak, peak_fs;
+	float l1 = 0;
+	MultirateLowPass(h, taps, 0.1f, 1);
+	CHECK(DecimatorInitQ15(&dec, h, taps, factor));
+	peak_fs = step_q15_ref(dec.coeffs, taps, factor, len, INT16_MAX);
+	int errors = step_q15_errors(&dec, taps, factor, len, dec.max_input, &peak);
+	printf("Q15 decimator step, gain 1: max input %d (%.1f%% of full scale), output peak %ld, %d errors "
+		"(a full scale step would reach %ld)\n", dec.max_input, 100.0 * dec.max_input / INT16_MAX, peak, errors, peak_fs);
+	CHECK(peak_fs > INT16_MAX);
+	CHECK(peak <= INT16_MAX);
+	CHECK(errors == 0);
+	DecimatorDeinitQ15(&dec);
+
+	/* Gain 1 / L1: full scale input */
+	for(int k = 0; k < taps; k++){
+		l1 += fabsf(h[k]);
+	}
+	MultirateLowPass(h, taps, 0.1f, 1 / l1);
+	CHECK(DecimatorInitQ15(&dec, h, taps, factor));
+	errors = step_q15_errors(&dec, taps, factor, len, dec.max_input, &peak);
+	printf("Q15 decimator step, gain 1 / L1 (%.2f dB): max input %d, output peak %ld, %d errors\n",
+		DB(1 / l1), dec.max_input, peak, errors);
+	CHECK(dec.max_input > INT16_MAX * 0.999);
+	CHECK(peak <= INT16_MAX);
+	CHECK(errors == 0);
+	DecimatorDeinitQ15(&dec);
+
+	/* A filter without negative coefficients can take any input */
+	for(int k = 0; k < 8; k++){
+		h[k] = 1 / 8.0f;
+	}
+	CHECK(DecimatorInitQ15(&dec, h, 8, factor));
+	CHECK(dec.max_input == INT16_MAX);
+	DecimatorDeinitQ15(&dec);
+}
+
+/**
+ * @brief Resampler by up / down: tones in the pass band (gain and distortion),
+ * images and aliases (stop band), and the output of the direct resampling
+ */
+static void check_resampler(int up, int down){
+	const double freqs[] = {0.02, 0.1, 0.18, 0.25};
+	int rate = (up > down) ? up : down;
+	int taps = 24 * rate;
+	float cut = 0.4f / rate;
+	float worst_pass = 0, worst_diff = 0;
+	double worst_res = 0;
+	resampler_t rs;
+	/* Filter at up times the input rate, pass band up to 0.8 of the lowest Nyquist frequency */
+	MultirateLowPass(h, taps, cut, up);
+	for(unsigned i = 0; i < sizeof(freqs) / sizeof(double); i++){
+		/* Tone in the pass band (relative to the input rate), integer number of cycles in SEGMENT outputs */
+		double f_in = freqs[i] * ((up < down) ? (double)up / down : 1);
+		double f_out = round(f_in * down / up * SEGMENT) / SEGMENT;
+		f_in = f_out * up / down;
+		int len = (SEGMENT + taps) * down / up + 1;
+		int n_out = 0;
+		tone(x, len, f_in);
+		CHECK(ResamplerInit(&rs, h, taps, up, down));
+		for(int pos = 0; pos < len; ){
+			int block = random_block(pos, len);
+			n_out += ResamplerProcess(&rs, &x[pos], &y[n_out], block);
+			pos += block;
+		}
+		ResamplerDeinit(&rs);
+		int n_ref = resample_ref(x, len, h, taps, up, down, y_ref);
+		CHECK(n_out == n_ref);
+		worst_diff = fmaxf(worst_diff, max_diff(y, y_ref, n_out));
+		double measured = tone_amplitude(&y[n_out - SEGMENT], SEGMENT, f_out);
+		worst_pass = fmaxf(worst_pass, fabs(DB(measured)));
+		/* Everything but the tone: images and aliases */
+		worst_res = fmax(worst_res, tone_residual(&y[n_out - SEGMENT], SEGMENT, f_out));
+	}
+	printf("Resampler by %d/%d, %d taps: pass band ripple %.4f dB, images %.1f dB, max difference with the direct resampling %.1e\n",
+		up, down, taps, worst_pass, DB(worst_res), worst_diff);
+	CHECK(worst_pass < 0.01f);
+	CHECK(DB(worst_res) < -65);
+	CHECK(worst_diff < 1e-5f);
+}
+
+/**
+ * @brief Images of the interpolator by 4: a tone out of the pass band at the input
+ * (above 0.8 of its Nyquist frequency) appears at the output only as images
+ */
+static void check_interpolator(void){
+	const int factor = 4, taps = 96;
+	resampler_t rs;
+	int len = SEGMENT / factor + taps;
+	int n_out;
+	MultirateLowPass(h, taps, 0.5f / factor, factor);
+	/* Tone in the pass band */
+	double f_in = 64.0 / SEGMENT;
+	tone(x, len, f_in);
+	CHECK(InterpolatorInit(&rs, h, taps, factor));
+	n_out = InterpolatorProcess(&rs, x, y, len);
+	ResamplerDeinit(&rs);
+	CHECK(n_out == len * factor);
+	double gain = tone_amplitude(&y[n_out - SEGMENT], SEGMENT, f_in / factor);
+	double worst_image = 0;
+	for(int k = 1; k < factor; k++){
+		worst_image = fmax(worst_image, tone_amplitude(&y[n_out - SEGMENT], SEGMENT, (k - f_in) / factor));
+		worst_image = fmax(worst_image, tone_amplitude(&y[n_out - SEGMENT], SEGMENT, (k + f_in) / factor));
+	}
+	printf("Interpolator by %d, %d taps: gain %.4f dB, largest image %.1f dB\n", factor, taps, DB(gain), DB(worst_image));
+	CHECK(fabs(DB(gain)) < 0.01);
+	CHECK(DB(worst_image) < -70);
+}
+
+/**
+ * @brief CIC decimator against its theoretical response and against the direct
+ * computation (stages moving sums of factor samples, exact integers)
+ */
+static void check_cic(int factor, int stages){
+	const double freqs[] = {0.002, 0.013, 0.031, 0.057, 0.11, 0.21, 0.33, 0.43};
+	cic_decimator_t cic;
+	double worst_err = 0;
+	int worst_diff = 0;
+	long long gain = 1;
+	for(int s = 0; s < stages; s++){
+		gain *= factor;
+	}
+	for(unsigned i = 0; i < sizeof(freqs) / sizeof(double); i++){
+		double f = round(freqs[i] * factor * SEGMENT) / (factor * SEGMENT);
+		int len = (SEGMENT + stages) * factor;
+		int n_out = 0;
+		tone_q15(x_q15, len, f, Q15_AMP);
+		CHECK(CicDecimatorInit(&cic, factor, stages));
+		for(int pos = 0; pos < len; ){
+			int block = random_block(pos, len);
+			n_out += CicDecimatorProcess(&cic, &x_q15[pos], &y_q15[n_out], block);
+			pos += block;
+		}
+		CHECK(n_out == len / factor);
+		/* Direct: stages moving sums, output at the inputs factor - 1, 2 * factor - 1, ... */
+		static long long sum[SIG_LEN];
+		for(int n = 0; n < len; n++){
+			sum[n] = x_q15[n];
+		}
+		for(int s = 0; s < stages; s++){
+			for(int n = len - 1; n >= 0; n--){
+				long long acc = 0;
+				for(int k = 0; (k < factor) && (n - k >= 0); k++){
+					acc += sum[n - k];
+				}
+				sum[n] = acc;
+			}
+		}
+		for(int n = 0; n < n_out; n++){
+			long ref = lround((double)sum[n * factor + factor - 1] / gain);
+			worst_diff = abs((int)(ref - y_q15[n])) > worst_diff ? abs((int)(ref - y_q15[n])) : worst_diff;
+		}
+		/* Response: (sin(pi f R) / (R sin(pi f)))^N */
+		double theory = pow(fabs(sin(M_PI * f * factor) / (factor * sin(M_PI * f))), stages);
+		q15_to_float(&y_q15[n_out - SEGMENT], y, SEGMENT);
+		double measured = tone_amplitude(y, SEGMENT, alias(f * factor));
+		worst_err = fmax(worst_err, fabs(measured - theory));
+	}
+	printf("CIC decimator by %d, %d stages: max difference with the theoretical response %.1e, with the direct sums %d LSB\n",
+		factor, stages, worst_err, worst_diff);
+	CHECK(worst_err < 2e-4);
+	CHECK(worst_diff <= 1);
+}
+
+static void check_cic_limits(void){
+	cic_decimator_t cic;
+	CHECK(CicDecimatorInit(&cic, 16, 4));
+	CHECK(!CicDecimatorInit(&cic, 16, 5));
+	CHECK(CicDecimatorInit(&cic, 256, 2));
+	CHECK(!CicDecimatorInit(&cic, 8, CIC_MAX_STAGES + 1));
+	CHECK(!CicDecimatorInit(&cic, 0, 2));
+	/* Full scale input: the integrators wrap around, the output does not */
+	int16_t full[4096], out[256];
+	for(int n = 0; n < 4096; n++){
+		full[n] = (n & 512) ? INT16_MIN : INT16_MAX;
+	}
+	CHECK(CicDecimatorInit(&cic, 16, 4));
+	int n_out = CicDecimatorProcess(&cic, full, out, 4096);
+	CHECK(n_out == 256);
+	CHECK(out[20] == INT16_MAX);
+	CHECK(out[52] == INT16_MIN);
+}
+
+/**
+ * @brief 8 kHz to 250 Hz: FIR at 8 kHz keeping one of every 32 samples, polyphase
+ * decimator by 32 and CIC by 8 followed by a Q15 decimator by 4
+ */
+static void ecg_pipeline(void){
+	const int fs = 8000, factor = 32, taps = 256, len = SIG_LEN;
+	const int runs = 20;
+	static float full[SIG_LEN];
+	static float coeffs[MAX_TAPS];
+	decimator_t dec;
+	decimator_q15_t dec_q15;
+	cic_decimator_t cic;
+	int n_out = 0;
+	MultirateLowPass(h, taps, 100.0f / fs, 1);
+	MultirateLowPass(coeffs, 64, 100.0f / 1000, 1);
+	tone(x, len, 20.0 / fs);
+
+	/* FIR at 8 kHz, then one of every 32 samples */
+	double start = now_us();
+	for(int r = 0; r < runs; r++){
+		for(int n = 0; n < len; n++){
+			float acc = 0;
+			for(int k = 0; (k < taps) && (k <= n); k++){
+				acc += h[k] * x[n - k];
+			}
+			full[n] = acc;
+		}
+		for(int n = 0; n < len / factor; n++){
+			y_ref[n] = full[n * factor + factor - 1];
+		}
+	}
+	double time_full = (now_us() - start) / runs;
+
+	/* Polyphase decimator */
+	start = now_us();
+	for(int r = 0; r < runs; r++){
+		DecimatorInit(&dec, h, taps, factor);
+		n_out = DecimatorProcess(&dec, x, y, len);
+		DecimatorDeinit(&dec);
+	}
+	double time_dec = (now_us() - start) / runs;
+	CHECK(n_out == len / factor);
+	CHECK(max_diff(y, y_ref, n_out) < 1e-5f);
+
+	/* CIC by 8 and Q15 decimator by 4 */
+	tone_q15(x_q15, len, 20.0 / fs, Q15_AMP);
+	start = now_us();
+	for(int r = 0; r < runs; r++){
+		CicDecimatorInit(&cic, 8, 4);
+		DecimatorInitQ15(&dec_q15, coeffs, 64, 4);
+		n_out = CicDecimatorProcess(&cic, x_q15, y2_q15, len);
+		n_out = DecimatorProcessQ15(&dec_q15, y2_q15, y_q15, n_out);
+		DecimatorDeinitQ15(&dec_q15);
+	}
+	double time_cic = (now_us() - start) / runs;
+	CHECK(n_out == len / factor);
+
+	printf("ECG 8 kHz -> 250 Hz, %d input samples:\n", len);
+	printf("  method                               MACs/output   time (us)\n");
+	printf("  %d taps at 8 kHz, 1 of 32 samples    %11d   %9.1f\n", taps, taps * factor, time_full);
+	printf("  polyphase decimator by 32            %11d   %9.1f\n", taps, time_dec);
+	printf("  CIC by 8 (4 stages) + Q15 FIR by 4   %11d   %9.1f\n", 64, time_cic);
+
+	/* Response of the CIC + FIR pipeline: 20 Hz passes, 300 Hz and 1 kHz are removed */
+	const double freqs[] = {20, 300, 1000, 3000};
+	for(unsigned i = 0; i < sizeof(freqs) / sizeof(double); i++){
+		double f = round(freqs[i] / fs * factor * 256) / (factor * 256);
+		tone_q15(x_q15, len, f, Q15_AMP);
+		CicDecimatorInit(&cic, 8, 4);
+		DecimatorInitQ15(&dec_q15, coeffs, 64, 4);
+		CHECK(Q15_AMP <= dec_q15.max_input);
+		n_out = CicDecimatorProcess(&cic, x_q15, y2_q15, len);
+		n_out = DecimatorProcessQ15(&dec_q15, y2_q15, y_q15, n_out);
+		DecimatorDeinitQ15(&dec_q15);
+		q15_to_float(&y_q15[n_out - 256], y, 256);
+		double measured = tone_amplitude(y, 256, alias(f * factor));
+		printf("  CIC + FIR, %6.0f Hz: %7.1f dB\n", f * fs, DB(measured));
+		if(i == 0){
+			CHECK(fabs(DB(measured)) < 0.1);
+		} else {
+			CHECK(DB(measured) < -60);
+		}
+	}
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	check_decimator();
+	check_decimator_q15();
+	check_decimator_q15_step();
+	check_resampler(4, 1);
+	check_resampler(5, 4);
+	check_resampler(4, 5);
+	check_resampler(1, 3);
+	check_resampler(3, 2);
+	check_interpolator();
+	check_cic(8, 4);
+	check_cic(16, 3);
+	check_cic(5, 3);
+	check_cic_limits();
+	ecg_pipeline();
+
+	if(failures == 0){
+		printf("OK\n");
+	}
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,199 @@
+/**
+ * @file packet_assembler_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host fuzz tests of the line/packet assembler (packet_assembler module):
+ * random messages fed in random chunks, with noise and corrupted lengths.
+ *
+ * Build (from this folder): make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "packet_assembler.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+#define BUF_SIZE		64			/* Assembler buffer */
+#define MESSAGES		20000		/* Messages of every fuzz run */
+#define STREAM_SIZE		(MESSAGES * (BUF_SIZE + 16))
+#define SYNC			ASSEMBLER_DEFAULT_SYNC
+
+/**
+ * @brief Message expected by the receiver
+ */
+typedef struct {
+	uint16_t len;
+	uint32_t offset;	/* Position of the payload in the stream */
+} message_t;
+/*==================[internal data definition]===============================*/
+static int failures;
+static uint8_t stream[STREAM_SIZE];
+static uint32_t stream_len;
+static message_t expected[MESSAGES];
+static uint32_t n_expected;
+static uint32_t n_received, n_matched;
+static uint8_t buf[BUF_SIZE + 2];
+/*==================[internal functions definition]==========================*/
+static uint8_t random_byte(uint8_t avoid){
+	uint8_t b;
+	do{
+		b = rand();
+	} while(b == avoid);
+	return b;
+}
+
+/**
+ * @brief Receiver callback: messages must arrive in order; unmatched ones are counted
+ */
+static void on_message(const uint8_t *data, uint16_t len, void *param){
+	uint32_t *next = param;
+	n_received++;
+	CHECK(len <= BUF_SIZE + 1);
+	/* A lost message makes the receiver skip ahead to the next match */
+	for(uint32_t i = *next; (i < n_expected) && (i < *next + 4); i++){
+		if((expected[i].len == len) && (memcmp(&stream[expected[i].offset], data, len) == 0)){
+			n_matched++;
+			*next = i + 1;
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Feed the whole stream in random chunks (1 to 300 bytes)
+ */
+static void feed_random(packet_assembler_t *assembler){
+	uint32_t pos = 0;
+	while(pos < stream_len){
+		uint32_t chunk = 1 + rand() % 300;
+		if(chunk > stream_len - pos){
+			chunk = stream_len - pos;
+		}
+		AssemblerFeed(assembler, &stream[pos], chunk);
+		pos += chunk;
+	}
+}
+
+/**
+ * @brief Text lines with "\n" or "\r\n", some too long and some empty
+ */
+static void test_lines(void){
+	packet_assembler_t assembler = {.mode = ASSEMBLER_LINE, .marker = '\n', .buf = buf, .size = BUF_SIZE + 2,
+									.func_p = on_message};
+	uint32_t next = 0, too_long = 0;
+	assembler.param_p = &next;
+	AssemblerInit(&assembler);
+	stream_len = n_expected = n_received = n_matched = 0;
+	for(int m = 0; m < MESSAGES; m++){
+		uint16_t len = rand() % (BUF_SIZE + 8);
+		uint32_t offset = stream_len;
+		for(uint16_t i = 0; i < len; i++){
+			stream[stream_len++] = 32 + rand() % 95;
+		}
+		bool cr = rand() % 2;
+		if(cr){
+			stream[stream_len++] = '\r';
+		}
+		stream[stream_len++] = '\n';
+		/* The buffer holds the line, the '\r' and the '\0' */
+		if(len + cr + 1 > BUF_SIZE + 2){
+			too_long++;
+		} else if(len > 0){
+			expected[n_expected++] = (message_t){.len = len, .offset = offset};
+		}
+	}
+	feed_random(&assembler);
+	printf("Lines:   %5u sent, %5u received, %4u too long\n", (unsigned)n_expected, (unsigned)n_received, (unsigned)too_long);
+	CHECK(n_received == n_expected);
+	CHECK(n_matched == n_expected);
+	CHECK(assembler.messages == n_expected);
+	CHECK(assembler.overflows == too_long);
+}
+
+/**
+ * @brief Length prefixed packets with noise between them and corrupted lengths
+ */
+static void test_packets(void){
+	packet_assembler_t assembler = {.mode = ASSEMBLER_LENGTH_PREFIXED, .marker = SYNC, .buf = buf,
+									.size = BUF_SIZE, .func_p = on_message};
+	uint32_t next = 0, corrupted = 0, oversized = 0;
+	assembler.param_p = &next;
+	AssemblerInit(&assembler);
+	stream_len = n_expected = n_received = n_matched = 0;
+	for(int m = 0; m < MESSAGES; m++){
+		/* Noise never holds the sync byte, so every packet can be found */
+		for(int n = rand() % 4; n > 0; n--){
+			stream[stream_len++] = random_byte(SYNC);
+		}
+		uint16_t len = rand() % (BUF_SIZE + 1);
+		uint16_t header_len = len;
+		if(rand() % 50 == 0){
+			/* Corrupted MSB: a length of up to 64 KiB */
+			header_len |= (uint16_t)random_byte(0) << 8;
+			corrupted++;
+		} else if(rand() % 50 == 0){
+			/* Valid header of a packet that does not fit */
+			len = header_len = BUF_SIZE + 1 + rand() % 16;
+			oversized++;
+		}
+		stream[stream_len++] = SYNC;
+		stream[stream_len++] = header_len & 0xFF;
+		stream[stream_len++] = header_len >> 8;
+		uint32_t offset = stream_len;
+		for(uint16_t i = 0; i < len; i++){
+			stream[stream_len++] = random_byte(SYNC);
+		}
+		if((header_len == len) && (len <= BUF_SIZE)){
+			expected[n_expected++] = (message_t){.len = len, .offset = offset};
+		}
+	}
+	feed_random(&assembler);
+	printf("Packets: %5u sent, %5u received, %4u corrupted lengths, %4u oversized\n",
+		   (unsigned)n_expected, (unsigned)n_received, (unsigned)corrupted, (unsigned)oversized);
+	/* A corrupted length only loses its own packet */
+	CHECK(n_matched == n_expected);
+	CHECK(n_received == n_expected);
+	CHECK(assembler.overflows == corrupted + oversized);
+}
+
+/**
+ * @brief AssemblerReset() drops the partial packet, as after a UART flush
+ */
+static void test_reset(void){
+	packet_assembler_t assembler = {.mode = ASSEMBLER_LENGTH_PREFIXED, .marker = SYNC, .buf = buf,
+									.size = BUF_SIZE, .func_p = on_message};
+	uint32_t next = 0;
+	assembler.param_p = &next;
+	AssemblerInit(&assembler);
+	stream_len = n_expected = n_received = n_matched = 0;
+	const uint8_t partial[] = {SYNC, 10, 0, 1, 2, 3};
+	const uint8_t packet[] = {SYNC, 3, 0, 7, 8, 9};
+	memcpy(stream, packet, sizeof(packet));
+	expected[n_expected++] = (message_t){.len = 3, .offset = 3};
+	AssemblerFeed(&assembler, partial, sizeof(partial));
+	AssemblerReset(&assembler);
+	AssemblerFeed(&assembler, packet, sizeof(packet));
+	CHECK(n_received == 1);
+	CHECK(n_matched == 1);
+	CHECK(assembler.messages == 1);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	srand(1);
+	test_lines();
+	test_packets();
+	test_reset();
+	printf(failures ? "%d FAILURES\n" : "OK\n", failures);
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
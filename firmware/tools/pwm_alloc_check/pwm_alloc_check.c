@@ -0,0 +1,169 @@
+/**
+ * @file pwm_alloc_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the PWM channel/timer allocator (pwm_alloc module).
+ *
+ * Build (from this folder):
+ *
+ *     gcc -O2 -I../../drivers/utils/inc pwm_alloc_check.c ../../drivers/utils/src/pwm_alloc.c -o pwm_alloc_check
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "pwm_alloc.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+/*==================[internal data definition]===============================*/
+static int failures;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Allocator invariants: user counts match the channels attached to each timer
+ */
+static void check_consistency(const pwm_alloc_t *alloc){
+	uint8_t users[PWM_ALLOC_TIMERS] = {0};
+	for(uint8_t ch = 0; ch < PWM_ALLOC_CHANNELS; ch++){
+		int8_t timer = PwmAllocTimer(alloc, ch);
+		if(timer != PWM_ALLOC_NONE){
+			CHECK(timer < PWM_ALLOC_TIMERS);
+			users[timer]++;
+		}
+	}
+	for(uint8_t t = 0; t < PWM_ALLOC_TIMERS; t++){
+		CHECK(users[t] == PwmAllocUsers(alloc, t));
+	}
+	/* Two used timers never run at the same frequency */
+	for(uint8_t a = 0; a < PWM_ALLOC_TIMERS; a++){
+		for(uint8_t b = a + 1; b < PWM_ALLOC_TIMERS; b++){
+			if(alloc->timers[a].users && alloc->timers[b].users){
+				CHECK(alloc->timers[a].freq != alloc->timers[b].freq);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Four servos at 50 Hz share one timer
+ */
+static void test_sharing(void){
+	pwm_alloc_t alloc;
+	bool configure;
+	PwmAllocInit(&alloc);
+	CHECK(PwmAllocAttach(&alloc, 0, 50, &configure) == 0);
+	CHECK(configure);
+	for(uint8_t ch = 1; ch < 4; ch++){
+		CHECK(PwmAllocAttach(&alloc, ch, 50, &configure) == 0);
+		CHECK(!configure);
+	}
+	CHECK(PwmAllocUsers(&alloc, 0) == 4);
+	CHECK(PwmAllocUsers(&alloc, 1) == 0);
+	/* The other timers are still available */
+	CHECK(PwmAllocAttach(&alloc, 4, 1000, &configure) == 1);
+	CHECK(configure);
+	check_consistency(&alloc);
+}
+
+/**
+ * @brief Frequency changes: in place when alone, moving when shared
+ */
+static void test_frequency_change(void){
+	pwm_alloc_t alloc;
+	bool configure;
+	PwmAllocInit(&alloc);
+	PwmAllocAttach(&alloc, 0, 50, &configure);
+	PwmAllocAttach(&alloc, 1, 50, &configure);
+	PwmAllocAttach(&alloc, 3, 440, &configure);
+	/* Buzzer alone on its timer: same timer, reconfigured */
+	CHECK(PwmAllocAttach(&alloc, 3, 880, &configure) == 1);
+	CHECK(configure);
+	CHECK(alloc.timers[1].freq == 880);
+	/* Same frequency again: nothing to configure */
+	CHECK(PwmAllocAttach(&alloc, 3, 880, &configure) == 1);
+	CHECK(!configure);
+	/* Shared timer: the channel moves, the other keeps 50 Hz */
+	CHECK(PwmAllocAttach(&alloc, 1, 100, &configure) == 2);
+	CHECK(configure);
+	CHECK(alloc.timers[0].freq == 50);
+	CHECK(PwmAllocUsers(&alloc, 0) == 1);
+	/* Moving to a frequency another timer already has: shares it */
+	CHECK(PwmAllocAttach(&alloc, 1, 880, &configure) == 1);
+	CHECK(!configure);
+	CHECK(PwmAllocUsers(&alloc, 2) == 0);
+	check_consistency(&alloc);
+}
+
+/**
+ * @brief Exhaustion: a fifth frequency fails and leaves the channel as it was
+ */
+static void test_exhaustion(void){
+	pwm_alloc_t alloc;
+	bool configure;
+	PwmAllocInit(&alloc);
+	for(uint8_t ch = 0; ch < 4; ch++){
+		CHECK(PwmAllocAttach(&alloc, ch, 100 * (ch + 1), &configure) == ch);
+	}
+	CHECK(PwmAllocAttach(&alloc, 4, 1000, &configure) == PWM_ALLOC_NONE);
+	CHECK(PwmAllocTimer(&alloc, 4) == PWM_ALLOC_NONE);
+	/* Channel 0 joins channel 1 on timer 1, timer 0 is freed and taken by channel 4 */
+	CHECK(PwmAllocAttach(&alloc, 0, 200, &configure) == 1);
+	CHECK(PwmAllocAttach(&alloc, 4, 1000, &configure) == 0);
+	CHECK(configure);
+	/* Channel 0 shares its timer: it can not get a new frequency */
+	CHECK(PwmAllocAttach(&alloc, 0, 2000, &configure) == PWM_ALLOC_NONE);
+	CHECK(PwmAllocTimer(&alloc, 0) == 1);
+	CHECK(alloc.timers[1].freq == 200);
+	CHECK(PwmAllocUsers(&alloc, 1) == 2);
+	/* Detaching frees the timer for other frequencies */
+	CHECK(PwmAllocDetach(&alloc, 2) == 2);
+	CHECK(PwmAllocDetach(&alloc, 2) == PWM_ALLOC_NONE);
+	CHECK(PwmAllocAttach(&alloc, 5, 5000, &configure) == 2);
+	CHECK(PwmAllocAttach(&alloc, 6, 50, &configure) == PWM_ALLOC_NONE);
+	check_consistency(&alloc);
+}
+
+/**
+ * @brief Random operations keep the allocator consistent
+ */
+static void test_random(void){
+	static const uint32_t freqs[] = {50, 100, 440, 880, 1000, 20000};
+	pwm_alloc_t alloc;
+	bool configure;
+	srand(1);
+	PwmAllocInit(&alloc);
+	for(uint32_t i = 0; i < 100000; i++){
+		uint8_t ch = rand() % PWM_ALLOC_CHANNELS;
+		if(rand() % 4 == 0){
+			PwmAllocDetach(&alloc, ch);
+		} else{
+			uint32_t freq = freqs[rand() % 6];
+			int8_t before = PwmAllocTimer(&alloc, ch);
+			int8_t timer = PwmAllocAttach(&alloc, ch, freq, &configure);
+			if(timer != PWM_ALLOC_NONE){
+				CHECK(alloc.timers[timer].freq == freq);
+			} else{
+				CHECK(PwmAllocTimer(&alloc, ch) == before);
+			}
+		}
+		check_consistency(&alloc);
+		if(failures){
+			return;
+		}
+	}
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	test_sharing();
+	test_frequency_change();
+	test_exhaustion();
+	test_random();
+	printf("%s\n", failures ? "FAILED" : "OK");
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*==================[end of file]============================================*/
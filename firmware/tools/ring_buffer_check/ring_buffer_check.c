@@ -0,0 +1,265 @@
+/**
+ * @file ring_buffer_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests and producer/consumer benchmark of the lock-free byte ring
+ * buffer (ring_buffer module) used by the UART stream mode.
+ *
+ * Build (from this folder): make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <sched.h>
+#include "ring_buffer.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+#define BIG_SIZE		(128 * 1024)		/* Larger than 64 KB */
+#define STRESS_BYTES	(16u * 1024 * 1024)
+#define BENCH_BYTES		(64u * 1024 * 1024)
+
+/**
+ * @brief Producer/consumer run: block size and access mode
+ */
+typedef struct {
+	ring_buffer_t *rb;
+	uint32_t total;				/* Bytes to transfer */
+	uint32_t block;				/* Maximum block per call (0: random up to 4096) */
+	bool zero_copy;				/* Reserve/Commit and Peek/Consume instead of Write/Read */
+	bool check;					/* Verify the byte sequence */
+	uint32_t errors;
+} stream_t;
+/*==================[internal data definition]===============================*/
+static int failures;
+static uint8_t big_storage[BIG_SIZE];
+/*==================[internal functions definition]==========================*/
+static double now_s(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Init, wrap around, contiguous blocks and vector writes
+ */
+static void test_basic(void){
+	ring_buffer_t rb;
+	uint8_t storage[16], out[32], *wblock;
+	const uint8_t *rblock;
+	CHECK(!RingBufferInit(&rb, storage, 0));
+	CHECK(!RingBufferInit(&rb, storage, 12));
+	CHECK(RingBufferInit(&rb, storage, 16));
+	CHECK(RingBufferFree(&rb) == 16);
+
+	/* Partial write when full, partial read when empty */
+	CHECK(RingBufferWrite(&rb, "0123456789", 10) == 10);
+	CHECK(RingBufferRead(&rb, out, 6) == 6);
+	CHECK(memcmp(out, "012345", 6) == 0);
+	CHECK(RingBufferWrite(&rb, "abcdefghijklmnop", 16) == 12);
+	CHECK(RingBufferUsed(&rb) == 16);
+	CHECK(RingBufferRead(&rb, out, 32) == 16);
+	CHECK(memcmp(out, "6789abcdefghijkl", 16) == 0);
+
+	/* Contiguous blocks stop at the end of the storage */
+	CHECK(RingBufferWrite(&rb, "ABCDEFGHIJ", 10) == 10);		/* Indexes 22 to 31: offsets 6 to 15 */
+	CHECK(RingBufferPeek(&rb, &rblock) == 10);
+	CHECK(rblock == &storage[6]);
+	RingBufferConsume(&rb, 4);
+	CHECK(RingBufferReserve(&rb, &wblock) == 10);				/* Offsets 0 to 9 (head at the end) */
+	CHECK(wblock == storage);
+	memcpy(wblock, "xyz", 3);
+	RingBufferCommit(&rb, 3);
+	CHECK(RingBufferRead(&rb, out, 32) == 9);
+	CHECK(memcmp(out, "EFGHIJxyz", 9) == 0);
+
+	/* Vector writes are all or nothing */
+	const ring_buffer_iovec_t record[] = {{"head:", 5}, {"1234", 4}, {"\r\n", 2}};
+	const ring_buffer_iovec_t too_big[] = {{"0123456789", 10}, {"0123456789", 10}};
+	CHECK(RingBufferWriteVector(&rb, record, 3) == 11);
+	CHECK(RingBufferWriteVector(&rb, too_big, 2) == 0);
+	CHECK(RingBufferUsed(&rb) == 11);
+	CHECK(RingBufferRead(&rb, out, 32) == 11);
+	CHECK(memcmp(out, "head:1234\r\n", 11) == 0);
+
+	/* Free running indexes crossing 2^32 */
+	atomic_store(&rb.head, UINT32_MAX - 5);
+	atomic_store(&rb.tail, UINT32_MAX - 5);
+	CHECK(RingBufferWrite(&rb, "0123456789", 10) == 10);
+	CHECK(RingBufferUsed(&rb) == 10);
+	CHECK(RingBufferRead(&rb, out, 32) == 10);
+	CHECK(memcmp(out, "0123456789", 10) == 0);
+
+	RingBufferWrite(&rb, "abc", 3);
+	RingBufferReset(&rb);
+	CHECK(RingBufferUsed(&rb) == 0);
+}
+
+/**
+ * @brief Buffers over 64 KB
+ */
+static void test_big(void){
+	ring_buffer_t rb;
+	static uint8_t in[BIG_SIZE], out[BIG_SIZE];
+	for(uint32_t i = 0; i < BIG_SIZE; i++){
+		in[i] = rand();
+	}
+	CHECK(RingBufferInit(&rb, big_storage, BIG_SIZE));
+	CHECK(RingBufferWrite(&rb, in, 100000) == 100000);
+	CHECK(RingBufferRead(&rb, out, 70000) == 70000);
+	CHECK(RingBufferWrite(&rb, in + 100000, BIG_SIZE - 100000) == BIG_SIZE - 100000);
+	CHECK(RingBufferWrite(&rb, in, BIG_SIZE) == 70000);
+	CHECK(RingBufferUsed(&rb) == BIG_SIZE);
+	CHECK(RingBufferRead(&rb, out + 70000, BIG_SIZE - 70000) == BIG_SIZE - 70000);
+	CHECK(memcmp(in, out, BIG_SIZE) == 0);
+	CHECK(RingBufferRead(&rb, out, BIG_SIZE) == 70000);
+	CHECK(memcmp(in, out, 70000) == 0);
+}
+
+static uint32_t block_len(const stream_t *s, uint32_t *seed){
+	return s->block ? s->block : 1 + rand_r(seed) % 4096;
+}
+
+static void *producer(void *arg){
+	stream_t *s = arg;
+	uint8_t buf[4096];
+	uint32_t sent = 0, seed = 1;
+	while(sent < s->total){
+		uint32_t len = block_len(s, &seed);
+		if(len > s->total - sent){
+			len = s->total - sent;
+		}
+		if(s->zero_copy){
+			uint8_t *block;
+			uint32_t n = RingBufferReserve(s->rb, &block);
+			if(n > len){
+				n = len;
+			}
+			for(uint32_t i = 0; s->check && (i < n); i++){
+				block[i] = (uint8_t)(sent + i);
+			}
+			RingBufferCommit(s->rb, n);
+			sent += n;
+			if(n == 0){
+				sched_yield();
+			}
+		} else{
+			uint32_t n;
+			for(uint32_t i = 0; s->check && (i < len); i++){
+				buf[i] = (uint8_t)(sent + i);
+			}
+			if(s->check && (rand_r(&seed) % 4 == 0) && (len > 1)){
+				/* Record in two segments */
+				ring_buffer_iovec_t iov[2] = {{buf, len / 2}, {buf + len / 2, len - len / 2}};
+				n = RingBufferWriteVector(s->rb, iov, 2);
+			} else{
+				n = RingBufferWrite(s->rb, buf, len);
+			}
+			sent += n;
+			if(n < len){
+				sched_yield();
+			}
+		}
+	}
+	return NULL;
+}
+
+static void *consumer(void *arg){
+	stream_t *s = arg;
+	uint8_t buf[4096];
+	uint32_t received = 0, seed = 2;
+	while(received < s->total){
+		uint32_t len = block_len(s, &seed);
+		const uint8_t *data = buf;
+		uint32_t n;
+		if(s->zero_copy){
+			n = RingBufferPeek(s->rb, &data);
+			if(n > len){
+				n = len;
+			}
+		} else{
+			n = RingBufferRead(s->rb, buf, len);
+		}
+		for(uint32_t i = 0; s->check && (i < n); i++){
+			s->errors += (data[i] != (uint8_t)(received + i));
+		}
+		if(s->zero_copy){
+			RingBufferConsume(s->rb, n);
+		}
+		received += n;
+		if(n == 0){
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Run a producer and a consumer thread, returns the throughput in MB/s
+ */
+static double run_stream(stream_t *s){
+	pthread_t prod, cons;
+	double start = now_s();
+	pthread_create(&cons, NULL, consumer, s);
+	pthread_create(&prod, NULL, producer, s);
+	pthread_join(prod, NULL);
+	pthread_join(cons, NULL);
+	return s->total / (now_s() - start) / 1e6;
+}
+
+/**
+ * @brief Threaded stress: random block sizes, copy and zero copy access, vector writes
+ */
+static void test_stress(void){
+	ring_buffer_t rb;
+	uint8_t storage[1024];
+	for(int zero_copy = 0; zero_copy < 2; zero_copy++){
+		RingBufferInit(&rb, storage, sizeof(storage));
+		stream_t s = {.rb = &rb, .total = STRESS_BYTES, .block = 0, .zero_copy = zero_copy, .check = true};
+		run_stream(&s);
+		printf("Stress (%s): %u MB through a 1 KB ring, %u errors\n", zero_copy ? "reserve/peek" : "write/read",
+			(unsigned)(STRESS_BYTES >> 20), (unsigned)s.errors);
+		CHECK(s.errors == 0);
+		CHECK(RingBufferUsed(&rb) == 0);
+	}
+}
+
+/**
+ * @brief Producer/consumer throughput (only reported: it depends on the host)
+ */
+static void benchmark(void){
+	const uint32_t blocks[] = {16, 256, 4096};
+	ring_buffer_t rb;
+	RingBufferInit(&rb, big_storage, 64 * 1024);
+	printf("Throughput with a 64 KB ring (MB/s):\n  block   write/read   reserve/peek\n");
+	for(unsigned b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++){
+		double mbps[2];
+		for(int zero_copy = 0; zero_copy < 2; zero_copy++){
+			RingBufferReset(&rb);
+			stream_t s = {.rb = &rb, .total = BENCH_BYTES, .block = blocks[b], .zero_copy = zero_copy};
+			mbps[zero_copy] = run_stream(&s);
+		}
+		printf("  %5u   %10.0f   %12.0f\n", (unsigned)blocks[b], mbps[0], mbps[1]);
+	}
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	srand(1);
+	test_basic();
+	test_big();
+	test_stress();
+	benchmark();
+	printf(failures ? "%d FAILURES\n" : "OK\n", failures);
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,181 @@
+/**
+ * @file rtttl_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the RTTTL melody compiler (rtttl module).
+ *
+ * Build (from this folder):
+ *
+ *     gcc -O2 -I../../drivers/utils/inc -I../../drivers/devices/inc rtttl_check.c ../../drivers/utils/src/rtttl.c -o rtttl_check
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "rtttl.h"
+#include "buzzer_melodies.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define MAX_NOTES	256
+#define LEN(a)		(sizeof(a) / sizeof(a[0]))
+/*==================[internal data definition]===============================*/
+static int failures;
+
+/* Reference lists written by hand from the RTTTL text */
+static const rtttl_note_t ref_simpsons[] = {
+	{NOTE_C6, 562}, {NOTE_E6, 375}, {NOTE_FS6, 375}, {NOTE_A6, 187}, {NOTE_G6, 562},
+	{NOTE_E6, 375}, {NOTE_C6, 375}, {NOTE_A5, 187}, {NOTE_FS5, 187}, {NOTE_FS5, 187},
+	{NOTE_FS5, 187}, {NOTE_G5, 750}, {RTTTL_PAUSE, 187}, {RTTTL_PAUSE, 187}, {NOTE_FS5, 187},
+	{NOTE_FS5, 187}, {NOTE_FS5, 187}, {NOTE_G5, 187}, {NOTE_AS5, 562}, {NOTE_C6, 187},
+	{NOTE_C6, 187}, {NOTE_C6, 187}, {NOTE_C6, 375}
+};
+
+/* Defaults in any order, upper case, spaces, dot after the octave, octave 3 */
+static const char *variant = "Test: b=120 , o=4,d=8 :C, 4d#., e5., 16P, 2b3, c";
+static const rtttl_note_t ref_variant[] = {
+	{NOTE_C4, 250}, {NOTE_DS4, 750}, {NOTE_E5, 375}, {RTTTL_PAUSE, 125}, {NOTE_B3, 1000},
+	{NOTE_C4, 250}
+};
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Previous buzzer.c parser (played the notes while parsing), used as reference
+ */
+static uint16_t legacy_parse(const char *p, rtttl_note_t *out){
+	static const uint16_t notes[] = {
+		0,
+		NOTE_C4, NOTE_CS4, NOTE_D4, NOTE_DS4, NOTE_E4, NOTE_F4, NOTE_FS4, NOTE_G4, NOTE_GS4, NOTE_A4, NOTE_AS4, NOTE_B4,
+		NOTE_C5, NOTE_CS5, NOTE_D5, NOTE_DS5, NOTE_E5, NOTE_F5, NOTE_FS5, NOTE_G5, NOTE_GS5, NOTE_A5, NOTE_AS5, NOTE_B5,
+		NOTE_C6, NOTE_CS6, NOTE_D6, NOTE_DS6, NOTE_E6, NOTE_F6, NOTE_FS6, NOTE_G6, NOTE_GS6, NOTE_A6, NOTE_AS6, NOTE_B6,
+		NOTE_C7, NOTE_CS7, NOTE_D7, NOTE_DS7, NOTE_E7, NOTE_F7, NOTE_FS7, NOTE_G7, NOTE_GS7, NOTE_A7, NOTE_AS7, NOTE_B7
+	};
+	static const uint8_t letter[] = {10, 12, 1, 3, 5, 6, 8};
+	uint8_t default_dur = 4, default_oct = 6, note, scale;
+	int bpm = 63, num;
+	long wholenote, duration;
+	uint16_t n = 0;
+	while(*p != ':') p++;
+	p++;
+	if(*p == 'd'){
+		p += 2;
+		num = 0;
+		while(*p >= '0' && *p <= '9') num = num * 10 + (*p++ - '0');
+		if(num > 0) default_dur = num;
+		p++;
+	}
+	if(*p == 'o'){
+		p += 2;
+		num = *p++ - '0';
+		if(num >= 3 && num <= 7) default_oct = num;
+		p++;
+	}
+	if(*p == 'b'){
+		p += 2;
+		num = 0;
+		while(*p >= '0' && *p <= '9') num = num * 10 + (*p++ - '0');
+		bpm = num;
+		p++;
+	}
+	wholenote = (60 * 1000L / bpm) * 4;
+	while(*p){
+		num = 0;
+		while(*p >= '0' && *p <= '9') num = num * 10 + (*p++ - '0');
+		duration = num ? wholenote / num : wholenote / default_dur;
+		note = (*p >= 'a' && *p <= 'g') ? letter[*p - 'a'] : 0;
+		p++;
+		if(*p == '#'){ note++; p++; }
+		if(*p == '.'){ duration += duration / 2; p++; }
+		if(*p >= '0' && *p <= '9'){ scale = *p++ - '0'; } else{ scale = default_oct; }
+		if(*p == ',') p++;
+		out[n].freq = note ? notes[(scale - 4) * 12 + note] : RTTTL_PAUSE;
+		out[n].duration = duration;
+		n++;
+	}
+	return n;
+}
+
+static bool same_notes(const rtttl_note_t *a, const rtttl_note_t *b, uint16_t n){
+	for(uint16_t i = 0; i < n; i++){
+		if((a[i].freq != b[i].freq) || (a[i].duration != b[i].duration)){
+			printf("  note %u: %u Hz %u ms, expected %u Hz %u ms\n", i, a[i].freq, a[i].duration, b[i].freq, b[i].duration);
+			return false;
+		}
+	}
+	return true;
+}
+
+static void test_reference(const char *name, const char *melody, const rtttl_note_t *ref, uint16_t len){
+	rtttl_note_t notes[MAX_NOTES];
+	uint16_t n = RtttlCompile(melody, notes, MAX_NOTES);
+	printf("%-12s %3u notes\n", name, n);
+	CHECK(n == len);
+	CHECK(same_notes(notes, ref, len));
+}
+
+static void test_legacy(void){
+	const char *melodies[] = {
+		songSimpsons, songIndiana, songTakeOnMe, songEntertainer, songMuppets, songXfiles,
+		songLooney, song20thCenFox, songBond, songMASH, songStarWars, songGoodBad, songTopGun,
+		songTeam, songFlinstones, songJeopardy, songGadget, songSmurfs, songMahnaMahna,
+		songLeisureSuit, songMissionImp
+	};
+	rtttl_note_t notes[MAX_NOTES], legacy[MAX_NOTES];
+	uint32_t total = 0;
+	for(unsigned i = 0; i < LEN(melodies); i++){
+		uint16_t n = RtttlCompile(melodies[i], notes, MAX_NOTES);
+		uint16_t m = legacy_parse(melodies[i], legacy);
+		CHECK(n > 0);
+		CHECK(n == m);
+		CHECK(same_notes(notes, legacy, n));
+		/* Size query and too small buffer */
+		CHECK(RtttlCompile(melodies[i], NULL, 0) == n);
+		CHECK(RtttlCompile(melodies[i], notes, n - 1) == 0);
+		total += n;
+	}
+	printf("%u melodies, %u notes equal to the previous parser\n", (unsigned)LEN(melodies), total);
+}
+
+static void test_errors(void){
+	rtttl_note_t notes[MAX_NOTES];
+	rtttl_parser_t parser;
+	rtttl_note_t note;
+	CHECK(RtttlCompile("no colon", notes, MAX_NOTES) == 0);
+	CHECK(RtttlCompile("x:d=4,o=5,b=100", notes, MAX_NOTES) == 0);		/* No second colon */
+	CHECK(RtttlCompile("x:", notes, MAX_NOTES) == 0);					/* Ends after the name */
+	CHECK(RtttlCompile("x:d=4,", notes, MAX_NOTES) == 0);				/* Ends after a default */
+	CHECK(RtttlCompile("x:d=4,o=9,b=100:c", notes, MAX_NOTES) == 0);		/* Invalid octave */
+	CHECK(RtttlCompile("x:d=4,b=0:c", notes, MAX_NOTES) == 0);			/* Invalid BPM */
+	CHECK(RtttlCompile("x:q=4:c", notes, MAX_NOTES) == 0);				/* Unknown default */
+	CHECK(RtttlCompile("x:b=100:c,h,d", notes, MAX_NOTES) == 0);		/* Invalid note */
+	CHECK(RtttlCompile("x:b=100:c9", notes, MAX_NOTES) == 0);			/* Note out of range */
+	CHECK(RtttlCompile("x:b=1:1c.", notes, MAX_NOTES) == 0);				/* Duration too long */
+	CHECK(RtttlCompile("x::b#7", notes, MAX_NOTES) == 1);				/* Highest note */
+	CHECK(notes[0].freq == NOTE_C8);
+	CHECK(RtttlCompile("x::", notes, MAX_NOTES) == 0);					/* Empty melody */
+	/* Notes before a syntax error are returned by RtttlNext() */
+	CHECK(RtttlBegin(&parser, "x:d=8:c,d,e,?,f"));
+	CHECK(RtttlNext(&parser, &note) && RtttlNext(&parser, &note) && RtttlNext(&parser, &note));
+	CHECK(note.freq == NOTE_E6);
+	CHECK(!RtttlNext(&parser, &note));
+	CHECK(parser.error);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	test_reference("Simpsons", songSimpsons, ref_simpsons, LEN(ref_simpsons));
+	test_reference("Variant", variant, ref_variant, LEN(ref_variant));
+	test_legacy();
+	test_errors();
+	if(failures){
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("OK\n");
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,225 @@
+/**
+ * @file slot_pool_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the lock-free slot allocator (slot_pool module), alone
+ * and driving a fake bus the way spi_mcu.c does with the SPI descriptors.
+ *
+ * Build (from this folder): make
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "slot_pool.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+#define QUEUE_SIZE		6			/* Descriptors of the fake device (SPI_QUEUE_SIZE) */
+#define PRODUCERS		3
+#define CONSUMERS		2
+#define TRANSFERS		20000		/* Transfers queued by every producer */
+
+/**
+ * @brief Driver information of a descriptor (spi_slot_t)
+ */
+typedef struct {
+	bool internal;		/* Command half of a command + data pair: not reported */
+	uint32_t user;
+} slot_t;
+/*==================[internal data definition]===============================*/
+static int failures;
+
+/* Fake device: descriptor pool, free count (free_sem) and the bus FIFO */
+static slot_pool_t pool;
+static sem_t free_sem;
+static slot_t slot[QUEUE_SIZE];
+static atomic_bool in_use[QUEUE_SIZE];
+static int8_t bus[QUEUE_SIZE];
+static int bus_head, bus_count;
+static bool bus_closed;
+static pthread_mutex_t bus_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t bus_cond = PTHREAD_COND_INITIALIZER;
+
+static atomic_uint_least8_t received[PRODUCERS][TRANSFERS];
+static atomic_int double_alloc;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Allocation order, exhaustion and release
+ */
+static void test_basic(void){
+	slot_pool_t p;
+	CHECK(!SlotPoolInit(&p, 0));
+	CHECK(!SlotPoolInit(&p, SLOT_POOL_MAX + 1));
+	CHECK(SlotPoolInit(&p, 4));
+	for(int8_t n = 0; n < 4; n++){
+		CHECK(SlotPoolAlloc(&p) == n);
+	}
+	CHECK(SlotPoolAlloc(&p) == SLOT_POOL_NONE);
+	CHECK(SlotPoolUsed(&p) == 4);
+	SlotPoolRelease(&p, 2);
+	SlotPoolRelease(&p, 7);				/* Out of range: ignored */
+	SlotPoolRelease(&p, SLOT_POOL_NONE);
+	CHECK(SlotPoolUsed(&p) == 3);
+	CHECK(SlotPoolAlloc(&p) == 2);
+	CHECK(SlotPoolAlloc(&p) == SLOT_POOL_NONE);
+
+	CHECK(SlotPoolInit(&p, SLOT_POOL_MAX));
+	for(int8_t n = 0; n < SLOT_POOL_MAX; n++){
+		CHECK(SlotPoolAlloc(&p) == n);
+	}
+	CHECK(SlotPoolAlloc(&p) == SLOT_POOL_NONE);
+	CHECK(SlotPoolUsed(&p) == SLOT_POOL_MAX);
+}
+
+/**
+ * @brief spi_alloc(): wait for a free descriptor and take it
+ */
+static int8_t bus_alloc(void){
+	sem_wait(&free_sem);
+	int8_t n = SlotPoolAlloc(&pool);
+	if((n != SLOT_POOL_NONE) && atomic_exchange(&in_use[n], true)){
+		atomic_fetch_add(&double_alloc, 1);
+	}
+	return n;
+}
+
+/**
+ * @brief spi_release(): give the descriptor back
+ */
+static void bus_release(int8_t n){
+	atomic_store(&in_use[n], false);
+	SlotPoolRelease(&pool, n);
+	sem_post(&free_sem);
+}
+
+/**
+ * @brief spi_device_queue_trans(): the FIFO has room for every descriptor
+ */
+static void bus_queue(int8_t n){
+	pthread_mutex_lock(&bus_mutex);
+	bus[(bus_head + bus_count) % QUEUE_SIZE] = n;
+	bus_count++;
+	pthread_cond_broadcast(&bus_cond);
+	pthread_mutex_unlock(&bus_mutex);
+}
+
+/**
+ * @brief spi_device_get_trans_result(): next finished descriptor (false: bus closed)
+ */
+static bool bus_result(int8_t *n){
+	pthread_mutex_lock(&bus_mutex);
+	while((bus_count == 0) && !bus_closed){
+		pthread_cond_wait(&bus_cond, &bus_mutex);
+	}
+	bool ok = (bus_count > 0);
+	if(ok){
+		*n = bus[bus_head];
+		bus_head = (bus_head + 1) % QUEUE_SIZE;
+		bus_count--;
+	}
+	pthread_mutex_unlock(&bus_mutex);
+	return ok;
+}
+
+/**
+ * @brief SpiQueue(): every third transfer is a command + data pair
+ */
+static void *producer(void *arg){
+	uint32_t id = (uint32_t)(uintptr_t)arg;
+	for(uint32_t i = 0; i < TRANSFERS; i++){
+		uint32_t user = (id << 24) | i;
+		if(i % 3 == 0){
+			int8_t n_cmd = bus_alloc();
+			int8_t n_data = bus_alloc();
+			CHECK((n_cmd != SLOT_POOL_NONE) && (n_data != SLOT_POOL_NONE));
+			slot[n_cmd] = (slot_t){.internal = true, .user = user};
+			slot[n_data] = (slot_t){.internal = false, .user = user};
+			bus_queue(n_cmd);
+			bus_queue(n_data);
+		} else {
+			int8_t n = bus_alloc();
+			CHECK(n != SLOT_POOL_NONE);
+			slot[n] = (slot_t){.internal = false, .user = user};
+			bus_queue(n);
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief SpiGetResult(): the slot is read before it is released
+ */
+static void *consumer(void *arg){
+	(void)arg;
+	int8_t n;
+	bool internal;
+	uint32_t user;
+	for(;;){
+		do{
+			if(!bus_result(&n)){
+				return NULL;
+			}
+			internal = slot[n].internal;
+			user = slot[n].user;
+			bus_release(n);
+		} while(internal);
+		atomic_fetch_add(&received[user >> 24][user & 0xFFFFFF], 1);
+	}
+}
+
+/**
+ * @brief Several tasks queueing and collecting on the same device
+ */
+static void test_fake_bus(void){
+	pthread_t prod[PRODUCERS], cons[CONSUMERS];
+	CHECK(SlotPoolInit(&pool, QUEUE_SIZE));
+	sem_init(&free_sem, 0, QUEUE_SIZE);
+	for(int c = 0; c < CONSUMERS; c++){
+		pthread_create(&cons[c], NULL, consumer, NULL);
+	}
+	for(int p = 0; p < PRODUCERS; p++){
+		pthread_create(&prod[p], NULL, producer, (void *)(uintptr_t)p);
+	}
+	for(int p = 0; p < PRODUCERS; p++){
+		pthread_join(prod[p], NULL);
+	}
+	pthread_mutex_lock(&bus_mutex);
+	bus_closed = true;
+	pthread_cond_broadcast(&bus_cond);
+	pthread_mutex_unlock(&bus_mutex);
+	for(int c = 0; c < CONSUMERS; c++){
+		pthread_join(cons[c], NULL);
+	}
+
+	/* Every transfer reported exactly once, and every descriptor back in the pool */
+	int wrong = 0;
+	for(int p = 0; p < PRODUCERS; p++){
+		for(int i = 0; i < TRANSFERS; i++){
+			wrong += (atomic_load(&received[p][i]) != 1);
+		}
+	}
+	CHECK(wrong == 0);
+	CHECK(atomic_load(&double_alloc) == 0);
+	CHECK(SlotPoolUsed(&pool) == 0);
+	printf("Fake bus: %d transfers from %d tasks, %d lost or repeated\n", PRODUCERS * TRANSFERS, PRODUCERS, wrong);
+	sem_destroy(&free_sem);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+	test_basic();
+	test_fake_bus();
+	printf(failures ? "%d FAILURES\n" : "OK\n", failures);
+	return failures != 0;
+}
+
+/*==================[end of file]============================================*/
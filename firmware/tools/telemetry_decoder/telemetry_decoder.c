@@ -0,0 +1,174 @@
+/**
+ * @file telemetry_decoder.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tool to convert binary telemetry captures (see telemetry.h) to CSV.
+ *
+ * Build (from this folder): make
+ *
+ * Usage:
+ *
+ *     telemetry_decoder [capture.bin]   decode a capture (stdin if omitted) to CSV on stdout
+ *     telemetry_decoder bench           round-trip check, bytes per sample and encode throughput
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "telemetry.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_FRAME			65535
+#define BENCH_SAMPLES		100			/*!< Samples per channel in each benchmark packet */
+#define BENCH_PACKETS		200000		/*!< Packets encoded in the benchmark */
+/*==================[internal data definition]===============================*/
+static uint8_t frame[MAX_FRAME];
+static uint8_t raw[MAX_FRAME];
+static const char *type_names[] = {"u16", "i16", "f32"};
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Print every sample of a decoded packet as one CSV line
+ */
+static void print_packet(const uint8_t *data, uint16_t len){
+	telemetry_header_t header;
+	telemetry_channel_t channel;
+	uint16_t offset = 0;
+	TelemetryParse(data, len, &header);
+	while(TelemetryNextChannel(data, len, &offset, &channel)){
+		for(uint16_t i = 0; i < channel.count; i++){
+			printf("%u,%u,%u,%s,%lu,%.9g\n", header.seq, header.timestamp, channel.id, type_names[channel.type],
+				   (unsigned long)header.timestamp + (unsigned long)i * channel.period, TelemetrySample(&channel, i));
+		}
+	}
+}
+
+static int decode(FILE *in){
+	uint32_t len = 0;
+	uint32_t frames = 0, errors = 0;
+	int c;
+	printf("seq,packet_timestamp_us,channel,type,sample_timestamp_us,value\n");
+	while((c = fgetc(in)) != EOF){
+		if(c != 0){
+			if(len < MAX_FRAME){
+				frame[len] = c;
+			}
+			len++;
+			continue;
+		}
+		if(len > 0){
+			int32_t raw_len = (len <= MAX_FRAME) ? TelemetryCobsDecode(frame, len, raw) : -1;
+			telemetry_header_t header;
+			if((raw_len > 0) && TelemetryParse(raw, raw_len, &header)){
+				print_packet(raw, raw_len);
+				frames++;
+			} else{
+				errors++;
+			}
+		}
+		len = 0;
+	}
+	fprintf(stderr, "%u frames decoded, %u corrupted frames dropped\n", frames, errors);
+	return 0;
+}
+
+static double elapsed(struct timespec *start){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+static int bench(void){
+	static uint16_t ch_u16[BENCH_SAMPLES];
+	static int16_t ch_i16[BENCH_SAMPLES];
+	static float ch_f32[BENCH_SAMPLES];
+	static uint8_t pkt_buf[1024];
+	telemetry_packet_t pkt;
+	telemetry_header_t header;
+	telemetry_channel_t channel;
+	struct timespec start;
+	uint16_t frame_len = 0;
+	uint32_t ascii_len = 0;
+	uint64_t total = 0;
+	char line[32];
+	double t;
+
+	for(int i = 0; i < BENCH_SAMPLES; i++){
+		ch_u16[i] = (uint16_t)(2048 + 2000 * sin(i * 0.1));
+		ch_i16[i] = (int16_t)(-1000 * cos(i * 0.2));
+		ch_f32[i] = (float)(12.5 * sin(i * 0.05));
+		/* ASCII reference: one "Field: value unit\r\n" line per sample, as in current projects */
+		ascii_len += snprintf(line, sizeof(line), "CH0: %u mV\r\n", ch_u16[i]);
+		ascii_len += snprintf(line, sizeof(line), "CH1: %d\r\n", ch_i16[i]);
+		ascii_len += snprintf(line, sizeof(line), "CH2: %.3f\r\n", ch_f32[i]);
+	}
+
+	/* Round trip */
+	TelemetryBegin(&pkt, pkt_buf, sizeof(pkt_buf), 7, 123456);
+	TelemetryAddChannel(&pkt, 0, TELEMETRY_U16, 1000, ch_u16, BENCH_SAMPLES);
+	TelemetryAddChannel(&pkt, 1, TELEMETRY_I16, 1000, ch_i16, BENCH_SAMPLES);
+	TelemetryAddChannel(&pkt, 2, TELEMETRY_F32, 1000, ch_f32, BENCH_SAMPLES);
+	frame_len = TelemetryEnd(&pkt, frame, sizeof(frame));
+	int32_t raw_len = TelemetryCobsDecode(frame, frame_len - 1, raw);
+	if((frame_len == 0) || memchr(frame, 0, frame_len - 1) || (raw_len < 0) || !TelemetryParse(raw, raw_len, &header)){
+		fprintf(stderr, "FAIL: round trip\n");
+		return 1;
+	}
+	uint16_t offset = 0;
+	while(TelemetryNextChannel(raw, raw_len, &offset, &channel)){
+		for(uint16_t i = 0; i < channel.count; i++){
+			float expected = (channel.id == 0) ? ch_u16[i] : (channel.id == 1) ? ch_i16[i] : ch_f32[i];
+			if(TelemetrySample(&channel, i) != expected){
+				fprintf(stderr, "FAIL: channel %u sample %u\n", channel.id, i);
+				return 1;
+			}
+		}
+	}
+	/* Single bit errors must be detected */
+	for(uint16_t i = 0; i < raw_len * 8; i++){
+		raw[i / 8] ^= 1 << (i % 8);
+		if(TelemetryParse(raw, raw_len, &header)){
+			fprintf(stderr, "FAIL: bit error %u not detected\n", i);
+			return 1;
+		}
+		raw[i / 8] ^= 1 << (i % 8);
+	}
+	printf("round trip: OK\n");
+	printf("binary: %u bytes for %u samples (%.2f bytes/sample)\n", frame_len, 3 * BENCH_SAMPLES, frame_len / (3.0 * BENCH_SAMPLES));
+	printf("ascii:  %u bytes for %u samples (%.2f bytes/sample)\n", ascii_len, 3 * BENCH_SAMPLES, ascii_len / (3.0 * BENCH_SAMPLES));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t n = 0; n < BENCH_PACKETS; n++){
+		TelemetryBegin(&pkt, pkt_buf, sizeof(pkt_buf), n, n * 100000);
+		TelemetryAddChannel(&pkt, 0, TELEMETRY_U16, 1000, ch_u16, BENCH_SAMPLES);
+		TelemetryAddChannel(&pkt, 1, TELEMETRY_I16, 1000, ch_i16, BENCH_SAMPLES);
+		TelemetryAddChannel(&pkt, 2, TELEMETRY_F32, 1000, ch_f32, BENCH_SAMPLES);
+		total += TelemetryEnd(&pkt, frame, sizeof(frame));
+	}
+	t = elapsed(&start);
+	printf("encode: %.1f Msamples/s, %.1f MB/s of frames\n", (double)BENCH_PACKETS * 3 * BENCH_SAMPLES / t / 1e6, total / t / 1e6);
+	return 0;
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+	FILE *in = stdin;
+	if((argc > 1) && (strcmp(argv[1], "bench") == 0)){
+		return bench();
+	}
+	if(argc > 1){
+		in = fopen(argv[1], "rb");
+		if(in == NULL){
+			perror(argv[1]);
+			return 1;
+		}
+	}
+	return decode(in);
+}
+
+/*==================[end of file]============================================*/